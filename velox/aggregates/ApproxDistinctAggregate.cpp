@@ -27,9 +27,20 @@
 namespace facebook::velox::aggregate {
 namespace {
 
+// The sketch of a group. It is sparse until the sparse sketch reaches the
+// size of the dense one. Only one of the two exists at a time, so that a group
+// takes the space of the larger of them, not of both.
 struct HllAccumulator {
   explicit HllAccumulator(exec::HashStringAllocator* allocator)
-      : sparseHll_{allocator}, denseHll_{allocator} {}
+      : allocator_{allocator}, sparseHll_{allocator} {}
+
+  ~HllAccumulator() {
+    if (isSparse_) {
+      sparseHll_.~SparseHll();
+    } else {
+      denseHll_.~DenseHll();
+    }
+  }
 
   void setIndexBitLength(int8_t indexBitLength) {
     indexBitLength_ = indexBitLength;
@@ -47,6 +58,18 @@ struct HllAccumulator {
     }
   }
 
+  void append(const uint64_t* hashes, int32_t numHashes) {
+    if (isSparse_) {
+      if (sparseHll_.insertHashes(hashes, numHashes)) {
+        toDense();
+      }
+    } else {
+      for (auto i = 0; i < numHashes; ++i) {
+        denseHll_.insertHash(hashes[i]);
+      }
+    }
+  }
+
   int64_t cardinality() const {
     return isSparse_ ? sparseHll_.cardinality() : denseHll_.cardinality();
   }
@@ -83,17 +106,22 @@ struct HllAccumulator {
                      : denseHll_.serialize(outputBuffer);
   }
 
+  // Replaces the sparse sketch with a dense one in the same space.
   void toDense() {
+    hll::DenseHll denseHll{indexBitLength_, allocator_};
+    sparseHll_.toDense(denseHll);
+    sparseHll_.~SparseHll();
+    new (&denseHll_) hll::DenseHll(std::move(denseHll));
     isSparse_ = false;
-    denseHll_.initialize(indexBitLength_);
-    sparseHll_.toDense(denseHll_);
-    sparseHll_.reset();
   }
 
+  exec::HashStringAllocator* const allocator_;
   bool isSparse_{true};
   int8_t indexBitLength_{-1};
-  hll::SparseHll sparseHll_;
-  hll::DenseHll denseHll_;
+  union {
+    hll::SparseHll sparseHll_;
+    hll::DenseHll denseHll_;
+  };
 };
 
 template <typename T>
@@ -237,19 +265,22 @@ class ApproxDistinctAggregate : public exec::Aggregate {
       bool /*mayPushdown*/) override {
     decodeArguments(rows, args);
 
+    // Hashes all values first and adds them to the sketch in one batch.
+    hashes_.clear();
     rows.applyToSelected([&](auto row) {
-      if (decodedValue_.isNullAt(row)) {
-        return;
-      }
-
-      auto accumulator = value<HllAccumulator>(group);
-      if (clearNull(group)) {
-        accumulator->setIndexBitLength(indexBitLength_);
+      if (!decodedValue_.isNullAt(row)) {
+        hashes_.push_back(hashOne(decodedValue_.valueAt<T>(row)));
       }
-
-      auto hash = hashOne(decodedValue_.valueAt<T>(row));
-      accumulator->append(hash);
     });
+    if (hashes_.empty()) {
+      return;
+    }
+
+    auto accumulator = value<HllAccumulator>(group);
+    if (clearNull(group)) {
+      accumulator->setIndexBitLength(indexBitLength_);
+    }
+    accumulator->append(hashes_.data(), hashes_.size());
   }
 
   void updateSingleGroupFinal(
@@ -353,6 +384,8 @@ class ApproxDistinctAggregate : public exec::Aggregate {
   DecodedVector decodedValue_;
   DecodedVector decodedMaxStandardError_;
   DecodedVector decodedHll_;
+  // Hashes of the input of updateSingleGroupPartial().
+  std::vector<uint64_t> hashes_;
 };
 
 template <TypeKind kind>
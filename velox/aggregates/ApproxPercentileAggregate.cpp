@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 #include <folly/stats/TDigest.h>
+#include <algorithm>
+#include <cmath>
 #include "velox/aggregates/AggregateNames.h"
 #include "velox/aggregates/IOUtils.h"
 #include "velox/exec/Aggregate.h"
@@ -23,44 +25,87 @@
 
 namespace facebook::velox::aggregate {
 namespace {
+// The serialized form of a digest is sum, count, min and max as doubles,
+// maxSize and the number of centroids as int32, the means of the centroids
+// as doubles and their weights as varints. The weights are counts of values,
+// so they are whole numbers and most are small.
+
+int32_t varintSize(uint64_t value) {
+  int32_t size = 1;
+  while (value >= 0x80) {
+    value >>= 7;
+    ++size;
+  }
+  return size;
+}
+
+template <typename TByteStream>
+void appendVarint(uint64_t value, TByteStream& output) {
+  while (value >= 0x80) {
+    output.appendOne(static_cast<uint8_t>(value | 0x80));
+    value >>= 7;
+  }
+  output.appendOne(static_cast<uint8_t>(value));
+}
+
+template <typename TByteStream>
+uint64_t readVarint(TByteStream& input) {
+  uint64_t value = 0;
+  for (int32_t shift = 0;; shift += 7) {
+    auto byte = input.template read<uint8_t>();
+    value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+    if (!(byte & 0x80)) {
+      return value;
+    }
+  }
+}
+
 int32_t serializedSize(const folly::TDigest& digest) {
-  return sizeof(size_t) + // maxSize
-      4 * sizeof(double) + // sum, count, min, max
-      sizeof(size_t) + // number of centroids
-      2 * sizeof(double) * digest.getCentroids().size();
+  int32_t size = 4 * sizeof(double) + // sum, count, min, max
+      2 * sizeof(int32_t); // maxSize, number of centroids
+  for (const auto& centroid : digest.getCentroids()) {
+    size += sizeof(double) +
+        varintSize(static_cast<uint64_t>(centroid.weight()));
+  }
+  return size;
 }
 
 template <typename TByteStream>
 void serialize(const folly::TDigest& digest, TByteStream& output) {
-  output.appendOne(digest.maxSize());
   output.appendOne(digest.sum());
   output.appendOne(digest.count());
   output.appendOne(digest.min());
   output.appendOne(digest.max());
+  output.appendOne(static_cast<int32_t>(digest.maxSize()));
 
   const auto& centroids = digest.getCentroids();
-  output.appendOne(centroids.size());
+  output.appendOne(static_cast<int32_t>(centroids.size()));
   for (const auto& centroid : centroids) {
     output.appendOne(centroid.mean());
-    output.appendOne(centroid.weight());
+  }
+  for (const auto& centroid : centroids) {
+    VELOX_DCHECK_EQ(centroid.weight(), std::floor(centroid.weight()));
+    appendVarint(static_cast<uint64_t>(centroid.weight()), output);
   }
 }
 
 template <typename TByteStream>
 folly::TDigest deserialize(TByteStream& input) {
-  auto maxSize = input.template read<size_t>();
   auto sum = input.template read<double>();
   auto count = input.template read<double>();
   auto min = input.template read<double>();
   auto max = input.template read<double>();
+  auto maxSize = input.template read<int32_t>();
 
-  auto centroidCount = input.template read<size_t>();
+  auto centroidCount = input.template read<int32_t>();
+  std::vector<double> means(centroidCount);
+  for (auto i = 0; i < centroidCount; i++) {
+    means[i] = input.template read<double>();
+  }
   std::vector<folly::TDigest::Centroid> centroids;
   centroids.reserve(centroidCount);
   for (auto i = 0; i < centroidCount; i++) {
-    auto mean = input.template read<double>();
-    auto weight = input.template read<double>();
-    centroids.emplace_back(folly::TDigest::Centroid(mean, weight));
+    centroids.emplace_back(means[i], readVarint(input));
   }
 
   return folly::TDigest(std::move(centroids), sum, count, max, min, maxSize);
@@ -72,12 +117,10 @@ folly::TDigest singleValueDigest(T v, int64_t count) {
       {folly::TDigest::Centroid(v, count)}, v * count, count, v, v);
 }
 
+// The state of a group: a digest of at most maxSize centroids, serialized in
+// memory from HashStringAllocator, and a few values not yet added to the
+// digest. The size does not depend on the number of input values.
 struct TDigestAccumulator {
-  explicit TDigestAccumulator(exec::HashStringAllocator* allocator)
-      : values_{exec::StlAllocator<double>(allocator)},
-        largeCountValues_{exec::StlAllocator<double>(allocator)},
-        largeCounts_{exec::StlAllocator<int64_t>(allocator)} {}
-
   void write(
       const folly::TDigest& digest,
       exec::HashStringAllocator* allocator) {
@@ -109,90 +152,70 @@ struct TDigestAccumulator {
     }
   }
 
-  template <typename T>
-  void append(T v, exec::HashStringAllocator* allocator) {
-    values_.emplace_back((double)v);
-
-    if (values_.size() >= kMaxBufferSize) {
-      flush(allocator);
+  // Adds 'values' to the digest. 'values' is scratch memory of the caller
+  // and may be reordered and extended. Values are held in the accumulator
+  // until there are more than kMaxBufferSize, so that a group that gets a
+  // few values per batch does not rewrite its digest for each batch.
+  void append(
+      std::vector<double>& values,
+      exec::HashStringAllocator* allocator) {
+    if (numBuffered_ + values.size() <= kMaxBufferSize) {
+      std::copy(values.begin(), values.end(), buffer_ + numBuffered_);
+      numBuffered_ += values.size();
+      return;
     }
+    values.insert(values.end(), buffer_, buffer_ + numBuffered_);
+    numBuffered_ = 0;
+    merge(values, allocator);
   }
 
-  template <typename T>
-  void append(T v, int64_t count, exec::HashStringAllocator* allocator) {
-    static const int64_t kMaxCountToBuffer = 99;
-
-    if (values_.size() + count <= kMaxBufferSize &&
-        count <= kMaxCountToBuffer) {
-      values_.reserve(values_.size() + count);
-      for (auto i = 0; i < count; i++) {
-        values_.emplace_back((double)v);
-      }
-
-      if (values_.size() >= kMaxBufferSize) {
-        flush(allocator);
-      }
-    } else {
-      largeCountValues_.emplace_back(v);
-      largeCounts_.emplace_back(count);
-      if (largeCountValues_.size() >= kMaxBufferSize) {
-        flush(allocator);
-      }
+  // Adds each of 'values' with the weight at the same position in 'counts'.
+  void append(
+      const std::vector<double>& values,
+      const std::vector<int64_t>& counts,
+      exec::HashStringAllocator* allocator) {
+    std::vector<folly::TDigest> digests;
+    digests.reserve(values.size() + 1);
+    for (auto i = 0; i < values.size(); i++) {
+      digests.emplace_back(singleValueDigest(values[i], counts[i]));
     }
-  }
 
-  void append(folly::TDigest digest, exec::HashStringAllocator* allocator) {
     if (hasValue()) {
-      auto currentDigest = read();
-      std::vector<folly::TDigest> digests = {
-          std::move(currentDigest), std::move(digest)};
-      auto combinedDigest =
-          folly::TDigest::merge(folly::Range(digests.data(), digests.size()));
-      write(combinedDigest, allocator);
-    } else {
-      write(digest, allocator);
+      digests.emplace_back(read());
     }
+
+    auto combinedDigest =
+        folly::TDigest::merge(folly::Range(digests.data(), digests.size()));
+    write(combinedDigest, allocator);
   }
 
   void flush(exec::HashStringAllocator* allocator) {
-    if (!values_.empty()) {
-      folly::TDigest digest{hasValue() ? read() : folly::TDigest()};
-      digest = digest.merge(values_);
-      values_.clear();
-      write(digest, allocator);
-    }
-
-    if (!largeCountValues_.empty()) {
-      std::vector<folly::TDigest> digests;
-      digests.reserve(largeCountValues_.size() + 1);
-      for (auto i = 0; i < largeCountValues_.size(); i++) {
-        digests.emplace_back(
-            singleValueDigest(largeCountValues_[i], largeCounts_[i]));
-      }
-
-      if (hasValue()) {
-        digests.emplace_back(read());
-      }
-
-      auto combinedDigest =
-          folly::TDigest::merge(folly::Range(digests.data(), digests.size()));
-      largeCountValues_.clear();
-      largeCounts_.clear();
-
-      write(combinedDigest, allocator);
+    if (numBuffered_) {
+      std::vector<double> values(buffer_, buffer_ + numBuffered_);
+      numBuffered_ = 0;
+      merge(values, allocator);
     }
   }
 
  private:
   // Maximum number of values to accumulate before updating TDigest.
-  static const size_t kMaxBufferSize = 4096;
+  static constexpr int32_t kMaxBufferSize = 16;
 
-  exec::HashStringAllocator::Header* begin_{nullptr};
-
-  std::vector<double, exec::StlAllocator<double>> values_;
+  void merge(
+      std::vector<double>& values,
+      exec::HashStringAllocator* allocator) {
+    std::sort(values.begin(), values.end());
+    folly::TDigest digest{hasValue() ? read() : folly::TDigest()};
+    write(
+        digest.merge(
+            folly::sorted_equivalent,
+            folly::Range(values.data(), values.size())),
+        allocator);
+  }
 
-  std::vector<double, exec::StlAllocator<double>> largeCountValues_;
-  std::vector<int64_t, exec::StlAllocator<int64_t>> largeCounts_;
+  exec::HashStringAllocator::Header* begin_{nullptr};
+  int32_t numBuffered_{0};
+  double buffer_[kMaxBufferSize];
 };
 
 // The following variations are possible:
@@ -219,7 +242,7 @@ class ApproxPercentileAggregate : public exec::Aggregate {
     exec::Aggregate::setAllNulls(groups, indices);
     for (auto i : indices) {
       auto group = groups[i];
-      new (group + offset_) TDigestAccumulator(allocator_);
+      new (group + offset_) TDigestAccumulator();
     }
   }
 
@@ -292,38 +315,10 @@ class ApproxPercentileAggregate : public exec::Aggregate {
     decodeArguments(rows, args);
     checkSetPercentile();
 
-    if (hasWeight_) {
-      rows.applyToSelected([&](auto row) {
-        if (decodedValue_.isNullAt(row) || decodedWeight_.isNullAt(row)) {
-          return;
-        }
-
-        auto accumulator = value<TDigestAccumulator>(groups[row]);
-        auto value = decodedValue_.valueAt<T>(row);
-        auto weight = decodedWeight_.valueAt<int64_t>(row);
-        VELOX_USER_CHECK_GE(
-            weight,
-            1,
-            "The value of the weight parameter must be greater than or equal to 1.");
-        accumulator->append(value, weight, allocator_);
-      });
-    } else {
-      if (decodedValue_.mayHaveNulls()) {
-        rows.applyToSelected([&](auto row) {
-          if (decodedValue_.isNullAt(row)) {
-            return;
-          }
-
-          auto accumulator = value<TDigestAccumulator>(groups[row]);
-          accumulator->append(decodedValue_.valueAt<T>(row), allocator_);
-        });
-      } else {
-        rows.applyToSelected([&](auto row) {
-          auto accumulator = value<TDigestAccumulator>(groups[row]);
-          accumulator->append(decodedValue_.valueAt<T>(row), allocator_);
-        });
-      }
-    }
+    collectRawInput(rows, [&](auto row) { return groups[row]; });
+    forEachGroup([&](char* group, auto begin, auto end) {
+      addRawInput(value<TDigestAccumulator>(group), begin, end);
+    });
   }
 
   void updateFinal(
@@ -333,19 +328,9 @@ class ApproxPercentileAggregate : public exec::Aggregate {
       bool /*mayPushdown*/) override {
     decodedDigest_.decode(*args[0], rows, true);
 
-    rows.applyToSelected([&](auto row) {
-      if (decodedDigest_.isNullAt(row)) {
-        return;
-      }
-
-      auto serialized = decodedDigest_.valueAt<StringView>(row);
-      InputByteStream stream(serialized.data());
-      auto percentile = stream.read<double>();
-      checkSetPercentile(percentile);
-      auto digest = deserialize(stream);
-
-      auto accumulator = value<TDigestAccumulator>(groups[row]);
-      accumulator->append(std::move(digest), allocator_);
+    collectIntermediate(rows, [&](auto row) { return groups[row]; });
+    forEachGroup([&](char* group, auto begin, auto end) {
+      addIntermediate(value<TDigestAccumulator>(group), begin, end);
     });
   }
 
@@ -357,37 +342,9 @@ class ApproxPercentileAggregate : public exec::Aggregate {
     decodeArguments(rows, args);
     checkSetPercentile();
 
-    auto accumulator = value<TDigestAccumulator>(group);
-
-    if (hasWeight_) {
-      rows.applyToSelected([&](auto row) {
-        if (decodedValue_.isNullAt(row) || decodedWeight_.isNullAt(row)) {
-          return;
-        }
-
-        auto value = decodedValue_.valueAt<T>(row);
-        auto weight = decodedWeight_.valueAt<int64_t>(row);
-        VELOX_USER_CHECK_GE(
-            weight,
-            1,
-            "The value of the weight parameter must be greater than or equal to 1.");
-        accumulator->append(value, weight, allocator_);
-      });
-    } else {
-      if (decodedValue_.mayHaveNulls()) {
-        rows.applyToSelected([&](auto row) {
-          if (decodedValue_.isNullAt(row)) {
-            return;
-          }
-
-          accumulator->append(decodedValue_.valueAt<T>(row), allocator_);
-        });
-      } else {
-        rows.applyToSelected([&](auto row) {
-          accumulator->append(decodedValue_.valueAt<T>(row), allocator_);
-        });
-      }
-    }
+    collectRawInput(rows, [&](auto /*row*/) { return group; });
+    addRawInput(
+        value<TDigestAccumulator>(group), groupRows_.begin(), groupRows_.end());
   }
 
   void updateSingleGroupFinal(
@@ -396,32 +353,10 @@ class ApproxPercentileAggregate : public exec::Aggregate {
       const std::vector<VectorPtr>& args,
       bool /*mayPushdown*/) override {
     decodedDigest_.decode(*args[0], rows, true);
-    auto accumulator = value<TDigestAccumulator>(group);
 
-    std::vector<folly::TDigest> digests;
-    digests.reserve(rows.end() + 1);
-    if (accumulator->hasValue()) {
-      digests.emplace_back(accumulator->read());
-    }
-
-    rows.applyToSelected([&](auto row) {
-      if (decodedDigest_.isNullAt(row)) {
-        return;
-      }
-
-      auto serialized = decodedDigest_.valueAt<StringView>(row);
-      InputByteStream stream(serialized.data());
-      auto percentile = stream.read<double>();
-      checkSetPercentile(percentile);
-
-      digests.emplace_back(deserialize(stream));
-    });
-
-    if (!digests.empty()) {
-      auto digest =
-          folly::TDigest::merge(folly::Range(digests.data(), digests.size()));
-      accumulator->write(digest, allocator_);
-    }
+    collectIntermediate(rows, [&](auto /*row*/) { return group; });
+    addIntermediate(
+        value<TDigestAccumulator>(group), groupRows_.begin(), groupRows_.end());
   }
 
  private:
@@ -455,6 +390,120 @@ class ApproxPercentileAggregate : public exec::Aggregate {
     }
   }
 
+  using GroupRowIterator =
+      std::vector<std::pair<char*, vector_size_t>>::const_iterator;
+
+  // Sets 'groupRows_' to the rows of 'rows' with non-null value and weight
+  // and their groups, ordered by group and row.
+  template <typename GetGroup>
+  void collectRawInput(const SelectivityVector& rows, GetGroup getGroup) {
+    groupRows_.clear();
+    rows.applyToSelected([&](auto row) {
+      if (decodedValue_.isNullAt(row) ||
+          (hasWeight_ && decodedWeight_.isNullAt(row))) {
+        return;
+      }
+      groupRows_.emplace_back(getGroup(row), row);
+    });
+    std::sort(groupRows_.begin(), groupRows_.end());
+  }
+
+  // Sets 'groupRows_' to the rows of 'rows' with a non-null digest and their
+  // groups, ordered by group and row.
+  template <typename GetGroup>
+  void collectIntermediate(const SelectivityVector& rows, GetGroup getGroup) {
+    groupRows_.clear();
+    rows.applyToSelected([&](auto row) {
+      if (!decodedDigest_.isNullAt(row)) {
+        groupRows_.emplace_back(getGroup(row), row);
+      }
+    });
+    std::sort(groupRows_.begin(), groupRows_.end());
+  }
+
+  // Calls 'func' with each group in 'groupRows_' and the range of its rows.
+  template <typename Func>
+  void forEachGroup(Func func) {
+    auto begin = groupRows_.cbegin();
+    while (begin != groupRows_.cend()) {
+      auto end = begin + 1;
+      while (end != groupRows_.cend() && end->first == begin->first) {
+        ++end;
+      }
+      func(begin->first, begin, end);
+      begin = end;
+    }
+  }
+
+  // Adds the values of the rows in [begin, end) to 'accumulator'. A value
+  // with weight up to kMaxCountToExpand is added as that many values, a
+  // value with a larger weight as a centroid with that weight.
+  void addRawInput(
+      TDigestAccumulator* accumulator,
+      GroupRowIterator begin,
+      GroupRowIterator end) {
+    static const int64_t kMaxCountToExpand = 99;
+
+    values_.clear();
+    largeCountValues_.clear();
+    largeCounts_.clear();
+    for (auto it = begin; it != end; ++it) {
+      auto row = it->second;
+      auto value = static_cast<double>(decodedValue_.valueAt<T>(row));
+      if (!hasWeight_) {
+        values_.push_back(value);
+        continue;
+      }
+      auto weight = decodedWeight_.valueAt<int64_t>(row);
+      VELOX_USER_CHECK_GE(
+          weight,
+          1,
+          "The value of the weight parameter must be greater than or equal to 1.");
+      if (weight <= kMaxCountToExpand) {
+        values_.insert(values_.end(), weight, value);
+      } else {
+        largeCountValues_.push_back(value);
+        largeCounts_.push_back(weight);
+      }
+    }
+
+    if (!values_.empty()) {
+      accumulator->append(values_, allocator_);
+    }
+    if (!largeCountValues_.empty()) {
+      accumulator->append(largeCountValues_, largeCounts_, allocator_);
+    }
+  }
+
+  // Merges the digests of the rows in [begin, end) into 'accumulator' with
+  // one TDigest::merge().
+  void addIntermediate(
+      TDigestAccumulator* accumulator,
+      GroupRowIterator begin,
+      GroupRowIterator end) {
+    std::vector<folly::TDigest> digests;
+    digests.reserve(end - begin + 1);
+    if (accumulator->hasValue()) {
+      digests.emplace_back(accumulator->read());
+    }
+
+    for (auto it = begin; it != end; ++it) {
+      auto serialized = decodedDigest_.valueAt<StringView>(it->second);
+      InputByteStream stream(serialized.data());
+      auto percentile = stream.read<double>();
+      checkSetPercentile(percentile);
+      digests.emplace_back(deserialize(stream));
+    }
+
+    if (digests.size() == 1) {
+      accumulator->write(digests[0], allocator_);
+    } else if (!digests.empty()) {
+      accumulator->write(
+          folly::TDigest::merge(folly::Range(digests.data(), digests.size())),
+          allocator_);
+    }
+  }
+
   void decodeArguments(
       const SelectivityVector& rows,
       const std::vector<VectorPtr>& args) {
@@ -498,6 +547,12 @@ class ApproxPercentileAggregate : public exec::Aggregate {
   DecodedVector decodedWeight_;
   DecodedVector decodedPercentile_;
   DecodedVector decodedDigest_;
+
+  // Scratch memory for a batch of input.
+  std::vector<std::pair<char*, vector_size_t>> groupRows_;
+  std::vector<double> values_;
+  std::vector<double> largeCountValues_;
+  std::vector<int64_t> largeCounts_;
 };
 
 bool registerApproxPercentile(const std::string& name) {
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/aggregates/AggregateNames.h"
+#include "velox/aggregates/SimdReduce.h"
 #include "velox/exec/Aggregate.h"
 #include "velox/vector/ComplexVector.h"
 #include "velox/vector/DecodedVector.h"
@@ -103,6 +104,69 @@ class AverageAggregate : public exec::Aggregate {
     }
   }
 
+  bool supportsDenseAccumulators() const override {
+    return isRawInput_;
+  }
+
+  // Keeps the sums and counts in separate arrays. A count of 0 means that
+  // the group has no value.
+  void updateDense(
+      const uint64_t* groupNumbers,
+      int32_t numGroupNumbers,
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args) override {
+    if (denseSums_.size() != static_cast<size_t>(numGroupNumbers)) {
+      VELOX_CHECK(denseSums_.empty());
+      denseSums_.assign(numGroupNumbers, 0);
+      denseCounts_.assign(numGroupNumbers, 0);
+    }
+    auto sums = denseSums_.data();
+    auto counts = denseCounts_.data();
+    decodedRaw_.decode(*args[0], rows);
+    if (decodedRaw_.isConstantMapping()) {
+      if (!decodedRaw_.isNullAt(0)) {
+        const double value = decodedRaw_.valueAt<T>(0);
+        rows.applyToSelected([&](vector_size_t i) {
+          sums[groupNumbers[i]] += value;
+          ++counts[groupNumbers[i]];
+        });
+      }
+    } else if (decodedRaw_.mayHaveNulls()) {
+      rows.applyToSelected([&](vector_size_t i) {
+        if (!decodedRaw_.isNullAt(i)) {
+          sums[groupNumbers[i]] += decodedRaw_.valueAt<T>(i);
+          ++counts[groupNumbers[i]];
+        }
+      });
+    } else if (decodedRaw_.isIdentityMapping()) {
+      const T* data = decodedRaw_.data<T>();
+      rows.applyToSelected([&](vector_size_t i) {
+        sums[groupNumbers[i]] += data[i];
+        ++counts[groupNumbers[i]];
+      });
+    } else {
+      rows.applyToSelected([&](vector_size_t i) {
+        sums[groupNumbers[i]] += decodedRaw_.valueAt<T>(i);
+        ++counts[groupNumbers[i]];
+      });
+    }
+  }
+
+  void flushDense(char** groups, int32_t numGroupNumbers) override {
+    if (denseSums_.empty()) {
+      return;
+    }
+    VELOX_CHECK_EQ(denseSums_.size(), static_cast<size_t>(numGroupNumbers));
+    for (auto i = 0; i < numGroupNumbers; ++i) {
+      if (denseCounts_[i]) {
+        VELOX_DCHECK_NOT_NULL(groups[i]);
+        updateNonNullValue(groups[i], denseCounts_[i], denseSums_[i]);
+      }
+    }
+    denseSums_.clear();
+    denseCounts_.clear();
+  }
+
  protected:
   void updatePartial(
       char** groups,
@@ -142,6 +206,25 @@ class AverageAggregate : public exec::Aggregate {
       bool /*mayPushdown*/) override {
     decodedRaw_.decode(*args[0], rows);
 
+    if constexpr (std::is_integral_v<T> && sizeof(T) < sizeof(int64_t)) {
+      // The sum of a batch of narrower integers is exact in int64_t and in
+      // double, so adding them in SIMD lanes gives the same result.
+      int64_t sum;
+      int64_t count;
+      if (reduceDecoded<T>(
+              decodedRaw_,
+              rows,
+              int64_t{0},
+              [](auto x, auto y) { return x + y; },
+              sum,
+              count)) {
+        if (count) {
+          updateNonNullValue(group, count, static_cast<double>(sum));
+        }
+        return;
+      }
+    }
+
     if (decodedRaw_.isConstantMapping()) {
       if (!decodedRaw_.isNullAt(0)) {
         const T value = decodedRaw_.valueAt<T>(0);
@@ -276,6 +359,9 @@ class AverageAggregate : public exec::Aggregate {
 
   DecodedVector decodedRaw_;
   DecodedVector decodedPartial_;
+  // Accumulators of updateDense() indexed by group number.
+  std::vector<double> denseSums_;
+  std::vector<int64_t> denseCounts_;
 };
 
 void checkSumCountRowType(TypePtr type, const std::string& errorMessage) {
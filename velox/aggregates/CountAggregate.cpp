@@ -90,6 +90,51 @@ class CountAggregate : public SimpleNumericAggregate<bool, int64_t, int64_t> {
     VELOX_UNREACHABLE();
   }
 
+  bool supportsDenseAccumulators() const override {
+    return true;
+  }
+
+  void updateDense(
+      const uint64_t* groupNumbers,
+      int32_t numGroupNumbers,
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args) override {
+    prepareDenseGroups(numGroupNumbers, 0);
+    auto counts = denseValues_.data();
+    auto hasValue = denseHasValue_.data();
+    auto addToDenseGroup = [&](vector_size_t i) {
+      auto group = groupNumbers[i];
+      ++counts[group];
+      hasValue[group] = 1;
+    };
+    if (args.empty()) {
+      rows.applyToSelected(addToDenseGroup);
+      return;
+    }
+
+    DecodedVector decoded(*args[0], rows);
+    if (decoded.isConstantMapping()) {
+      if (!decoded.isNullAt(0)) {
+        rows.applyToSelected(addToDenseGroup);
+      }
+    } else if (decoded.mayHaveNulls()) {
+      rows.applyToSelected([&](vector_size_t i) {
+        if (!decoded.isNullAt(i)) {
+          addToDenseGroup(i);
+        }
+      });
+    } else {
+      rows.applyToSelected(addToDenseGroup);
+    }
+  }
+
+  void flushDense(char** groups, int32_t numGroupNumbers) override {
+    flushDenseGroups(
+        groups, numGroupNumbers, [](int64_t& result, int64_t value) {
+          result += value;
+        });
+  }
+
   void updateSingleGroupPartial(
       char* group,
       const SelectivityVector& rows,
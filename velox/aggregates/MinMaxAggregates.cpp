@@ -39,6 +39,27 @@ struct MinMaxTrait<Timestamp> {
   }
 };
 
+// Returns the identity of max over T. Unlike MinMaxTrait<T>::min(), this is
+// -inf for floating point types, so that max over -inf values is -inf.
+template <typename T>
+constexpr T maxIdentity() {
+  if constexpr (std::is_floating_point_v<T>) {
+    return -std::numeric_limits<T>::infinity();
+  } else {
+    return std::numeric_limits<T>::lowest();
+  }
+}
+
+// Returns the identity of min over T, +inf for floating point types.
+template <typename T>
+constexpr T minIdentity() {
+  if constexpr (std::is_floating_point_v<T>) {
+    return std::numeric_limits<T>::infinity();
+  } else {
+    return std::numeric_limits<T>::max();
+  }
+}
+
 template <typename T, typename ResultType>
 class MinMaxAggregate : public SimpleNumericAggregate<T, T, ResultType> {
   using BaseAggregate = SimpleNumericAggregate<T, T, ResultType>;
@@ -137,19 +158,60 @@ class MaxAggregate : public MinMaxAggregate<T, ResultType> {
     updatePartial(groups, rows, args, mayPushdown);
   }
 
+  bool supportsDenseAccumulators() const override {
+    return std::is_arithmetic_v<T>;
+  }
+
+  void updateDense(
+      const uint64_t* groupNumbers,
+      int32_t numGroupNumbers,
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args) override {
+    BaseAggregate::updateDenseGroups(
+        groupNumbers,
+        numGroupNumbers,
+        rows,
+        args[0],
+        maxIdentity<T>(),
+        combine);
+  }
+
+  void flushDense(char** groups, int32_t numGroupNumbers) override {
+    BaseAggregate::flushDenseGroups(groups, numGroupNumbers, combine);
+  }
+
   void updateSingleGroupPartial(
       char* group,
       const SelectivityVector& rows,
       const std::vector<VectorPtr>& args,
       bool mayPushdown) override {
-    BaseAggregate::updateOneGroup(
-        group,
-        rows,
-        args[0],
-        [](T& result, T value) { result = result > value ? result : value; },
-        [](T& result, T value, int /* unused */) { result = value; },
-        mayPushdown,
-        kInitialValue_);
+    auto updateSingleValue = [](T& result, T value) {
+      result = result > value ? result : value;
+    };
+    auto updateDuplicateValues = [](T& result, T value, int /* unused */) {
+      result = value;
+    };
+    if constexpr (std::is_arithmetic_v<T>) {
+      BaseAggregate::reduceOneGroup(
+          group,
+          rows,
+          args[0],
+          [](auto x, auto y) { return x > y ? x : y; },
+          updateSingleValue,
+          updateDuplicateValues,
+          mayPushdown,
+          kInitialValue_,
+          maxIdentity<T>());
+    } else {
+      BaseAggregate::updateOneGroup(
+          group,
+          rows,
+          args[0],
+          updateSingleValue,
+          updateDuplicateValues,
+          mayPushdown,
+          kInitialValue_);
+    }
   }
 
   void updateSingleGroupFinal(
@@ -162,6 +224,12 @@ class MaxAggregate : public MinMaxAggregate<T, ResultType> {
 
  private:
   static constexpr T kInitialValue_{MinMaxTrait<T>::min()};
+
+  static void combine(T& result, T value) {
+    if (result < value) {
+      result = value;
+    }
+  }
 };
 
 template <typename T, typename ResultType>
@@ -218,19 +286,60 @@ class MinAggregate : public MinMaxAggregate<T, ResultType> {
     updatePartial(groups, rows, args, mayPushdown);
   }
 
+  bool supportsDenseAccumulators() const override {
+    return std::is_arithmetic_v<T>;
+  }
+
+  void updateDense(
+      const uint64_t* groupNumbers,
+      int32_t numGroupNumbers,
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args) override {
+    BaseAggregate::updateDenseGroups(
+        groupNumbers,
+        numGroupNumbers,
+        rows,
+        args[0],
+        minIdentity<T>(),
+        combine);
+  }
+
+  void flushDense(char** groups, int32_t numGroupNumbers) override {
+    BaseAggregate::flushDenseGroups(groups, numGroupNumbers, combine);
+  }
+
   void updateSingleGroupPartial(
       char* group,
       const SelectivityVector& rows,
       const std::vector<VectorPtr>& args,
       bool mayPushdown) override {
-    BaseAggregate::updateOneGroup(
-        group,
-        rows,
-        args[0],
-        [](T& result, T value) { result = result < value ? result : value; },
-        [](T& result, T value, int /* unused */) { result = value; },
-        mayPushdown,
-        kInitialValue_);
+    auto updateSingleValue = [](T& result, T value) {
+      result = result < value ? result : value;
+    };
+    auto updateDuplicateValues = [](T& result, T value, int /* unused */) {
+      result = value;
+    };
+    if constexpr (std::is_arithmetic_v<T>) {
+      BaseAggregate::reduceOneGroup(
+          group,
+          rows,
+          args[0],
+          [](auto x, auto y) { return x < y ? x : y; },
+          updateSingleValue,
+          updateDuplicateValues,
+          mayPushdown,
+          kInitialValue_,
+          minIdentity<T>());
+    } else {
+      BaseAggregate::updateOneGroup(
+          group,
+          rows,
+          args[0],
+          updateSingleValue,
+          updateDuplicateValues,
+          mayPushdown,
+          kInitialValue_);
+    }
   }
 
   void updateSingleGroupFinal(
@@ -243,6 +352,12 @@ class MinAggregate : public MinMaxAggregate<T, ResultType> {
 
  private:
   static constexpr T kInitialValue_{MinMaxTrait<T>::max()};
+
+  static void combine(T& result, T value) {
+    if (result > value) {
+      result = value;
+    }
+  }
 };
 
 class NonNumericMinMaxAggregateBase : public exec::Aggregate {
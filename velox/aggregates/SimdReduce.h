@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstring>
+#include <type_traits>
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/common/base/SimdUtil.h"
+#include "velox/vector/DecodedVector.h"
+#include "velox/vector/SelectivityVector.h"
+#include "velox/vector/TypeAliases.h"
+
+namespace facebook::velox::aggregate {
+
+// A 256 bit vector of T and a vector of TInput with the same number of
+// lanes. These are gcc/clang vector extension types like the ones in
+// SimdUtil.h, so that +, < and ?: work lane by lane and
+// __builtin_convertvector widens TInput lanes to T.
+template <typename T, typename TInput = T>
+struct ReduceLanes {
+  static constexpr int32_t kSize = simd::Vectors<T>::VSize;
+  static_assert(sizeof(TInput) <= sizeof(T));
+
+  typedef T Vector __attribute__((vector_size(kSize * sizeof(T))));
+  typedef TInput InputVector
+      __attribute__((vector_size(kSize * sizeof(TInput))));
+};
+
+// Combines with 'op' the values of the rows in [begin, end) that are set in
+// 'rows' and in 'nonNulls', if 'nonNulls' is not nullptr. The value of row
+// i is values[i] or values[indices[i]] if 'indices' is not nullptr. Sets
+// 'numValues' to the number of rows combined and returns 'identity' if
+// there are none.
+//
+// 'op' is called with both TResult and ReduceLanes<TResult>::Vector
+// arguments, e.g. [](auto x, auto y) { return x < y ? x : y; }. It must be
+// associative and commutative with 'identity' as neutral element, since the
+// values are combined in ReduceLanes<TResult>::kSize independent lanes. The
+// null and selection masks are applied a word at a time. Groups of lanes
+// with all rows present are loaded with one vector load, the other groups
+// one lane at a time.
+template <typename TInput, typename TResult, typename Op>
+TResult reduceRows(
+    const TInput* values,
+    const vector_size_t* indices,
+    const uint64_t* rows,
+    const uint64_t* nonNulls,
+    vector_size_t begin,
+    vector_size_t end,
+    TResult identity,
+    Op op,
+    int64_t& numValues) {
+  using Lanes = ReduceLanes<TResult, TInput>;
+  using Vector = typename Lanes::Vector;
+  constexpr int32_t kLanes = Lanes::kSize;
+  const uint64_t kAllLanes = bits::lowMask(kLanes);
+
+  Vector result;
+  for (auto lane = 0; lane < kLanes; ++lane) {
+    result[lane] = identity;
+  }
+  numValues = 0;
+
+  auto addWord = [&](int32_t wordIndex, uint64_t word) {
+    if (!word) {
+      return;
+    }
+    numValues += __builtin_popcountll(word);
+    const vector_size_t firstRow = wordIndex * 64;
+    for (auto offset = 0; offset < 64; offset += kLanes) {
+      const auto laneBits = (word >> offset) & kAllLanes;
+      if (!laneBits) {
+        continue;
+      }
+      const auto row = firstRow + offset;
+      Vector lanes;
+      if (laneBits == kAllLanes) {
+        if (indices) {
+          for (auto lane = 0; lane < kLanes; ++lane) {
+            lanes[lane] = values[indices[row + lane]];
+          }
+        } else {
+          typename Lanes::InputVector input;
+          memcpy(&input, values + row, sizeof(input));
+          lanes = __builtin_convertvector(input, Vector);
+        }
+      } else {
+        // Lanes of rows that are not selected or null get 'identity'. These
+        // are not read since they may be past the end of the data or have
+        // an out of range index.
+        for (auto lane = 0; lane < kLanes; ++lane) {
+          if (laneBits & (1UL << lane)) {
+            lanes[lane] = indices ? values[indices[row + lane]]
+                                  : values[row + lane];
+          } else {
+            lanes[lane] = identity;
+          }
+        }
+      }
+      result = op(result, lanes);
+    }
+  };
+
+  bits::forEachWord(
+      begin,
+      end,
+      [&](int32_t index, uint64_t mask) {
+        addWord(
+            index,
+            rows[index] & (nonNulls ? nonNulls[index] : ~0UL) & mask);
+      },
+      [&](int32_t index) {
+        addWord(index, rows[index] & (nonNulls ? nonNulls[index] : ~0UL));
+      });
+
+  TResult total = identity;
+  for (auto lane = 0; lane < kLanes; ++lane) {
+    total = op(total, static_cast<TResult>(result[lane]));
+  }
+  return total;
+}
+
+// Runs reduceRows() over the values of 'decoded' in 'rows' and sets 'result'
+// and 'numValues'. Returns false for the inputs the kernel does not cover,
+// which the caller handles row by row: constants, booleans, and
+// dictionaries over a base vector with nulls, since their null flags are
+// not per row.
+template <typename TInput, typename TResult, typename Op>
+bool reduceDecoded(
+    DecodedVector& decoded,
+    const SelectivityVector& rows,
+    TResult identity,
+    Op op,
+    TResult& result,
+    int64_t& numValues) {
+  if constexpr (
+      !std::is_arithmetic_v<TInput> || std::is_same_v<TInput, bool>) {
+    return false;
+  } else {
+    if (decoded.isConstantMapping()) {
+      return false;
+    }
+    const uint64_t* nonNulls = nullptr;
+    if (decoded.mayHaveNulls()) {
+      if (!decoded.isIdentityMapping() && !decoded.hasExtraNulls()) {
+        return false;
+      }
+      nonNulls = decoded.nulls();
+    }
+    result = reduceRows(
+        decoded.data<TInput>(),
+        decoded.isIdentityMapping() ? nullptr : decoded.indices(),
+        rows.asRange().bits(),
+        nonNulls,
+        rows.begin(),
+        rows.end(),
+        identity,
+        op,
+        numValues);
+    return true;
+  }
+}
+
+} // namespace facebook::velox::aggregate
@@ -16,6 +16,7 @@
 #pragma once
 
 #include "velox/aggregates/AggregationHook.h"
+#include "velox/aggregates/SimdReduce.h"
 #include "velox/exec/Aggregate.h"
 #include "velox/vector/DecodedVector.h"
 #include "velox/vector/FlatVector.h"
@@ -139,10 +140,31 @@ class SimpleNumericAggregate : public exec::Aggregate {
       const VectorPtr& arg,
       UpdateSingle updateSingleValue,
       UpdateDuplicate updateDuplicateValues,
-      bool /*mayPushdown*/,
+      bool mayPushdown,
       TData initialValue) {
     DecodedVector decoded(*arg, rows);
+    updateOneGroup(
+        group,
+        rows,
+        decoded,
+        updateSingleValue,
+        updateDuplicateValues,
+        mayPushdown,
+        initialValue);
+  }
 
+  template <
+      typename TData = TResult,
+      typename UpdateSingle,
+      typename UpdateDuplicate>
+  void updateOneGroup(
+      char* group,
+      const SelectivityVector& rows,
+      const DecodedVector& decoded,
+      UpdateSingle updateSingleValue,
+      UpdateDuplicate updateDuplicateValues,
+      bool /*mayPushdown*/,
+      TData initialValue) {
     // Do row by row if not all rows are selected.
     if (decoded.isConstantMapping()) {
       if (!decoded.isNullAt(0)) {
@@ -171,6 +193,134 @@ class SimpleNumericAggregate : public exec::Aggregate {
     }
   }
 
+  // Same as updateOneGroup() but combines the values with the SIMD kernel
+  // of reduceDecoded() where it applies. 'op' is applied to both TData and
+  // vectors of TData, e.g. [](auto x, auto y) { return x + y; }, and has
+  // 'identity' as neutral value.
+  template <
+      typename TData = TResult,
+      typename Op,
+      typename UpdateSingle,
+      typename UpdateDuplicate>
+  void reduceOneGroup(
+      char* group,
+      const SelectivityVector& rows,
+      const VectorPtr& arg,
+      Op op,
+      UpdateSingle updateSingleValue,
+      UpdateDuplicate updateDuplicateValues,
+      bool mayPushdown,
+      TData initialValue,
+      TData identity) {
+    DecodedVector decoded(*arg, rows);
+    TData result;
+    int64_t numValues;
+    if (reduceDecoded<TInput>(
+            decoded, rows, identity, op, result, numValues)) {
+      if (numValues) {
+        // A null group holds 'initialValue', which is not always neutral,
+        // e.g. for max of floating point values.
+        auto& value = *exec::Aggregate::value<TData>(group);
+        value = exec::Aggregate::clearNull(group) ? result : op(value, result);
+      }
+      return;
+    }
+    updateOneGroup(
+        group,
+        rows,
+        decoded,
+        updateSingleValue,
+        updateDuplicateValues,
+        mayPushdown,
+        initialValue);
+  }
+
+  // Sizes 'denseValues_' for 'numGroupNumbers' groups starting at
+  // 'initialValue' unless already sized by a previous update.
+  void prepareDenseGroups(int32_t numGroupNumbers, TAccumulator initialValue) {
+    if (denseValues_.size() != static_cast<size_t>(numGroupNumbers)) {
+      VELOX_CHECK(denseValues_.empty());
+      denseValues_.assign(numGroupNumbers, initialValue);
+      denseHasValue_.assign(numGroupNumbers, 0);
+    }
+  }
+
+  // Adds the non-null values of 'arg' in 'rows' to 'denseValues_' at the
+  // group numbers of the rows. The dense counterpart of updateGroups().
+  // 'initialValue' is the identity of 'updateSingleValue'.
+  template <typename UpdateSingleValue>
+  void updateDenseGroups(
+      const uint64_t* groupNumbers,
+      int32_t numGroupNumbers,
+      const SelectivityVector& rows,
+      const VectorPtr& arg,
+      TAccumulator initialValue,
+      UpdateSingleValue updateSingleValue) {
+    prepareDenseGroups(numGroupNumbers, initialValue);
+    auto values = denseValues_.data();
+    auto hasValue = denseHasValue_.data();
+    DecodedVector decoded(*arg, rows);
+    if (decoded.isConstantMapping()) {
+      if (!decoded.isNullAt(0)) {
+        auto value = decoded.valueAt<TInput>(0);
+        rows.applyToSelected([&](vector_size_t i) {
+          auto group = groupNumbers[i];
+          updateSingleValue(values[group], value);
+          hasValue[group] = 1;
+        });
+      }
+    } else if (decoded.mayHaveNulls()) {
+      rows.applyToSelected([&](vector_size_t i) {
+        if (decoded.isNullAt(i)) {
+          return;
+        }
+        auto group = groupNumbers[i];
+        updateSingleValue(values[group], decoded.valueAt<TInput>(i));
+        hasValue[group] = 1;
+      });
+    } else if (decoded.isIdentityMapping() && !std::is_same_v<TInput, bool>) {
+      auto data = decoded.data<TInput>();
+      rows.applyToSelected([&](vector_size_t i) {
+        auto group = groupNumbers[i];
+        updateSingleValue(values[group], data[i]);
+        hasValue[group] = 1;
+      });
+    } else {
+      rows.applyToSelected([&](vector_size_t i) {
+        auto group = groupNumbers[i];
+        updateSingleValue(values[group], decoded.valueAt<TInput>(i));
+        hasValue[group] = 1;
+      });
+    }
+  }
+
+  // Combines the accumulators of updateDenseGroups() into 'groups' with
+  // 'combine' and resets them.
+  template <typename Combine>
+  void
+  flushDenseGroups(char** groups, int32_t numGroupNumbers, Combine combine) {
+    if (denseValues_.empty()) {
+      return;
+    }
+    VELOX_CHECK_EQ(denseValues_.size(), static_cast<size_t>(numGroupNumbers));
+    for (auto i = 0; i < numGroupNumbers; ++i) {
+      if (!denseHasValue_[i]) {
+        continue;
+      }
+      VELOX_DCHECK_NOT_NULL(groups[i]);
+      // A null group holds the initial value, which is not always the
+      // identity of 'combine', e.g. for max of floating point values.
+      auto& value = *exec::Aggregate::value<TAccumulator>(groups[i]);
+      if (exec::Aggregate::clearNull(groups[i])) {
+        value = denseValues_[i];
+      } else {
+        combine(value, denseValues_[i]);
+      }
+    }
+    denseValues_.clear();
+    denseHasValue_.clear();
+  }
+
   template <typename THook>
   void
   pushdown(char** groups, const SelectivityVector& rows, const VectorPtr& arg) {
@@ -204,6 +354,11 @@ class SimpleNumericAggregate : public exec::Aggregate {
         RowSet(indices, numIndices), &hook);
   }
 
+  // Accumulators of updateDenseGroups() indexed by group number.
+  std::vector<TAccumulator> denseValues_;
+  // 1 for the group numbers with a value in 'denseValues_'.
+  std::vector<uint8_t> denseHasValue_;
+
  private:
   // TData is either TAccumulator or TResult, which in most cases are the same,
   // but for sum(real) can differ.
@@ -81,19 +81,37 @@ class SumAggregate
     updateInternal<ResultType>(groups, rows, args, mayPushdown);
   }
 
+  bool supportsDenseAccumulators() const override {
+    return exec::Aggregate::isRawInput_;
+  }
+
+  void updateDense(
+      const uint64_t* groupNumbers,
+      int32_t numGroupNumbers,
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args) override {
+    BaseAggregate::updateDenseGroups(
+        groupNumbers,
+        numGroupNumbers,
+        rows,
+        args[0],
+        0,
+        [](TAccumulator& result, TInput value) { result += value; });
+  }
+
+  void flushDense(char** groups, int32_t numGroupNumbers) override {
+    BaseAggregate::flushDenseGroups(
+        groups, numGroupNumbers, [](TAccumulator& result, TAccumulator value) {
+          result += value;
+        });
+  }
+
   void updateSingleGroupPartial(
       char* group,
       const SelectivityVector& rows,
       const std::vector<VectorPtr>& args,
       bool mayPushdown) override {
-    BaseAggregate::template updateOneGroup<TAccumulator>(
-        group,
-        rows,
-        args[0],
-        [](TAccumulator& result, TInput value) { result += value; },
-        [](TAccumulator& result, TInput value, int n) { result += n * value; },
-        mayPushdown,
-        0);
+    updateSingleGroup<TAccumulator>(group, rows, args[0], mayPushdown);
   }
 
   void updateSingleGroupFinal(
@@ -101,17 +119,49 @@ class SumAggregate
       const SelectivityVector& rows,
       const std::vector<VectorPtr>& args,
       bool mayPushdown) override {
-    BaseAggregate::template updateOneGroup<ResultType>(
-        group,
-        rows,
-        args[0],
-        [](ResultType& result, TInput value) { result += value; },
-        [](ResultType& result, TInput value, int n) { result += n * value; },
-        mayPushdown,
-        0);
+    updateSingleGroup<ResultType>(group, rows, args[0], mayPushdown);
   }
 
  protected:
+  // TData is either TAccumulator or TResult, which in most cases are the same,
+  // but for sum(real) can differ.
+  template <typename TData>
+  void updateSingleGroup(
+      char* group,
+      const SelectivityVector& rows,
+      const VectorPtr& arg,
+      bool mayPushdown) {
+    auto updateSingleValue = [](TData& result, TInput value) {
+      result += value;
+    };
+    auto updateDuplicateValues = [](TData& result, TInput value, int n) {
+      result += n * value;
+    };
+    // Integer sums do not depend on the order of addition. Floating point
+    // sums stay in row order so that the result does not change.
+    if constexpr (std::is_integral_v<TData>) {
+      BaseAggregate::template reduceOneGroup<TData>(
+          group,
+          rows,
+          arg,
+          [](auto x, auto y) { return x + y; },
+          updateSingleValue,
+          updateDuplicateValues,
+          mayPushdown,
+          0,
+          0);
+    } else {
+      BaseAggregate::template updateOneGroup<TData>(
+          group,
+          rows,
+          arg,
+          updateSingleValue,
+          updateDuplicateValues,
+          mayPushdown,
+          0);
+    }
+  }
+
   // TData is either TAccumulator or TResult, which in most cases are the same,
   // but for sum(real) can differ.
   template <typename TData>
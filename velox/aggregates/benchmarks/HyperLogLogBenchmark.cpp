@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#define XXH_INLINE_ALL
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include "velox/aggregates/hyperloglog/DenseHll.h"
+#include "velox/aggregates/hyperloglog/HllUtils.h"
+#include "velox/aggregates/hyperloglog/SparseHll.h"
+#include "velox/external/xxhash.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::aggregate::hll;
+
+// Measures the per-group work of approx_distinct with many groups: merging
+// serialized dense sketches in the final aggregation and adding the hashes
+// of a batch of input to sparse sketches one at a time or all together.
+
+namespace {
+
+constexpr int32_t kNumGroups = 10'000;
+constexpr int32_t kDenseValuesPerGroup = 5'000;
+constexpr int32_t kSparseValuesPerGroup = 200;
+
+uint64_t hashOne(int64_t value) {
+  return XXH64(&value, sizeof(value), 0);
+}
+
+class HyperLogLogBenchmark {
+ public:
+  HyperLogLogBenchmark()
+      : indexBitLength_(toIndexBitLength(kDefaultStandardError)) {
+    for (auto group = 0; group < kNumGroups; ++group) {
+      groups_.emplace_back(indexBitLength_, &allocator_);
+      DenseHll partial(indexBitLength_, &allocator_);
+      for (auto i = 0; i < kDenseValuesPerGroup; ++i) {
+        groups_.back().insertHash(hashOne(group * 1'000'000L + i));
+        partial.insertHash(hashOne(group * 1'000'000L + i / 2 + 7'777));
+      }
+      serialized_.emplace_back(partial.serializedSize(), '\0');
+      partial.serialize(serialized_.back().data());
+    }
+    for (auto i = 0; i < kSparseValuesPerGroup * kNumGroups; ++i) {
+      hashes_.push_back(hashOne(i));
+    }
+  }
+
+  // Merges a serialized dense sketch into each group.
+  int32_t mergeDense() {
+    for (auto group = 0; group < kNumGroups; ++group) {
+      groups_[group].mergeWith(serialized_[group].data());
+    }
+    return kNumGroups;
+  }
+
+  // Adds kSparseValuesPerGroup hashes to a new sparse sketch for each group.
+  int32_t insertSparse(bool batch) {
+    folly::BenchmarkSuspender suspender;
+    std::vector<SparseHll> sketches;
+    sketches.reserve(kNumGroups);
+    for (auto group = 0; group < kNumGroups; ++group) {
+      sketches.emplace_back(&allocator_);
+      sketches.back().setSoftMemoryLimit(
+          DenseHll::estimateInMemorySize(indexBitLength_));
+    }
+    suspender.dismiss();
+
+    for (auto group = 0; group < kNumGroups; ++group) {
+      auto hashes = hashes_.data() + group * kSparseValuesPerGroup;
+      if (batch) {
+        sketches[group].insertHashes(hashes, kSparseValuesPerGroup);
+      } else {
+        for (auto i = 0; i < kSparseValuesPerGroup; ++i) {
+          sketches[group].insertHash(hashes[i]);
+        }
+      }
+    }
+    return kNumGroups * kSparseValuesPerGroup;
+  }
+
+ private:
+  const int8_t indexBitLength_;
+  exec::HashStringAllocator allocator_{memory::MappedMemory::getInstance()};
+  std::vector<DenseHll> groups_;
+  std::vector<std::string> serialized_;
+  std::vector<uint64_t> hashes_;
+};
+
+std::unique_ptr<HyperLogLogBenchmark> benchmark;
+
+BENCHMARK_MULTI(mergeDense) {
+  return benchmark->mergeDense();
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_MULTI(insertSparseByHash) {
+  return benchmark->insertSparse(false);
+}
+
+BENCHMARK_RELATIVE_MULTI(insertSparseBatch) {
+  return benchmark->insertSparse(true);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  benchmark = std::make_unique<HyperLogLogBenchmark>();
+  folly::runBenchmarks();
+  benchmark.reset();
+  return 0;
+}
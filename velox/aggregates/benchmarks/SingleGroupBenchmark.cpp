@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+#include <limits>
+
+#include "velox/aggregates/SimdReduce.h"
+#include "velox/vector/tests/VectorMaker.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::aggregate;
+using namespace facebook::velox::test;
+
+// Compares the SIMD kernel of the global sum and max aggregates to a row by
+// row loop over DecodedVector, as in updateOneGroup(), for flat input with
+// and without nulls and for a dictionary that adds nulls.
+
+namespace {
+
+constexpr vector_size_t kNumRows = 10'000;
+
+class SingleGroupBenchmark {
+ public:
+  SingleGroupBenchmark() : allRows_(kNumRows) {
+    auto indices =
+        AlignedBuffer::allocate<vector_size_t>(kNumRows, pool_.get());
+    auto rawIndices = indices->asMutable<vector_size_t>();
+    auto nulls = AlignedBuffer::allocate<bool>(kNumRows, pool_.get());
+    auto rawNulls = nulls->asMutable<uint64_t>();
+    for (auto row = 0; row < kNumRows; ++row) {
+      rawIndices[row] = (row * 7919) % kNumRows;
+      bits::setNull(rawNulls, row, row % 11 == 0);
+    }
+    vectors_ = {
+        vectorMaker_.rowVector({
+            vectorMaker_.flatVector<int32_t>(
+                kNumRows, [](auto row) { return row % 1000; }),
+            vectorMaker_.flatVector<double>(
+                kNumRows, [](auto row) { return row * 0.1; }),
+        }),
+        vectorMaker_.rowVector({
+            vectorMaker_.flatVector<int32_t>(
+                kNumRows,
+                [](auto row) { return row % 1000; },
+                VectorMaker::nullEvery(7)),
+            vectorMaker_.flatVector<double>(
+                kNumRows,
+                [](auto row) { return row * 0.1; },
+                VectorMaker::nullEvery(7)),
+        })};
+    auto flat = vectors_[0];
+    vectors_.push_back(vectorMaker_.rowVector({
+        BaseVector::wrapInDictionary(
+            nulls, indices, kNumRows, flat->childAt(0)),
+        BaseVector::wrapInDictionary(
+            nulls, indices, kNumRows, flat->childAt(1)),
+    }));
+  }
+
+  // Returns the sum of the first column of vectors_[input] and the max of
+  // the second.
+  std::pair<int64_t, double> run(int32_t input, bool simd) {
+    folly::BenchmarkSuspender suspender;
+    const auto& data = vectors_[input];
+    DecodedVector sumInput(*data->childAt(0), allRows_);
+    DecodedVector maxInput(*data->childAt(1), allRows_);
+    suspender.dismiss();
+
+    if (simd) {
+      int64_t sum;
+      double max;
+      int64_t numValues;
+      reduceDecoded<int32_t>(
+          sumInput,
+          allRows_,
+          int64_t{0},
+          [](auto x, auto y) { return x + y; },
+          sum,
+          numValues);
+      reduceDecoded<double>(
+          maxInput,
+          allRows_,
+          std::numeric_limits<double>::lowest(),
+          [](auto x, auto y) { return x > y ? x : y; },
+          max,
+          numValues);
+      return {sum, max};
+    }
+    int64_t sum = 0;
+    double max = std::numeric_limits<double>::lowest();
+    allRows_.applyToSelected([&](vector_size_t row) {
+      if (!sumInput.isNullAt(row)) {
+        sum += sumInput.valueAt<int32_t>(row);
+      }
+    });
+    allRows_.applyToSelected([&](vector_size_t row) {
+      if (!maxInput.isNullAt(row)) {
+        auto value = maxInput.valueAt<double>(row);
+        max = max > value ? max : value;
+      }
+    });
+    return {sum, max};
+  }
+
+ private:
+  std::unique_ptr<memory::MemoryPool> pool_{
+      memory::getDefaultScopedMemoryPool()};
+  VectorMaker vectorMaker_{pool_.get()};
+  SelectivityVector allRows_;
+  // Flat, flat with nulls and dictionary with nulls.
+  std::vector<RowVectorPtr> vectors_;
+};
+
+std::unique_ptr<SingleGroupBenchmark> benchmark;
+
+BENCHMARK_MULTI(flatByRow) {
+  folly::doNotOptimizeAway(benchmark->run(0, false));
+  return kNumRows;
+}
+
+BENCHMARK_RELATIVE_MULTI(flatSimd) {
+  folly::doNotOptimizeAway(benchmark->run(0, true));
+  return kNumRows;
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_MULTI(flatNullsByRow) {
+  folly::doNotOptimizeAway(benchmark->run(1, false));
+  return kNumRows;
+}
+
+BENCHMARK_RELATIVE_MULTI(flatNullsSimd) {
+  folly::doNotOptimizeAway(benchmark->run(1, true));
+  return kNumRows;
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_MULTI(dictionaryNullsByRow) {
+  folly::doNotOptimizeAway(benchmark->run(2, false));
+  return kNumRows;
+}
+
+BENCHMARK_RELATIVE_MULTI(dictionaryNullsSimd) {
+  folly::doNotOptimizeAway(benchmark->run(2, true));
+  return kNumRows;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  benchmark = std::make_unique<SingleGroupBenchmark>();
+  folly::runBenchmarks();
+  benchmark.reset();
+  return 0;
+}
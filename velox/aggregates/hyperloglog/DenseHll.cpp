@@ -17,6 +17,8 @@
 #include "velox/aggregates/IOUtils.h"
 #include "velox/aggregates/hyperloglog/BiasCorrection.h"
 #include "velox/aggregates/hyperloglog/HllUtils.h"
+#include "velox/common/base/SimdUtil.h"
+#include "velox/common/process/ProcessBase.h"
 
 namespace facebook::velox::aggregate::hll {
 namespace {
@@ -80,6 +82,68 @@ int8_t getOverflowImpl(
   }
   return 0;
 }
+
+/// Sets each 4 bit delta in 'deltas' to the larger of itself minus 'shift'
+/// and the corresponding delta in 'otherDeltas' minus 'otherShift', with
+/// differences below 0 set to 0. This merges the deltas of 2 HLLs without
+/// overflows into deltas from the larger of the 2 baselines, where 'shift'
+/// and 'otherShift' are the distances from the baselines of the 2 HLLs to
+/// the new baseline. Returns the number of zero deltas after the merge.
+int32_t mergeDeltas(
+    int8_t* deltas,
+    const int8_t* otherDeltas,
+    int32_t size,
+    int8_t shift,
+    int8_t otherShift) {
+  int32_t numZeros = 0;
+  int32_t i = 0;
+  if (process::hasAvx2()) {
+    // 32 bytes, i.e. 64 buckets at a time. The low and high 4 bits of each
+    // byte are processed as separate vectors of bytes, where the saturating
+    // subtraction and the unsigned max work lane by lane.
+    const auto nibbleMask = _mm256_set1_epi8(0x0f);
+    const auto shiftVector = _mm256_set1_epi8(shift);
+    const auto otherShiftVector = _mm256_set1_epi8(otherShift);
+    const auto zero = _mm256_setzero_si256();
+    for (; i + 32 <= size; i += 32) {
+      auto slots = _mm256_loadu_si256(reinterpret_cast<__m256i*>(deltas + i));
+      auto otherSlots = _mm256_loadu_si256(
+          reinterpret_cast<const __m256i*>(otherDeltas + i));
+      auto low = _mm256_max_epu8(
+          _mm256_subs_epu8(_mm256_and_si256(slots, nibbleMask), shiftVector),
+          _mm256_subs_epu8(
+              _mm256_and_si256(otherSlots, nibbleMask), otherShiftVector));
+      auto high = _mm256_max_epu8(
+          _mm256_subs_epu8(
+              _mm256_and_si256(_mm256_srli_epi16(slots, 4), nibbleMask),
+              shiftVector),
+          _mm256_subs_epu8(
+              _mm256_and_si256(_mm256_srli_epi16(otherSlots, 4), nibbleMask),
+              otherShiftVector));
+      _mm256_storeu_si256(
+          reinterpret_cast<__m256i*>(deltas + i),
+          _mm256_or_si256(_mm256_slli_epi16(high, 4), low));
+      numZeros += __builtin_popcount(
+                      _mm256_movemask_epi8(_mm256_cmpeq_epi8(low, zero))) +
+          __builtin_popcount(
+                      _mm256_movemask_epi8(_mm256_cmpeq_epi8(high, zero)));
+    }
+  }
+  for (; i < size; ++i) {
+    int8_t newSlot = 0;
+    for (int bitShift = 4; bitShift >= 0; bitShift -= 4) {
+      int8_t delta = ((deltas[i] >> bitShift) & 0x0f) - shift;
+      int8_t otherDelta = ((otherDeltas[i] >> bitShift) & 0x0f) - otherShift;
+      int8_t newDelta = std::max<int8_t>(std::max(delta, otherDelta), 0);
+      if (newDelta == 0) {
+        ++numZeros;
+      }
+      newSlot |= newDelta << bitShift;
+    }
+    deltas[i] = newSlot;
+  }
+  return numZeros;
+}
 } // namespace
 
 DenseHll::DenseHll(int8_t indexBitLength, exec::HashStringAllocator* allocator)
@@ -429,6 +493,21 @@ void DenseHll::mergeWith(
     const uint16_t* otherOverflowBuckets,
     const int8_t* otherOverflowValues) {
   int8_t newBaseline = std::max(baseline_, otherBaseline);
+
+  if (overflows_ == 0 && otherOverflows == 0) {
+    // No delta of either HLL is larger than kMaxDelta, so none of the merged
+    // deltas from the larger baseline is either.
+    baselineCount_ = mergeDeltas(
+        deltas_.data(),
+        otherDeltas,
+        deltas_.size(),
+        newBaseline - baseline_,
+        newBaseline - otherBaseline);
+    baseline_ = newBaseline;
+    adjustBaselineIfNeeded();
+    return;
+  }
+
   int32_t baselineCount = 0;
 
   int bucket = 0;
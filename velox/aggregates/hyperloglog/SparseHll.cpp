@@ -14,6 +14,10 @@
  * limitations under the License.
  */
 #include "velox/aggregates/hyperloglog/SparseHll.h"
+
+#include <algorithm>
+#include <cstring>
+
 #include "velox/aggregates/IOUtils.h"
 #include "velox/aggregates/hyperloglog/HllUtils.h"
 
@@ -153,40 +157,70 @@ void SparseHll::mergeWith(const char* serialized) {
 void SparseHll::mergeWith(size_t otherSize, const uint32_t* otherEntries) {
   VELOX_CHECK_GT(otherSize, 0);
 
-  auto size = entries_.size();
-  std::vector<uint32_t> merged(size + otherSize);
+  // Merges from the back into the space after the current entries, so that no
+  // temporary is needed. An entry of 'this' is not overwritten before it is
+  // read because the merged entries written so far are no more than the
+  // entries read.
+  const int64_t size = entries_.size();
+  entries_.resize(size + otherSize);
+  auto entries = entries_.data();
 
-  int pos = 0;
-  int leftPos = 0;
-  int rightPos = 0;
+  int64_t pos = size + otherSize;
+  int64_t leftPos = size - 1;
+  int64_t rightPos = otherSize - 1;
 
-  while (leftPos < size && rightPos < otherSize) {
-    auto left = decodeIndex(entries_[leftPos]);
+  while (leftPos >= 0 && rightPos >= 0) {
+    auto left = decodeIndex(entries[leftPos]);
     auto right = decodeIndex(otherEntries[rightPos]);
-    if (left < right) {
-      merged[pos++] = entries_[leftPos++];
-    } else if (left > right) {
-      merged[pos++] = otherEntries[rightPos++];
+    if (left > right) {
+      entries[--pos] = entries[leftPos--];
+    } else if (left < right) {
+      entries[--pos] = otherEntries[rightPos--];
     } else {
       auto value = std::max(
-          decodeValue(entries_[leftPos++]),
-          decodeValue(otherEntries[rightPos++]));
-      merged[pos++] = encode(left, value);
+          decodeValue(entries[leftPos--]),
+          decodeValue(otherEntries[rightPos--]));
+      entries[--pos] = encode(left, value);
     }
   }
 
-  while (leftPos < size) {
-    merged[pos++] = entries_[leftPos++];
+  while (rightPos >= 0) {
+    entries[--pos] = otherEntries[rightPos--];
   }
 
-  while (rightPos < otherSize) {
-    merged[pos++] = otherEntries[rightPos++];
+  // The entries of 'this' up to 'leftPos' are in place. Entries with the same
+  // index in both inputs leave a gap between these and the merged entries.
+  const auto numMerged = size + otherSize - pos;
+  if (pos != leftPos + 1) {
+    memmove(
+        entries + leftPos + 1, entries + pos, numMerged * sizeof(uint32_t));
   }
+  entries_.resize(leftPos + 1 + numMerged);
+}
 
-  entries_.resize(pos);
-  for (auto i = 0; i < pos; i++) {
-    entries_[i] = merged[i];
+bool SparseHll::insertHashes(const uint64_t* hashes, int32_t numHashes) {
+  if (numHashes > 0) {
+    std::vector<uint32_t> newEntries(numHashes);
+    for (auto i = 0; i < numHashes; ++i) {
+      newEntries[i] = encode(
+          computeIndex(hashes[i], kIndexBitLength),
+          computeValue(hashes[i], kIndexBitLength));
+    }
+    // The index is in the high bits of the entry, so entries with the same
+    // index are sorted by value and the last one has the largest value.
+    std::sort(newEntries.begin(), newEntries.end());
+    int32_t numUnique = 0;
+    for (auto entry : newEntries) {
+      if (numUnique > 0 &&
+          decodeIndex(newEntries[numUnique - 1]) == decodeIndex(entry)) {
+        newEntries[numUnique - 1] = entry;
+      } else {
+        newEntries[numUnique++] = entry;
+      }
+    }
+    mergeWith(numUnique, newEntries.data());
   }
+  return entries_.size() >= softNumEntriesLimit_;
 }
 
 void SparseHll::verify() const {
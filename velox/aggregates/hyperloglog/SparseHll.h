@@ -35,6 +35,11 @@ class SparseHll {
   /// Returns true if soft memory limit has been reached. False, otherwise.
   bool insertHash(uint64_t hash);
 
+  /// Same as calling insertHash() for each of 'hashes' but sorts the new
+  /// entries and merges them with the existing ones in one pass. Returns true
+  /// if soft memory limit has been reached after inserting all hashes.
+  bool insertHashes(const uint64_t* hashes, int32_t numHashes);
+
   int64_t cardinality() const;
 
   /// Serializes internal state using Presto SparseV2 format.
@@ -150,6 +150,28 @@ TEST_F(SparseHllTest, mergeWith) {
   testMergeWith(sequence(0, 100), sequence(0, 100));
 }
 
+TEST_F(SparseHllTest, insertHashes) {
+  SparseHll expected{&allocator_};
+  SparseHll sparseHll{&allocator_};
+
+  // Batches with duplicates, with values already present and with values
+  // that sort before and after the existing entries.
+  for (auto batch : {sequence(100, 200), sequence(0, 150), sequence(50, 400)}) {
+    std::vector<uint64_t> hashes;
+    for (auto value : batch) {
+      hashes.push_back(hashOne(value));
+      hashes.push_back(hashOne(value));
+    }
+    for (auto hash : hashes) {
+      expected.insertHash(hash);
+    }
+    sparseHll.insertHashes(hashes.data(), hashes.size());
+    sparseHll.verify();
+    ASSERT_EQ(serialize(11, sparseHll), serialize(11, expected));
+  }
+  ASSERT_EQ(400, sparseHll.cardinality());
+}
+
 class SparseHllToDenseTest : public ::testing::TestWithParam<int8_t> {
  protected:
   std::string serialize(DenseHll& denseHll) {
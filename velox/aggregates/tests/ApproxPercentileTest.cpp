@@ -241,5 +241,41 @@ TEST_F(ApproxPercentileTest, largeWeightsGroupBy) {
   testGroupByAgg(keys, values, weights, 0.5, expectedResult);
 }
 
+// Test many groups that get a few values per batch, so that values are held
+// in the accumulators across batches.
+TEST_F(ApproxPercentileTest, manyGroupsManyBatches) {
+  vector_size_t size = 1'000;
+  std::vector<RowVectorPtr> vectors;
+  for (auto batch = 0; batch < 3; ++batch) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int32_t>(size, [](auto row) { return row % 500; }),
+        makeFlatVector<int64_t>(
+            size,
+            [batch](auto row) {
+              return (row % 500) * 100 + row / 500 + batch;
+            }),
+    }));
+  }
+
+  // Group k has values k * 100 + {0, 1, 1, 2, 2, 3}. The estimated median
+  // is k * 100 + 1.75.
+  auto expectedResult = makeRowVector(
+      {makeFlatVector<int32_t>(500, [](auto row) { return row; }),
+       makeFlatVector<int64_t>(500, [](auto row) { return row * 100 + 1; })});
+
+  auto op = PlanBuilder()
+                .values(vectors)
+                .singleAggregation({0}, {"approx_percentile(c1, 0.5)"})
+                .planNode();
+  assertQuery(op, expectedResult);
+
+  op = PlanBuilder()
+           .values(vectors)
+           .partialAggregation({0}, {"approx_percentile(c1, 0.5)"})
+           .finalAggregation({0}, {"approx_percentile(a0)"}, {BIGINT()})
+           .planNode();
+  assertQuery(op, expectedResult);
+}
+
 } // namespace
 } // namespace facebook::velox::aggregate::test
@@ -320,4 +320,91 @@ TEST_F(MinMaxTest, initialValue) {
   assertQuery(agg, "SELECT -1");
 }
 
+TEST_F(MinMaxTest, globalNullsAndDictionary) {
+  // Global aggregations over flat inputs with and without nulls and over a
+  // dictionary that adds nulls. All doubles are negative, below the initial
+  // value of max.
+  constexpr vector_size_t kSize = 1'000;
+  auto flat = makeRowVector({
+      makeFlatVector<int32_t>(kSize, [](auto row) { return row % 777 - 300; }),
+      makeFlatVector<double>(kSize, [](auto row) { return -1 - row * 0.25; }),
+  });
+  auto withNulls = makeRowVector({
+      makeFlatVector<int32_t>(
+          kSize, [](auto row) { return row % 555 - 200; }, nullEvery(7)),
+      makeFlatVector<double>(
+          kSize, [](auto row) { return -2 - row * 0.5; }, nullEvery(5)),
+  });
+  auto nulls = AlignedBuffer::allocate<bool>(kSize, pool_.get());
+  auto rawNulls = nulls->asMutable<uint64_t>();
+  for (auto row = 0; row < kSize; ++row) {
+    bits::setNull(rawNulls, row, row % 3 == 0 || row > 900);
+  }
+  auto indices = makeIndices(kSize, [](auto row) { return kSize - 1 - row; });
+  auto dictionary = makeRowVector({
+      BaseVector::wrapInDictionary(nulls, indices, kSize, flat->childAt(0)),
+      BaseVector::wrapInDictionary(nulls, indices, kSize, flat->childAt(1)),
+  });
+  std::vector<RowVectorPtr> vectors = {flat, withNulls, dictionary};
+  createDuckDbTable(vectors);
+
+  auto agg = PlanBuilder()
+                 .values(vectors)
+                 .partialAggregation(
+                     {}, {"min(c0)", "max(c0)", "min(c1)", "max(c1)"})
+                 .finalAggregation(
+                     {},
+                     {"min(a0)", "max(a1)", "min(a2)", "max(a3)"},
+                     {INTEGER(), INTEGER(), DOUBLE(), DOUBLE()})
+                 .planNode();
+  assertQuery(agg, "SELECT min(c0), max(c0), min(c1), max(c1) FROM tmp");
+}
+
+TEST_F(MinMaxTest, globalInfinities) {
+  // Max over -inf and min over +inf, flat and in a dictionary that adds
+  // nulls. The largest finite values are not identities for these.
+  constexpr vector_size_t kSize = 1'000;
+  constexpr double kInf = std::numeric_limits<double>::infinity();
+  constexpr float kFloatInf = std::numeric_limits<float>::infinity();
+  auto flat = makeRowVector({
+      makeFlatVector<double>(kSize, [](auto /*row*/) { return -kInf; }),
+      makeFlatVector<double>(
+          kSize, [](auto /*row*/) { return kInf; }, nullEvery(7)),
+      makeFlatVector<float>(kSize, [](auto /*row*/) { return -kFloatInf; }),
+      makeFlatVector<float>(
+          kSize, [](auto /*row*/) { return kFloatInf; }, nullEvery(5)),
+  });
+  auto nulls = AlignedBuffer::allocate<bool>(kSize, pool_.get());
+  auto rawNulls = nulls->asMutable<uint64_t>();
+  for (auto row = 0; row < kSize; ++row) {
+    bits::setNull(rawNulls, row, row % 3 == 0);
+  }
+  auto indices = makeIndices(kSize, [](auto row) { return kSize - 1 - row; });
+  std::vector<VectorPtr> dictionaryChildren;
+  for (auto& child : flat->children()) {
+    dictionaryChildren.push_back(
+        BaseVector::wrapInDictionary(nulls, indices, kSize, child));
+  }
+  auto dictionary = makeRowVector(dictionaryChildren);
+
+  auto expected = makeRowVector({
+      makeFlatVector<double>({-kInf}),
+      makeFlatVector<double>({kInf}),
+      makeFlatVector<float>({-kFloatInf}),
+      makeFlatVector<float>({kFloatInf}),
+  });
+  for (const auto& input : {flat, dictionary}) {
+    auto agg = PlanBuilder()
+                   .values({input})
+                   .partialAggregation(
+                       {}, {"max(c0)", "min(c1)", "max(c2)", "min(c3)"})
+                   .finalAggregation(
+                       {},
+                       {"max(a0)", "min(a1)", "max(a2)", "min(a3)"},
+                       {DOUBLE(), DOUBLE(), REAL(), REAL()})
+                   .planNode();
+    assertQuery(agg, expected);
+  }
+}
+
 } // namespace
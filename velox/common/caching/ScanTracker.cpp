@@ -16,10 +16,42 @@
 
 #include "velox/common/caching/ScanTracker.h"
 
+#include <algorithm>
 #include <sstream>
 
 namespace facebook::velox::cache {
 
+void IoLatencyModel::recordIo(uint64_t bytes, uint64_t micros) {
+  const double x = bytes;
+  const double y = micros;
+  weight_ = weight_ * kDecay + 1;
+  sumBytes_ = sumBytes_ * kDecay + x;
+  sumMicros_ = sumMicros_ * kDecay + y;
+  sumBytesSquared_ = sumBytesSquared_ * kDecay + x * x;
+  sumBytesMicros_ = sumBytesMicros_ * kDecay + x * y;
+  ++numSamples_;
+}
+
+uint64_t IoLatencyModel::mergeDistance(uint64_t defaultDistance) const {
+  if (numSamples_ < kMinSamples) {
+    return defaultDistance;
+  }
+  // Least squares fit of micros = latency + bytes * microsPerByte.
+  const double denominator = weight_ * sumBytesSquared_ - sumBytes_ * sumBytes_;
+  if (denominator <= 1e-9 * weight_ * sumBytesSquared_) {
+    // All IOs were of about the same size.
+    return defaultDistance;
+  }
+  const double microsPerByte =
+      (weight_ * sumBytesMicros_ - sumBytes_ * sumMicros_) / denominator;
+  const double latency = (sumMicros_ - microsPerByte * sumBytes_) / weight_;
+  if (microsPerByte <= 0 || latency <= 0) {
+    return defaultDistance;
+  }
+  return static_cast<uint64_t>(std::clamp<double>(
+      latency / microsPerByte, kMinMergeDistance, kMaxMergeDistance));
+}
+
 void ScanTracker::recordReference(
     const TrackingId id,
     uint64_t bytes,
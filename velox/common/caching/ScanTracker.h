@@ -89,6 +89,42 @@ struct TrackingData {
   }
 };
 
+// Fit of IO time against IO size over recent IOs. The time of an IO
+// is modeled as a fixed per-request latency plus a per-byte transfer
+// time. Older samples are decayed so that the fit follows changes in
+// load.
+class IoLatencyModel {
+ public:
+  // Minimum number of samples before the fit is used.
+  static constexpr int32_t kMinSamples = 8;
+  // Weight of the previous samples when adding a new one.
+  static constexpr double kDecay = 0.97;
+  // Bounds for mergeDistance().
+  static constexpr uint64_t kMinMergeDistance = 16 << 10;
+  static constexpr uint64_t kMaxMergeDistance = 64 << 20;
+
+  void recordIo(uint64_t bytes, uint64_t micros);
+
+  // Returns the gap in bytes that takes as long to transfer as the
+  // latency of a separate request. Reading two ranges separated by a
+  // smaller gap in one IO is faster than reading them separately.
+  // Returns 'defaultDistance' if there is no usable fit yet.
+  uint64_t mergeDistance(uint64_t defaultDistance) const;
+
+  int32_t numSamples() const {
+    return numSamples_;
+  }
+
+ private:
+  int32_t numSamples_{0};
+  // Decayed sums for the least squares fit.
+  double weight_{0};
+  double sumBytes_{0};
+  double sumMicros_{0};
+  double sumBytesSquared_{0};
+  double sumBytesMicros_{0};
+};
+
 // Tracks column access frequency during execution of a query. A
 // ScanTracker is created at the level of a Task/TableScan, so that
 // all threads of a scan report in the same tracker. The same
@@ -123,6 +159,20 @@ class ScanTracker {
   // given by 'id'.
   void recordRead(const TrackingId id, uint64_t bytes, uint64_t groupId);
 
+  // Records that a single IO of 'bytes' bytes took 'micros'. Feeds the
+  // latency model that decides the coalescing of IOs for the scan.
+  void recordIo(uint64_t bytes, uint64_t micros) {
+    std::lock_guard<std::mutex> l(mutex_);
+    ioModel_.recordIo(bytes, micros);
+  }
+
+  // Returns the largest gap between two ranges that should be read in one
+  // IO, based on the IOs of the scan so far. See IoLatencyModel.
+  uint64_t mergeDistance(uint64_t defaultDistance) {
+    std::lock_guard<std::mutex> l(mutex_);
+    return ioModel_.mergeDistance(defaultDistance);
+  }
+
   // True if 'trackingId' is read at least  'minReadPct' % of the time.
   bool shouldPrefetch(TrackingId id, int32_t minReadPct) {
     std::lock_guard<std::mutex> l(mutex_);
@@ -147,6 +197,7 @@ class ScanTracker {
   std::function<void(ScanTracker*)> unregisterer_;
   folly::F14FastMap<TrackingId, TrackingData> data_;
   TrackingData sum_;
+  IoLatencyModel ioModel_;
 };
 
 } // namespace facebook::velox::cache
@@ -100,14 +100,14 @@ class SimpleLRUCache {
     return maxSize_;
   }
 
- private:
-  bool addInternal(Key key, Value* value, int64_t size, bool pinned);
-
   // Remove unpinned elements until at least size space is freed. Returns
   // the size actually freed, which may be less than requested if the
   // remaining are all pinned.
   int64_t free(int64_t size);
 
+ private:
+  bool addInternal(Key key, Value* value, int64_t size, bool pinned);
+
   const int64_t maxSize_;
   int64_t curSize_ = 0;
   int64_t pinnedSize_ = 0;
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/ScanTracker.h"
+
+#include "gtest/gtest.h"
+
+using namespace facebook::velox::cache;
+
+namespace {
+// Records IOs of 1 to 10 units of 'unitBytes' with a fixed 'latency' in
+// micros and a throughput of 'bytesPerMicro'.
+void recordIos(
+    IoLatencyModel& model,
+    uint64_t unitBytes,
+    uint64_t latency,
+    uint64_t bytesPerMicro) {
+  for (auto i = 0; i < 100; ++i) {
+    uint64_t bytes = (i % 10 + 1) * unitBytes;
+    model.recordIo(bytes, latency + bytes / bytesPerMicro);
+  }
+}
+} // namespace
+
+TEST(ScanTrackerTest, mergeDistance) {
+  constexpr uint64_t kDefault = 1 << 20;
+  IoLatencyModel objectStore;
+  EXPECT_EQ(kDefault, objectStore.mergeDistance(kDefault));
+
+  // 20ms latency at 100MB/s is worth 2MB of transfer.
+  recordIos(objectStore, 4 << 20, 20'000, 100);
+  EXPECT_NEAR(2'000'000, objectStore.mergeDistance(kDefault), 10'000);
+
+  // 80us latency at 2GB/s is worth 160KB.
+  IoLatencyModel ssd;
+  recordIos(ssd, 256 << 10, 80, 2'000);
+  EXPECT_NEAR(160'000, ssd.mergeDistance(kDefault), 10'000);
+
+  // A change in latency moves the distance as old samples decay.
+  recordIos(ssd, 256 << 10, 800, 2'000);
+  EXPECT_NEAR(1'600'000, ssd.mergeDistance(kDefault), 100'000);
+
+  // Same size IOs give no fit.
+  IoLatencyModel sameSize;
+  for (auto i = 0; i < 100; ++i) {
+    sameSize.recordIo(1 << 20, 1'000);
+  }
+  EXPECT_EQ(kDefault, sameSize.mergeDistance(kDefault));
+
+  // The distance is bounded.
+  IoLatencyModel slow;
+  recordIos(slow, 64 << 20, 10'000'000, 1'000);
+  EXPECT_EQ(IoLatencyModel::kMaxMergeDistance, slow.mergeDistance(kDefault));
+}
+
+TEST(ScanTrackerTest, trackerMergeDistance) {
+  ScanTracker tracker;
+  EXPECT_EQ(1000, tracker.mergeDistance(1000));
+  for (auto i = 0; i < 100; ++i) {
+    uint64_t bytes = (i % 10 + 1) << 20;
+    tracker.recordIo(bytes, 10'000 + bytes / 1'000);
+  }
+  EXPECT_NEAR(10'000'000, tracker.mergeDistance(1000), 100'000);
+}
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+namespace facebook::velox {
+
+// A value that is made at most once, either ahead of time on a
+// background executor by prepare() or on demand by the consumer in
+// move(). If the consumer gets to the value while it is being made, it
+// waits for the background maker instead of making it twice. An
+// exception thrown by the maker is rethrown to the consumer.
+template <typename Item>
+class AsyncSource {
+ public:
+  explicit AsyncSource(std::function<std::unique_ptr<Item>()> make)
+      : make_(std::move(make)) {}
+
+  // Makes the value unless it has been or is being made.
+  void prepare() {
+    std::function<std::unique_ptr<Item>()> make;
+    {
+      std::lock_guard<std::mutex> l(mutex_);
+      if (!make_) {
+        return;
+      }
+      making_ = true;
+      std::swap(make, make_);
+    }
+    std::unique_ptr<Item> item;
+    std::exception_ptr exception;
+    try {
+      item = make();
+    } catch (...) {
+      exception = std::current_exception();
+    }
+    {
+      std::lock_guard<std::mutex> l(mutex_);
+      item_ = std::move(item);
+      exception_ = exception;
+      making_ = false;
+    }
+    made_.notify_all();
+  }
+
+  // Returns the value, making it on the calling thread if the background
+  // maker has not started. Returns nullptr after the first call.
+  std::unique_ptr<Item> move() {
+    prepare();
+    std::unique_lock<std::mutex> l(mutex_);
+    made_.wait(l, [&]() { return !making_; });
+    if (exception_) {
+      std::rethrow_exception(exception_);
+    }
+    return std::move(item_);
+  }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable made_;
+  std::function<std::unique_ptr<Item>()> make_;
+  bool making_{false};
+  std::unique_ptr<Item> item_;
+  std::exception_ptr exception_;
+};
+
+} // namespace facebook::velox
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/process/PerfCounters.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <cstring>
+#include <utility>
+#include <vector>
+
+namespace facebook::velox::process {
+
+#ifdef __linux__
+namespace {
+
+constexpr int32_t kNumEvents = 4;
+
+// Type and config of the events in the order of the members of PerfCounts.
+// PERF_COUNT_HW_CACHE_MISSES counts misses of the last level cache.
+constexpr std::pair<uint32_t, uint64_t> kEvents[kNumEvents] = {
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES}};
+
+// The counters of one thread. They are opened as one group so that they are
+// scheduled on the PMU together and read with a single system call.
+class ThreadCounters {
+ public:
+  ThreadCounters() {
+    for (auto i = 0; i < kNumEvents; ++i) {
+      struct perf_event_attr attr;
+      memset(&attr, 0, sizeof(attr));
+      attr.size = sizeof(attr);
+      attr.type = kEvents[i].first;
+      attr.config = kEvents[i].second;
+      attr.read_format = PERF_FORMAT_GROUP;
+      // Counting in user space only is allowed with perf_event_paranoid up
+      // to 2, which is the default.
+      attr.exclude_kernel = 1;
+      attr.exclude_hv = 1;
+      // The calling thread on any CPU.
+      const int fd = syscall(__NR_perf_event_open, &attr, 0, -1, leader_, 0);
+      if (fd < 0) {
+        continue;
+      }
+      if (leader_ < 0) {
+        leader_ = fd;
+      }
+      fds_.push_back(fd);
+      events_.push_back(i);
+    }
+  }
+
+  ~ThreadCounters() {
+    for (auto fd : fds_) {
+      close(fd);
+    }
+  }
+
+  bool read(PerfCounts& counts) {
+    if (leader_ < 0) {
+      return false;
+    }
+    // The number of events followed by the value of each.
+    uint64_t buffer[1 + kNumEvents];
+    const auto size = ::read(leader_, buffer, sizeof(buffer));
+    if (size < static_cast<ssize_t>(sizeof(uint64_t) * (1 + events_.size())) ||
+        buffer[0] != events_.size()) {
+      return false;
+    }
+    uint64_t values[kNumEvents] = {};
+    for (size_t i = 0; i < events_.size(); ++i) {
+      values[events_[i]] = buffer[1 + i];
+    }
+    counts = {values[0], values[1], values[2], values[3]};
+    return true;
+  }
+
+ private:
+  int leader_ = -1;
+  std::vector<int> fds_;
+  // The index in kEvents for each of 'fds_'.
+  std::vector<int32_t> events_;
+};
+
+} // namespace
+
+bool readThreadPerfCounts(PerfCounts& counts) {
+  thread_local ThreadCounters counters;
+  return counters.read(counts);
+}
+
+#else
+
+bool readThreadPerfCounts(PerfCounts& /*counts*/) {
+  return false;
+}
+
+#endif
+
+} // namespace facebook::velox::process
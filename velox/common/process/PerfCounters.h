@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace facebook::velox::process {
+
+// Hardware event counts of a thread.
+struct PerfCounts {
+  uint64_t cycles = 0;
+  uint64_t instructions = 0;
+  // Last level cache misses.
+  uint64_t llcMisses = 0;
+  uint64_t branchMisses = 0;
+
+  PerfCounts operator-(const PerfCounts& other) const {
+    return {
+        cycles - other.cycles,
+        instructions - other.instructions,
+        llcMisses - other.llcMisses,
+        branchMisses - other.branchMisses};
+  }
+};
+
+// Reads the hardware counters of the calling thread into 'counts'. The
+// counters are opened with perf_event_open on the first call on each thread
+// and stay open until the thread exits, so that the difference of two reads
+// on the same thread counts the events in between. Returns false if the
+// counters are not available: on other systems than Linux, on machines
+// without a PMU, e.g. many VMs, or when kernel.perf_event_paranoid does not
+// allow user space counting. An event the machine does not have reads as 0.
+bool readThreadPerfCounts(PerfCounts& counts);
+
+} // namespace facebook::velox::process
@@ -19,6 +19,9 @@
 #include "velox/core/Context.h"
 #include "velox/vector/ComplexVector.h"
 
+namespace folly {
+class Executor;
+}
 namespace facebook::velox::common {
 class Filter;
 }
@@ -84,10 +87,43 @@ class DataSource {
   // processed.
   virtual void addSplit(std::shared_ptr<ConnectorSplit> split) = 0;
 
+  // Returns true if preloadSplit() does work ahead of addSplit().
+  virtual bool canPreloadSplits() const {
+    return false;
+  }
+
+  // Starts preparing 'split' on 'executor' while the current split is
+  // being processed, e.g. opening its file and reading its metadata. The
+  // split stays queued and is later passed to addSplit() of this or
+  // another DataSource of the same connector, which uses or waits for the
+  // result, so the result must be kept in the split and must not depend on
+  // 'this'. Called while the split queue is locked, so must not block.
+  virtual void preloadSplit(
+      std::shared_ptr<ConnectorSplit> /*split*/,
+      folly::Executor* /*executor*/) {}
+
+  // Called right after addSplit(). Limits the current split to the first
+  // of at most 'numParts' parts and returns splits for the other parts,
+  // to be read by other data sources of the same query. Returns no splits
+  // if the current split is not worth dividing.
+  virtual std::vector<std::shared_ptr<ConnectorSplit>> divideSplit(
+      int32_t /*numParts*/) {
+    return {};
+  }
+
   // Process a split added via addSplit. Returns nullptr if split has been fully
   // processed.
   virtual RowVectorPtr next(uint64_t size) = 0;
 
+  // Allows the DataSource to return, instead of the rows of a split, rows
+  // made from the file statistics of the split. These must have the same
+  // number of rows and the same non-null count in each column as the split.
+  // The columns in 'minMaxChannels' must also have the same minimum and
+  // maximum. Called when the consumer of the output depends on nothing
+  // else, e.g. a global count, min and max.
+  virtual void enableAggregationFromStats(
+      const std::vector<ChannelIndex>& /*minMaxChannels*/) {}
+
   // Add dynamically generated filter.
   // @param outputChannel index into outputType specified in
   // Connector::createDataSource() that identifies the column this filter
@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 #include "velox/connectors/hive/HiveConnector.h"
+#include <folly/Executor.h>
+#include <numeric>
 #include <velox/dwio/dwrf/reader/SelectiveColumnReader.h>
 #include "velox/dwio/common/InputStream.h"
 #include "velox/expression/ControlExpr.h"
@@ -26,6 +28,7 @@ DEFINE_int32(
     1024,
     "Amount of space for the file handle cache in mb.");
 
+
 namespace facebook::velox::connector::hive {
 
 namespace {
@@ -35,9 +38,17 @@ static const char* kBucket = "$bucket";
 
 HiveDataSink::HiveDataSink(
     std::shared_ptr<const RowType> inputType,
-    const std::string& filePath,
+    const HiveInsertTableHandle& insertTableHandle,
+    uint64_t sortBufferSize,
     velox::memory::MemoryPool* memoryPool)
-    : inputType_(inputType) {
+    : inputType_(inputType),
+      pool_(memoryPool),
+      sortOrder_(insertTableHandle.sortOrder()),
+      sortBufferSize_(sortBufferSize) {
+  for (const auto& name : insertTableHandle.sortColumns()) {
+    sortChannels_.push_back(inputType_->getChildIdx(name));
+  }
+
   auto config = std::make_shared<WriterConfig>();
   // TODO: Wire up serde properties to writer configs.
 
@@ -47,18 +58,132 @@ HiveDataSink::HiveDataSink(
   // Without explicitly setting flush policy, the default memory based flush
   // policy is used.
 
-  auto sink = facebook::dwio::common::DataSink::create(filePath);
+  auto sink =
+      facebook::dwio::common::DataSink::create(insertTableHandle.filePath());
   writer_ = std::make_unique<Writer>(options, std::move(sink), *memoryPool);
 }
 
 void HiveDataSink::appendData(VectorPtr input) {
-  writer_->write(input);
+  if (sortChannels_.empty()) {
+    writer_->write(input);
+    return;
+  }
+  const auto numRows = input->size();
+  if (sortBuffer_ &&
+      (sortBufferBytes_ >= sortBufferSize_ ||
+       sortBuffer_->size() + static_cast<int64_t>(numRows) >
+           std::numeric_limits<vector_size_t>::max())) {
+    flushSortBuffer();
+  }
+  if (!sortBuffer_) {
+    sortBuffer_ = std::static_pointer_cast<RowVector>(
+        BaseVector::create(inputType_, 0, pool_));
+  }
+  const auto offset = sortBuffer_->size();
+  sortBuffer_->resize(offset + numRows);
+  sortBuffer_->copy(input.get(), offset, 0, numRows);
+  sortBufferBytes_ += input->retainedSize();
 }
 
 void HiveDataSink::close() {
+  if (sortBuffer_) {
+    flushSortBuffer();
+  }
   writer_->close();
 }
 
+void HiveDataSink::flushSortBuffer() {
+  const auto numRows = sortBuffer_->size();
+  auto order = sortOrder_ == HiveInsertTableHandle::SortOrder::kZOrder
+      ? zOrder()
+      : lexicographicOrder();
+  auto indices = AlignedBuffer::allocate<vector_size_t>(numRows, pool_);
+  std::copy(order.begin(), order.end(), indices->asMutable<vector_size_t>());
+  writer_->write(
+      BaseVector::wrapInDictionary(nullptr, indices, numRows, sortBuffer_));
+  // Starts a new stripe so that no stripe spans two sorted batches.
+  writer_->flush();
+  sortBuffer_ = nullptr;
+  sortBufferBytes_ = 0;
+}
+
+std::vector<vector_size_t> HiveDataSink::lexicographicOrder() const {
+  std::vector<vector_size_t> order(sortBuffer_->size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(
+      order.begin(), order.end(), [&](vector_size_t left, vector_size_t right) {
+        for (auto channel : sortChannels_) {
+          const auto& column = sortBuffer_->childAt(channel);
+          auto result = column->compare(column.get(), left, right);
+          if (result != 0) {
+            return result < 0;
+          }
+        }
+        return false;
+      });
+  return order;
+}
+
+namespace {
+// True if the most significant set bit of 'x' is below that of 'y'.
+inline bool lessMsb(uint32_t x, uint32_t y) {
+  return x < y && x < (x ^ y);
+}
+} // namespace
+
+std::vector<vector_size_t> HiveDataSink::zOrder() const {
+  const auto numRows = sortBuffer_->size();
+  const int32_t numKeys = sortChannels_.size();
+  std::vector<vector_size_t> order(numRows);
+  std::iota(order.begin(), order.end(), 0);
+
+  // Replaces each value by its rank among the values of its column, so
+  // that all columns contribute equally to the interleaving whatever
+  // their type and range. Equal values get the same rank. 'ranks' has
+  // the ranks of one row next to each other.
+  std::vector<uint32_t> ranks(static_cast<size_t>(numRows) * numKeys);
+  std::vector<vector_size_t> columnOrder(numRows);
+  for (auto key = 0; key < numKeys; ++key) {
+    const auto& column = sortBuffer_->childAt(sortChannels_[key]);
+    std::iota(columnOrder.begin(), columnOrder.end(), 0);
+    std::sort(
+        columnOrder.begin(),
+        columnOrder.end(),
+        [&](vector_size_t left, vector_size_t right) {
+          return column->compare(column.get(), left, right) < 0;
+        });
+    uint32_t rank = 0;
+    for (auto i = 0; i < numRows; ++i) {
+      if (i > 0 &&
+          column->compare(column.get(), columnOrder[i - 1], columnOrder[i]) !=
+              0) {
+        rank = i;
+      }
+      ranks[static_cast<size_t>(columnOrder[i]) * numKeys + key] = rank;
+    }
+  }
+
+  // Compares the interleaved bits of two rows without materializing them:
+  // the key with the most significant differing bit decides. Ties in bit
+  // position go to the earlier key.
+  std::stable_sort(
+      order.begin(), order.end(), [&](vector_size_t left, vector_size_t right) {
+        const auto* leftRanks = &ranks[static_cast<size_t>(left) * numKeys];
+        const auto* rightRanks = &ranks[static_cast<size_t>(right) * numKeys];
+        int32_t decidingKey = 0;
+        uint32_t decidingBits = leftRanks[0] ^ rightRanks[0];
+        for (auto key = 1; key < numKeys; ++key) {
+          const auto bits = leftRanks[key] ^ rightRanks[key];
+          if (lessMsb(decidingBits, bits)) {
+            decidingKey = key;
+            decidingBits = bits;
+          }
+        }
+        return leftRanks[decidingKey] < rightRanks[decidingKey];
+      });
+  return order;
+}
+
 namespace {
 static void makeFieldSpecs(
     const std::string& pathPrefix,
@@ -115,15 +240,19 @@ HiveDataSource::HiveDataSource(
     const std::unordered_map<
         std::string,
         std::shared_ptr<connector::ColumnHandle>>& columnHandles,
+    std::shared_ptr<const Connector> connector,
     FileHandleFactory* fileHandleFactory,
     velox::memory::MemoryPool* pool,
     DataCache* dataCache,
+    dwrf::DecodedStripeCache* decodedStripeCache,
     ExpressionEvaluator* expressionEvaluator)
     : outputType_(outputType),
+      connector_(std::move(connector)),
       fileHandleFactory_(fileHandleFactory),
       pool_(pool),
       readerOpts_(pool),
       dataCache_(dataCache),
+      decodedStripeCache_(decodedStripeCache),
       expressionEvaluator_(expressionEvaluator) {
   regularColumns_.reserve(outputType->size());
 
@@ -193,11 +322,47 @@ HiveDataSource::HiveDataSource(
       std::make_unique<dwrf::SelectiveColumnReaderFactory>(scanSpec_.get());
   rowReaderOpts_.setColumnReaderFactory(columnReaderFactory_.get());
 
-  ioStats_ = std::make_unique<dwio::common::IoStatistics>();
+  ioStats_ = std::make_shared<dwio::common::IoStatistics>();
 }
 
 namespace {
 
+// Returns false if the value of 'constant' does not pass 'filter'.
+bool testConstantFilter(
+    const common::Filter& filter,
+    const BaseVector& constant) {
+  if (constant.isNullAt(0)) {
+    return filter.testNull();
+  }
+  switch (constant.typeKind()) {
+    case TypeKind::BOOLEAN:
+      return filter.testBool(constant.as<SimpleVector<bool>>()->valueAt(0));
+    case TypeKind::TINYINT:
+      return filter.testInt64(constant.as<SimpleVector<int8_t>>()->valueAt(0));
+    case TypeKind::SMALLINT:
+      return filter.testInt64(
+          constant.as<SimpleVector<int16_t>>()->valueAt(0));
+    case TypeKind::INTEGER:
+      return filter.testInt64(
+          constant.as<SimpleVector<int32_t>>()->valueAt(0));
+    case TypeKind::BIGINT:
+      return filter.testInt64(
+          constant.as<SimpleVector<int64_t>>()->valueAt(0));
+    case TypeKind::REAL:
+      return filter.testFloat(constant.as<SimpleVector<float>>()->valueAt(0));
+    case TypeKind::DOUBLE:
+      return filter.testDouble(
+          constant.as<SimpleVector<double>>()->valueAt(0));
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY: {
+      auto value = constant.as<SimpleVector<StringView>>()->valueAt(0);
+      return filter.testBytes(value.data(), value.size());
+    }
+    default:
+      return true;
+  }
+}
+
 bool testFilters(
     common::ScanSpec* scanSpec,
     dwrf::DwrfReader* reader,
@@ -209,7 +374,15 @@ bool testFilters(
   for (const auto& child : scanSpec->children()) {
     if (child->filter()) {
       const auto& name = child->fieldName();
-      if (!rowType->containsChild(name)) {
+      if (child->isConstant()) {
+        // Partition keys, $path and $bucket have the same value for the
+        // whole split.
+        if (!testConstantFilter(*child->filter(), *child->constantValue())) {
+          VLOG(1) << "Skipping " << filePath
+                  << " based on the value of " << name;
+          return false;
+        }
+      } else if (!rowType->containsChild(name)) {
         // Column is missing. Most likely due to schema evolution.
         if (child->filter()->isDeterministic() &&
             !child->filter()->testNull()) {
@@ -234,6 +407,61 @@ bool testFilters(
 
   return true;
 }
+
+// Returns true if 'spec' or any of its descendants that is not a constant
+// has a filter. Filters on constants, e.g. partition keys, hold for all rows
+// of a split that is not skipped by testFilters(). Unlike
+// ScanSpec::hasFilter(), does not cache.
+bool hasAnyFilter(const common::ScanSpec& spec) {
+  if (spec.isConstant()) {
+    return false;
+  }
+  if (spec.filter()) {
+    return true;
+  }
+  for (const auto& child : spec.children()) {
+    if (hasAnyFilter(*child)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Returns a flat vector of 'Kind' with 3 rows: 2 non-null values and a null.
+template <TypeKind Kind>
+VectorPtr makeStatsValues(const TypePtr& type, memory::MemoryPool* pool) {
+  using T = typename TypeTraits<Kind>::NativeType;
+  auto values = BaseVector::create<FlatVector<T>>(type, 3, pool);
+  values->set(0, T());
+  values->set(1, T());
+  values->setNull(2, true);
+  return values;
+}
+
+// Sets rows 0 and 1 of 'values' to 'min' and 'max'. Returns false if
+// 'values' is not of an integer type.
+bool setStatsMinMax(BaseVector* values, int64_t min, int64_t max) {
+  switch (values->typeKind()) {
+    case TypeKind::TINYINT:
+      values->asFlatVector<int8_t>()->set(0, min);
+      values->asFlatVector<int8_t>()->set(1, max);
+      return true;
+    case TypeKind::SMALLINT:
+      values->asFlatVector<int16_t>()->set(0, min);
+      values->asFlatVector<int16_t>()->set(1, max);
+      return true;
+    case TypeKind::INTEGER:
+      values->asFlatVector<int32_t>()->set(0, min);
+      values->asFlatVector<int32_t>()->set(1, max);
+      return true;
+    case TypeKind::BIGINT:
+      values->asFlatVector<int64_t>()->set(0, min);
+      values->asFlatVector<int64_t>()->set(1, max);
+      return true;
+    default:
+      return false;
+  }
+}
 } // namespace
 
 void HiveDataSource::addDynamicFilter(
@@ -253,6 +481,73 @@ void HiveDataSource::addDynamicFilter(
   columnReader->resetFilterCaches();
 }
 
+std::unique_ptr<OpenedFile> HiveDataSource::openFile(
+    FileHandleFactory* fileHandleFactory,
+    DataCache* dataCache,
+    const std::string& filePath,
+    const dwio::common::ReaderOptions& readerOpts,
+    std::shared_ptr<dwio::common::IoStatistics> ioStats,
+    std::shared_ptr<const dwrf::FileTail> tail) {
+  auto file = std::make_unique<OpenedFile>();
+  file->ioStats = std::move(ioStats);
+  file->fileHandle = fileHandleFactory->generate(filePath);
+
+  file->readerOpts = readerOpts;
+  if (dataCache) {
+    auto dataCacheConfig = std::make_shared<dwio::common::DataCacheConfig>();
+    dataCacheConfig->cache = dataCache;
+    dataCacheConfig->filenum = file->fileHandle->uuid.id();
+    file->readerOpts.setDataCacheConfig(std::move(dataCacheConfig));
+  }
+
+  auto input = std::make_unique<dwio::common::ReadFileInputStream>(
+      file->fileHandle->file.get(),
+      dwio::common::MetricsLog::voidLog(),
+      file->ioStats.get());
+  if (tail) {
+    file->reader = dwrf::DwrfReader::create(
+        std::move(input), file->readerOpts, std::move(tail));
+  } else {
+    file->reader = dwrf::DwrfReader::create(std::move(input), file->readerOpts);
+  }
+  return file;
+}
+
+void HiveDataSource::preloadSplit(
+    std::shared_ptr<ConnectorSplit> split,
+    folly::Executor* executor) {
+  auto hiveSplit = std::dynamic_pointer_cast<HiveConnectorSplit>(split);
+  VELOX_CHECK(hiveSplit, "Wrong type of split");
+  if (hiveSplit->preloadedTail) {
+    // The same split was queued twice.
+    return;
+  }
+  // The split may be read by another data source after 'this' is gone, so
+  // the maker does not refer to 'this'. The file handle factory and the
+  // data cache belong to the connector, which the maker keeps alive since
+  // the job may run after the query and the connector are gone.
+  auto preload = std::make_shared<AsyncSource<dwrf::FileTail>>(
+      [connector = connector_,
+       fileHandleFactory = fileHandleFactory_,
+       dataCache = dataCache_,
+       filePath = hiveSplit->filePath,
+       ioStats = ioStats_]() {
+        auto pool =
+            memory::getProcessDefaultMemoryManager().getRoot().addScopedChild(
+                "preloadSplit");
+        auto file = openFile(
+            fileHandleFactory,
+            dataCache,
+            filePath,
+            dwio::common::ReaderOptions(pool.get()),
+            ioStats);
+        return file->reader->getFileTail();
+      });
+  hiveSplit->preloadedTail = preload;
+  ++preloadedSplits_;
+  executor->add([preload]() { preload->prepare(); });
+}
+
 void HiveDataSource::addSplit(std::shared_ptr<ConnectorSplit> split) {
   VELOX_CHECK(
       split_ == nullptr,
@@ -262,38 +557,29 @@ void HiveDataSource::addSplit(std::shared_ptr<ConnectorSplit> split) {
 
   VLOG(1) << "Adding split " << split_->toString();
 
-  fileHandle_ = fileHandleFactory_->generate(split_->filePath);
-
-  if (dataCache_) {
-    auto dataCacheConfig = std::make_shared<dwio::common::DataCacheConfig>();
-    dataCacheConfig->cache = dataCache_;
-    dataCacheConfig->filenum = fileHandle_->uuid.id();
-    readerOpts_.setDataCacheConfig(std::move(dataCacheConfig));
+  std::shared_ptr<const dwrf::FileTail> tail = split_->fileTail;
+  if (!tail && split_->preloadedTail) {
+    // Waits for the tail if the executor is reading it, reads it here if
+    // the executor has not got to it.
+    tail = split_->preloadedTail->move();
   }
-
-  reader_ = dwrf::DwrfReader::create(
-      std::make_unique<dwio::common::ReadFileInputStream>(
-          fileHandle_->file.get(),
-          dwio::common::MetricsLog::voidLog(),
-          ioStats_.get()),
-      readerOpts_);
+  file_ = openFile(
+      fileHandleFactory_,
+      dataCache_,
+      split_->filePath,
+      readerOpts_,
+      ioStats_,
+      std::move(tail));
+  auto& reader = file_->reader;
 
   emptySplit_ = false;
-  if (reader_->getFooter().has_numberofrows() &&
-      reader_->getFooter().numberofrows() == 0) {
-    emptySplit_ = true;
-    return;
-  }
-
-  // Check filters and see if the whole split can be skipped
-  if (!testFilters(scanSpec_.get(), reader_.get(), split_->filePath)) {
+  if (reader->getFooter().has_numberofrows() &&
+      reader->getFooter().numberofrows() == 0) {
     emptySplit_ = true;
-    ++skippedSplits_;
-    skippedSplitBytes_ += split_->length;
     return;
   }
 
-  auto fileType = reader_->getType();
+  auto fileType = reader->getType();
 
   for (int i = 0; i < readerOutputType_->size(); i++) {
     auto fieldName = readerOutputType_->nameOf(i);
@@ -337,6 +623,20 @@ void HiveDataSource::addSplit(std::shared_ptr<ConnectorSplit> split) {
         bucketSpec, velox::variant(split_->tableBucketNumber.value()));
   }
 
+  // Check filters and see if the whole split can be skipped. Runs after the
+  // constant values are set, so that filters on these are checked too.
+  if (!testFilters(scanSpec_.get(), reader.get(), split_->filePath)) {
+    emptySplit_ = true;
+    ++skippedSplits_;
+    skippedSplitBytes_ += split_->length;
+    return;
+  }
+
+  if (statsMinMaxChannels_ && prepareStatsOutput()) {
+    ++statsAnsweredSplits_;
+    return;
+  }
+
   std::vector<std::string> columnNames;
   for (auto& spec : scanSpec_->children()) {
     if (!spec->isConstant()) {
@@ -352,19 +652,84 @@ void HiveDataSource::addSplit(std::shared_ptr<ConnectorSplit> split) {
     cs = std::make_shared<dwio::common::ColumnSelector>(fileType, columnNames);
   }
 
-  rowReader_ = reader_->createRowReader(
+  if (decodedStripeCache_) {
+    rowReaderOpts_.setDecodedStripeCache(
+        decodedStripeCache_, file_->fileHandle->uuid.id());
+  }
+  rowReader_ = reader->createRowReader(
       rowReaderOpts_.select(cs).range(split_->start, split_->length));
 }
 
+std::vector<std::shared_ptr<ConnectorSplit>> HiveDataSource::divideSplit(
+    int32_t numParts) {
+  VELOX_CHECK(split_ != nullptr, "No split to divide. Call addSplit first.");
+  if (emptySplit_ || statsSplit_ || numParts < 2) {
+    return {};
+  }
+
+  // The stripes that start in the split are read by the split.
+  const auto& footer = file_->reader->getFooter();
+  std::vector<uint64_t> stripeOffsets;
+  for (auto i = 0; i < footer.stripes_size(); ++i) {
+    auto offset = footer.stripes(i).offset();
+    if (offset >= split_->start && offset - split_->start < split_->length) {
+      stripeOffsets.push_back(offset);
+    }
+  }
+  numParts = std::min<int32_t>(numParts, stripeOffsets.size());
+  if (numParts < 2) {
+    return {};
+  }
+
+  std::vector<uint64_t> partStarts;
+  partStarts.reserve(numParts);
+  partStarts.push_back(split_->start);
+  for (auto i = 1; i < numParts; ++i) {
+    partStarts.push_back(stripeOffsets[i * stripeOffsets.size() / numParts]);
+  }
+
+  // The parts share one copy of the tail, which does not refer to the
+  // memory pool of 'this'.
+  std::shared_ptr<const dwrf::FileTail> tail = file_->reader->getFileTail();
+  std::vector<std::shared_ptr<ConnectorSplit>> parts;
+  for (auto i = 1; i < numParts; ++i) {
+    auto start = partStarts[i];
+    // The last part ends where the split does. 'length' may be the
+    // maximum uint64_t, so the end is not computed.
+    auto length = i + 1 < numParts
+        ? partStarts[i + 1] - start
+        : split_->length - (start - split_->start);
+    auto part = std::make_shared<HiveConnectorSplit>(
+        split_->connectorId,
+        split_->filePath,
+        split_->fileFormat,
+        start,
+        length,
+        split_->partitionKeys,
+        split_->tableBucketNumber);
+    part->fileTail = tail;
+    parts.push_back(std::move(part));
+  }
+
+  rowReader_ = file_->reader->createRowReader(
+      rowReaderOpts_.range(split_->start, partStarts[1] - split_->start));
+  ++dividedSplits_;
+  return parts;
+}
+
 RowVectorPtr HiveDataSource::next(uint64_t size) {
   VELOX_CHECK(split_ != nullptr, "No split to process. Call addSplit first.");
   if (emptySplit_) {
     split_.reset();
-    reader_.reset();
+    file_.reset();
     rowReader_.reset();
     return nullptr;
   }
 
+  if (statsSplit_) {
+    return nextFromStats();
+  }
+
   if (!output_) {
     output_ = BaseVector::create(readerOutputType_, 0, pool_);
   }
@@ -419,11 +784,135 @@ RowVectorPtr HiveDataSource::next(uint64_t size) {
   skippedStrides_ += rowReader_->skippedStrides();
 
   split_.reset();
-  reader_.reset();
+  file_.reset();
   rowReader_.reset();
   return nullptr;
 }
 
+bool HiveDataSource::prepareStatsOutput() {
+  if (remainingFilterExprSet_ || hasAnyFilter(*scanSpec_)) {
+    return false;
+  }
+  const auto& footer = file_->reader->getFooter();
+  if (!footer.has_numberofrows()) {
+    return false;
+  }
+  // The statistics are for the whole file. The split must read all of it.
+  for (auto i = 0; i < footer.stripes_size(); ++i) {
+    auto offset = footer.stripes(i).offset();
+    if (offset < split_->start || offset - split_->start >= split_->length) {
+      return false;
+    }
+  }
+
+  const auto& fileType = file_->reader->getType();
+  const auto& fileTypeWithId = file_->reader->getTypeWithId();
+  std::vector<StatsColumn> columns;
+  columns.reserve(outputType_->size());
+  for (ChannelIndex channel = 0; channel < outputType_->size(); ++channel) {
+    const auto& name = outputType_->nameOf(channel);
+    auto spec = scanSpec_->childByName(name);
+    if (spec && spec->isConstant()) {
+      columns.push_back({spec->constantValue(), 0, true});
+      continue;
+    }
+    const auto& type = outputType_->childAt(channel);
+    switch (type->kind()) {
+      case TypeKind::BOOLEAN:
+      case TypeKind::TINYINT:
+      case TypeKind::SMALLINT:
+      case TypeKind::INTEGER:
+      case TypeKind::BIGINT:
+      case TypeKind::REAL:
+      case TypeKind::DOUBLE:
+      case TypeKind::VARCHAR:
+      case TypeKind::VARBINARY:
+        break;
+      default:
+        return false;
+    }
+    if (!fileType->containsChild(name)) {
+      return false;
+    }
+    auto stats = file_->reader->getColumnStatistics(
+        fileTypeWithId->childByName(name)->id);
+    if (!stats || !stats->getNumberOfValues().has_value()) {
+      return false;
+    }
+    auto values = VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+        makeStatsValues, type->kind(), type, pool_);
+    int64_t numValues = stats->getNumberOfValues().value();
+    bool minMax = std::find(
+                      statsMinMaxChannels_->begin(),
+                      statsMinMaxChannels_->end(),
+                      channel) != statsMinMaxChannels_->end();
+    if (minMax && numValues > 0) {
+      auto intStats =
+          dynamic_cast<const dwrf::IntegerColumnStatistics*>(stats.get());
+      if (!intStats || !intStats->getMinimum().has_value() ||
+          !intStats->getMaximum().has_value() ||
+          !setStatsMinMax(
+              values.get(),
+              intStats->getMinimum().value(),
+              intStats->getMaximum().value())) {
+        return false;
+      }
+    }
+    columns.push_back({std::move(values), numValues, false});
+  }
+  statsColumns_ = std::move(columns);
+  statsRows_ = footer.numberofrows();
+  statsRow_ = 0;
+  statsSplit_ = true;
+  return true;
+}
+
+RowVectorPtr HiveDataSource::nextFromStats() {
+  // The rows are constant vectors, so batches can be larger than those
+  // decoded from the file.
+  constexpr int64_t kMaxStatsBatchRows = 100'000;
+  if (statsRow_ >= statsRows_) {
+    statsSplit_ = false;
+    statsColumns_.clear();
+    split_.reset();
+    file_.reset();
+    return nullptr;
+  }
+  // Each batch is one constant vector per column. A column has the minimum
+  // in row 0, the maximum in row 1, and other values up to 'numValues'
+  // repeat the minimum. The rest are null.
+  auto end = std::min(statsRows_, statsRow_ + kMaxStatsBatchRows);
+  for (const auto& column : statsColumns_) {
+    if (column.constant) {
+      continue;
+    }
+    for (auto breakpoint : {int64_t(1), int64_t(2), column.numValues}) {
+      if (breakpoint > statsRow_) {
+        end = std::min(end, breakpoint);
+      }
+    }
+  }
+  auto numRows = end - statsRow_;
+  std::vector<VectorPtr> children;
+  children.reserve(statsColumns_.size());
+  for (const auto& column : statsColumns_) {
+    vector_size_t index = 0;
+    if (!column.constant) {
+      if (statsRow_ >= column.numValues) {
+        index = 2;
+      } else if (statsRow_ == 1) {
+        index = 1;
+      }
+    }
+    children.push_back(
+        BaseVector::wrapInConstant(numRows, index, column.values));
+  }
+  statsRow_ = end;
+  completedRows_ += numRows;
+  return std::make_shared<RowVector>(
+      pool_, outputType_, BufferPtr(nullptr), numRows, std::move(children));
+}
+
 vector_size_t HiveDataSource::evaluateRemainingFilter(RowVectorPtr& rowVector) {
   filterRows_.resize(output_->size());
 
@@ -445,12 +934,24 @@ void HiveDataSource::setNullConstantValue(
   spec->setConstantValue(BaseVector::createNullConstant(type, 1, pool_));
 }
 
+namespace {
+std::unique_ptr<dwrf::DecodedStripeCache> makeDecodedStripeCache(
+    const Config* properties) {
+  auto maxBytes = properties
+      ? properties->get<int64_t>(HiveConnector::kDecodedStripeCacheBytes, 0)
+      : 0;
+  return maxBytes > 0 ? std::make_unique<dwrf::DecodedStripeCache>(maxBytes)
+                      : nullptr;
+}
+} // namespace
+
 HiveConnector::HiveConnector(
     const std::string& id,
     std::shared_ptr<const Config> properties,
     std::unique_ptr<DataCache> dataCache)
     : Connector(id, properties),
       dataCache_(std::move(dataCache)),
+      decodedStripeCache_(makeDecodedStripeCache(properties.get())),
       fileHandleFactory_(
           std::make_unique<SimpleLRUCache<std::string, FileHandle>>(
               FLAGS_file_handle_cache_mb << 20),
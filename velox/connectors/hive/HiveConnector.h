@@ -16,8 +16,10 @@
 #pragma once
 
 #include "velox/common/caching/DataCache.h"
+#include "velox/common/future/AsyncSource.h"
 #include "velox/connectors/hive/FileHandle.h"
 #include "velox/connectors/hive/HiveConnectorSplit.h"
+#include "velox/dwio/dwrf/reader/DecodedStripeCache.h"
 #include "velox/dwio/dwrf/reader/DwrfReader.h"
 #include "velox/dwio/dwrf/reader/ScanSpec.h"
 #include "velox/dwio/dwrf/writer/Writer.h"
@@ -84,24 +86,52 @@ class HiveTableHandle : public ConnectorTableHandle {
  */
 class HiveInsertTableHandle : public ConnectorInsertTableHandle {
  public:
-  explicit HiveInsertTableHandle(const std::string& filePath)
-      : filePath_(filePath) {}
+  // How the rows of a file are ordered by 'sortColumns'. kLexicographic
+  // orders by the first column, then by the next and so on. kZOrder
+  // interleaves the bits of the ranks of the values of all columns, so
+  // that rows close in all columns are written together and the stats of
+  // each column narrow down.
+  enum class SortOrder { kLexicographic, kZOrder };
+
+  // If 'sortColumns' is not empty, the data sink sorts batches of rows by
+  // these columns before writing them, so that the stripes and row groups
+  // of the file have narrow min/max stats on these columns.
+  explicit HiveInsertTableHandle(
+      const std::string& filePath,
+      std::vector<std::string> sortColumns = {},
+      SortOrder sortOrder = SortOrder::kLexicographic)
+      : filePath_(filePath),
+        sortColumns_(std::move(sortColumns)),
+        sortOrder_(sortOrder) {}
 
   const std::string& filePath() const {
     return filePath_;
   }
 
+  const std::vector<std::string>& sortColumns() const {
+    return sortColumns_;
+  }
+
+  SortOrder sortOrder() const {
+    return sortOrder_;
+  }
+
   virtual ~HiveInsertTableHandle() {}
 
  private:
   const std::string filePath_;
+  const std::vector<std::string> sortColumns_;
+  const SortOrder sortOrder_;
 };
 
 class HiveDataSink : public DataSink {
  public:
-  explicit HiveDataSink(
+  // Sorted writes buffer up to 'sortBufferSize' bytes of input before
+  // sorting and writing it.
+  HiveDataSink(
       std::shared_ptr<const RowType> inputType,
-      const std::string& filePath,
+      const HiveInsertTableHandle& insertTableHandle,
+      uint64_t sortBufferSize,
       velox::memory::MemoryPool* memoryPool);
 
   void appendData(VectorPtr input) override;
@@ -109,10 +139,38 @@ class HiveDataSink : public DataSink {
   void close() override;
 
  private:
+  // Sorts the rows in 'sortBuffer_' and writes them.
+  void flushSortBuffer();
+
+  // Returns the order of the rows of 'sortBuffer_' by 'sortChannels_'.
+  std::vector<vector_size_t> lexicographicOrder() const;
+
+  std::vector<vector_size_t> zOrder() const;
+
   const std::shared_ptr<const RowType> inputType_;
+  velox::memory::MemoryPool* const pool_;
+  // Positions of the sort columns in 'inputType_'. Empty if rows are
+  // written in arrival order.
+  std::vector<ChannelIndex> sortChannels_;
+  const HiveInsertTableHandle::SortOrder sortOrder_;
+  const uint64_t sortBufferSize_;
+  // Rows appended since the last flushSortBuffer().
+  RowVectorPtr sortBuffer_;
+  // Retained size of the input copied into 'sortBuffer_'.
+  uint64_t sortBufferBytes_{0};
   std::unique_ptr<facebook::velox::dwrf::Writer> writer_;
 };
 
+// A file of a split with its reader. The reader reads through the file
+// handle, counts its IO in 'ioStats' and keeps references to 'readerOpts',
+// so these are declared first to be destroyed last.
+struct OpenedFile {
+  std::shared_ptr<dwio::common::IoStatistics> ioStats;
+  FileHandleCachedPtr fileHandle;
+  dwio::common::ReaderOptions readerOpts;
+  std::unique_ptr<dwrf::DwrfReader> reader;
+};
+
 class HiveDataSource : public DataSource {
  public:
   HiveDataSource(
@@ -121,19 +179,45 @@ class HiveDataSource : public DataSource {
       const std::unordered_map<
           std::string,
           std::shared_ptr<connector::ColumnHandle>>& columnHandles,
+      std::shared_ptr<const Connector> connector,
       FileHandleFactory* fileHandleFactory,
       velox::memory::MemoryPool* pool,
       DataCache* dataCache,
+      dwrf::DecodedStripeCache* decodedStripeCache,
       ExpressionEvaluator* expressionEvaluator);
 
   void addSplit(std::shared_ptr<ConnectorSplit> split) override;
 
+  bool canPreloadSplits() const override {
+    return true;
+  }
+
+  // Reads the tail of the file of 'split' on 'executor' into
+  // 'split->preloadedTail', so that addSplit() does not read it again.
+  // The tail is read on a memory pool of its own, since 'pool_' is used
+  // by the driver meanwhile.
+  void preloadSplit(
+      std::shared_ptr<ConnectorSplit> split,
+      folly::Executor* executor) override;
+
+  // Divides the split between the stripes that start in it, so that each
+  // part has about the same number of stripes. The parts carry the tail
+  // of the file, so that their readers do not read it again. Each reader
+  // is made on the pool of the data source that reads the part.
+  std::vector<std::shared_ptr<ConnectorSplit>> divideSplit(
+      int32_t numParts) override;
+
   void addDynamicFilter(
       ChannelIndex outputChannel,
       const std::shared_ptr<common::Filter>& filter) override;
 
   RowVectorPtr next(uint64_t size) override;
 
+  void enableAggregationFromStats(
+      const std::vector<ChannelIndex>& minMaxChannels) override {
+    statsMinMaxChannels_ = minMaxChannels;
+  }
+
   uint64_t getCompletedRows() override {
     return completedRows_;
   }
@@ -146,22 +230,51 @@ class HiveDataSource : public DataSource {
     return {
         {"skippedSplits", skippedSplits_},
         {"skippedSplitBytes", skippedSplitBytes_},
-        {"skippedStrides", skippedStrides_}};
+        {"skippedStrides", skippedStrides_},
+        {"mergedRegions", ioStats_->mergedRegions()},
+        {"splitRegions", ioStats_->splitRegions()},
+        {"gapPrefetchBytes", ioStats_->gapPrefetchBytes()},
+        {"preloadedSplits", preloadedSplits_},
+        {"statsAnsweredSplits", statsAnsweredSplits_},
+        {"dividedSplits", dividedSplits_}};
   }
 
  private:
+  // Opens 'filePath' for reading with 'readerOpts'. Reads the tail of the
+  // file unless it is given in 'tail'. Static since it is also called on
+  // the executor for preloaded splits.
+  static std::unique_ptr<OpenedFile> openFile(
+      FileHandleFactory* fileHandleFactory,
+      DataCache* dataCache,
+      const std::string& filePath,
+      const dwio::common::ReaderOptions& readerOpts,
+      std::shared_ptr<dwio::common::IoStatistics> ioStats,
+      std::shared_ptr<const dwrf::FileTail> tail = nullptr);
+
   // Evaluates remainingFilter_ on the specified vector. Returns number of rows
   // passed. Populates filterEvalCtx_.selectedIndices and selectedBits if only
   // some rows passed the filter. If no or all rows passed
   // filterEvalCtx_.selectedIndices and selectedBits are not updated.
   vector_size_t evaluateRemainingFilter(RowVectorPtr& rowVector);
 
+  // Prepares statsColumns_ for returning the rows of the split from the
+  // file statistics. Returns false if the statistics do not have all that
+  // is needed or if the split does not cover the whole file.
+  bool prepareStatsOutput();
+
+  // Returns the next batch of rows made from statsColumns_, or nullptr at
+  // the end of the split.
+  RowVectorPtr nextFromStats();
+
   void setConstantValue(common::ScanSpec* spec, const velox::variant& value)
       const;
 
   void setNullConstantValue(common::ScanSpec* spec, const TypePtr& type) const;
 
   const std::shared_ptr<const RowType> outputType_;
+  // Owner of 'fileHandleFactory_' and 'dataCache_'. Held by the jobs of
+  // preloadSplit(), which may run after the connector is unregistered.
+  const std::shared_ptr<const Connector> connector_;
   FileHandleFactory* fileHandleFactory_;
   velox::memory::MemoryPool* pool_;
   std::vector<std::string> regularColumns_;
@@ -170,8 +283,9 @@ class HiveDataSource : public DataSource {
   std::shared_ptr<HiveConnectorSplit> split_;
   dwio::common::ReaderOptions readerOpts_;
   dwio::common::RowReaderOptions rowReaderOpts_;
-  std::unique_ptr<dwio::common::IoStatistics> ioStats_;
-  std::unique_ptr<dwrf::DwrfReader> reader_;
+  std::shared_ptr<dwio::common::IoStatistics> ioStats_;
+  // The file of the current split.
+  std::unique_ptr<OpenedFile> file_;
   std::unique_ptr<dwrf::DwrfRowReader> rowReader_;
   std::unique_ptr<exec::ExprSet> remainingFilterExprSet_;
   std::shared_ptr<const RowType> readerOutputType_;
@@ -186,9 +300,43 @@ class HiveDataSource : public DataSource {
   // Number of strides (row groups) skipped based on statistics.
   int64_t skippedStrides_{0};
 
+  // Number of splits whose rows were made from file statistics.
+  int64_t statsAnsweredSplits_{0};
+
+  // Number of splits divided by divideSplit().
+  int64_t dividedSplits_{0};
+
+  // Number of splits passed to preloadSplit().
+  int64_t preloadedSplits_{0};
+
+  // A column of the rows made from file statistics. Rows 0, 1 and 2 of
+  // 'values' are the minimum, the maximum and a null. The first 'numValues'
+  // rows of the split are non-null. 'constant' is true for partition keys
+  // and other columns whose value comes from the split.
+  struct StatsColumn {
+    VectorPtr values;
+    int64_t numValues;
+    bool constant;
+  };
+
+  // Output channels whose minimum and maximum must be preserved if rows are
+  // made from statistics. Set by enableAggregationFromStats().
+  std::optional<std::vector<ChannelIndex>> statsMinMaxChannels_;
+
+  // True if the rows of the current split are made from statistics.
+  bool statsSplit_{false};
+
+  // One per output column if 'statsSplit_'.
+  std::vector<StatsColumn> statsColumns_;
+
+  // Number of rows in the current split and the number returned so far if
+  // 'statsSplit_'.
+  int64_t statsRows_{0};
+  int64_t statsRow_{0};
+
   VectorPtr output_;
-  FileHandleCachedPtr fileHandle_;
   DataCache* dataCache_;
+  dwrf::DecodedStripeCache* decodedStripeCache_;
   ExpressionEvaluator* expressionEvaluator_;
   uint64_t completedRows_ = 0;
 
@@ -198,7 +346,8 @@ class HiveDataSource : public DataSource {
   exec::FilterEvalCtx filterEvalCtx_;
 };
 
-class HiveConnector final : public Connector {
+class HiveConnector final : public Connector,
+                            public std::enable_shared_from_this<HiveConnector> {
  public:
   explicit HiveConnector(
       const std::string& id,
@@ -216,6 +365,7 @@ class HiveConnector final : public Connector {
         outputType,
         tableHandle,
         columnHandles,
+        shared_from_this(),
         &fileHandleFactory_,
         connectorQueryCtx->memoryPool(),
         connectorQueryCtx->config()->get<std::string>(
@@ -223,6 +373,7 @@ class HiveConnector final : public Connector {
                 kNodeSelectionStrategySoftAffinity
             ? dataCache_.get()
             : nullptr,
+        decodedStripeCache_.get(),
         connectorQueryCtx->expressionEvaluator());
   }
 
@@ -237,12 +388,34 @@ class HiveConnector final : public Connector {
         "Hive connector expecting hive write handle!");
     return std::make_shared<HiveDataSink>(
         inputType,
-        hiveInsertHandle->filePath(),
+        *hiveInsertHandle,
+        connectorQueryCtx->config()->get<uint64_t>(
+            kSortedWriteBufferSize, kSortedWriteBufferSizeDefault),
         connectorQueryCtx->memoryPool());
   }
 
+  // The most input a data sink buffers for sorting when the insert table
+  // handle has sort columns. Each sorted batch is written as at least one
+  // stripe, so a smaller buffer gives more stripes with wider stats.
+  static constexpr const char* kSortedWriteBufferSize =
+      "sorted_write_buffer_size";
+  static constexpr uint64_t kSortedWriteBufferSizeDefault = 64UL << 20;
+
+  // Connector property for the most memory in bytes that the decoded
+  // columns of recently read stripes may take. 0, the default, disables
+  // the cache.
+  static constexpr const char* kDecodedStripeCacheBytes =
+      "decoded_stripe_cache_bytes";
+
+  // Returns the cache of decoded stripe columns shared by the data sources
+  // of 'this', or nullptr if kDecodedStripeCacheBytes is 0.
+  dwrf::DecodedStripeCache* decodedStripeCache() const {
+    return decodedStripeCache_.get();
+  }
+
  private:
   std::unique_ptr<DataCache> dataCache_;
+  std::unique_ptr<dwrf::DecodedStripeCache> decodedStripeCache_;
   FileHandleFactory fileHandleFactory_;
 
   static constexpr const char* kNodeSelectionStrategy =
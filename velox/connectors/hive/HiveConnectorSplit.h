@@ -17,9 +17,14 @@
 
 #include <optional>
 #include <unordered_map>
+#include "velox/common/future/AsyncSource.h"
 #include "velox/dwio/common/Options.h"
 #include "velox/exec/Operator.h"
 
+namespace facebook::velox::dwrf {
+struct FileTail;
+} // namespace facebook::velox::dwrf
+
 namespace facebook::velox::connector::hive {
 
 const std::string kHiveConnectorName = "hive";
@@ -31,6 +36,13 @@ struct HiveConnectorSplit : public connector::ConnectorSplit {
   const uint64_t length;
   const std::unordered_map<std::string, std::string> partitionKeys;
   std::optional<int32_t> tableBucketNumber;
+  // The tail of the file, read by the HiveDataSource that divided the
+  // split this split is a part of. Null for splits not made by dividing
+  // another split.
+  std::shared_ptr<const dwrf::FileTail> fileTail;
+  // The tail of the file, read ahead of addSplit() on the executor of the
+  // query while the split is queued. Set by HiveDataSource::preloadSplit().
+  std::shared_ptr<AsyncSource<dwrf::FileTail>> preloadedTail;
 
   HiveConnectorSplit(
       const std::string& connectorId,
@@ -175,6 +175,31 @@ class QueryCtx : public Context {
     return get<bool>(kExprEvalSimplified, false);
   }
 
+  bool exprResultCacheEnabled() const {
+    return get<bool>(kExprResultCacheEnabled, false);
+  }
+
+  std::string hashJoinTableCacheKey() const {
+    return get<std::string>(kHashJoinTableCacheKey, "");
+  }
+
+  bool perfCountersEnabled() const {
+    return get<bool>(kPerfCountersEnabled, false);
+  }
+
+  int32_t maxSplitPreloadPerDriver() const {
+    return get<int32_t>(
+        kMaxSplitPreloadPerDriver, kMaxSplitPreloadPerDriverDefault);
+  }
+
+  bool traceEnabled() const {
+    return get<bool>(kTraceEnabled, false);
+  }
+
+  int32_t traceMaxEvents() const {
+    return get<int32_t>(kTraceMaxEvents, kTraceMaxEventsDefault);
+  }
+
   static constexpr const char* kCodegenEnabled = "driver.codegen.enabled";
   static constexpr const char* kCodegenConfigurationFilePath =
       "driver.codegen.configuration_file_path";
@@ -202,6 +227,45 @@ class QueryCtx : public Context {
   static constexpr const char* kExprEvalSimplified =
       "driver.expr_eval.simplified";
 
+  // If true, the results of deterministic expressions over the base vectors
+  // of dictionaries are shared between ExprSets, operators and queries
+  // through exec::ExprResultCache. False by default.
+  static constexpr const char* kExprResultCacheEnabled =
+      "driver.expr_result_cache_enabled";
+
+  // Identifies the data read by the build sides of the hash joins of the
+  // query, e.g. the snapshot of the tables and the splits they are read
+  // from. If set, build sides with the same plan and key share one hash
+  // table across queries through exec::HashJoinTableCache. Empty by
+  // default, which disables the sharing.
+  static constexpr const char* kHashJoinTableCacheKey =
+      "driver.hash_join_table_cache_key";
+
+  // If true, the hardware events (cycles, instructions, last level cache
+  // misses and branch misses) counted during the calls of the Driver into
+  // each operator are added to the runtime stats of the operator. Needs
+  // perf_event_open to be allowed. False by default.
+  static constexpr const char* kPerfCountersEnabled =
+      "driver.perf_counters_enabled";
+
+  // The number of queued splits per driver of a TableScan that the
+  // connector prepares, e.g. reads the file footers of, on the executor of
+  // the query while the drivers read other splits. The splits stay queued
+  // for any driver to take. 0 disables preloading. Has no effect if the
+  // query has no executor.
+  static constexpr const char* kMaxSplitPreloadPerDriver =
+      "max_split_preload_per_driver";
+  static constexpr int32_t kMaxSplitPreloadPerDriverDefault = 2;
+
+  // If true, each Task records when its Drivers are on thread, their calls
+  // into operators and the time they are blocked. See
+  // exec::Task::traceRecorder(). False by default.
+  static constexpr const char* kTraceEnabled = "driver.trace_enabled";
+
+  // The number of most recent events kept by the trace of a Task.
+  static constexpr const char* kTraceMaxEvents = "driver.trace_max_events";
+  static constexpr int32_t kTraceMaxEventsDefault = 64 * 1024;
+
   // Flags used to configure the CAST operator:
 
   // This flag makes the Row conversion to by applied
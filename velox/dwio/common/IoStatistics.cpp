@@ -43,6 +43,18 @@ uint64_t IoStatistics::outputBatchSize() const {
   return outputBatchSize_.load(std::memory_order_relaxed);
 }
 
+uint64_t IoStatistics::mergedRegions() const {
+  return mergedRegions_.load(std::memory_order_relaxed);
+}
+
+uint64_t IoStatistics::splitRegions() const {
+  return splitRegions_.load(std::memory_order_relaxed);
+}
+
+uint64_t IoStatistics::gapPrefetchBytes() const {
+  return gapPrefetchBytes_.load(std::memory_order_relaxed);
+}
+
 uint64_t IoStatistics::incRawBytesRead(int64_t v) {
   return rawBytesRead_.fetch_add(v, std::memory_order_relaxed);
 }
@@ -63,6 +75,18 @@ uint64_t IoStatistics::incRawOverreadBytes(int64_t v) {
   return rawOverreadBytes_.fetch_add(v, std::memory_order_relaxed);
 }
 
+uint64_t IoStatistics::incMergedRegions(int64_t v) {
+  return mergedRegions_.fetch_add(v, std::memory_order_relaxed);
+}
+
+uint64_t IoStatistics::incSplitRegions(int64_t v) {
+  return splitRegions_.fetch_add(v, std::memory_order_relaxed);
+}
+
+uint64_t IoStatistics::incGapPrefetchBytes(int64_t v) {
+  return gapPrefetchBytes_.fetch_add(v, std::memory_order_relaxed);
+}
+
 void IoStatistics::incOperationCounters(
     const std::string& operation,
     const uint64_t resourceThrottleCount,
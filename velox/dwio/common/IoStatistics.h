@@ -43,12 +43,23 @@ class IoStatistics {
   uint64_t rawBytesWritten() const;
   uint64_t inputBatchSize() const;
   uint64_t outputBatchSize() const;
+  // Counts of IO coalescing decisions. A merged region is read in the
+  // same IO as the preceding region, a split region would have been
+  // merged but starts a new IO to bound the IO size. Gap prefetch bytes
+  // are of seldom read streams that are cached because they fall in the
+  // gap of a merged IO.
+  uint64_t mergedRegions() const;
+  uint64_t splitRegions() const;
+  uint64_t gapPrefetchBytes() const;
 
   uint64_t incRawBytesRead(int64_t);
   uint64_t incRawOverreadBytes(int64_t);
   uint64_t incRawBytesWritten(int64_t);
   uint64_t incInputBatchSize(int64_t);
   uint64_t incOutputBatchSize(int64_t);
+  uint64_t incMergedRegions(int64_t);
+  uint64_t incSplitRegions(int64_t);
+  uint64_t incGapPrefetchBytes(int64_t);
 
   void incOperationCounters(
       const std::string& operation,
@@ -67,6 +78,9 @@ class IoStatistics {
   std::atomic<uint64_t> inputBatchSize_{0};
   std::atomic<uint64_t> outputBatchSize_{0};
   std::atomic<uint64_t> rawOverreadBytes_{0};
+  std::atomic<uint64_t> mergedRegions_{0};
+  std::atomic<uint64_t> splitRegions_{0};
+  std::atomic<uint64_t> gapPrefetchBytes_{0};
 
   std::unordered_map<std::string, OperationCounters> operationStats_;
   mutable std::mutex operationStatsMutex_;
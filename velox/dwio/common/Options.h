@@ -29,6 +29,7 @@
 namespace facebook::velox::dwrf {
 class BufferedInputFactory;
 class ColumnReaderFactory;
+class DecodedStripeCache;
 } // namespace facebook::velox::dwrf
 
 namespace facebook {
@@ -94,6 +95,8 @@ class RowReaderOptions {
   std::shared_ptr<ColumnSelector> selector_;
   velox::dwrf::ColumnReaderFactory* columnReaderFactory_ = nullptr;
   std::unordered_set<uint32_t> flatmapNodeIdAsStruct_;
+  velox::dwrf::DecodedStripeCache* decodedStripeCache_ = nullptr;
+  uint64_t decodedStripeCacheFileNum_ = 0;
 
  public:
   RowReaderOptions(const RowReaderOptions& other) {
@@ -106,6 +109,8 @@ class RowReaderOptions {
     columnReaderFactory_ = other.columnReaderFactory_;
     returnFlatVector_ = other.returnFlatVector_;
     flatmapNodeIdAsStruct_ = other.flatmapNodeIdAsStruct_;
+    decodedStripeCache_ = other.decodedStripeCache_;
+    decodedStripeCacheFileNum_ = other.decodedStripeCacheFileNum_;
   }
 
   RowReaderOptions() noexcept
@@ -232,6 +237,23 @@ class RowReaderOptions {
     columnReaderFactory_ = factory;
   }
 
+  // Sets a cache of decoded stripe columns for the selective column
+  // readers. 'fileNum' identifies the file in the cache keys.
+  void setDecodedStripeCache(
+      velox::dwrf::DecodedStripeCache* cache,
+      uint64_t fileNum) {
+    decodedStripeCache_ = cache;
+    decodedStripeCacheFileNum_ = fileNum;
+  }
+
+  velox::dwrf::DecodedStripeCache* getDecodedStripeCache() const {
+    return decodedStripeCache_;
+  }
+
+  uint64_t getDecodedStripeCacheFileNum() const {
+    return decodedStripeCacheFileNum_;
+  }
+
   void setFlatmapNodeIdsAsStruct(
       std::unordered_set<uint32_t> flatmapNodeIdsAsStruct) {
     flatmapNodeIdAsStruct_ = std::move(flatmapNodeIdsAsStruct);
@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/lang/Bits.h>
+
+#include <cstdint>
+
+namespace facebook::velox::dwrf {
+
+// Unpacking of big-endian bit-packed integers as written by ORC RLEv2
+// DIRECT and PATCHED_BASE runs. Bits are numbered from the most
+// significant bit of the first byte. Value i of a run of 'width' bit
+// values starts at bit i * width.
+//
+// The kernels take an optional row list. If 'rows' is non-null,
+// result[i] is the value at position rows[i], else result[i] is the
+// value at position i. 'rows' must be ascending. The kernels never
+// read at or past 'end'.
+
+// Returns the 'width' bit value starting at bit 'bit' of 'input'. 'width'
+// is 1 to 64.
+inline uint64_t extractBitsBE(
+    const char* input,
+    const char* end,
+    uint64_t bit,
+    int32_t width) {
+  const char* byte = input + (bit >> 3);
+  const int32_t shift = bit & 7;
+  uint64_t word;
+  if (end - byte >= 8) {
+    word = __builtin_bswap64(folly::loadUnaligned<uint64_t>(byte));
+  } else {
+    word = 0;
+    for (int32_t i = 0; i < 8; ++i) {
+      word = (word << 8) |
+          (byte + i < end ? static_cast<uint8_t>(byte[i]) : 0);
+    }
+  }
+  word <<= shift;
+  if (width + shift > 64) {
+    // A value wider than 56 bits may extend into a ninth byte.
+    word |= static_cast<uint8_t>(byte[8]) >> (8 - shift);
+  }
+  return word >> (64 - width);
+}
+
+inline uint64_t zigzagDecodeBits(uint64_t value) {
+  return (value >> 1) ^ (~(value & 1) + 1);
+}
+
+// Unpacks 'numValues' values of 'width' bits starting at bit 'bitOffset' of
+// 'input', one 8 byte load per value.
+template <bool kZigZag, typename T>
+inline void unpackBitsScalar(
+    const char* input,
+    const char* end,
+    uint64_t bitOffset,
+    int32_t width,
+    const int32_t* rows,
+    int32_t numValues,
+    T* result) {
+  for (int32_t i = 0; i < numValues; ++i) {
+    const uint64_t row = rows ? rows[i] : i;
+    auto value = extractBitsBE(input, end, bitOffset + row * width, width);
+    if (kZigZag) {
+      value = zigzagDecodeBits(value);
+    }
+    result[i] = static_cast<T>(value);
+  }
+}
+
+// Unpacks with a constant width, which lets the compiler fold the shifts
+// and masks of extractBitsBE().
+template <int32_t kWidth, bool kZigZag, typename T>
+inline void unpackBitsFixed(
+    const char* input,
+    const char* end,
+    uint64_t bitOffset,
+    const int32_t* rows,
+    int32_t numValues,
+    T* result) {
+  unpackBitsScalar<kZigZag>(
+      input, end, bitOffset, kWidth, rows, numValues, result);
+}
+
+// Unpacks 'numValues' values of 'bitWidth' bits from 'input' into
+// 'result', selecting the kernel specialized for 'bitWidth'. All widths
+// that RLEv2 can encode have a specialization.
+template <bool kZigZag, typename T>
+void unpackBits(
+    const char* input,
+    const char* end,
+    uint64_t bitOffset,
+    int32_t bitWidth,
+    const int32_t* rows,
+    int32_t numValues,
+    T* result) {
+#define VELOX_UNPACK_WIDTH(width)                        \
+  case width:                                            \
+    unpackBitsFixed<width, kZigZag>(                     \
+        input, end, bitOffset, rows, numValues, result); \
+    return;
+
+  switch (bitWidth) {
+    VELOX_UNPACK_WIDTH(1)
+    VELOX_UNPACK_WIDTH(2)
+    VELOX_UNPACK_WIDTH(3)
+    VELOX_UNPACK_WIDTH(4)
+    VELOX_UNPACK_WIDTH(5)
+    VELOX_UNPACK_WIDTH(6)
+    VELOX_UNPACK_WIDTH(7)
+    VELOX_UNPACK_WIDTH(8)
+    VELOX_UNPACK_WIDTH(9)
+    VELOX_UNPACK_WIDTH(10)
+    VELOX_UNPACK_WIDTH(11)
+    VELOX_UNPACK_WIDTH(12)
+    VELOX_UNPACK_WIDTH(13)
+    VELOX_UNPACK_WIDTH(14)
+    VELOX_UNPACK_WIDTH(15)
+    VELOX_UNPACK_WIDTH(16)
+    VELOX_UNPACK_WIDTH(17)
+    VELOX_UNPACK_WIDTH(18)
+    VELOX_UNPACK_WIDTH(19)
+    VELOX_UNPACK_WIDTH(20)
+    VELOX_UNPACK_WIDTH(21)
+    VELOX_UNPACK_WIDTH(22)
+    VELOX_UNPACK_WIDTH(23)
+    VELOX_UNPACK_WIDTH(24)
+    VELOX_UNPACK_WIDTH(26)
+    VELOX_UNPACK_WIDTH(28)
+    VELOX_UNPACK_WIDTH(30)
+    VELOX_UNPACK_WIDTH(32)
+    VELOX_UNPACK_WIDTH(40)
+    VELOX_UNPACK_WIDTH(48)
+    VELOX_UNPACK_WIDTH(56)
+    VELOX_UNPACK_WIDTH(64)
+    default:
+      unpackBitsScalar<kZigZag>(
+          input, end, bitOffset, bitWidth, rows, numValues, result);
+  }
+#undef VELOX_UNPACK_WIDTH
+}
+
+} // namespace facebook::velox::dwrf
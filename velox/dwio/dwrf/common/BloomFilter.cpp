@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/dwrf/common/BloomFilter.h"
+
+#include <folly/lang/Bits.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "velox/dwio/common/exception/Exception.h"
+
+namespace facebook::velox::dwrf {
+
+namespace {
+
+constexpr uint64_t kMurmurC1 = 0x87c37b91114253d5UL;
+constexpr uint64_t kMurmurC2 = 0x4cf5ad432745937fUL;
+constexpr uint64_t kMurmurSeed = 104729;
+
+inline uint64_t rotateLeft(uint64_t value, int32_t shift) {
+  return (value << shift) | (value >> (64 - shift));
+}
+
+// Arithmetic right shift.
+inline uint64_t shiftRightSigned(uint64_t value, int32_t shift) {
+  return static_cast<uint64_t>(static_cast<int64_t>(value) >> shift);
+}
+
+inline uint64_t mixMurmurBlock(uint64_t k) {
+  k *= kMurmurC1;
+  k = rotateLeft(k, 31);
+  return k * kMurmurC2;
+}
+
+inline uint64_t finalizeMurmur(uint64_t hash) {
+  hash ^= hash >> 33;
+  hash *= 0xff51afd7ed558ccdUL;
+  hash ^= hash >> 33;
+  hash *= 0xc4ceb9fe1a85ec53UL;
+  hash ^= hash >> 33;
+  return hash;
+}
+
+} // namespace
+
+BloomFilter::BloomFilter(uint64_t expectedEntries, double fpp) {
+  DWIO_ENSURE(fpp > 0.0 && fpp < 1.0, "Invalid bloom filter fpp ", fpp);
+  const auto numEntries =
+      static_cast<double>(std::max<uint64_t>(expectedEntries, 1));
+  auto numBits = static_cast<uint64_t>(
+      -numEntries * std::log(fpp) / (std::log(2.0) * std::log(2.0)));
+  // Rounds up to whole words. As in ORC, a whole number of words gets one
+  // more.
+  numBits += 64 - numBits % 64;
+  bits_.resize(numBits / 64);
+  numHashFunctions_ = std::max<int32_t>(
+      1,
+      static_cast<int32_t>(std::round(
+          static_cast<double>(numBits) / numEntries * std::log(2.0))));
+}
+
+BloomFilter::BloomFilter(const proto::BloomFilter& bloomFilter)
+    : numHashFunctions_(bloomFilter.numhashfunctions()) {
+  if (bloomFilter.has_utf8bitset()) {
+    const auto& bytes = bloomFilter.utf8bitset();
+    DWIO_ENSURE(
+        bytes.size() % sizeof(uint64_t) == 0, "Corrupt bloom filter bitset");
+    // The words are little endian.
+    bits_.resize(bytes.size() / sizeof(uint64_t));
+    memcpy(bits_.data(), bytes.data(), bytes.size());
+  } else {
+    bits_.assign(bloomFilter.bitset().begin(), bloomFilter.bitset().end());
+  }
+  DWIO_ENSURE(
+      !bits_.empty() && numHashFunctions_ > 0, "Corrupt bloom filter");
+}
+
+void BloomFilter::reset() {
+  std::fill(bits_.begin(), bits_.end(), 0);
+}
+
+void BloomFilter::toProto(proto::BloomFilter& bloomFilter) const {
+  bloomFilter.set_numhashfunctions(numHashFunctions_);
+  bloomFilter.set_utf8bitset(
+      reinterpret_cast<const char*>(bits_.data()),
+      bits_.size() * sizeof(uint64_t));
+}
+
+// static
+uint64_t BloomFilter::hashLong(int64_t value) {
+  auto key = static_cast<uint64_t>(value);
+  key = ~key + (key << 21);
+  key = key ^ shiftRightSigned(key, 24);
+  key = key + (key << 3) + (key << 8);
+  key = key ^ shiftRightSigned(key, 14);
+  key = key + (key << 2) + (key << 4);
+  key = key ^ shiftRightSigned(key, 28);
+  key = key + (key << 31);
+  return key;
+}
+
+// static
+uint64_t BloomFilter::hashBytes(const char* data, int32_t size) {
+  uint64_t hash = kMurmurSeed;
+  const int32_t numBlocks = size / 8;
+  for (int32_t i = 0; i < numBlocks; ++i) {
+    hash ^= mixMurmurBlock(folly::Endian::little(
+        folly::loadUnaligned<uint64_t>(data + i * 8)));
+    hash = rotateLeft(hash, 27) * 5 + 0x52dce729;
+  }
+  const int32_t tailStart = numBlocks * 8;
+  if (tailStart < size) {
+    uint64_t tail = 0;
+    for (int32_t i = size - 1; i >= tailStart; --i) {
+      tail = (tail << 8) | static_cast<uint8_t>(data[i]);
+    }
+    hash ^= mixMurmurBlock(tail);
+  }
+  hash ^= size;
+  return finalizeMurmur(hash);
+}
+
+void BloomFilter::addHash(uint64_t hash) {
+  const auto hash1 = static_cast<uint32_t>(hash);
+  const auto hash2 = static_cast<uint32_t>(hash >> 32);
+  const auto numBits = this->numBits();
+  for (int32_t i = 1; i <= numHashFunctions_; ++i) {
+    auto combined = static_cast<int32_t>(hash1 + i * hash2);
+    if (combined < 0) {
+      combined = ~combined;
+    }
+    const auto bit = combined % numBits;
+    bits_[bit / 64] |= 1UL << (bit % 64);
+  }
+}
+
+bool BloomFilter::testHash(uint64_t hash) const {
+  const auto hash1 = static_cast<uint32_t>(hash);
+  const auto hash2 = static_cast<uint32_t>(hash >> 32);
+  const auto numBits = this->numBits();
+  for (int32_t i = 1; i <= numHashFunctions_; ++i) {
+    auto combined = static_cast<int32_t>(hash1 + i * hash2);
+    if (combined < 0) {
+      combined = ~combined;
+    }
+    const auto bit = combined % numBits;
+    if (!(bits_[bit / 64] & (1UL << (bit % 64)))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace facebook::velox::dwrf
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/dwio/dwrf/common/wrap/dwrf-proto-wrapper.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace facebook::velox::dwrf {
+
+// Bloom filter over the values of one row group, stored in the
+// BLOOM_FILTER_UTF8 stream. Hashing and bit layout follow the ORC bloom
+// filter: integers are hashed with Thomas Wang's 64 bit mix, strings with
+// Murmur3 and each value sets 'numHashFunctions' bits derived from the two
+// 32 bit halves of its hash.
+class BloomFilter {
+ public:
+  static constexpr double kDefaultFpp = 0.05;
+
+  // Makes an empty filter sized for 'expectedEntries' distinct values at
+  // a false positive probability of 'fpp'.
+  BloomFilter(uint64_t expectedEntries, double fpp);
+
+  // Makes a filter from its serialized form.
+  explicit BloomFilter(const proto::BloomFilter& bloomFilter);
+
+  void addLong(int64_t value) {
+    addHash(hashLong(value));
+  }
+
+  void addBytes(const char* data, int32_t size) {
+    addHash(hashBytes(data, size));
+  }
+
+  // Returns false if 'value' was definitely not added.
+  bool testLong(int64_t value) const {
+    return testHash(hashLong(value));
+  }
+
+  bool testBytes(const char* data, int32_t size) const {
+    return testHash(hashBytes(data, size));
+  }
+
+  // Clears all values while keeping the size.
+  void reset();
+
+  void toProto(proto::BloomFilter& bloomFilter) const;
+
+  uint64_t numBits() const {
+    return bits_.size() * 64;
+  }
+
+  int32_t numHashFunctions() const {
+    return numHashFunctions_;
+  }
+
+  static uint64_t hashLong(int64_t value);
+
+  static uint64_t hashBytes(const char* data, int32_t size);
+
+ private:
+  void addHash(uint64_t hash);
+
+  bool testHash(uint64_t hash) const;
+
+  std::vector<uint64_t> bits_;
+  int32_t numHashFunctions_;
+};
+
+} // namespace facebook::velox::dwrf
@@ -15,6 +15,7 @@
  */
 
 #include "velox/dwio/dwrf/common/CachedBufferedInput.h"
+#include "velox/common/time/Timer.h"
 #include "velox/dwio/dwrf/common/CacheInputStream.h"
 
 namespace facebook::velox::dwrf {
@@ -72,26 +73,46 @@ bool CachedBufferedInput::shouldPreload() {
   return false;
 }
 
+bool CachedBufferedInput::makePin(CacheRequest& request) {
+  request.pin = cache_->findOrCreate(request.key, request.size, nullptr);
+  if (request.pin.empty()) {
+    // Already loading for another thread.
+    return false;
+  }
+  if (request.pin.entry()->isExclusive()) {
+    // A new entry to be filled.
+    request.pin.entry()->setPrefetch();
+    return true;
+  }
+  // Already in cache, access time is refreshed.
+  request.pin.clear();
+  return false;
+}
+
 void CachedBufferedInput::load(const dwio::common::LogType) {
   std::vector<CacheRequest*> toLoad;
+  // Requests for streams that are seldom read. These are loaded only if
+  // they fall in the gap between two regions that are read in one IO.
+  std::vector<CacheRequest*> seldomRead;
   // 'requests_ is cleared on exit.
   int32_t numNewLoads = 0;
   auto requests = std::move(requests_);
+  std::vector<CacheRequest*> sorted;
+  sorted.reserve(requests.size());
   for (auto& request : requests) {
-    if (tracker_->shouldPrefetch(request.trackingId, 3)) {
-      request.pin = cache_->findOrCreate(request.key, request.size, nullptr);
-      if (request.pin.empty()) {
-        // Already loading for another thread.
-        continue;
-      }
-      if (request.pin.entry()->isExclusive()) {
-        // A new entry to be filled.
-        request.pin.entry()->setPrefetch();
-        toLoad.push_back(&request);
-      } else {
-        // Already in cache, access time is refreshed.
-        request.pin.clear();
-      }
+    sorted.push_back(&request);
+  }
+  std::sort(
+      sorted.begin(),
+      sorted.end(),
+      [&](const CacheRequest* left, const CacheRequest* right) {
+        return left->key.offset < right->key.offset;
+      });
+  for (auto* request : sorted) {
+    if (!tracker_->shouldPrefetch(request->trackingId, kMinReadPct)) {
+      seldomRead.push_back(request);
+    } else if (makePin(*request)) {
+      toLoad.push_back(request);
     }
   }
   if (toLoad.empty()) {
@@ -101,15 +122,15 @@ void CachedBufferedInput::load(const dwio::common::LogType) {
   if (toLoad.empty()) {
     return;
   }
-  std::sort(
-      toLoad.begin(),
-      toLoad.end(),
-      [&](const CacheRequest* left, const CacheRequest* right) {
-        return left->key.offset < right->key.offset;
-      });
+  // The gap worth reading over depends on the latency and throughput of
+  // the storage, e.g. a few hundred KB for local SSD and MBs for object
+  // stores.
+  const auto mergeDistance = tracker_->mergeDistance(kMaxMergeDistance);
+  auto* stats = input_.getStats();
   // Combine adjacent short reads.
   dwio::common::Region last = {0, 0};
   std::vector<CachePin> readBatch;
+  auto nextSeldom = seldomRead.begin();
 
   for (const auto& request : toLoad) {
     auto* entry = request->pin.entry();
@@ -117,13 +138,38 @@ void CachedBufferedInput::load(const dwio::common::LogType) {
         static_cast<uint64_t>(entry->offset()),
         static_cast<uint64_t>(entry->size())};
     VELOX_CHECK_LT(0, entryRegion.length);
+    const auto gapStart = last.offset + last.length;
+    bool split = false;
     if (last.length == 0) {
       // first region
       last = entryRegion;
-    } else if (!tryMerge(last, entryRegion)) {
+    } else if (!tryMerge(last, entryRegion, mergeDistance, split)) {
+      if (split && stats) {
+        stats->incSplitRegions(1);
+      }
       ++numNewLoads;
       readRegion(std::move(readBatch));
+      readBatch.clear();
       last = entryRegion;
+    } else {
+      if (stats) {
+        stats->incMergedRegions(1);
+      }
+      // The gap is read anyway, so seldom read streams that are entirely
+      // in the gap are cached at no extra IO.
+      for (; nextSeldom != seldomRead.end(); ++nextSeldom) {
+        auto* seldom = *nextSeldom;
+        if (seldom->key.offset + seldom->size > entryRegion.offset) {
+          break;
+        }
+        if (seldom->key.offset >= gapStart && seldom->size > 0 &&
+            makePin(*seldom)) {
+          if (stats) {
+            stats->incGapPrefetchBytes(seldom->size);
+          }
+          readBatch.push_back(std::move(seldom->pin));
+        }
+      }
     }
     readBatch.push_back(std::move(request->pin));
   }
@@ -141,7 +187,9 @@ void CachedBufferedInput::load(const dwio::common::LogType) {
 
 bool CachedBufferedInput::tryMerge(
     dwio::common::Region& first,
-    const dwio::common::Region& second) {
+    const dwio::common::Region& second,
+    uint64_t mergeDistance,
+    bool& split) {
   DWIO_ENSURE_GE(second.offset, first.offset, "regions should be sorted.");
   int64_t gap = second.offset - first.offset - first.length;
   if (gap < 0) {
@@ -149,8 +197,12 @@ bool CachedBufferedInput::tryMerge(
     return false;
   }
   // compare with 0 since it's comparison in different types
-  if (gap <= kMaxMergeDistance) {
+  if (static_cast<uint64_t>(gap) <= mergeDistance) {
     int64_t extension = gap + second.length;
+    if (first.length + extension > kMaxCoalescedBytes) {
+      split = true;
+      return false;
+    }
 
     if (extension > 0) {
       first.length += extension;
@@ -170,8 +222,10 @@ class DwrfFusedLoad : public cache::FusedLoad {
  public:
   void initialize(
       std::vector<CachePin>&& pins,
-      std::unique_ptr<AbstractInputStreamHolder> input) {
+      std::unique_ptr<AbstractInputStreamHolder> input,
+      std::shared_ptr<ScanTracker> tracker) {
     input_ = std::move(input);
+    tracker_ = std::move(tracker);
     cache::FusedLoad::initialize(std::move(pins));
   }
 
@@ -206,17 +260,26 @@ class DwrfFusedLoad : public cache::FusedLoad {
       lastOffset = startOffset + size;
     }
 
-    stream.read(buffers, start, dwio::common::LogType::FILE);
+    uint64_t micros = 0;
+    {
+      MicrosecondTimer timer(&micros);
+      stream.read(buffers, start, dwio::common::LogType::FILE);
+    }
+    if (tracker_) {
+      tracker_->recordIo(lastOffset - start, micros);
+    }
   }
 
  private:
   std::unique_ptr<AbstractInputStreamHolder> input_;
+  // Receives the size and time of the IO for the latency model.
+  std::shared_ptr<ScanTracker> tracker_;
 };
 } // namespace
 
 void CachedBufferedInput::readRegion(std::vector<CachePin> pins) {
   auto load = std::make_shared<DwrfFusedLoad>();
-  load->initialize(std::move(pins), streamSource_());
+  load->initialize(std::move(pins), streamSource_(), tracker_);
   fusedLoads_.push_back(load);
 }
 
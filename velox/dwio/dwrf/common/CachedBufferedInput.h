@@ -44,6 +44,15 @@ using StreamSource =
 
 class CachedBufferedInput : public BufferedInput {
  public:
+  // Streams read less often than this percentage of the times they are
+  // referenced are not prefetched unless they fall in the gap of a
+  // coalesced IO.
+  static constexpr int32_t kMinReadPct = 3;
+
+  // Regions are not merged into an IO larger than this, so that large
+  // loads are split into IOs that can run in parallel.
+  static constexpr uint64_t kMaxCoalescedBytes = 32 << 20;
+
   CachedBufferedInput(
       dwio::common::InputStream& input,
       memory::MemoryPool& pool,
@@ -94,11 +103,18 @@ class CachedBufferedInput : public BufferedInput {
     cache::CachePin pin;
   };
 
+  // Creates the cache entry for 'request'. Returns true if the entry is
+  // new and needs to be loaded.
+  bool makePin(CacheRequest& request);
+
   // Updates first  to include second if they are near enough to justify merging
-  // the IO.
+  // the IO. 'mergeDistance' is the largest gap to read over. Sets 'split'
+  // if the regions are near enough but the result would be too large.
   bool tryMerge(
       dwio::common::Region& first,
-      const dwio::common::Region& second);
+      const dwio::common::Region& second,
+      uint64_t mergeDistance,
+      bool& split);
 
   // Schedules 'pins' to be read in a single IO covering
   // 'region'. 'pins are sorted and non-overlapping and do not have
@@ -82,6 +82,12 @@ enum StreamKind {
  */
 std::string streamKindToString(StreamKind kind);
 
+// Returns true for streams that are written to the index section of a
+// stripe, ahead of the data streams.
+inline bool isIndexStream(StreamKind kind) {
+  return kind == StreamKind_ROW_INDEX || kind == StreamKind_BLOOM_FILTER_UTF8;
+}
+
 class StreamInformation {
  public:
   virtual ~StreamInformation() = default;
@@ -105,6 +105,8 @@ class Config {
   static Entry<bool> MAP_FLAT_DICT_SHARE;
   static Entry<const std::vector<uint32_t>> MAP_FLAT_COLS;
   static Entry<uint32_t> MAP_FLAT_MAX_KEYS;
+  static Entry<const std::vector<uint32_t>> BLOOM_FILTER_COLS;
+  static Entry<float> BLOOM_FILTER_FPP;
   static Entry<uint64_t> MAX_DICTIONARY_SIZE;
   static Entry<uint64_t> STRIPE_SIZE;
   // With this config, we don't even try the more memory intensive encodings
@@ -117,6 +117,45 @@ int64_t RleDecoderV2<isSigned>::readLongBE(uint64_t bsz) {
   return ret;
 }
 
+template <bool isSigned>
+void RleDecoderV2<isSigned>::readPackedBytes(uint64_t numBytes) {
+  auto& bufferStart = IntDecoder<isSigned>::bufferStart;
+  auto& bufferEnd = IntDecoder<isSigned>::bufferEnd;
+  if (static_cast<uint64_t>(bufferEnd - bufferStart) >= numBytes) {
+    packedRun = bufferStart;
+    packedRunEnd = bufferStart + numBytes;
+    bufferStart += numBytes;
+    return;
+  }
+  packedRunCopy.resize(numBytes);
+  char* copy = packedRunCopy.data();
+  uint64_t numCopied = 0;
+  while (numCopied < numBytes) {
+    if (bufferStart == bufferEnd) {
+      // Loads the next buffer.
+      copy[numCopied++] = readByte();
+      continue;
+    }
+    auto numToCopy =
+        std::min<uint64_t>(bufferEnd - bufferStart, numBytes - numCopied);
+    memcpy(copy + numCopied, bufferStart, numToCopy);
+    bufferStart += numToCopy;
+    numCopied += numToCopy;
+  }
+  packedRun = copy;
+  packedRunEnd = copy + numBytes;
+}
+
+template <bool isSigned>
+void RleDecoderV2<isSigned>::readPackedLongs(
+    int64_t* data,
+    uint64_t numValues,
+    uint32_t width) {
+  readPackedBytes(bits::nbytes(numValues * width));
+  unpackBits<false>(
+      packedRun, packedRunEnd, 0, width, nullptr, numValues, data);
+}
+
 template <bool isSigned>
 RleDecoderV2<isSigned>::RleDecoderV2(
     std::unique_ptr<SeekableInputStream> input,
@@ -141,7 +180,10 @@ RleDecoderV2<isSigned>::RleDecoderV2(
       patchMask(0),
       actualGap(0),
       unpacked(pool, 0),
-      unpackedPatch(pool, 0) {
+      unpackedPatch(pool, 0),
+      packedRun(nullptr),
+      packedRunEnd(nullptr),
+      packedRunCopy(pool, 0) {
   // PASS
 }
 
@@ -168,14 +210,26 @@ template void RleDecoderV2<false>::seekToRowGroup(PositionProvider& location);
 
 template <bool isSigned>
 void RleDecoderV2<isSigned>::skip(uint64_t numValues) {
-  // simple for now, until perf tests indicate something encoding specific is
-  // needed
   const uint64_t N = 64;
   int64_t dummy[N];
 
   while (numValues) {
-    uint64_t nRead = std::min(N, numValues);
-    next(dummy, nRead, nullptr);
+    if (runRead == runLength) {
+      // Starts the next run.
+      next(dummy, 1, nullptr);
+      --numValues;
+      continue;
+    }
+    uint64_t nRead = std::min(numValues, runLength - runRead);
+    auto enc = encoding();
+    if (enc == DIRECT || enc == SHORT_REPEAT) {
+      // Values of these runs are independent of each other and need not
+      // be decoded.
+      runRead += nRead;
+    } else {
+      nRead = std::min(N, nRead);
+      next(dummy, nRead, nullptr);
+    }
     numValues -= nRead;
   }
 }
@@ -305,22 +359,31 @@ uint64_t RleDecoderV2<isSigned>::nextDirect(
     // runs are one off
     runLength += 1;
     runRead = 0;
+
+    readPackedBytes(bits::nbytes(runLength * bitSize));
   }
 
   uint64_t nRead = std::min(runLength - runRead, numValues);
-
-  runRead += readLongs(data, offset, nRead, bitSize, nulls);
-
-  if (isSigned) {
-    if (nulls) {
-      for (uint64_t pos = offset; pos < offset + nRead; ++pos) {
-        if (!bits::isBitNull(nulls, pos)) {
-          data[pos] = ZigZag::decode(static_cast<uint64_t>(data[pos]));
-        }
-      }
-    } else {
-      for (uint64_t pos = offset; pos < offset + nRead; ++pos) {
-        data[pos] = ZigZag::decode(static_cast<uint64_t>(data[pos]));
+  uint64_t numNonNull =
+      nulls ? bits::countNonNulls(nulls, offset, offset + nRead) : nRead;
+
+  unpackBits<isSigned>(
+      packedRun,
+      packedRunEnd,
+      runRead * bitSize,
+      bitSize,
+      nullptr,
+      numNonNull,
+      data + offset);
+  runRead += numNonNull;
+
+  if (numNonNull < nRead) {
+    // Moves the values to their non-null positions, last first so that
+    // no value is overwritten before it is moved.
+    int64_t source = numNonNull;
+    for (int64_t pos = offset + nRead - 1; source > 0; --pos) {
+      if (!bits::isBitNull(nulls, pos)) {
+        data[pos] = data[offset + --source];
       }
     }
   }
@@ -393,9 +456,7 @@ uint64_t RleDecoderV2<isSigned>::nextPatched(
     // TODO: something more efficient than resize
     unpacked.resize(runLength);
     unpackedIdx = 0;
-    readLongs(unpacked.data(), 0, runLength, bitSize);
-    // any remaining bits are thrown out
-    resetReadLongs();
+    readPackedLongs(unpacked.data(), runLength, bitSize);
 
     // TODO: something more efficient than resize
     unpackedPatch.resize(pl);
@@ -408,9 +469,7 @@ uint64_t RleDecoderV2<isSigned>::nextPatched(
         "Corrupt PATCHED_BASE encoded data (patchBitSize + pgw > 64)! ",
         IntDecoder<isSigned>::inputStream->getName());
     uint32_t cfb = getClosestFixedBits(patchBitSize + pgw);
-    readLongs(unpackedPatch.data(), 0, pl, cfb);
-    // any remaining bits are thrown out
-    resetReadLongs();
+    readPackedLongs(unpackedPatch.data(), pl, cfb);
 
     // apply the patch directly when decoding the packed data
     patchMask = ((static_cast<int64_t>(1) << patchBitSize) - 1);
@@ -21,6 +21,7 @@
 #include "velox/dwio/common/DataBuffer.h"
 #include "velox/dwio/common/exception/Exception.h"
 #include "velox/dwio/dwrf/common/Adaptor.h"
+#include "velox/dwio/dwrf/common/BitPackDecoder.h"
 #include "velox/dwio/dwrf/common/IntDecoder.h"
 
 #include <vector>
@@ -57,6 +58,10 @@ class RleDecoderV2 : public IntDecoder<isSigned> {
   void next(int64_t* data, uint64_t numValues, const uint64_t* nulls) override;
 
  private:
+  EncodingType encoding() const {
+    return static_cast<EncodingType>((firstByte >> 6) & 0x03);
+  }
+
   // Used by PATCHED_BASE
   void adjustGapAndPatch() {
     curGap = static_cast<uint64_t>(unpackedPatch[patchIdx]) >> patchBitSize;
@@ -106,6 +111,16 @@ class RleDecoderV2 : public IntDecoder<isSigned> {
   }
 
   int64_t readLongBE(uint64_t bsz);
+
+  // Points 'packedRun' and 'packedRunEnd' at the next 'numBytes' of
+  // input and advances past them. The bytes are copied to
+  // 'packedRunCopy' if they are not contiguous in the input.
+  void readPackedBytes(uint64_t numBytes);
+
+  // Unpacks 'numValues' byte aligned values of 'width' bits from the
+  // input into 'data'.
+  void readPackedLongs(int64_t* data, uint64_t numValues, uint32_t width);
+
   uint64_t readLongs(
       int64_t* data,
       uint64_t offset,
@@ -184,6 +199,11 @@ class RleDecoderV2 : public IntDecoder<isSigned> {
   int64_t actualGap; // Used by PATCHED_BASE
   dwio::common::DataBuffer<int64_t> unpacked; // Used by PATCHED_BASE
   dwio::common::DataBuffer<int64_t> unpackedPatch; // Used by PATCHED_BASE
+  // Bit-packed values of the current DIRECT run.
+  const char* packedRun;
+  const char* packedRunEnd;
+  // Holds packed values that straddle input buffers.
+  dwio::common::DataBuffer<char> packedRunCopy;
 };
 
 } // namespace facebook::velox::dwrf
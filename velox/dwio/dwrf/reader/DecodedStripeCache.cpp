@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/dwrf/reader/DecodedStripeCache.h"
+
+namespace facebook::velox::dwrf {
+
+DecodedStripeCache::DecodedStripeCache(int64_t maxBytes)
+    : pool_(memory::getProcessDefaultMemoryManager().getRoot().addScopedChild(
+          "DecodedStripeCache",
+          maxBytes)),
+      cache_(maxBytes) {}
+
+bool DecodedStripeCache::shouldCollect(int64_t bytes) {
+  if (bytes > cache_.maxSize() / kMaxEntryFraction) {
+    return false;
+  }
+  std::lock_guard<std::mutex> l(mutex_);
+  auto available = pool_->getCap() - pool_->getCurrentBytes();
+  if (available < bytes) {
+    // The evicted vectors are freed unless a reader still refers to them.
+    cache_.free(bytes - available);
+    available = pool_->getCap() - pool_->getCurrentBytes();
+  }
+  return available >= bytes;
+}
+
+VectorPtr DecodedStripeCache::get(const Key& key) {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto values = cache_.get(key);
+  if (!values) {
+    ++numMisses_;
+    return nullptr;
+  }
+  // The copy keeps the vector alive after the entry is released.
+  auto result = *values;
+  cache_.release(key);
+  ++numHits_;
+  return result;
+}
+
+void DecodedStripeCache::put(const Key& key, VectorPtr values) {
+  VELOX_CHECK(values->pool() == pool_.get());
+  auto size = values->retainedSize();
+  auto entry = std::make_unique<VectorPtr>(std::move(values));
+  std::lock_guard<std::mutex> l(mutex_);
+  if (cache_.add(key, entry.get(), size)) {
+    entry.release();
+  }
+}
+
+} // namespace facebook::velox::dwrf
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <mutex>
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/common/caching/SimpleLRUCache.h"
+#include "velox/common/memory/Memory.h"
+#include "velox/vector/BaseVector.h"
+
+namespace facebook::velox::dwrf {
+
+// Caches decoded columns of whole stripes as flat vectors, keyed on file,
+// stripe and column. Where AsyncDataCache and DataCache keep the encoded
+// bytes, this also saves decompressing and decoding on repeated scans of
+// small, frequently read tables. Shared by the SelectiveColumnReaders of
+// all RowReaders that have it in their RowReaderOptions. Thread-safe.
+class DecodedStripeCache {
+ public:
+  struct Key {
+    // Identifies the file, e.g. the id of the file name in fileIds().
+    uint64_t fileNum;
+    uint32_t stripe;
+    // Id of the column in the file schema.
+    uint32_t node;
+
+    bool operator==(const Key& other) const {
+      return fileNum == other.fileNum && stripe == other.stripe &&
+          node == other.node;
+    }
+  };
+
+  // Makes a cache of at most 'maxBytes' of vectors. The vectors are
+  // allocated from a child of the process root memory pool capped at
+  // 'maxBytes', so that evicted vectors still referenced by readers and
+  // columns being collected count against the same limit.
+  explicit DecodedStripeCache(int64_t maxBytes);
+
+  // Returns the values for 'key' or nullptr if they are not cached. The
+  // result is shared with other readers and must not be modified. It stays
+  // valid after being evicted.
+  VectorPtr get(const Key& key);
+
+  // Adds 'values' for 'key' unless 'key' is already cached or 'values' do
+  // not fit. 'values' must be allocated from pool().
+  void put(const Key& key, VectorPtr values);
+
+  // Returns true if a column of about 'bytes' decoded is worth reading into
+  // the cache. A column over 1 / kMaxEntryFraction of the capacity would
+  // evict many others, if it fits at all. Evicts the least recently used
+  // entries if pool() has no room for 'bytes' more.
+  bool shouldCollect(int64_t bytes);
+
+  memory::MemoryPool* pool() const {
+    return pool_.get();
+  }
+
+  int64_t numHits() const {
+    return numHits_;
+  }
+
+  int64_t numMisses() const {
+    return numMisses_;
+  }
+
+  int64_t currentBytes() const {
+    std::lock_guard<std::mutex> l(mutex_);
+    return cache_.currentSize();
+  }
+
+ private:
+  static constexpr int64_t kMaxEntryFraction = 8;
+
+  struct KeyHasher {
+    size_t operator()(const Key& key) const {
+      return bits::hashMix(
+          bits::hashMix(std::hash<uint64_t>()(key.fileNum), key.stripe),
+          key.node);
+    }
+  };
+
+  mutable std::mutex mutex_;
+  // Declared before 'cache_' so that the cached vectors are freed first.
+  std::unique_ptr<memory::MemoryPool> pool_;
+  SimpleLRUCache<Key, VectorPtr, std::equal_to<Key>, KeyHasher> cache_;
+  std::atomic<int64_t> numHits_{0};
+  std::atomic<int64_t> numMisses_{0};
+};
+
+} // namespace facebook::velox::dwrf
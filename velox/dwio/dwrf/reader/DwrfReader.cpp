@@ -132,4 +132,12 @@ std::unique_ptr<DwrfReader> DwrfReader::create(
   return std::make_unique<DwrfReader>(options, std::move(stream));
 }
 
+std::unique_ptr<DwrfReader> DwrfReader::create(
+    std::unique_ptr<InputStream> stream,
+    const ReaderOptions& options,
+    std::shared_ptr<const FileTail> tail) {
+  return std::make_unique<DwrfReader>(
+      options, std::move(stream), std::move(tail));
+}
+
 } // namespace facebook::velox::dwrf
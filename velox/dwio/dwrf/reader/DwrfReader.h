@@ -89,6 +89,12 @@ class DwrfReader : public DwrfReaderShared {
       std::unique_ptr<dwio::common::InputStream> input)
       : DwrfReaderShared{options, std::move(input)} {}
 
+  DwrfReader(
+      const dwio::common::ReaderOptions& options,
+      std::unique_ptr<dwio::common::InputStream> input,
+      std::shared_ptr<const FileTail> tail)
+      : DwrfReaderShared{options, std::move(input), std::move(tail)} {}
+
   ~DwrfReader() override = default;
 
   std::unique_ptr<DwrfRowReader> createRowReader() const;
@@ -105,6 +111,15 @@ class DwrfReader : public DwrfReaderShared {
       std::unique_ptr<dwio::common::InputStream> stream,
       const dwio::common::ReaderOptions& options);
 
+  /**
+   * Create a reader for the dwrf file from the tail of the file read by
+   * another reader, e.g. one with another memory pool.
+   */
+  static std::unique_ptr<DwrfReader> create(
+      std::unique_ptr<dwio::common::InputStream> stream,
+      const dwio::common::ReaderOptions& options,
+      std::shared_ptr<const FileTail> tail);
+
   friend class E2EEncryptionTest;
 };
 
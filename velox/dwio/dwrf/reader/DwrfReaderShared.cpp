@@ -200,6 +200,21 @@ DwrfReaderShared::DwrfReaderShared(
           options.getDataCacheConfig().get())),
       options_(options) {}
 
+DwrfReaderShared::DwrfReaderShared(
+    const ReaderOptions& options,
+    std::unique_ptr<InputStream> input,
+    std::shared_ptr<const FileTail> tail)
+    : readerBase_(std::make_unique<ReaderBase>(
+          options.getMemoryPool(),
+          std::move(input),
+          std::move(tail),
+          options.getDecrypterFactory(),
+          options.getBufferedInputFactory()
+              ? options.getBufferedInputFactory()
+              : BufferedInputFactory::baseFactory(),
+          options.getDataCacheConfig().get())),
+      options_(options) {}
+
 std::unique_ptr<StripeInformation> DwrfReaderShared::getStripe(
     uint32_t stripeIndex) const {
   DWIO_ENSURE_LE(
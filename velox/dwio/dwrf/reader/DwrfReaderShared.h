@@ -137,6 +137,15 @@ class DwrfReaderShared {
       const dwio::common::ReaderOptions& options,
       std::unique_ptr<dwio::common::InputStream> input);
 
+  /**
+   * Constructor that takes the tail of the file from another reader
+   * instead of reading it from 'input'.
+   */
+  DwrfReaderShared(
+      const dwio::common::ReaderOptions& options,
+      std::unique_ptr<dwio::common::InputStream> input,
+      std::shared_ptr<const FileTail> tail);
+
   virtual ~DwrfReaderShared() = default;
 
   CompressionKind getCompression() const {
@@ -199,6 +208,10 @@ class DwrfReaderShared {
     return readerBase_->getFooter();
   }
 
+  std::unique_ptr<FileTail> getFileTail() const {
+    return readerBase_->getFileTail();
+  }
+
   static uint64_t getMemoryUse(
       ReaderBase& readerBase,
       int32_t stripeIx,
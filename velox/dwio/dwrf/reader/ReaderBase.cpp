@@ -216,6 +216,54 @@ ReaderBase::ReaderBase(
   handler_ = DecryptionHandler::create(*footer_, factory);
 }
 
+ReaderBase::ReaderBase(
+    MemoryPool& pool,
+    std::unique_ptr<InputStream> stream,
+    std::shared_ptr<const FileTail> tail,
+    DecrypterFactory* factory,
+    BufferedInputFactory* bufferedInputFactory,
+    dwio::common::DataCacheConfig* dataCacheConfig)
+    : pool_{pool},
+      stream_{std::move(stream)},
+      arena_(std::make_unique<google::protobuf::Arena>()),
+      postScript_{std::make_unique<proto::PostScript>(tail->postScript)},
+      footer_{tail->footer},
+      bufferedInputFactory_(bufferedInputFactory),
+      dataCacheConfig_(dataCacheConfig),
+      fileLength_{tail->fileLength},
+      psLength_{tail->psLength},
+      tail_{std::move(tail)} {
+  input_ = bufferedInputFactory_->create(*stream_, pool, dataCacheConfig);
+  schema_ = std::dynamic_pointer_cast<const RowType>(convertType(*footer_));
+  DWIO_ENSURE_NOT_NULL(schema_, "invalid schema");
+  if (!tail_->metadataCache.empty()) {
+    auto cacheBuffer = std::make_shared<dwio::common::DataBuffer<char>>(
+        pool, tail_->metadataCache.size());
+    memcpy(
+        cacheBuffer->data(),
+        tail_->metadataCache.data(),
+        tail_->metadataCache.size());
+    cache_ = std::make_unique<StripeMetadataCache>(
+        *postScript_, *footer_, std::move(cacheBuffer));
+  }
+  handler_ = DecryptionHandler::create(*footer_, factory);
+}
+
+std::unique_ptr<FileTail> ReaderBase::getFileTail() const {
+  auto tail = std::make_unique<FileTail>();
+  tail->postScript = *postScript_;
+  tail->arena = std::make_unique<google::protobuf::Arena>();
+  tail->footer =
+      google::protobuf::Arena::CreateMessage<proto::Footer>(tail->arena.get());
+  tail->footer->CopyFrom(*footer_);
+  if (cache_) {
+    tail->metadataCache.assign(cache_->data(), postScript_->cachesize());
+  }
+  tail->fileLength = fileLength_;
+  tail->psLength = psLength_;
+  return tail;
+}
+
 std::vector<uint64_t> ReaderBase::getRowsPerStripe() const {
   std::vector<uint64_t> rowsPerStripe;
   auto numStripes = getFooter().stripes_size();
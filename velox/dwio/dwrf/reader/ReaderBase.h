@@ -58,6 +58,22 @@ class FooterStatisticsImpl : public Statistics {
   }
 };
 
+// The post script, footer and stripe metadata cache of a file, in memory
+// that does not come from a MemoryPool. A ReaderBase made from these does
+// not read the tail of the file again, and may use another pool than the
+// ReaderBase they were taken from, e.g. one of another thread.
+struct FileTail {
+  proto::PostScript postScript;
+  // Owns 'footer'.
+  std::unique_ptr<google::protobuf::Arena> arena;
+  proto::Footer* footer{nullptr};
+  // The stripe metadata cache section of the file. Empty if the file has
+  // none.
+  std::string metadataCache;
+  uint64_t fileLength{0};
+  uint64_t psLength{0};
+};
+
 class ReaderBase {
  public:
   // create reader base from input stream
@@ -95,6 +111,16 @@ class ReaderBase {
     }
   }
 
+  // create reader base from the tail of the file read by another reader
+  ReaderBase(
+      memory::MemoryPool& pool,
+      std::unique_ptr<dwio::common::InputStream> stream,
+      std::shared_ptr<const FileTail> tail,
+      dwio::common::encryption::DecrypterFactory* factory = nullptr,
+      BufferedInputFactory* bufferedInputFactory =
+          BufferedInputFactory::baseFactory(),
+      dwio::common::DataCacheConfig* dataCacheConfig = nullptr);
+
   // for testing
   explicit ReaderBase(memory::MemoryPool& pool) : pool_{pool} {}
 
@@ -141,6 +167,10 @@ class ReaderBase {
     return cache_;
   }
 
+  // Returns a copy of the tail of the file, for making ReaderBases for the
+  // same file on other pools.
+  std::unique_ptr<FileTail> getFileTail() const;
+
   const encryption::DecryptionHandler& getDecryptionHandler() const {
     return *handler_;
   }
@@ -243,8 +273,10 @@ class ReaderBase {
   std::shared_ptr<const RowType> schema_;
   // Lazily populated
   mutable std::shared_ptr<const dwio::common::TypeWithId> schemaWithId_;
-  uint64_t fileLength_;
-  uint64_t psLength_;
+  uint64_t fileLength_{0};
+  uint64_t psLength_{0};
+  // The tail 'this' was made from, if any. Owns 'footer_' then.
+  std::shared_ptr<const FileTail> tail_;
 };
 
 } // namespace facebook::velox::dwrf
@@ -41,12 +41,26 @@ class ScanSpec {
   static constexpr ChannelIndex kNoChannel = ~0;
 
   explicit ScanSpec(const Subfield::PathElement& element) {
-    if (element.kind() == kNestedField) {
-      auto field = reinterpret_cast<const Subfield::NestedField*>(&element);
-      fieldName_ = field->name();
-
-    } else {
-      VELOX_CHECK(false, "Only nested fields are supported");
+    switch (element.kind()) {
+      case kNestedField:
+        fieldName_ =
+            reinterpret_cast<const Subfield::NestedField*>(&element)->name();
+        break;
+      case kLongSubscript:
+        // Integer map key, e.g. features[123].
+        subscript_ =
+            reinterpret_cast<const Subfield::LongSubscript*>(&element)
+                ->index();
+        break;
+      case kStringSubscript:
+        // String map key, e.g. features["abc"].
+        fieldName_ =
+            reinterpret_cast<const Subfield::StringSubscript*>(&element)
+                ->index();
+        break;
+      default:
+        VELOX_CHECK(
+            false, "Only nested fields and map subscripts are supported");
     }
   }
 
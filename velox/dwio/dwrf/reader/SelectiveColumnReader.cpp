@@ -19,6 +19,7 @@
 #include "velox/aggregates/AggregationHook.h"
 #include "velox/common/base/Portability.h"
 #include "velox/dwio/common/TypeUtils.h"
+#include "velox/dwio/dwrf/reader/DecodedStripeCache.h"
 #include "velox/dwio/dwrf/common/DirectDecoder.h"
 #include "velox/dwio/dwrf/common/FloatingPointDecoder.h"
 #include "velox/dwio/dwrf/common/RLEv1.h"
@@ -27,7 +28,10 @@
 #include "velox/vector/DictionaryVector.h"
 #include "velox/vector/FlatVector.h"
 
+#include <algorithm>
 #include <numeric>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace facebook::velox::dwrf {
 
@@ -68,6 +72,61 @@ inline RleVersion convertRleVersion(proto::ColumnEncoding_Kind kind) {
       DWIO_RAISE("Unknown encoding in convertRleVersion");
   }
 }
+
+// Returns a function that is false if a row group's bloom filter shows
+// that no value passes 'filter', or nullptr if 'filter' is not an
+// equality or IN filter. Bloom filters do not record nulls, so filters
+// that pass nulls are not checked.
+std::function<bool(const BloomFilter&)> makeBloomFilterTest(
+    const common::Filter& filter) {
+  if (filter.testNull()) {
+    return nullptr;
+  }
+  auto testLongs = [](std::vector<int64_t> values) {
+    return [values = std::move(values)](const BloomFilter& bloomFilter) {
+      return std::any_of(values.begin(), values.end(), [&](int64_t value) {
+        return bloomFilter.testLong(value);
+      });
+    };
+  };
+  switch (filter.kind()) {
+    case FilterKind::kBigintRange: {
+      auto& range = static_cast<const common::BigintRange&>(filter);
+      if (!range.isSingleValue()) {
+        return nullptr;
+      }
+      return testLongs({range.lower()});
+    }
+    case FilterKind::kBigintValuesUsingHashTable:
+      return testLongs(
+          static_cast<const common::BigintValuesUsingHashTable&>(filter)
+              .values());
+    case FilterKind::kBigintValuesUsingBitmask:
+      return testLongs(
+          static_cast<const common::BigintValuesUsingBitmask&>(filter)
+              .values());
+    case FilterKind::kBytesRange: {
+      auto& range = static_cast<const common::BytesRange&>(filter);
+      if (!range.isSingleValue()) {
+        return nullptr;
+      }
+      return [value = range.lower()](const BloomFilter& bloomFilter) {
+        return bloomFilter.testBytes(value.data(), value.size());
+      };
+    }
+    case FilterKind::kBytesValues: {
+      auto& values = static_cast<const common::BytesValues&>(filter).values();
+      return [&values](const BloomFilter& bloomFilter) {
+        return std::any_of(
+            values.begin(), values.end(), [&](const std::string& value) {
+              return bloomFilter.testBytes(value.data(), value.size());
+            });
+      };
+    }
+    default:
+      return nullptr;
+  }
+}
 } // namespace
 
 SelectiveColumnReader::SelectiveColumnReader(
@@ -84,6 +143,10 @@ SelectiveColumnReader::SelectiveColumnReader(
     indexStream_ =
         stripe.getStream(ek.forKind(proto::Stream_Kind_ROW_INDEX), false);
   }
+  if (scanSpec->filter() && makeBloomFilterTest(*scanSpec->filter())) {
+    bloomFilterStream_ = stripe.getStream(
+        ek.forKind(proto::Stream_Kind_BLOOM_FILTER_UTF8), false);
+  }
 }
 
 std::vector<uint32_t> SelectiveColumnReader::filterRowGroups(
@@ -95,12 +158,23 @@ std::vector<uint32_t> SelectiveColumnReader::filterRowGroups(
     return ColumnReader::filterRowGroups(rowGroupSize, context);
   }
 
+  ensureBloomFilterIndex();
+  std::function<bool(const BloomFilter&)> bloomFilterTest;
+  if (bloomFilterIndex_ &&
+      bloomFilterIndex_->bloomfilter_size() == index_->entry_size()) {
+    bloomFilterTest = makeBloomFilterTest(*filter);
+  }
+
   std::vector<uint32_t> stridesToSkip;
   for (auto i = 0; i < index_->entry_size(); i++) {
     const auto& entry = index_->entry(i);
     auto columnStats = ColumnStatistics::fromProto(entry.statistics(), context);
     if (!testFilter(filter, columnStats.get(), rowGroupSize, type_)) {
       stridesToSkip.push_back(i); // Skipping stride based on column stats.
+    } else if (
+        bloomFilterTest &&
+        !bloomFilterTest(BloomFilter(bloomFilterIndex_->bloomfilter(i)))) {
+      stridesToSkip.push_back(i); // Skipping stride based on bloom filter.
     }
   }
   return stridesToSkip;
@@ -2483,6 +2557,177 @@ void SelectiveFloatingPointColumnReader<TData, TRequested>::read(
   }
 }
 
+class SelectiveTimestampColumnReader : public SelectiveColumnReader {
+ public:
+  using ValueType = Timestamp;
+
+  SelectiveTimestampColumnReader(
+      const EncodingKey& ek,
+      const std::shared_ptr<const TypeWithId>& type,
+      StripeStreams& stripe,
+      common::ScanSpec* scanSpec);
+
+  // Values are decoded from two streams and filtered row by row.
+  bool hasBulkPath() const override {
+    return false;
+  }
+
+  void seekToRowGroup(uint32_t index) override {
+    ensureRowGroupIndex();
+
+    auto positions = toPositions(index_->entry(index));
+    PositionProvider positionsProvider(positions);
+
+    if (notNullDecoder) {
+      notNullDecoder->seekToRowGroup(positionsProvider);
+    }
+
+    seconds_->seekToRowGroup(positionsProvider);
+    nanos_->seekToRowGroup(positionsProvider);
+
+    VELOX_CHECK(!positionsProvider.hasNext());
+  }
+
+  uint64_t skip(uint64_t numValues) override;
+
+  void read(vector_size_t offset, RowSet rows, const uint64_t* incomingNulls)
+      override;
+
+  void getValues(RowSet rows, VectorPtr* result) override {
+    getFlatValues<Timestamp, Timestamp>(rows, result);
+  }
+
+ private:
+  template <bool hasFilter, bool keepValues>
+  void processRows(RowSet rows, const uint64_t* nulls);
+
+  std::unique_ptr<IntDecoder</*isSigned*/ true>> seconds_;
+  std::unique_ptr<IntDecoder</*isSigned*/ false>> nanos_;
+
+  // Seconds and encoded nanos for the rows of the current read.
+  BufferPtr secondsBuffer_;
+  BufferPtr nanosBuffer_;
+};
+
+SelectiveTimestampColumnReader::SelectiveTimestampColumnReader(
+    const EncodingKey& ek,
+    const std::shared_ptr<const TypeWithId>& type,
+    StripeStreams& stripe,
+    common::ScanSpec* scanSpec)
+    : SelectiveColumnReader(ek, stripe, scanSpec, type->type, true) {
+  RleVersion vers = convertRleVersion(stripe.getEncoding(ek).kind());
+  auto data = ek.forKind(proto::Stream_Kind_DATA);
+  bool vints = stripe.getUseVInts(data);
+  seconds_ = IntDecoder</*isSigned*/ true>::createRle(
+      stripe.getStream(data, true), vers, memoryPool, vints, LONG_BYTE_SIZE);
+  auto nanoData = ek.forKind(proto::Stream_Kind_NANO_DATA);
+  bool nanoVInts = stripe.getUseVInts(nanoData);
+  nanos_ = IntDecoder</*isSigned*/ false>::createRle(
+      stripe.getStream(nanoData, true),
+      vers,
+      memoryPool,
+      nanoVInts,
+      LONG_BYTE_SIZE);
+}
+
+uint64_t SelectiveTimestampColumnReader::skip(uint64_t numValues) {
+  numValues = ColumnReader::skip(numValues);
+  seconds_->skip(numValues);
+  nanos_->skip(numValues);
+  return numValues;
+}
+
+void SelectiveTimestampColumnReader::read(
+    vector_size_t offset,
+    RowSet rows,
+    const uint64_t* incomingNulls) {
+  prepareRead<Timestamp>(offset, rows, incomingNulls);
+  VELOX_CHECK(
+      !scanSpec_->valueHook(),
+      "Value hooks are not supported for timestamp columns");
+  auto filter = scanSpec_->filter();
+  if (scanSpec_->readsNullsOnly()) {
+    // The data streams were not advanced by seekTo(), so they must not
+    // be read here either.
+    filterNulls<Timestamp>(
+        rows,
+        filter->kind() == FilterKind::kIsNull,
+        scanSpec_->keepValues());
+    return;
+  }
+
+  vector_size_t numRows = rows.back() + 1;
+  auto nulls = nullsInReadRange_ ? nullsInReadRange_->as<uint64_t>() : nullptr;
+  ensureCapacity<int64_t>(secondsBuffer_, numRows, &memoryPool);
+  ensureCapacity<int64_t>(nanosBuffer_, numRows, &memoryPool);
+  seconds_->next(secondsBuffer_->asMutable<int64_t>(), numRows, nulls);
+  nanos_->next(nanosBuffer_->asMutable<int64_t>(), numRows, nulls);
+  readOffset_ += numRows;
+
+  if (filter) {
+    if (scanSpec_->keepValues()) {
+      processRows<true, true>(rows, nulls);
+    } else {
+      processRows<true, false>(rows, nulls);
+    }
+  } else {
+    if (scanSpec_->keepValues()) {
+      processRows<false, true>(rows, nulls);
+    } else {
+      // No filter and no values: all rows pass.
+      setOutputRows(rows);
+    }
+  }
+}
+
+template <bool hasFilter, bool keepValues>
+void SelectiveTimestampColumnReader::processRows(
+    RowSet rows,
+    const uint64_t* nulls) {
+  auto filter = scanSpec_->filter();
+  auto rawSeconds = secondsBuffer_->as<int64_t>();
+  auto rawNanos = nanosBuffer_->as<int64_t>();
+  for (auto row : rows) {
+    if (nulls && bits::isBitNull(nulls, row)) {
+      if (hasFilter) {
+        if (!filter->testNull()) {
+          continue;
+        }
+        addOutputRow(row);
+      }
+      if (keepValues) {
+        addNull<Timestamp>();
+      }
+      continue;
+    }
+    // The low 3 bits of the nanos give the count of trailing decimal
+    // zeros that were dropped, minus one.
+    auto nanos = rawNanos[row];
+    auto zeros = nanos & 0x7;
+    nanos >>= 3;
+    if (zeros != 0) {
+      for (auto i = 0; i <= zeros; ++i) {
+        nanos *= 10;
+      }
+    }
+    auto seconds = rawSeconds[row] + EPOCH_OFFSET;
+    if (seconds < 0 && nanos != 0) {
+      seconds -= 1;
+    }
+    Timestamp value(seconds, nanos);
+    if (hasFilter) {
+      if (!filter->testTimestamp(value)) {
+        continue;
+      }
+      addOutputRow(row);
+    }
+    if (keepValues) {
+      // Timestamp is not a POD, so this does not go through addValue().
+      reinterpret_cast<Timestamp*>(rawValues_)[numValues_++] = value;
+    }
+  }
+}
+
 class SelectiveStringDirectColumnReader : public SelectiveColumnReader {
  public:
   using ValueType = StringView;
@@ -3786,6 +4031,52 @@ void SelectiveStringDictionaryColumnReader::ensureInitialized() {
   initTimeClocks_ = timer.elapsedClocks();
 }
 
+namespace {
+// Returns true if a top level column of 'kind' may be kept in a
+// DecodedStripeCache.
+bool isDecodedCacheable(TypeKind kind) {
+  switch (kind) {
+    case TypeKind::BOOLEAN:
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::REAL:
+    case TypeKind::DOUBLE:
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+    case TypeKind::TIMESTAMP:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Returns the approximate size of the flat vector of the 'numRows' values of
+// 'type' in 'node'. String data is estimated by the size of the streams of
+// 'node', which is less than the decoded size if compressed.
+int64_t estimateDecodedBytes(
+    const StripeStreams& stripe,
+    uint32_t node,
+    const Type& type,
+    uint64_t numRows) {
+  // Nulls.
+  int64_t bytes = bits::nbytes(numRows);
+  switch (type.kind()) {
+    case TypeKind::BOOLEAN:
+      return bytes + bits::nbytes(numRows);
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      stripe.visitStreamsOfNode(node, [&](const StreamInformation& stream) {
+        bytes += stream.getLength();
+      });
+      return bytes + numRows * sizeof(StringView);
+    default:
+      return bytes + numRows * type.cppSizeInBytes();
+  }
+}
+} // namespace
+
 class SelectiveStructColumnReader : public SelectiveColumnReader {
  public:
   SelectiveStructColumnReader(
@@ -3851,7 +4142,76 @@ class SelectiveStructColumnReader : public SelectiveColumnReader {
   }
 
  private:
+  // Decoded values of a top level column for the whole stripe, from or for
+  // 'decodedCache_'.
+  struct StripeColumn {
+    // Id of the column in the file schema.
+    uint32_t node{0};
+    // Values from 'decodedCache_'. The column then has no reader.
+    VectorPtr cached;
+    // Values read so far, added to 'decodedCache_' when complete.
+    VectorPtr collected;
+    bool collecting{false};
+  };
+
+  const StripeColumn* stripeColumn(const common::ScanSpec& childSpec) const {
+    auto it = stripeColumns_.find(&childSpec);
+    return it == stripeColumns_.end() ? nullptr : &it->second;
+  }
+
+  bool isCached(const common::ScanSpec& childSpec) const {
+    auto column = stripeColumn(childSpec);
+    return column && column->cached;
+  }
+
+  bool isCollecting(const common::ScanSpec& childSpec) const {
+    auto column = stripeColumn(childSpec);
+    return column && column->collecting;
+  }
+
+  // Returns the subset of 'rows' for which the cached values of
+  // 'childSpec' at 'offset' + row pass the filter of 'childSpec'.
+  RowSet filterCached(
+      const common::ScanSpec& childSpec,
+      vector_size_t offset,
+      RowSet rows);
+
+  // Returns the cached values of 'childSpec' at 'rows' after
+  // lazyVectorReadOffset_.
+  VectorPtr getCachedValues(const common::ScanSpec& childSpec, RowSet rows);
+
+  // Appends the values of the collected columns in 'result' for 'rows' to
+  // StripeColumn::collected. Adds the columns to 'decodedCache_' after the
+  // last row of the stripe. Stops collecting if 'rows' are not the next
+  // rows of the stripe, e.g. after a filter.
+  void collect(RowSet rows, const RowVector& result);
+
+  void stopCollecting();
+
   std::vector<std::unique_ptr<SelectiveColumnReader>> children_;
+
+  // Set for the root reader if the RowReaderOptions have a cache of
+  // decoded stripe columns.
+  DecodedStripeCache* decodedCache_{nullptr};
+  uint64_t fileNum_{0};
+  uint32_t stripeIndex_{0};
+  vector_size_t stripeRows_{0};
+
+  // The children of 'scanSpec_' that may be cached. Keyed on the spec
+  // since the children are reordered by filter selectivity.
+  std::unordered_map<const common::ScanSpec*, StripeColumn> stripeColumns_;
+
+  // True if some of 'stripeColumns_' are cached.
+  bool hasCached_{false};
+
+  // True if some of 'stripeColumns_' are collecting.
+  bool collecting_{false};
+
+  // Number of leading rows of the stripe in StripeColumn::collected.
+  vector_size_t numCollected_{0};
+
+  // Rows passing filters on cached values.
+  raw_vector<vector_size_t> cachedFilterRows_;
   // Sequence number of output batch. Checked against ColumnLoaders
   // created by 'this' to verify they are still valid at load.
   uint64_t numReads_ = 0;
@@ -3877,6 +4237,13 @@ SelectiveStructColumnReader::SelectiveStructColumnReader(
 
   const auto& cs = stripe.getColumnSelector();
   auto& childSpecs = scanSpec->children();
+  const auto& options = stripe.getRowReaderOptions();
+  if (dataType->id == 0 && options.getDecodedStripeCache()) {
+    decodedCache_ = options.getDecodedStripeCache();
+    fileNum_ = options.getDecodedStripeCacheFileNum();
+    stripeIndex_ = stripe.stripeIndex();
+    stripeRows_ = stripe.stripeRows();
+  }
   for (auto i = 0; i < childSpecs.size(); ++i) {
     auto childSpec = childSpecs[i].get();
     if (childSpec->isConstant()) {
@@ -3886,6 +4253,25 @@ SelectiveStructColumnReader::SelectiveStructColumnReader(
     auto childRequestedType =
         requestedType->childByName(childSpec->fieldName());
     VELOX_CHECK(cs.shouldReadNode(childDataType->id));
+    if (decodedCache_ && childSpec->children().empty() &&
+        isDecodedCacheable(childRequestedType->type->kind())) {
+      auto& column = stripeColumns_[childSpec];
+      column.node = childDataType->id;
+      auto cached = decodedCache_->get({fileNum_, stripeIndex_, column.node});
+      if (cached && cached->type()->kindEquals(childRequestedType->type)) {
+        // The column is not read, so its streams are not loaded either.
+        column.cached = std::move(cached);
+        hasCached_ = true;
+        continue;
+      }
+      column.collecting = !cached && childSpec->projectOut() &&
+          decodedCache_->shouldCollect(estimateDecodedBytes(
+              stripe,
+              column.node,
+              *childRequestedType->type,
+              stripeRows_));
+      collecting_ = collecting_ || column.collecting;
+    }
     children_.push_back(SelectiveColumnReader::build(
         childRequestedType, childDataType, stripe, childSpec, ek.sequence));
     childSpec->setSubscript(children_.size() - 1);
@@ -3938,7 +4324,7 @@ void SelectiveStructColumnReader::next(
     VectorPtr& result,
     const uint64_t* incomingNulls) {
   VELOX_CHECK(!incomingNulls, "next may only be called for the root reader.");
-  if (children_.empty()) {
+  if (children_.empty() && !hasCached_) {
     // no readers
     // This can be either count(*) query or a query that select only
     // constant columns (partition keys or columns missing from an old file
@@ -4051,14 +4437,24 @@ void SelectiveStructColumnReader::read(
   const uint64_t* structNulls =
       nullsInReadRange_ ? nullsInReadRange_->as<uint64_t>() : nullptr;
   bool hasFilter = false;
-  assert(!children_.empty());
+  assert(!children_.empty() || hasCached_);
   for (size_t i = 0; i < childSpecs.size(); ++i) {
     auto& childSpec = childSpecs[i];
     if (childSpec->isConstant()) {
       continue;
     }
+    if (isCached(*childSpec)) {
+      if (childSpec->filter()) {
+        hasFilter = true;
+        activeRows = filterCached(*childSpec, offset, activeRows);
+        if (activeRows.empty()) {
+          break;
+        }
+      }
+      continue;
+    }
     if (childSpec->projectOut() && !childSpec->filter() &&
-        !childSpec->extractValues()) {
+        !childSpec->extractValues() && !isCollecting(*childSpec)) {
       // Will make a LazyVector.
       continue;
     }
@@ -4094,7 +4490,7 @@ void SelectiveStructColumnReader::read(
 }
 
 void SelectiveStructColumnReader::getValues(RowSet rows, VectorPtr* result) {
-  assert(!children_.empty());
+  assert(!children_.empty() || hasCached_);
   VELOX_CHECK(
       *result != nullptr,
       "SelectiveStructColumnReader expects a non-null result");
@@ -4125,8 +4521,11 @@ void SelectiveStructColumnReader::getValues(RowSet rows, VectorPtr* result) {
     if (childSpec->isConstant()) {
       resultRow->childAt(channel) = BaseVector::wrapInConstant(
           rows.size(), 0, childSpec->constantValue());
+    } else if (isCached(*childSpec)) {
+      resultRow->childAt(channel) = getCachedValues(*childSpec, rows);
     } else {
-      if (!childSpec->extractValues() && !childSpec->filter()) {
+      if (!childSpec->extractValues() && !childSpec->filter() &&
+          !isCollecting(*childSpec)) {
         // LazyVector result.
         if (!lazyPrepared) {
           if (rows.size() != outputRows_.size()) {
@@ -4145,6 +4544,136 @@ void SelectiveStructColumnReader::getValues(RowSet rows, VectorPtr* result) {
       }
     }
   }
+  if (collecting_) {
+    collect(rows, *resultRow);
+  }
+}
+
+namespace {
+template <TypeKind Kind>
+vector_size_t filterCachedValues(
+    const BaseVector& values,
+    const common::Filter& filter,
+    vector_size_t offset,
+    RowSet rows,
+    vector_size_t* passed) {
+  using T = typename TypeTraits<Kind>::NativeType;
+  auto flat = values.asUnchecked<FlatVector<T>>();
+  vector_size_t numPassed = 0;
+  for (auto row : rows) {
+    auto index = offset + row;
+    bool pass;
+    if (flat->isNullAt(index)) {
+      pass = filter.testNull();
+    } else if constexpr (std::is_same_v<T, bool>) {
+      pass = filter.testBool(flat->valueAt(index));
+    } else if constexpr (std::is_same_v<T, float>) {
+      pass = filter.testFloat(flat->valueAt(index));
+    } else if constexpr (std::is_same_v<T, double>) {
+      pass = filter.testDouble(flat->valueAt(index));
+    } else if constexpr (std::is_same_v<T, StringView>) {
+      auto value = flat->valueAt(index);
+      pass = filter.testBytes(value.data(), value.size());
+    } else if constexpr (std::is_same_v<T, Timestamp>) {
+      pass = filter.testTimestamp(flat->valueAt(index));
+    } else {
+      pass = filter.testInt64(flat->valueAt(index));
+    }
+    if (pass) {
+      passed[numPassed++] = row;
+    }
+  }
+  return numPassed;
+}
+} // namespace
+
+RowSet SelectiveStructColumnReader::filterCached(
+    const common::ScanSpec& childSpec,
+    vector_size_t offset,
+    RowSet rows) {
+  const auto& values = *stripeColumn(childSpec)->cached;
+  auto filter = childSpec.filter();
+  // Filtering in place is safe since no row moves up.
+  if (rows.data() != cachedFilterRows_.data()) {
+    cachedFilterRows_.resize(rows.size());
+  }
+  auto numPassed = VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+      filterCachedValues,
+      values.typeKind(),
+      values,
+      *filter,
+      offset,
+      rows,
+      cachedFilterRows_.data());
+  cachedFilterRows_.resize(numPassed);
+  return RowSet(cachedFilterRows_);
+}
+
+VectorPtr SelectiveStructColumnReader::getCachedValues(
+    const common::ScanSpec& childSpec,
+    RowSet rows) {
+  auto indices =
+      AlignedBuffer::allocate<vector_size_t>(rows.size(), &memoryPool);
+  auto rawIndices = indices->asMutable<vector_size_t>();
+  for (auto i = 0; i < rows.size(); ++i) {
+    rawIndices[i] = lazyVectorReadOffset_ + rows[i];
+  }
+  return BaseVector::wrapInDictionary(
+      BufferPtr(nullptr),
+      indices,
+      rows.size(),
+      stripeColumn(childSpec)->cached);
+}
+
+void SelectiveStructColumnReader::collect(
+    RowSet rows,
+    const RowVector& result) {
+  if (lazyVectorReadOffset_ != numCollected_ ||
+      static_cast<vector_size_t>(rows.size()) != rows.back() + 1) {
+    stopCollecting();
+    return;
+  }
+  try {
+    for (auto& [childSpec, column] : stripeColumns_) {
+      if (!column.collecting) {
+        continue;
+      }
+      const auto& values = result.childAt(childSpec->channel());
+      if (!column.collected) {
+        // The values are copied to the cache's memory so that they may
+        // outlive the query.
+        column.collected = BaseVector::create(
+            values->type(), stripeRows_, decodedCache_->pool());
+      }
+      column.collected->copy(values.get(), numCollected_, 0, rows.size());
+    }
+  } catch (const VeloxRuntimeError& e) {
+    // The cache's memory is full, e.g. with vectors that readers still
+    // refer to. The stripe is read without the cache.
+    if (e.errorCode() != error_code::kMemCapExceeded.c_str()) {
+      throw;
+    }
+    stopCollecting();
+    return;
+  }
+  numCollected_ += rows.size();
+  if (numCollected_ == stripeRows_) {
+    for (auto& [childSpec, column] : stripeColumns_) {
+      if (column.collecting) {
+        decodedCache_->put(
+            {fileNum_, stripeIndex_, column.node}, std::move(column.collected));
+      }
+    }
+    stopCollecting();
+  }
+}
+
+void SelectiveStructColumnReader::stopCollecting() {
+  for (auto& [childSpec, column] : stripeColumns_) {
+    column.collecting = false;
+    column.collected.reset();
+  }
+  collecting_ = false;
 }
 
 // Abstract superclass for list and map readers. Encapsulates common
@@ -4583,6 +5112,480 @@ void SelectiveMapColumnReader::getValues(RowSet rows, VectorPtr* result) {
       values);
 }
 
+// Reader for maps in flat map encoding, where the values of each key are in
+// separate streams together with an in-map stream telling which maps have
+// the key. Children of the ScanSpec name keys, e.g. features[123] or
+// features["abc"], and only the streams of the named keys are opened if
+// any of these is projected out. Otherwise all keys of the stripe are read.
+// A filter on a key applies to its value, which is null in rows without the
+// key. The result is a map of the projected keys or, if the column is in
+// RowReaderOptions::getMapColumnIdAsStruct(), a struct with a field per
+// projected key in key order.
+template <typename T>
+class SelectiveFlatMapColumnReader : public SelectiveColumnReader {
+ public:
+  SelectiveFlatMapColumnReader(
+      const EncodingKey& ek,
+      const std::shared_ptr<const TypeWithId>& requestedType,
+      const std::shared_ptr<const TypeWithId>& dataType,
+      StripeStreams& stripe,
+      common::ScanSpec* scanSpec);
+
+  bool useBulkPath() const override {
+    return false;
+  }
+
+  void resetFilterCaches() override {
+    for (auto& node : keyNodes_) {
+      node.reader->resetFilterCaches();
+    }
+  }
+
+  // The row index entries of the value streams start with the position of
+  // the in-map stream, which the value readers do not expect. The streams
+  // are therefore advanced by decoding.
+  void seekToRowGroup(uint32_t index) override {
+    seekTo(index * rowsPerRowGroup_, false);
+  }
+
+  uint64_t skip(uint64_t numValues) override;
+
+  void read(vector_size_t offset, RowSet rows, const uint64_t* incomingNulls)
+      override;
+
+  void getValues(RowSet rows, VectorPtr* result) override;
+
+ private:
+  using Key =
+      std::conditional_t<std::is_same_v<T, StringView>, std::string, T>;
+
+  struct KeyNode {
+    Key key;
+    uint32_t sequence;
+    common::ScanSpec* spec;
+    // True if the values are returned.
+    bool projectOut;
+    std::unique_ptr<SelectiveColumnReader> reader;
+    std::unique_ptr<ByteRleDecoder> inMap;
+    // Bit for each row of the last read() or skip(). Set if the map at the
+    // row is not null and has 'key'. Passed as nulls to 'reader'.
+    BufferPtr inMapBits;
+  };
+
+  static Key extractKey(const proto::KeyInfo& info);
+
+  static bool matches(const common::ScanSpec& spec, const Key& key);
+
+  // Reads the in-map flags of 'numRows' rows with map nulls 'nulls' into
+  // 'node.inMapBits'.
+  void readInMap(KeyNode& node, vector_size_t numRows, const uint64_t* nulls);
+
+  // Skips the values of 'node' up to row 'end'. 'offset' is the row of the
+  // first bit in 'node.inMapBits'.
+  void catchUp(KeyNode& node, vector_size_t offset, vector_size_t end);
+
+  // Returns the nulls of the maps at 'rows' or nullptr if there are none.
+  BufferPtr getNulls(RowSet rows);
+
+  void getMapValues(RowSet rows, VectorPtr* result);
+
+  void getStructValues(RowSet rows, VectorPtr* result);
+
+  const TypePtr requestedType_;
+  const bool returnStruct_;
+  std::vector<KeyNode> keyNodes_;
+  // Index in 'keyNodes_' for each child of 'scanSpec_' with a key in the
+  // stripe.
+  std::unordered_map<const common::ScanSpec*, int32_t> specToNode_;
+  // Specs of the keys read without a child in 'scanSpec_'.
+  std::vector<std::unique_ptr<common::ScanSpec>> ownedSpecs_;
+  // Projected keys in key order and their index in 'keyNodes_' or -1 if the
+  // key is not in the stripe. Used for returning a struct.
+  std::vector<std::pair<Key, int32_t>> structFields_;
+};
+
+template <>
+int8_t SelectiveFlatMapColumnReader<int8_t>::extractKey(
+    const proto::KeyInfo& info) {
+  return info.intkey();
+}
+
+template <>
+int16_t SelectiveFlatMapColumnReader<int16_t>::extractKey(
+    const proto::KeyInfo& info) {
+  return info.intkey();
+}
+
+template <>
+int32_t SelectiveFlatMapColumnReader<int32_t>::extractKey(
+    const proto::KeyInfo& info) {
+  return info.intkey();
+}
+
+template <>
+int64_t SelectiveFlatMapColumnReader<int64_t>::extractKey(
+    const proto::KeyInfo& info) {
+  return info.intkey();
+}
+
+template <>
+std::string SelectiveFlatMapColumnReader<StringView>::extractKey(
+    const proto::KeyInfo& info) {
+  return info.byteskey();
+}
+
+template <typename T>
+bool SelectiveFlatMapColumnReader<T>::matches(
+    const common::ScanSpec& spec,
+    const Key& key) {
+  if constexpr (std::is_same_v<T, StringView>) {
+    return spec.fieldName() == key;
+  } else {
+    return spec.fieldName().empty() && spec.subscript() == key;
+  }
+}
+
+template <typename T>
+SelectiveFlatMapColumnReader<T>::SelectiveFlatMapColumnReader(
+    const EncodingKey& ek,
+    const std::shared_ptr<const TypeWithId>& requestedType,
+    const std::shared_ptr<const TypeWithId>& dataType,
+    StripeStreams& stripe,
+    common::ScanSpec* scanSpec)
+    : SelectiveColumnReader(ek, stripe, scanSpec, dataType->type),
+      requestedType_(requestedType->type),
+      returnStruct_(
+          stripe.getRowReaderOptions().getMapColumnIdAsStruct().count(
+              requestedType->id) > 0) {
+  DWIO_ENSURE_EQ(ek.node, dataType->id, "working on the same node");
+  auto& childSpecs = scanSpec_->children();
+  const bool pruned =
+      std::any_of(childSpecs.begin(), childSpecs.end(), [](auto& spec) {
+        return spec->projectOut();
+      });
+  VELOX_CHECK(
+      pruned || !returnStruct_,
+      "Reading a flat map as struct requires the keys to project");
+
+  auto& valueType = requestedType->childAt(1);
+  auto& dataValueType = dataType->childAt(1);
+  std::unordered_set<uint32_t> processed;
+  stripe.visitStreamsOfNode(
+      dataValueType->id, [&](const StreamInformation& stream) {
+        auto sequence = stream.getSequence();
+        // Sequence 0 has the dictionary shared by all keys.
+        if (sequence == 0 || !processed.insert(sequence).second) {
+          return;
+        }
+        EncodingKey seqEk(dataValueType->id, sequence);
+        auto key = extractKey(stripe.getEncoding(seqEk).key());
+        common::ScanSpec* keySpec = nullptr;
+        for (auto& childSpec : childSpecs) {
+          if (matches(*childSpec, key)) {
+            keySpec = childSpec.get();
+            break;
+          }
+        }
+        if (pruned &&
+            (!keySpec || (!keySpec->projectOut() && !keySpec->filter()))) {
+          return;
+        }
+        if (!keySpec) {
+          ownedSpecs_.push_back(
+              std::make_unique<common::ScanSpec>("elements"));
+          keySpec = ownedSpecs_.back().get();
+        }
+        const bool projectOut = !pruned || keySpec->projectOut();
+        if (projectOut) {
+          // The values are always extracted since there are no lazy
+          // vectors for map values.
+          keySpec->setExtractValues(true);
+        }
+        auto inMap =
+            stripe.getStream(seqEk.forKind(proto::Stream_Kind_IN_MAP), true);
+        DWIO_ENSURE_NOT_NULL(inMap, "In map stream is required");
+        keyNodes_.push_back(KeyNode{
+            std::move(key),
+            sequence,
+            keySpec,
+            projectOut,
+            SelectiveColumnReader::build(
+                valueType, dataValueType, stripe, keySpec, sequence),
+            createBooleanRleDecoder(std::move(inMap), seqEk),
+            nullptr});
+      });
+
+  // Sort by sequence so that the keys of a map are in a fixed order.
+  std::sort(keyNodes_.begin(), keyNodes_.end(), [](auto& a, auto& b) {
+    return a.sequence < b.sequence;
+  });
+  for (auto i = 0; i < keyNodes_.size(); ++i) {
+    specToNode_[keyNodes_[i].spec] = i;
+  }
+
+  if (returnStruct_) {
+    for (auto& childSpec : childSpecs) {
+      if (!childSpec->projectOut()) {
+        continue;
+      }
+      auto it = specToNode_.find(childSpec.get());
+      if constexpr (std::is_same_v<T, StringView>) {
+        structFields_.emplace_back(
+            childSpec->fieldName(), it == specToNode_.end() ? -1 : it->second);
+      } else {
+        structFields_.emplace_back(
+            childSpec->subscript(), it == specToNode_.end() ? -1 : it->second);
+      }
+    }
+    std::sort(structFields_.begin(), structFields_.end());
+  }
+
+  VLOG(1) << "[Flat-Map] Initialized a selective flat-map column reader for "
+          << "node " << dataType->id << ", keys=" << keyNodes_.size();
+}
+
+template <typename T>
+void SelectiveFlatMapColumnReader<T>::readInMap(
+    KeyNode& node,
+    vector_size_t numRows,
+    const uint64_t* nulls) {
+  const auto numBytes = bits::nbytes(numRows) + simd::kPadding;
+  if (!node.inMapBits || node.inMapBits->capacity() < numBytes) {
+    node.inMapBits = AlignedBuffer::allocate<char>(numBytes, &memoryPool);
+  }
+  // Reads one flag per non-null map and leaves the bits of null maps unset.
+  node.inMap->next(node.inMapBits->asMutable<char>(), numRows, nulls);
+}
+
+template <typename T>
+void SelectiveFlatMapColumnReader<T>::catchUp(
+    KeyNode& node,
+    vector_size_t offset,
+    vector_size_t end) {
+  auto reader = node.reader.get();
+  auto readOffset = reader->readOffset();
+  if (readOffset >= end) {
+    return;
+  }
+  // The value streams have a value for each row that has the key.
+  reader->skip(bits::countBits(
+      node.inMapBits->as<uint64_t>(), readOffset - offset, end - offset));
+  reader->setReadOffset(end);
+}
+
+template <typename T>
+uint64_t SelectiveFlatMapColumnReader<T>::skip(uint64_t numValues) {
+  auto numNonNulls = ColumnReader::skip(numValues);
+  for (auto& node : keyNodes_) {
+    uint64_t numInMap = 0;
+    if (numNonNulls > 0) {
+      readInMap(node, numNonNulls, nullptr);
+      numInMap =
+          bits::countBits(node.inMapBits->as<uint64_t>(), 0, numNonNulls);
+    }
+    node.reader->skip(numInMap);
+    node.reader->setReadOffset(node.reader->readOffset() + numValues);
+  }
+  return numValues;
+}
+
+template <typename T>
+void SelectiveFlatMapColumnReader<T>::read(
+    vector_size_t offset,
+    RowSet rows,
+    const uint64_t* incomingNulls) {
+  // Puts the children with filters first in the order of selectivity.
+  scanSpec_->newRead();
+  prepareRead<char>(offset, rows, incomingNulls);
+  const vector_size_t numRows = rows.back() + 1;
+  const uint64_t* mapNulls =
+      nullsInReadRange_ ? nullsInReadRange_->as<uint64_t>() : nullptr;
+  for (auto& node : keyNodes_) {
+    readInMap(node, numRows, mapNulls);
+  }
+
+  RowSet activeRows = rows;
+  for (auto& childSpec : scanSpec_->children()) {
+    auto filter = childSpec->filter();
+    if (!filter) {
+      continue;
+    }
+    auto it = specToNode_.find(childSpec.get());
+    if (it == specToNode_.end()) {
+      // No map in the stripe has the key, so the value is always null.
+      if (!filter->testNull()) {
+        activeRows = RowSet();
+        break;
+      }
+      continue;
+    }
+    auto& node = keyNodes_[it->second];
+    {
+      SelectivityTimer timer(childSpec->selectivity(), activeRows.size());
+      node.reader->resetInitTimeClocks();
+      node.reader->read(
+          offset, activeRows, node.inMapBits->as<uint64_t>());
+      // Exclude initialization time.
+      timer.subtract(node.reader->initTimeClocks());
+      activeRows = node.reader->outputRows();
+      childSpec->selectivity().addOutput(activeRows.size());
+    }
+    if (activeRows.empty()) {
+      break;
+    }
+  }
+
+  if (!activeRows.empty()) {
+    for (auto& node : keyNodes_) {
+      if (node.projectOut && !node.spec->filter()) {
+        node.reader->read(
+            offset, activeRows, node.inMapBits->as<uint64_t>());
+      }
+    }
+  }
+  // Readers that were not read up to the end of 'rows' are advanced, so
+  // that all are at the same row before the next read.
+  for (auto& node : keyNodes_) {
+    catchUp(node, offset, offset + numRows);
+  }
+  if (scanSpec_->hasFilter()) {
+    setOutputRows(activeRows);
+  }
+  readOffset_ = offset + numRows;
+}
+
+template <typename T>
+BufferPtr SelectiveFlatMapColumnReader<T>::getNulls(RowSet rows) {
+  if (!nullsInReadRange_) {
+    return nullptr;
+  }
+  auto readerNulls = nullsInReadRange_->as<uint64_t>();
+  auto nulls = AlignedBuffer::allocate<bool>(rows.size(), &memoryPool);
+  auto rawNulls = nulls->asMutable<uint64_t>();
+  for (auto i = 0; i < rows.size(); ++i) {
+    bits::setBit(rawNulls, i, bits::isBitSet(readerNulls, rows[i]));
+  }
+  return nulls;
+}
+
+template <typename T>
+void SelectiveFlatMapColumnReader<T>::getValues(
+    RowSet rows,
+    VectorPtr* result) {
+  if (returnStruct_) {
+    getStructValues(rows, result);
+  } else {
+    getMapValues(rows, result);
+  }
+}
+
+template <typename T>
+void SelectiveFlatMapColumnReader<T>::getMapValues(
+    RowSet rows,
+    VectorPtr* result) {
+  const vector_size_t numRows = rows.size();
+  auto& mapType = requestedType_->asMap();
+
+  // The projected keys that are in at least one of 'rows' and their values.
+  std::vector<KeyNode*> nodes;
+  std::vector<VectorPtr> nodeValues;
+  vector_size_t numEntries = 0;
+  for (auto& node : keyNodes_) {
+    if (!node.projectOut) {
+      continue;
+    }
+    auto inMap = node.inMapBits->as<uint64_t>();
+    vector_size_t count = 0;
+    for (auto row : rows) {
+      count += bits::isBitSet(inMap, row);
+    }
+    if (count > 0) {
+      nodes.push_back(&node);
+      nodeValues.emplace_back();
+      node.reader->getValues(rows, &nodeValues.back());
+      numEntries += count;
+    }
+  }
+
+  // The values of the keys are concatenated and the entries of the maps
+  // are indices into these.
+  VectorPtr allValues;
+  if (nodeValues.size() == 1) {
+    allValues = nodeValues[0];
+  } else {
+    allValues = BaseVector::create(
+        mapType.valueType(), nodeValues.size() * numRows, &memoryPool);
+    for (auto i = 0; i < nodeValues.size(); ++i) {
+      allValues->copy(nodeValues[i].get(), i * numRows, 0, numRows);
+    }
+  }
+
+  auto keys = BaseVector::create(mapType.keyType(), numEntries, &memoryPool);
+  auto rawKeys = keys->asFlatVector<T>();
+  auto indices =
+      AlignedBuffer::allocate<vector_size_t>(numEntries, &memoryPool);
+  auto rawIndices = indices->asMutable<vector_size_t>();
+  auto offsets = AlignedBuffer::allocate<vector_size_t>(numRows, &memoryPool);
+  auto rawOffsets = offsets->asMutable<vector_size_t>();
+  auto sizes = AlignedBuffer::allocate<vector_size_t>(numRows, &memoryPool);
+  auto rawSizes = sizes->asMutable<vector_size_t>();
+  vector_size_t numSet = 0;
+  for (auto i = 0; i < numRows; ++i) {
+    rawOffsets[i] = numSet;
+    for (auto j = 0; j < nodes.size(); ++j) {
+      if (bits::isBitSet(nodes[j]->inMapBits->as<uint64_t>(), rows[i])) {
+        rawKeys->set(numSet, T(nodes[j]->key));
+        rawIndices[numSet] = j * numRows + i;
+        ++numSet;
+      }
+    }
+    rawSizes[i] = numSet - rawOffsets[i];
+  }
+
+  *result = std::make_shared<MapVector>(
+      &memoryPool,
+      requestedType_,
+      getNulls(rows),
+      numRows,
+      offsets,
+      sizes,
+      keys,
+      numEntries > 0 ? BaseVector::wrapInDictionary(
+                           nullptr, indices, numEntries, allValues)
+                     : BaseVector::create(
+                           mapType.valueType(), 0, &memoryPool));
+}
+
+template <typename T>
+void SelectiveFlatMapColumnReader<T>::getStructValues(
+    RowSet rows,
+    VectorPtr* result) {
+  auto& valueType = requestedType_->asMap().valueType();
+  std::vector<std::string> names;
+  std::vector<VectorPtr> children;
+  for (auto& [key, index] : structFields_) {
+    if constexpr (std::is_same_v<T, StringView>) {
+      names.push_back(key);
+    } else {
+      names.push_back(folly::to<std::string>(key));
+    }
+    children.emplace_back();
+    if (index < 0) {
+      children.back() =
+          BaseVector::createNullConstant(valueType, rows.size(), &memoryPool);
+    } else {
+      keyNodes_[index].reader->getValues(rows, &children.back());
+    }
+  }
+  *result = std::make_shared<RowVector>(
+      &memoryPool,
+      ROW(std::move(names),
+          std::vector<TypePtr>(structFields_.size(), valueType)),
+      getNulls(rows),
+      rows.size(),
+      std::move(children));
+}
+
 } // namespace
 
 std::unique_ptr<SelectiveColumnReader> buildIntegerReader(
@@ -4604,6 +5607,34 @@ std::unique_ptr<SelectiveColumnReader> buildIntegerReader(
   }
 }
 
+std::unique_ptr<SelectiveColumnReader> buildFlatMapReader(
+    const EncodingKey& ek,
+    const std::shared_ptr<const TypeWithId>& requestedType,
+    const std::shared_ptr<const TypeWithId>& dataType,
+    StripeStreams& stripe,
+    common::ScanSpec* scanSpec) {
+  switch (dataType->childAt(0)->type->kind()) {
+    case TypeKind::TINYINT:
+      return std::make_unique<SelectiveFlatMapColumnReader<int8_t>>(
+          ek, requestedType, dataType, stripe, scanSpec);
+    case TypeKind::SMALLINT:
+      return std::make_unique<SelectiveFlatMapColumnReader<int16_t>>(
+          ek, requestedType, dataType, stripe, scanSpec);
+    case TypeKind::INTEGER:
+      return std::make_unique<SelectiveFlatMapColumnReader<int32_t>>(
+          ek, requestedType, dataType, stripe, scanSpec);
+    case TypeKind::BIGINT:
+      return std::make_unique<SelectiveFlatMapColumnReader<int64_t>>(
+          ek, requestedType, dataType, stripe, scanSpec);
+    case TypeKind::VARBINARY:
+    case TypeKind::VARCHAR:
+      return std::make_unique<SelectiveFlatMapColumnReader<StringView>>(
+          ek, requestedType, dataType, stripe, scanSpec);
+    default:
+      DWIO_RAISE("buildReader unhandled flat map key type");
+  }
+}
+
 std::unique_ptr<SelectiveColumnReader> SelectiveColumnReader::build(
     const std::shared_ptr<const TypeWithId>& requestedType,
     const std::shared_ptr<const TypeWithId>& dataType,
@@ -4629,7 +5660,8 @@ std::unique_ptr<SelectiveColumnReader> SelectiveColumnReader::build(
     case TypeKind::MAP:
       if (stripe.getEncoding(ek).kind() ==
           proto::ColumnEncoding_Kind_MAP_FLAT) {
-        VELOX_UNSUPPORTED("SelectiveColumnReader does not support flat maps");
+        return buildFlatMapReader(
+            ek, requestedType, dataType, stripe, scanSpec);
       }
       return std::make_unique<SelectiveMapColumnReader>(
           ek, requestedType, dataType, stripe, scanSpec);
@@ -4656,6 +5688,9 @@ std::unique_ptr<SelectiveColumnReader> SelectiveColumnReader::build(
     case TypeKind::TINYINT:
       return std::make_unique<SelectiveByteRleColumnReader>(
           ek, requestedType, dataType, stripe, scanSpec, false);
+    case TypeKind::TIMESTAMP:
+      return std::make_unique<SelectiveTimestampColumnReader>(
+          ek, dataType, stripe, scanSpec);
     case TypeKind::VARBINARY:
     case TypeKind::VARCHAR:
       switch (static_cast<int64_t>(stripe.getEncoding(ek).kind())) {
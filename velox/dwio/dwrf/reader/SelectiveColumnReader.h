@@ -20,6 +20,7 @@
 #include "velox/common/memory/Memory.h"
 #include "velox/common/process/ProcessBase.h"
 #include "velox/dwio/common/ColumnSelector.h"
+#include "velox/dwio/dwrf/common/BloomFilter.h"
 #include "velox/dwio/dwrf/reader/ColumnReader.h"
 #include "velox/dwio/dwrf/reader/ScanSpec.h"
 #include "velox/type/Filter.h"
@@ -283,6 +284,13 @@ class SelectiveColumnReader : public ColumnReader {
     }
   }
 
+  void ensureBloomFilterIndex() const {
+    if (bloomFilterStream_) {
+      bloomFilterIndex_ = ProtoUtils::readProto<proto::BloomFilterIndex>(
+          std::move(bloomFilterStream_));
+    }
+  }
+
   // Specification of filters, value extraction, pruning etc. The
   // spec is assigned at construction and the contents may change at
   // run time based on adaptation. Owned by caller.
@@ -290,6 +298,10 @@ class SelectiveColumnReader : public ColumnReader {
   TypePtr type_;
   mutable std::unique_ptr<SeekableInputStream> indexStream_;
   mutable std::unique_ptr<proto::RowIndex> index_;
+  // Per row group bloom filters. Only loaded if the column has a filter
+  // that a bloom filter can decide, e.g. equality or IN.
+  mutable std::unique_ptr<SeekableInputStream> bloomFilterStream_;
+  mutable std::unique_ptr<proto::BloomFilterIndex> bloomFilterIndex_;
   // Number of rows in a row group. Last row group may have fewer rows.
   uint32_t rowsPerRowGroup_;
   // Row number after last read row, relative to stripe start.
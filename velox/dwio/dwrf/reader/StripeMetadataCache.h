@@ -51,6 +51,11 @@ class StripeMetadataCache {
     return getIndex(mode, stripeIndex) != INVALID_INDEX;
   }
 
+  // Returns the cached bytes, laid out as in the cache section of the file.
+  const char* data() const {
+    return buffer_->data();
+  }
+
   std::unique_ptr<SeekableArrayInputStream> get(
       proto::StripeCacheMode mode,
       uint64_t stripeIndex) const {
@@ -216,7 +216,7 @@ std::unique_ptr<SeekableInputStream> StripeStreamsImpl::getCompressedStream(
   const auto& info = getStreamInfo(si);
 
   std::unique_ptr<SeekableInputStream> streamRead;
-  if (si.kind == StreamKind::StreamKind_ROW_INDEX) {
+  if (isIndexStream(si.kind)) {
     streamRead = getIndexStreamFromCache(info);
   }
 
@@ -266,7 +266,7 @@ std::unique_ptr<SeekableInputStream> StripeStreamsImpl::getStream(
   }
 
   std::unique_ptr<SeekableInputStream> streamRead;
-  if (si.kind == StreamKind::StreamKind_ROW_INDEX) {
+  if (isIndexStream(si.kind)) {
     streamRead = getIndexStreamFromCache(info);
   }
 
@@ -157,6 +157,12 @@ class StripeStreams {
 
   // Number of rows per row group. Last row group may have fewer rows.
   virtual uint32_t rowsPerRowGroup() const = 0;
+
+  // Index of the stripe in the file.
+  virtual uint32_t stripeIndex() const = 0;
+
+  // Number of rows in the stripe.
+  virtual uint64_t stripeRows() const = 0;
 };
 
 class StripeStreamsBase : public StripeStreams {
@@ -286,6 +292,14 @@ class StripeStreamsImpl : public StripeStreamsBase {
     return reader_.getReader().getFooter().rowindexstride();
   }
 
+  uint32_t stripeIndex() const override {
+    return stripeIndex_;
+  }
+
+  uint64_t stripeRows() const override {
+    return reader_.getReader().getFooter().stripes(stripeIndex_).numberofrows();
+  }
+
  private:
   const StreamInformation& getStreamInfo(
       const StreamIdentifier& si,
@@ -551,6 +551,15 @@ class E2EFilterTest : public testing::Test {
     auto config = std::make_shared<dwrf::Config>();
     config->set(dwrf::Config::COMPRESSION, dwrf::CompressionKind_NONE);
     config->set(dwrf::Config::USE_VINTS, useVInts_);
+    if (!flatMapColumns_.empty()) {
+      config->set(dwrf::Config::FLATTEN_MAP, true);
+      config->set<const std::vector<uint32_t>>(
+          dwrf::Config::MAP_FLAT_COLS, flatMapColumns_);
+    }
+    if (!bloomFilterColumns_.empty()) {
+      config->set<const std::vector<uint32_t>>(
+          dwrf::Config::BLOOM_FILTER_COLS, bloomFilterColumns_);
+    }
     WriterOptions options;
     options.config = config;
     options.schema = type;
@@ -617,7 +626,8 @@ class E2EFilterTest : public testing::Test {
       const std::vector<uint32_t>& hitRows,
       uint64_t& time,
       bool useValueHook,
-      bool skipCheck = false) {
+      bool skipCheck = false,
+      int64_t* skippedStrides = nullptr) {
     auto input = std::make_unique<MemoryInputStream>(
         sinkPtr_->getData(), sinkPtr_->size());
 
@@ -676,6 +686,9 @@ class E2EFilterTest : public testing::Test {
     if (!skipCheck) {
       ASSERT_EQ(rowIndex, hitRows.size());
     }
+    if (skippedStrides) {
+      *skippedStrides = rowReader->skippedStrides();
+    }
   }
 
   template <TypeKind Kind>
@@ -899,6 +912,10 @@ class E2EFilterTest : public testing::Test {
   std::unordered_map<std::string, std::array<int32_t, 2>> filterCoverage_;
   folly::Random::DefaultGenerator rng_;
   bool useVInts_ = true;
+  // Top level columns written as flat maps.
+  std::vector<uint32_t> flatMapColumns_;
+  // Top level columns written with bloom filters.
+  std::vector<uint32_t> bloomFilterColumns_;
 }; // namespace facebook::dwio::dwrf
 
 TEST_F(E2EFilterTest, integerDirect) {
@@ -1022,4 +1039,247 @@ TEST_F(E2EFilterTest, listAndMap) {
       10);
 }
 
+TEST_F(E2EFilterTest, flatMap) {
+  // Row 'i' has keys 0-9 except the ones with (i + key) % 3 == 0. The value
+  // of key k is i * 10 + k and is null if (i + key) % 11 == 0. Every 17th
+  // map is null.
+  constexpr int32_t kBatchSize = 5'000;
+  auto makeBatches = [&](std::function<bool(int32_t)> keepKey) {
+    std::vector<RowVectorPtr> batches;
+    for (auto batch = 0; batch < 2; ++batch) {
+      auto longs = BaseVector::create(BIGINT(), kBatchSize, pool_.get());
+      MapBuilder<int32_t, int64_t>::rows maps;
+      for (auto row = 0; row < kBatchSize; ++row) {
+        int64_t i = batch * kBatchSize + row;
+        longs->asFlatVector<int64_t>()->set(row, i);
+        if (i % 17 == 0) {
+          maps.push_back(std::nullopt);
+          continue;
+        }
+        MapBuilder<int32_t, int64_t>::row map;
+        for (auto key = 0; key < 10; ++key) {
+          if ((i + key) % 3 == 0 || !keepKey(key)) {
+            continue;
+          }
+          map.emplace_back(
+              key,
+              (i + key) % 11 == 0 ? std::nullopt
+                                  : std::optional<int64_t>(i * 10 + key));
+        }
+        maps.push_back(std::move(map));
+      }
+      batches.push_back(std::make_shared<RowVector>(
+          pool_.get(),
+          rowType_,
+          BufferPtr(nullptr),
+          kBatchSize,
+          std::vector<VectorPtr>{
+              longs,
+              MapBuilder<int32_t, int64_t>::create(*pool_, maps)}));
+    }
+    return batches;
+  };
+
+  rowType_ = ROW({"long_val", "map_val"}, {BIGINT(), MAP(INTEGER(), BIGINT())});
+  batches_ = makeBatches([](int32_t) { return true; });
+  flatMapColumns_ = {1};
+  writeToMemory(rowType_, batches_);
+  uint64_t time = 0;
+
+  // All keys.
+  auto spec = makeScanSpec(SubfieldFilters{});
+  readWithoutFilter(spec.get(), batches_, time);
+
+  // A filter on the value of a key returns the rows with the key and a
+  // value in range with all their keys.
+  SubfieldFilters filters;
+  filters[Subfield("map_val[2]")] =
+      std::make_unique<BigintRange>(10'000, 60'000, false);
+  std::vector<uint32_t> hitRows;
+  for (auto batch = 0; batch < 2; ++batch) {
+    for (auto row = 0; row < kBatchSize; ++row) {
+      int64_t i = batch * kBatchSize + row;
+      if (i % 17 != 0 && (i + 2) % 3 != 0 && (i + 2) % 11 != 0 &&
+          i * 10 + 2 >= 10'000 && i * 10 + 2 <= 60'000) {
+        hitRows.push_back(batchPosition(batch, row));
+      }
+    }
+  }
+  spec = makeScanSpec(std::move(filters));
+  readWithFilter(spec.get(), batches_, hitRows, time, false);
+
+  // Projecting keys reads only these. Key 20 is in no map.
+  spec = makeScanSpec(SubfieldFilters{});
+  for (auto key : {"map_val[1]", "map_val[4]", "map_val[20]"}) {
+    spec->getOrCreateChild(Subfield(key))->setProjectOut(true);
+  }
+  readWithoutFilter(
+      spec.get(),
+      makeBatches([](int32_t key) { return key == 1 || key == 4; }),
+      time);
+
+  // A filter on a key that is in no map is applied to null.
+  filters.clear();
+  filters[Subfield("map_val[20]")] = std::make_unique<IsNull>();
+  hitRows.clear();
+  for (auto batch = 0; batch < 2; ++batch) {
+    for (auto row = 0; row < kBatchSize; ++row) {
+      hitRows.push_back(batchPosition(batch, row));
+    }
+  }
+  spec = makeScanSpec(std::move(filters));
+  readWithFilter(spec.get(), batches_, hitRows, time, false);
+}
+
+TEST_F(E2EFilterTest, timestamp) {
+  // Row 'i' has seconds 1'600'000'000 + i * 7 and nanos with a varying
+  // count of trailing zeros. Every 13th value is null. 'ts_null' is all
+  // null.
+  constexpr int32_t kBatchSize = 5'000;
+  auto makeTimestamp = [](int64_t i) {
+    return Timestamp(1'600'000'000 + i * 7, (i % 1'000) * 1'000'000);
+  };
+  rowType_ = ROW(
+      {"long_val", "ts_val", "ts_null"}, {BIGINT(), TIMESTAMP(), TIMESTAMP()});
+  batches_.clear();
+  for (auto batch = 0; batch < 2; ++batch) {
+    auto longs = BaseVector::create(BIGINT(), kBatchSize, pool_.get());
+    auto timestamps = BaseVector::create(TIMESTAMP(), kBatchSize, pool_.get());
+    auto nulls = BaseVector::create(TIMESTAMP(), kBatchSize, pool_.get());
+    for (auto row = 0; row < kBatchSize; ++row) {
+      int64_t i = batch * kBatchSize + row;
+      longs->asFlatVector<int64_t>()->set(row, i);
+      if (i % 13 == 0) {
+        timestamps->setNull(row, true);
+      } else {
+        timestamps->asFlatVector<Timestamp>()->set(row, makeTimestamp(i));
+      }
+      nulls->setNull(row, true);
+    }
+    batches_.push_back(std::make_shared<RowVector>(
+        pool_.get(),
+        rowType_,
+        BufferPtr(nullptr),
+        kBatchSize,
+        std::vector<VectorPtr>{longs, timestamps, nulls}));
+  }
+  writeToMemory(rowType_, batches_);
+  uint64_t time = 0;
+
+  auto spec = makeScanSpec(SubfieldFilters{});
+  readWithoutFilter(spec.get(), batches_, time);
+
+  // A range filter is applied to the decoded values. Nulls pass.
+  auto lower = makeTimestamp(1'000);
+  auto upper = makeTimestamp(7'000);
+  SubfieldFilters filters;
+  filters[Subfield("ts_val")] =
+      std::make_unique<TimestampRange>(lower, upper, true);
+  std::vector<uint32_t> hitRows;
+  for (auto batch = 0; batch < 2; ++batch) {
+    for (auto row = 0; row < kBatchSize; ++row) {
+      int64_t i = batch * kBatchSize + row;
+      if (i % 13 == 0 ||
+          (makeTimestamp(i) >= lower && makeTimestamp(i) <= upper)) {
+        hitRows.push_back(batchPosition(batch, row));
+      }
+    }
+  }
+  spec = makeScanSpec(std::move(filters));
+  readWithFilter(spec.get(), batches_, hitRows, time, false);
+
+  // The statistics of 'ts_null' show no values, so all row groups are
+  // skipped without decoding.
+  filters.clear();
+  filters[Subfield("ts_null")] =
+      std::make_unique<TimestampRange>(lower, upper, false);
+  spec = makeScanSpec(std::move(filters));
+  readWithFilter(spec.get(), batches_, {}, time, false);
+}
+
+TEST_F(E2EFilterTest, bloomFilter) {
+  // The first half of the rows has the even and the second half the odd
+  // values of the same range. The min/max statistics of a row group with
+  // even values overlap odd values and vice versa, so only the bloom
+  // filters can skip row groups without hits.
+  constexpr int32_t kBatchSize = 5'000;
+  constexpr int32_t kNumBatches = 4;
+  constexpr int64_t kHalf = kBatchSize * kNumBatches / 2;
+  auto makeLong = [&](int64_t i) {
+    return i < kHalf ? 2 * i : 2 * (i - kHalf) + 1;
+  };
+  auto makeString = [&](int64_t i) {
+    return fmt::format("s{}", makeLong(i));
+  };
+  rowType_ = ROW({"long_val", "string_val"}, {BIGINT(), VARCHAR()});
+  batches_.clear();
+  for (auto batch = 0; batch < kNumBatches; ++batch) {
+    auto longs = BaseVector::create(BIGINT(), kBatchSize, pool_.get());
+    auto strings = BaseVector::create(VARCHAR(), kBatchSize, pool_.get());
+    for (auto row = 0; row < kBatchSize; ++row) {
+      int64_t i = batch * kBatchSize + row;
+      longs->asFlatVector<int64_t>()->set(row, makeLong(i));
+      strings->asFlatVector<StringView>()->set(row, StringView(makeString(i)));
+    }
+    batches_.push_back(std::make_shared<RowVector>(
+        pool_.get(),
+        rowType_,
+        BufferPtr(nullptr),
+        kBatchSize,
+        std::vector<VectorPtr>{longs, strings}));
+  }
+  bloomFilterColumns_ = {0, 1};
+  writeToMemory(rowType_, batches_);
+  uint64_t time = 0;
+
+  auto test = [&](const std::string& column,
+                  std::unique_ptr<Filter> filter,
+                  std::function<bool(int64_t)> expected) {
+    std::vector<uint32_t> hitRows;
+    for (auto batch = 0; batch < kNumBatches; ++batch) {
+      for (auto row = 0; row < kBatchSize; ++row) {
+        if (expected(batch * kBatchSize + row)) {
+          hitRows.push_back(batchPosition(batch, row));
+        }
+      }
+    }
+    SubfieldFilters filters;
+    filters[Subfield(column)] = std::move(filter);
+    auto spec = makeScanSpec(std::move(filters));
+    int64_t skippedStrides = 0;
+    readWithFilter(
+        spec.get(), batches_, hitRows, time, false, false, &skippedStrides);
+    // Each batch is a stripe of one row group and at most one has hits.
+    EXPECT_GT(skippedStrides, 0);
+  };
+
+  test("long_val", std::make_unique<BigintRange>(7, 7, false), [&](auto i) {
+    return makeLong(i) == 7;
+  });
+  test(
+      "long_val",
+      createBigintValues({3, 5, 1'001, 123'456'789}, false),
+      [&](auto i) {
+        auto value = makeLong(i);
+        return value == 3 || value == 5 || value == 1'001;
+      });
+  test("long_val", createBigintValues({11, 13, 15}, false), [&](auto i) {
+    auto value = makeLong(i);
+    return value == 11 || value == 13 || value == 15;
+  });
+  test(
+      "string_val",
+      std::make_unique<BytesRange>(
+          "s8", false, false, "s8", false, false, false),
+      [&](auto i) { return makeString(i) == "s8"; });
+  test(
+      "string_val",
+      std::make_unique<BytesValues>(
+          std::vector<std::string>{"s9", "s19", "none"}, false),
+      [&](auto i) {
+        auto value = makeString(i);
+        return value == "s9" || value == "s19";
+      });
+}
+
 } // namespace facebook::dwio::dwrf
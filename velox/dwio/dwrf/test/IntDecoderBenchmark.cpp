@@ -24,6 +24,7 @@
 #include "folly/init/Init.h"
 #include "folly/lang/Bits.h"
 #include "velox/dwio/common/exception/Exception.h"
+#include "velox/dwio/dwrf/common/BitPackDecoder.h"
 #include "velox/dwio/dwrf/common/IntCodecCommon.h"
 #include "velox/dwio/dwrf/common/IntDecoder.h"
 
@@ -47,6 +48,15 @@ std::vector<uint64_t> randomInts_u64;
 std::vector<uint64_t> randomInts_u64_result;
 std::vector<char> buffer_u64;
 
+// Bit-packed values for the RLEv2 unpack benchmarks. Random bytes are
+// valid packed data for any bit width.
+const int32_t kNumPacked = 100000;
+std::vector<char> packedBuffer;
+std::vector<int64_t> unpackedResult;
+// Every 10th row, for selective unpack.
+std::vector<int32_t> selectedRows;
+std::vector<int64_t> selectedResult;
+
 uint64_t readVuLong(const char* buffer, size_t& len) {
   if (LIKELY(len >= folly::kMaxVarintLength64)) {
     const char* p = buffer;
@@ -825,6 +835,106 @@ size_t writeVulongToBuffer(uint64_t val, char* buffer, size_t pos) {
   return pos;
 }
 
+// Unpacks a bit at a time like RleDecoderV2::readLongs did before the
+// width-specialized kernels.
+void unpackBitsLegacy(
+    const char* input,
+    uint32_t width,
+    int32_t numValues,
+    int64_t* result) {
+  uint32_t bitsLeft = 0;
+  uint32_t curByte = 0;
+  for (int32_t i = 0; i < numValues; ++i) {
+    uint64_t value = 0;
+    uint64_t bitsLeftToRead = width;
+    while (bitsLeftToRead > bitsLeft) {
+      value <<= bitsLeft;
+      value |= curByte & ((1 << bitsLeft) - 1);
+      bitsLeftToRead -= bitsLeft;
+      curByte = static_cast<unsigned char>(*input++);
+      bitsLeft = 8;
+    }
+    if (bitsLeftToRead > 0) {
+      value <<= bitsLeftToRead;
+      bitsLeft -= static_cast<uint32_t>(bitsLeftToRead);
+      value |= (curByte >> bitsLeft) & ((1 << bitsLeftToRead) - 1);
+    }
+    result[i] = static_cast<int64_t>(value);
+  }
+}
+
+void unpackLegacy(int32_t width) {
+  unpackBitsLegacy(
+      packedBuffer.data(), width, kNumPacked, unpackedResult.data());
+}
+
+void unpackScalar(int32_t width) {
+  unpackBitsScalar<false>(
+      packedBuffer.data(),
+      packedBuffer.data() + packedBuffer.size(),
+      0,
+      width,
+      nullptr,
+      kNumPacked,
+      unpackedResult.data());
+}
+
+void unpackFixed(int32_t width) {
+  unpackBits<false>(
+      packedBuffer.data(),
+      packedBuffer.data() + packedBuffer.size(),
+      0,
+      width,
+      nullptr,
+      kNumPacked,
+      unpackedResult.data());
+}
+
+// Without row selection all values are unpacked and the selected ones
+// are copied out.
+void unpackSelectiveLegacy(int32_t width) {
+  unpackLegacy(width);
+  for (auto i = 0; i < selectedRows.size(); ++i) {
+    selectedResult[i] = unpackedResult[selectedRows[i]];
+  }
+}
+
+void unpackSelectiveFixed(int32_t width) {
+  unpackBits<false>(
+      packedBuffer.data(),
+      packedBuffer.data() + packedBuffer.size(),
+      0,
+      width,
+      selectedRows.data(),
+      selectedRows.size(),
+      selectedResult.data());
+}
+
+#define UNPACK_BENCHMARKS(width)                     \
+  BENCHMARK(unpackLegacy_##width) {                  \
+    unpackLegacy(width);                             \
+  }                                                  \
+  BENCHMARK_RELATIVE(unpackScalar_##width) {         \
+    unpackScalar(width);                             \
+  }                                                  \
+  BENCHMARK_RELATIVE(unpackFixed_##width) {          \
+    unpackFixed(width);                              \
+  }                                                  \
+  BENCHMARK(unpackSelectiveLegacy_##width) {         \
+    unpackSelectiveLegacy(width);                    \
+  }                                                  \
+  BENCHMARK_RELATIVE(unpackSelectiveFixed_##width) { \
+    unpackSelectiveFixed(width);                     \
+  }
+
+UNPACK_BENCHMARKS(1)
+UNPACK_BENCHMARKS(7)
+UNPACK_BENCHMARKS(13)
+UNPACK_BENCHMARKS(24)
+UNPACK_BENCHMARKS(32)
+UNPACK_BENCHMARKS(48)
+UNPACK_BENCHMARKS(64)
+
 BENCHMARK(decodeOld_16) {
   size_t currentLen = len_u16;
   const size_t startingLen = len_u16;
@@ -909,6 +1019,16 @@ int32_t main(int32_t argc, char* argv[]) {
   randomInts_u64_result.resize(randomInts_u64.size());
   len_u64 = pos;
 
+  packedBuffer.resize(kNumPacked * sizeof(uint64_t));
+  for (auto i = 0; i < packedBuffer.size(); ++i) {
+    packedBuffer[i] = static_cast<char>(folly::Random::rand32());
+  }
+  unpackedResult.resize(kNumPacked);
+  for (auto i = 0; i < kNumPacked; i += 10) {
+    selectedRows.push_back(i);
+  }
+  selectedResult.resize(selectedRows.size());
+
   folly::runBenchmarks();
   return 0;
 }
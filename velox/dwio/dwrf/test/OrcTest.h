@@ -109,6 +109,14 @@ class MockStripeStreams : public StripeStreams {
     return 1'000'000;
   }
 
+  uint32_t stripeIndex() const override {
+    VELOX_UNSUPPORTED();
+  }
+
+  uint64_t stripeRows() const override {
+    VELOX_UNSUPPORTED();
+  }
+
  private:
   std::unique_ptr<memory::ScopedMemoryPool> scopedPool_;
   dwio::common::RowReaderOptions options_;
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "velox/dwio/dwrf/common/BloomFilter.h"
+
+using namespace facebook::velox::dwrf;
+
+TEST(TestBloomFilter, size) {
+  // Same sizing as the ORC bloom filter.
+  BloomFilter bloomFilter(10'000, 0.05);
+  EXPECT_EQ(bloomFilter.numBits(), 62'400);
+  EXPECT_EQ(bloomFilter.numHashFunctions(), 4);
+}
+
+TEST(TestBloomFilter, longs) {
+  constexpr int32_t kNumValues = 10'000;
+  BloomFilter bloomFilter(kNumValues, 0.05);
+  for (int64_t i = 0; i < kNumValues; ++i) {
+    bloomFilter.addLong(i * 2);
+  }
+  int32_t numFalsePositives = 0;
+  for (int64_t i = 0; i < kNumValues; ++i) {
+    EXPECT_TRUE(bloomFilter.testLong(i * 2));
+    numFalsePositives += bloomFilter.testLong(i * 2 + 1);
+  }
+  EXPECT_LT(numFalsePositives, kNumValues / 10);
+
+  bloomFilter.reset();
+  EXPECT_FALSE(bloomFilter.testLong(0));
+}
+
+TEST(TestBloomFilter, bytes) {
+  constexpr int32_t kNumValues = 10'000;
+  BloomFilter bloomFilter(kNumValues, 0.05);
+  for (int32_t i = 0; i < kNumValues; ++i) {
+    auto value = fmt::format("value {}", i * 2);
+    bloomFilter.addBytes(value.data(), value.size());
+  }
+  int32_t numFalsePositives = 0;
+  for (int32_t i = 0; i < kNumValues; ++i) {
+    auto value = fmt::format("value {}", i * 2);
+    EXPECT_TRUE(bloomFilter.testBytes(value.data(), value.size()));
+    value = fmt::format("value {}", i * 2 + 1);
+    numFalsePositives += bloomFilter.testBytes(value.data(), value.size());
+  }
+  EXPECT_LT(numFalsePositives, kNumValues / 10);
+  EXPECT_FALSE(bloomFilter.testBytes("", 0));
+}
+
+TEST(TestBloomFilter, serialize) {
+  BloomFilter bloomFilter(1'000, 0.01);
+  for (int64_t i = 0; i < 1'000; ++i) {
+    bloomFilter.addLong(i * 1'000'003);
+  }
+  proto::BloomFilter proto;
+  bloomFilter.toProto(proto);
+  EXPECT_EQ(proto.numhashfunctions(), bloomFilter.numHashFunctions());
+  EXPECT_EQ(proto.utf8bitset().size() * 8, bloomFilter.numBits());
+
+  BloomFilter copy(proto);
+  EXPECT_EQ(copy.numBits(), bloomFilter.numBits());
+  for (int64_t i = -1'000; i < 2'000; ++i) {
+    EXPECT_EQ(
+        copy.testLong(i * 1'000'003), bloomFilter.testLong(i * 1'000'003));
+  }
+
+  // Readers also accept the bitset as repeated fixed64.
+  proto::BloomFilter longs;
+  longs.set_numhashfunctions(proto.numhashfunctions());
+  for (auto i = 0; i < proto.utf8bitset().size(); i += 8) {
+    uint64_t word;
+    memcpy(&word, proto.utf8bitset().data() + i, sizeof(word));
+    longs.add_bitset(word);
+  }
+  BloomFilter fromLongs(longs);
+  for (int64_t i = 0; i < 1'000; ++i) {
+    EXPECT_TRUE(fromLongs.testLong(i * 1'000'003));
+  }
+}
@@ -592,6 +592,38 @@ TEST(TestReader, testMismatchSchemaMoreFields) {
   }
 }
 
+TEST(TestReader, testReaderFromFileTail) {
+  RowReaderOptions rowReaderOpts;
+  VectorPtr expected;
+  std::unique_ptr<FileTail> tail;
+  {
+    auto pool =
+        memory::getProcessDefaultMemoryManager().getRoot().addScopedChild(
+            "first");
+    ReaderOptions readerOpts(pool.get());
+    auto reader = DwrfReader::create(
+        std::make_unique<FileInputStream>(structFile), readerOpts);
+    reader->createRowReader(rowReaderOpts)->next(1000, expected);
+    tail = reader->getFileTail();
+  }
+
+  // The tail outlives the reader and the pool it was read with.
+  auto pool = memory::getProcessDefaultMemoryManager().getRoot().addScopedChild(
+      "second");
+  ReaderOptions readerOpts(pool.get());
+  auto reader = DwrfReader::create(
+      std::make_unique<FileInputStream>(structFile),
+      readerOpts,
+      std::move(tail));
+  EXPECT_EQ(expected->size(), reader->getFooter().numberofrows());
+  VectorPtr batch;
+  reader->createRowReader(rowReaderOpts)->next(1000, batch);
+  ASSERT_EQ(expected->size(), batch->size());
+  for (auto i = 0; i < batch->size(); ++i) {
+    EXPECT_TRUE(batch->equalValueAt(expected.get(), i, i));
+  }
+}
+
 TEST(TestReader, testMismatchSchemaFewerFields) {
   // file has schema: a int, b struct<a:int, b:float, c:string>, c float
   ReaderOptions readerOpts;
@@ -20,6 +20,7 @@
 #include "velox/dwio/dwrf/test/OrcTest.h"
 
 #include <gtest/gtest.h>
+#include <random>
 #include <vector>
 
 using namespace facebook::velox;
@@ -662,6 +663,102 @@ TEST(RLEv2, bitsLeftByPreviousStream) {
   }
 };
 
+namespace {
+// Encodes 'values' as DIRECT runs of 'width' bit zigzag encoded values.
+std::vector<char> encodeDirectRuns(
+    const std::vector<int64_t>& values,
+    int32_t width) {
+  int32_t encodedWidth;
+  if (width <= 24) {
+    encodedWidth = width - 1;
+  } else if (width <= 32) {
+    encodedWidth = 24 + (width - 26) / 2;
+  } else {
+    encodedWidth = 28 + (width - 40) / 8;
+  }
+  std::vector<char> bytes;
+  for (size_t start = 0; start < values.size(); start += 512) {
+    auto length = std::min<size_t>(512, values.size() - start);
+    bytes.push_back((1 << 6) | (encodedWidth << 1) | ((length - 1) >> 8));
+    bytes.push_back((length - 1) & 0xff);
+    auto begin = bytes.size();
+    bytes.resize(begin + bits::nbytes(length * width), 0);
+    for (size_t i = 0; i < length; ++i) {
+      auto value = facebook::ZigZag::encode(values[start + i]);
+      for (int32_t bit = 0; bit < width; ++bit) {
+        if ((value >> (width - 1 - bit)) & 1) {
+          auto position = i * width + bit;
+          bytes[begin + position / 8] |= 0x80 >> (position % 8);
+        }
+      }
+    }
+  }
+  return bytes;
+}
+} // namespace
+
+TEST(RLEv2, directAllWidths) {
+  auto scopedPool = memory::getDefaultScopedMemoryPool();
+  std::mt19937_64 rng(1);
+  constexpr int32_t kNumValues = 1200;
+  for (auto width : {1,  2,  3,  4,  5,  6,  7,  8,  9,  10, 11,
+                     12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22,
+                     23, 24, 26, 28, 30, 32, 40, 48, 56, 64}) {
+    SCOPED_TRACE("width " + std::to_string(width));
+    std::vector<int64_t> values(kNumValues);
+    const uint64_t mask = width == 64 ? ~0UL : bits::lowMask(width);
+    for (auto& value : values) {
+      value = facebook::ZigZag::decode(rng() & mask);
+    }
+    auto bytes = encodeDirectRuns(values, width);
+    // A small block size makes runs straddle input buffers.
+    auto makeDecoder = [&]() {
+      return IntDecoder<true>::createRle(
+          std::make_unique<SeekableArrayInputStream>(
+              bytes.data(), bytes.size(), 7),
+          RleVersion_2,
+          *scopedPool,
+          true,
+          LONG_BYTE_SIZE);
+    };
+
+    auto rle = makeDecoder();
+    std::vector<int64_t> data(kNumValues);
+    for (auto i = 0; i < kNumValues; i += 100) {
+      rle->next(data.data() + i, 100, nullptr);
+    }
+    EXPECT_EQ(values, data);
+
+    rle = makeDecoder();
+    int64_t value;
+    int32_t row = 0;
+    for (auto toSkip : {250, 300, 1, 0, 510}) {
+      rle->skip(toSkip);
+      row += toSkip;
+      rle->next(&value, 1, nullptr);
+      EXPECT_EQ(values[row], value);
+      ++row;
+    }
+
+    // Every third position is null. Non-null positions get consecutive
+    // values.
+    rle = makeDecoder();
+    constexpr int32_t kNumPositions = kNumValues / 2 * 3;
+    std::vector<uint64_t> nulls(bits::nwords(kNumPositions), ~0UL);
+    for (auto i = 0; i < kNumPositions; i += 3) {
+      bits::setNull(nulls.data(), i);
+    }
+    std::vector<int64_t> withNulls(kNumPositions);
+    rle->next(withNulls.data(), kNumPositions, nulls.data());
+    row = 0;
+    for (auto i = 0; i < kNumPositions; ++i) {
+      if (!bits::isBitNull(nulls.data(), i)) {
+        EXPECT_EQ(values[row++], withNulls[i]);
+      }
+    }
+  }
+}
+
 TEST(RLEv1, simpleTest) {
   auto scopedPool = memory::getDefaultScopedMemoryPool();
   const unsigned char buffer[] = {
@@ -528,6 +528,14 @@ class TestStripeStreams : public StripeStreamsBase {
     VELOX_UNSUPPORTED();
   }
 
+  uint32_t stripeIndex() const override {
+    VELOX_UNSUPPORTED();
+  }
+
+  uint64_t stripeRows() const override {
+    VELOX_UNSUPPORTED();
+  }
+
   MOCK_CONST_METHOD2(
       getEncodingProxy,
       proto::ColumnEncoding*(uint32_t, uint32_t));
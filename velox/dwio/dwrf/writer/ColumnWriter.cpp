@@ -326,6 +326,7 @@ class IntegerColumnWriter : public ColumnWriter {
     // Add entry with stats for either case.
     indexBuilder_->addEntry(*indexStatsBuilder_);
     indexStatsBuilder_->reset();
+    addBloomFilterEntry();
     ColumnWriter::recordPosition();
     // TODO: the only way useDictionaryEncoding_ right now is
     // through abandonDictionary, so we already have the stream initialization
@@ -514,6 +515,9 @@ uint64_t IntegerColumnWriter<T>::writeDict(
     T value = decodedVector.valueAt<T>(pos);
     rows_.unsafeAppend(dictEncoder_.addKey(value));
     statsBuilder.addValues(value);
+    if (bloomFilter_) {
+      bloomFilter_->addLong(value);
+    }
   };
 
   uint64_t nullCount = 0;
@@ -552,6 +556,13 @@ uint64_t IntegerColumnWriter<T>::writeDirect(
   auto vals = flatVector->rawValues();
 
   auto count = dataDirect_->add(vals, ranges, nulls);
+  if (bloomFilter_) {
+    for (auto& pos : ranges) {
+      if (!nulls || !bits::isBitNull(nulls, pos)) {
+        bloomFilter_->addLong(vals[pos]);
+      }
+    }
+  }
   StatisticsBuilderUtils::addValues<T>(
       dynamic_cast<IntegerStatisticsBuilder&>(*indexStatsBuilder_),
       slice,
@@ -908,6 +919,7 @@ class StringColumnWriter : public ColumnWriter {
     // Add entry with stats for either case.
     indexBuilder_->addEntry(*indexStatsBuilder_);
     indexStatsBuilder_->reset();
+    addBloomFilterEntry();
     ColumnWriter::recordPosition();
     // TODO: the only way useDictionaryEncoding_ right now is
     // through abandonDictionary, so we already have the stream initialization
@@ -1112,6 +1124,9 @@ uint64_t StringColumnWriter::writeDict(
     rows_.unsafeAppend(dictEncoder_.addKey(sp, strideIndex));
     statsBuilder.addValues(sp);
     rawSize += sp.size();
+    if (bloomFilter_) {
+      bloomFilter_->addBytes(sp.data(), sp.size());
+    }
   };
 
   uint64_t nullCount = 0;
@@ -1156,6 +1171,9 @@ uint64_t StringColumnWriter::writeDirect(
     auto size = sp.size();
     dataDirect_->write(sp.data(), size);
     statsBuilder.addValues(sp);
+    if (bloomFilter_) {
+      bloomFilter_->addBytes(sp.data(), size);
+    }
     rawSize += size;
     lengths.unsafeAppend(size);
   };
@@ -1914,6 +1932,30 @@ uint64_t MapColumnWriter::write(const VectorPtr& slice, const Ranges& ranges) {
 
 } // namespace
 
+void ColumnWriter::initBloomFilter() {
+  if (!isIndexEnabled() || type_.parent == nullptr || type_.parent->id != 0) {
+    return;
+  }
+  switch (type_.type->kind()) {
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::VARCHAR:
+      break;
+    default:
+      return;
+  }
+  const auto& bloomFilterCols = getConfig(Config::BLOOM_FILTER_COLS);
+  if (std::find(
+          bloomFilterCols.begin(), bloomFilterCols.end(), type_.column) ==
+      bloomFilterCols.end()) {
+    return;
+  }
+  bloomFilter_ = std::make_unique<BloomFilter>(
+      context_.indexStride, getConfig(Config::BLOOM_FILTER_FPP));
+  bloomFilterStream_ = newStream(StreamKind::StreamKind_BLOOM_FILTER_UTF8);
+}
+
 std::unique_ptr<ColumnWriter> ColumnWriter::create(
     WriterContext& context,
     const TypeWithId& type,
@@ -18,6 +18,7 @@
 
 #include "gtest/gtest_prod.h"
 
+#include "velox/dwio/dwrf/common/BloomFilter.h"
 #include "velox/dwio/dwrf/common/ByteRLE.h"
 #include "velox/dwio/dwrf/common/Common.h"
 #include "velox/dwio/dwrf/common/IntEncoder.h"
@@ -72,6 +73,7 @@ class ColumnWriter {
     fileStatsBuilder_->merge(*indexStatsBuilder_);
     indexBuilder_->addEntry(*indexStatsBuilder_);
     indexStatsBuilder_->reset();
+    addBloomFilterEntry();
     recordPosition();
     for (auto& child : children_) {
       child->createIndexEntry();
@@ -105,6 +107,11 @@ class ColumnWriter {
     setEncoding(encoding);
     encodingOverride(encoding);
     indexBuilder_->flush();
+    if (bloomFilter_) {
+      bloomFilterIndex_.SerializeToZeroCopyStream(bloomFilterStream_.get());
+      bloomFilterStream_->flush();
+      bloomFilterIndex_.Clear();
+    }
   }
 
   virtual uint64_t writeFileStats(
@@ -151,6 +158,20 @@ class ColumnWriter {
     auto options = StatisticsBuilderOptions::fromConfig(context.getConfigs());
     indexStatsBuilder_ = StatisticsBuilder::create(type.type->kind(), options);
     fileStatsBuilder_ = StatisticsBuilder::create(type.type->kind(), options);
+    initBloomFilter();
+  }
+
+  // Creates the bloom filter and its stream if the column is listed in
+  // BLOOM_FILTER_COLS. Only top level integer and string columns are
+  // supported.
+  void initBloomFilter();
+
+  // Closes the bloom filter of the current stride.
+  void addBloomFilterEntry() {
+    if (bloomFilter_) {
+      bloomFilter_->toProto(*bloomFilterIndex_.add_bloomfilter());
+      bloomFilter_->reset();
+    }
   }
 
   virtual void recordPosition() {
@@ -209,6 +230,12 @@ class ColumnWriter {
   std::unique_ptr<IndexBuilder> indexBuilder_;
   std::unique_ptr<StatisticsBuilder> indexStatsBuilder_;
   std::unique_ptr<StatisticsBuilder> fileStatsBuilder_;
+  // Set if the column writes a BLOOM_FILTER_UTF8 stream. Values are added
+  // to 'bloomFilter_' and one entry per stride accumulates in
+  // 'bloomFilterIndex_' until flush.
+  std::unique_ptr<BloomFilter> bloomFilter_;
+  std::unique_ptr<BufferedOutputStream> bloomFilterStream_;
+  proto::BloomFilterIndex bloomFilterIndex_;
 
   std::unique_ptr<ByteRleEncoder> present_;
   bool hasNull_ = false;
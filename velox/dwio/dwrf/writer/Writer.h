@@ -38,6 +38,12 @@ class Writer : public WriterShared {
   // Write columnar batch
   void write(const VectorPtr& slice);
 
+  // Ends the current stripe, so that rows written after start a new one.
+  // No-op if no rows have been written since the last stripe.
+  void flush() {
+    WriterShared::flush();
+  }
+
  protected:
   void flushImpl(std::function<proto::ColumnEncoding&(uint32_t)>
                      encodingFactory) override {
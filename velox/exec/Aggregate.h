@@ -117,6 +117,33 @@ class Aggregate {
                 : updateSingleGroupFinal(group, rows, args, mayPushdown);
   }
 
+  // Returns true if 'this' can keep accumulators in dense arrays indexed by
+  // group number, see updateDense(). This is used when a HashTable in
+  // HashMode::kArray assigns the groups, so that an update is a loop over
+  // dense arrays instead of a store through a group pointer per row.
+  virtual bool supportsDenseAccumulators() const {
+    return false;
+  }
+
+  // Like update() but adds to accumulators in dense arrays owned by 'this'.
+  // @param groupNumbers The number of the group of each row of 'args'.
+  // @param numGroupNumbers Upper bound of 'groupNumbers'. Same for all calls
+  // between two flushDense().
+  virtual void updateDense(
+      const uint64_t* /*groupNumbers*/,
+      int32_t /*numGroupNumbers*/,
+      const SelectivityVector& /*rows*/,
+      const std::vector<VectorPtr>& /*args*/) {
+    VELOX_UNSUPPORTED();
+  }
+
+  // Combines the accumulators of updateDense() into the group rows and
+  // resets them.
+  // @param groups The group row of each group number. nullptr for a group
+  // number without a group.
+  // @param numGroupNumbers The 'numGroupNumbers' of updateDense().
+  virtual void flushDense(char** /*groups*/, int32_t /*numGroupNumbers*/) {}
+
   // Finalizes the state in groups. Defaults to no op for cases like
   // sum and max.
   virtual void finalize(char** groups, int32_t numGroups) = 0;
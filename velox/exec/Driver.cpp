@@ -89,6 +89,24 @@ DriverCtx::createConnectorQueryCtx(const std::string& connectorId) const {
       expressionEvaluator.get());
 }
 
+std::string blockingReasonToString(BlockingReason reason) {
+  switch (reason) {
+    case BlockingReason::kNotBlocked:
+      return "kNotBlocked";
+    case BlockingReason::kWaitForConsumer:
+      return "kWaitForConsumer";
+    case BlockingReason::kWaitForSplit:
+      return "kWaitForSplit";
+    case BlockingReason::kWaitForExchange:
+      return "kWaitForExchange";
+    case BlockingReason::kWaitForJoinBuild:
+      return "kWaitForJoinBuild";
+    case BlockingReason::kWaitForMemory:
+      return "kWaitForMemory";
+  }
+  VELOX_UNREACHABLE();
+}
+
 BlockingState::BlockingState(
     std::shared_ptr<Driver> driver,
     ContinueFuture&& future,
@@ -116,6 +134,8 @@ void BlockingState::setResume(
       .via(&exec)
       .thenValue([state, executor](bool /* unused */) {
         state->operator_->recordBlockingTime(state->sinceMicros_);
+        state->driver_->traceBlocked(
+            state->operator_, state->reason_, state->sinceMicros_);
         auto driver = state->driver_;
         {
           std::lock_guard<std::mutex> l(*driver->cancelPool()->mutex());
@@ -230,9 +250,55 @@ Driver::Driver(
     : ctx_(std::move(ctx)),
       task_(ctx_->task),
       cancelPool_(ctx_->task->cancelPool()),
-      operators_(std::move(operators)) {
+      operators_(std::move(operators)),
+      perfCountersEnabled_(ctx_->task->queryCtx()->perfCountersEnabled()),
+      traceRecorder_(ctx_->task->traceRecorder()) {
   // Operators need access to their Driver for adaptation.
   ctx_->driver = this;
+  if (traceRecorder_) {
+    for (auto& op : operators_) {
+      traceRecorder_->setOperatorName(
+          ctx_->pipelineId, op->stats().operatorId, op->stats().operatorType);
+    }
+  }
+}
+
+OperatorStats* FOLLY_NULLABLE Driver::perfStats(Operator* FOLLY_NONNULL op) {
+  return perfCountersEnabled_ ? &op->stats() : nullptr;
+}
+
+TraceScope Driver::traceScope(
+    TraceEvent::Type type,
+    Operator* FOLLY_NULLABLE op) {
+  if (!traceRecorder_) {
+    return TraceScope(nullptr, {});
+  }
+  TraceEvent event;
+  event.type = type;
+  event.pipelineId = ctx_->pipelineId;
+  event.driverId = ctx_->driverId;
+  event.operatorId = op ? op->stats().operatorId : -1;
+  event.threadId = state_.tid;
+  return TraceScope(traceRecorder_.get(), event);
+}
+
+void Driver::traceBlocked(
+    Operator* FOLLY_NONNULL op,
+    BlockingReason reason,
+    uint64_t sinceMicros) {
+  if (!traceRecorder_) {
+    return;
+  }
+  TraceEvent event;
+  event.type = TraceEvent::Type::kBlocked;
+  event.blockingReason = static_cast<uint8_t>(reason);
+  event.pipelineId = ctx_->pipelineId;
+  event.driverId = ctx_->driverId;
+  event.operatorId = op->stats().operatorId;
+  event.startMicros = sinceMicros;
+  const auto now = TraceRecorder::nowMicros();
+  event.durationMicros = now > sinceMicros ? now - sinceMicros : 0;
+  traceRecorder_->record(event);
 }
 
 namespace {
@@ -332,6 +398,7 @@ core::StopReason Driver::runInternal(
         }
         close();
       });
+  auto onThreadTrace = traceScope(TraceEvent::Type::kOnThread, nullptr);
   try {
     int32_t numOperators = operators_.size();
     ContinueFuture future(false);
@@ -367,6 +434,8 @@ core::StopReason Driver::runInternal(
             RowVectorPtr result;
             {
               OperationTimer timer(op->stats().getOutputTiming);
+              PerfCounterTimer perfTimer(perfStats(op));
+              auto trace = traceScope(TraceEvent::Type::kGetOutput, op);
               result = op->getOutput();
               if (result) {
                 op->stats().outputPositions += result->size();
@@ -377,6 +446,8 @@ core::StopReason Driver::runInternal(
             pushdownFilters(i);
             if (result) {
               OperationTimer timer(nextOp->stats().addInputTiming);
+              PerfCounterTimer perfTimer(perfStats(nextOp));
+              auto trace = traceScope(TraceEvent::Type::kAddInput, nextOp);
               nextOp->stats().inputPositions += result->size();
               nextOp->stats().inputBytes += resultBytes;
               nextOp->addInput(result);
@@ -406,6 +477,8 @@ core::StopReason Driver::runInternal(
               if (op->isFinishing()) {
                 if (!nextOp->isFinishing()) {
                   OperationTimer timer(nextOp->stats().finishTiming);
+                  PerfCounterTimer perfTimer(perfStats(nextOp));
+                  auto trace = traceScope(TraceEvent::Type::kFinish, nextOp);
                   nextOp->finish();
                   break;
                 }
@@ -419,6 +492,8 @@ core::StopReason Driver::runInternal(
           // will come back here after this is again on thread.
           {
             OperationTimer timer(op->stats().getOutputTiming);
+            PerfCounterTimer perfTimer(perfStats(op));
+            auto trace = traceScope(TraceEvent::Type::kGetOutput, op);
             op->getOutput();
           }
           pushdownFilters(i);
@@ -428,10 +503,14 @@ core::StopReason Driver::runInternal(
           // The source is not blocked and not interrupted.
           if (op->isFinishing()) {
             guard.notThrown();
+            // Record the on-thread time before close() detaches the Task.
+            onThreadTrace.end();
             close();
             return core::StopReason::kAtEnd;
           }
           OperationTimer timer(op->stats().finishTiming);
+          PerfCounterTimer perfTimer(perfStats(op));
+          auto trace = traceScope(TraceEvent::Type::kFinish, op);
           op->finish();
           break;
         }
@@ -534,6 +613,19 @@ bool Driver::mayPushdownAggregation(Operator* aggregation) const {
       aggregation->toString());
 }
 
+std::optional<std::vector<ChannelIndex>>
+Driver::sourceStatsAggregationChannels() const {
+  if (operators_.size() < 2) {
+    return std::nullopt;
+  }
+  auto aggregation = operators_[1].get();
+  auto channels = aggregation->statsAggregationChannels();
+  if (!channels || !mayPushdownAggregation(aggregation)) {
+    return std::nullopt;
+  }
+  return channels;
+}
+
 std::unordered_set<ChannelIndex> Driver::canPushdownFilters(
     Operator* FOLLY_NONNULL filterSource,
     const std::vector<ChannelIndex>& channels) const {
@@ -19,6 +19,7 @@
 #include "velox/connectors/Connector.h"
 #include "velox/core/PlanNode.h"
 #include "velox/core/QueryCtx.h"
+#include "velox/exec/TraceRecorder.h"
 
 namespace facebook::velox::exec {
 
@@ -37,6 +38,8 @@ enum class BlockingReason {
   kWaitForMemory
 };
 
+std::string blockingReasonToString(BlockingReason reason);
+
 using ContinueFuture = folly::SemiFuture<bool>;
 
 class BlockingState {
@@ -167,6 +170,13 @@ class Driver {
   // order-preserving and do not increase cardinality.
   bool mayPushdownAggregation(Operator* FOLLY_NONNULL aggregation) const;
 
+  // Returns statsAggregationChannels() of the operator right after the
+  // source if it is an aggregation that may be answered from statistics of
+  // the source's data. Operators in between, e.g. filters, would make the
+  // statistics not apply, so the aggregation must directly follow the source.
+  std::optional<std::vector<ChannelIndex>> sourceStatsAggregationChannels()
+      const;
+
   // Returns a subset of channels for which there are operators upstream from
   // filterSource that accept dynamically generated filters.
   std::unordered_set<ChannelIndex> canPushdownFilters(
@@ -186,6 +196,13 @@ class Driver {
     return ctx_.get();
   }
 
+  // Adds the time 'op' blocked 'this' for 'reason' since 'sinceMicros' to
+  // the trace of the Task if it has one.
+  void traceBlocked(
+      Operator* FOLLY_NONNULL op,
+      BlockingReason reason,
+      uint64_t sinceMicros);
+
  private:
   core::StopReason runInternal(
       std::shared_ptr<Driver>& self,
@@ -197,6 +214,14 @@ class Driver {
   // position in the pipeline.
   void pushdownFilters(int operatorIndex);
 
+  // Returns the stats of 'op' if the calls into 'op' are to be counted with
+  // a PerfCounterTimer, nullptr otherwise.
+  OperatorStats* FOLLY_NULLABLE perfStats(Operator* FOLLY_NONNULL op);
+
+  // Returns a scope that adds an event of 'type' for 'op' to the trace of
+  // the Task if it has one. 'op' is nullptr for TraceEvent::Type::kOnThread.
+  TraceScope traceScope(TraceEvent::Type type, Operator* FOLLY_NULLABLE op);
+
   std::unique_ptr<DriverCtx> ctx_;
   std::shared_ptr<Task> task_;
   core::CancelPoolPtr cancelPool_;
@@ -207,6 +232,15 @@ class Driver {
   std::vector<std::unique_ptr<Operator>> operators_;
 
   BlockingReason blockingReason_{BlockingReason::kNotBlocked};
+
+  // True if hardware events are counted for each operator. See
+  // QueryCtx::kPerfCountersEnabled.
+  const bool perfCountersEnabled_;
+
+  // The trace of the Task or nullptr if QueryCtx::kTraceEnabled is not set.
+  // Shared with the Task since BlockingState::setResume() traces after the
+  // Task may be freed.
+  const std::shared_ptr<TraceRecorder> traceRecorder_;
 };
 
 using OperatorSupplier = std::function<std::unique_ptr<Operator>(
@@ -152,6 +152,7 @@ void GroupingSet::addInput(const RowVectorPtr& input, bool mayPushdown) {
   }
   if (rehash) {
     if (table_->hashMode() != BaseHashTable::HashMode::kHash) {
+      flushDenseAccumulators();
       table_->decideHashMode(input->size());
     }
     addInput(input, mayPushdown);
@@ -160,6 +161,7 @@ void GroupingSet::addInput(const RowVectorPtr& input, bool mayPushdown) {
   numAdded_ += lookup_->rows.size();
   table_->groupProbe(*lookup_);
   prepareMaskedSelectivityVectors(input);
+  const auto numGroupNumbers = numDenseGroupNumbers();
   for (auto i = 0; i < aggregates_.size(); ++i) {
     const SelectivityVector& rows = getSelectivityVector(i);
     // TODO(spershin): We disable the pushdown at the moment if selectivity
@@ -168,6 +170,14 @@ void GroupingSet::addInput(const RowVectorPtr& input, bool mayPushdown) {
     const bool canPushdown = (&rows != &activeRows_) && mayPushdown &&
         mayPushdown_[i] && areAllLazyNotLoaded(tempVectors_);
     populateTempVectors(i, input);
+    if (numGroupNumbers && !canPushdown &&
+        aggregates_[i]->supportsDenseAccumulators()) {
+      // In kArray mode the hash of a row is the number of its group.
+      aggregates_[i]->updateDense(
+          lookup_->hashes.data(), numGroupNumbers, rows, tempVectors_);
+      hasDenseAccumulators_ = true;
+      continue;
+    }
     aggregates_[i]->update(
         lookup_->hits.data(), rows, tempVectors_, canPushdown);
   }
@@ -262,6 +272,25 @@ const SelectivityVector& GroupingSet::getSelectivityVector(
   return it->second.rows;
 }
 
+int32_t GroupingSet::numDenseGroupNumbers() const {
+  if (table_->hashMode() != BaseHashTable::HashMode::kArray) {
+    return 0;
+  }
+  const int64_t numGroupNumbers = table_->arrayGroups().size();
+  return numGroupNumbers <= kMaxDenseGroupNumbers ? numGroupNumbers : 0;
+}
+
+void GroupingSet::flushDenseAccumulators() {
+  if (!hasDenseAccumulators_) {
+    return;
+  }
+  auto groups = table_->arrayGroups();
+  for (auto& aggregate : aggregates_) {
+    aggregate->flushDense(groups.data(), groups.size());
+  }
+  hasDenseAccumulators_ = false;
+}
+
 bool GroupingSet::getOutput(
     int32_t batchSize,
     bool isPartial,
@@ -291,6 +320,10 @@ bool GroupingSet::getOutput(
     return true;
   }
 
+  if (table_) {
+    flushDenseAccumulators();
+  }
+
   // @lint-ignore CLANGTIDY
   char* groups[batchSize];
   int32_t numGroups =
@@ -318,6 +351,7 @@ bool GroupingSet::getOutput(
 
 void GroupingSet::resetPartial() {
   if (table_) {
+    flushDenseAccumulators();
     table_->clear();
   }
 }
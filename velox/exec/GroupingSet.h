@@ -63,6 +63,20 @@ class GroupingSet {
   // index for this aggregation), otherwise it returns reference to activeRows_.
   const SelectivityVector& getSelectivityVector(size_t aggregateIndex) const;
 
+  // Returns the number of group numbers of 'table_' if the aggregates that
+  // support it may keep their accumulators in dense arrays, 0 otherwise.
+  // See Aggregate::updateDense().
+  int32_t numDenseGroupNumbers() const;
+
+  // Adds the dense accumulators of the aggregates to the group rows. Called
+  // before the accumulators in the rows are read and before the group
+  // numbers change.
+  void flushDenseAccumulators();
+
+  // Largest HashMode::kArray table for which the aggregates keep dense
+  // accumulators. Larger arrays of accumulators would not stay in cache.
+  static constexpr int32_t kMaxDenseGroupNumbers = 64 * 1024;
+
   std::vector<ChannelIndex> keyChannels_;
   std::vector<std::unique_ptr<VectorHasher>> hashers_;
   const bool isGlobal_;
@@ -87,6 +101,8 @@ class GroupingSet {
   std::unique_ptr<BaseHashTable> table_;
   std::unique_ptr<HashLookup> lookup_;
   uint64_t numAdded_ = 0;
+  // True if an aggregate has dense accumulators not yet added to the rows.
+  bool hasDenseAccumulators_ = false;
   SelectivityVector activeRows_;
   // For aggregations that use masks we keep selectivity vectors in this map,
   // keyed by the channel index, so the selectivity vectors can be reused.
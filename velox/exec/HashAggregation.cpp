@@ -18,6 +18,27 @@
 
 namespace facebook::velox::exec {
 
+namespace {
+// Returns true if aggregate 'name' over 'channels' is count, min or max of a
+// single input column or constant. Adds the input column of min and max to
+// 'minMaxChannels'.
+bool addStatsAggregate(
+    const std::string& name,
+    const std::vector<ChannelIndex>& channels,
+    std::vector<ChannelIndex>& minMaxChannels) {
+  if (name == "count") {
+    return channels.size() <= 1;
+  }
+  if ((name == "min" || name == "max") && channels.size() == 1) {
+    if (channels[0] != kConstantChannel) {
+      minMaxChannels.push_back(channels[0]);
+    }
+    return true;
+  }
+  return false;
+}
+} // namespace
+
 HashAggregation::HashAggregation(
     int32_t operatorId,
     DriverCtx* driverCtx,
@@ -58,6 +79,12 @@ HashAggregation::HashAggregation(
   aggrMaskChannels.reserve(numAggregates);
   std::vector<std::vector<ChannelIndex>> args;
   std::vector<std::vector<VectorPtr>> constantLists;
+  // A global aggregation over raw input made only of count, min and max can
+  // be answered from statistics.
+  bool fromStats = isGlobal_ && !isDistinct_ &&
+      (aggregationNode->step() == core::AggregationNode::Step::kPartial ||
+       aggregationNode->step() == core::AggregationNode::Step::kSingle);
+  std::vector<ChannelIndex> minMaxChannels;
   for (auto i = 0; i < numAggregates; i++) {
     const auto& aggregate = aggregationNode->aggregates()[i];
 
@@ -89,9 +116,14 @@ HashAggregation::HashAggregation(
     const auto& resultType = outputType_->childAt(numHashers + i);
     aggregates.push_back(Aggregate::create(
         aggregate->name(), aggregationNode->step(), argTypes, resultType));
+    fromStats = fromStats && aggrMask == nullptr &&
+        addStatsAggregate(aggregate->name(), channels, minMaxChannels);
     args.push_back(channels);
     constantLists.push_back(constants);
   }
+  if (fromStats) {
+    statsAggregationChannels_ = std::move(minMaxChannels);
+  }
 
   // Check that aggregate result type match the output type
   for (auto i = 0; i < aggregates.size(); i++) {
@@ -48,6 +48,11 @@ class HashAggregation : public Operator {
     groupingSet_.reset();
   }
 
+  std::optional<std::vector<ChannelIndex>> statsAggregationChannels()
+      const override {
+    return statsAggregationChannels_;
+  }
+
  private:
   static constexpr int32_t kOutputBatchSize = 10'000;
 
@@ -62,6 +67,9 @@ class HashAggregation : public Operator {
   RowContainerIterator resultIterator_;
   bool pushdownChecked_ = false;
   bool mayPushdown_ = false;
+  // The inputs of min and max if all aggregates are count, min or max. See
+  // Operator::statsAggregationChannels().
+  std::optional<std::vector<ChannelIndex>> statsAggregationChannels_;
 };
 
 } // namespace facebook::velox::exec
@@ -15,6 +15,7 @@
  */
 
 #include "velox/exec/HashBuild.h"
+#include "velox/exec/HashJoinTableCache.h"
 #include "velox/exec/OperatorUtils.h"
 #include "velox/exec/Task.h"
 
@@ -27,6 +28,9 @@ void HashJoinBridge::setHashTable(std::unique_ptr<BaseHashTable> table) {
   VELOX_CHECK(!table_, "setHashTable may be called only once");
   // Ownership becomes shared.
   table_.reset(table.release());
+  if (!cacheKey_.empty()) {
+    HashJoinTableCache::instance()->insert(cacheKey_, {table_, false});
+  }
   notifyConsumersLocked();
 }
 
@@ -37,7 +41,31 @@ void HashJoinBridge::setAntiJoinHasNullKeys() {
       "Only one of setAntiJoinHasNullKeys or setHashTable may be called");
 
   antiJoinHasNullKeys_ = true;
+  if (!cacheKey_.empty()) {
+    HashJoinTableCache::instance()->insert(cacheKey_, {nullptr, true});
+  }
+  notifyConsumersLocked();
+}
+
+bool HashJoinBridge::setFromCache(const std::string& cacheKey) {
+  std::lock_guard<std::mutex> l(mutex_);
+  if (fromCache_.has_value()) {
+    return fromCache_.value();
+  }
+  auto entry = HashJoinTableCache::instance()->find(cacheKey);
+  fromCache_ = entry.has_value();
+  if (!entry.has_value()) {
+    // Otherwise the table is built in the memory of the query and not
+    // cached.
+    if (HashJoinTableCache::instance()->hasRoom()) {
+      cacheKey_ = cacheKey;
+    }
+    return false;
+  }
+  table_ = std::move(entry->table);
+  antiJoinHasNullKeys_ = entry->antiJoinHasNullKeys;
   notifyConsumersLocked();
+  return true;
 }
 
 std::optional<HashJoinBridge::HashBuildResult> HashJoinBridge::tableOrFuture(
@@ -95,6 +123,22 @@ HashBuild::HashBuild(
   const bool allowDuplicates =
       !joinNode->isSemiJoin() && !joinNode->isAntiJoin();
 
+  const auto cacheKey =
+      operatorCtx_->task()->queryCtx()->hashJoinTableCacheKey();
+  if (!cacheKey.empty() && HashJoinTableCache::isCacheable(*joinNode)) {
+    auto bridge = operatorCtx_->task()->getHashJoinBridge(planNodeId());
+    if (bridge->setFromCache(
+            HashJoinTableCache::makeKey(*joinNode, cacheKey))) {
+      // The probe side already has the table. The upstream operators
+      // finish without producing input for 'this'.
+      isFinishing_ = true;
+      stats_.addRuntimeStat("hashTableFromCache", 1);
+    } else if (bridge->buildsForCache()) {
+      // The table may be shared by other Tasks after this one is gone.
+      mappedMemory_ = HashJoinTableCache::instance()->mappedMemory();
+    }
+  }
+
   table_ = HashTable<true>::createForJoin(
       std::move(keyHashers), dependentTypes, allowDuplicates, mappedMemory_);
   analyzeKeys_ = table_->hashMode() != BaseHashTable::HashMode::kHash;
@@ -143,21 +187,23 @@ void HashBuild::addInput(RowVectorPtr input) {
   }
   auto rows = table_->rows();
   auto nextOffset = rows->nextOffset();
+  newRows_.resize(input->size());
   activeRows_.applyToSelected([&](auto rowIndex) {
     char* newRow = rows->newRow();
     if (nextOffset) {
       *reinterpret_cast<char**>(newRow + nextOffset) = nullptr;
     }
-    // Store the columns for each row in sequence. At probe time
-    // strings of the row will probably be in consecutive places, so
-    // reading one will prime the cache for the next.
-    for (auto i = 0; i < hashers.size(); ++i) {
-      rows->store(hashers[i]->decodedVector(), rowIndex, newRow, i);
-    }
-    for (auto i = 0; i < dependentChannels_.size(); ++i) {
-      rows->store(*decoders_[i], rowIndex, newRow, i + hashers.size());
-    }
+    newRows_[rowIndex] = newRow;
   });
+  // Store the new rows a column at a time.
+  for (auto i = 0; i < hashers.size(); ++i) {
+    rows->storeColumn(
+        hashers[i]->decodedVector(), activeRows_, newRows_.data(), i);
+  }
+  for (auto i = 0; i < dependentChannels_.size(); ++i) {
+    rows->storeColumn(
+        *decoders_[i], activeRows_, newRows_.data(), i + hashers.size());
+  }
 }
 
 void HashBuild::finish() {
@@ -44,9 +44,30 @@ class HashJoinBridge : public JoinBridge {
 
   std::optional<HashBuildResult> tableOrFuture(ContinueFuture* future);
 
+  // Looks up the result of the build side in HashJoinTableCache under
+  // 'cacheKey'. The first call decides for all the HashBuild operators of
+  // the join. Returns true if the result is cached, in which case it is
+  // handed over to the probe side and the build side has nothing to do.
+  // Otherwise, returns false and setHashTable() or
+  // setAntiJoinHasNullKeys() add the result of the build to the cache if
+  // the cache had room for building it. See buildsForCache().
+  bool setFromCache(const std::string& cacheKey);
+
+  // Returns true if the build side is to be built in the memory of
+  // HashJoinTableCache and added to the cache. Valid after setFromCache()
+  // returned false.
+  bool buildsForCache() {
+    std::lock_guard<std::mutex> l(mutex_);
+    return !cacheKey_.empty();
+  }
+
  private:
   std::shared_ptr<BaseHashTable> table_;
   bool antiJoinHasNullKeys_{false};
+
+  // Set on the first call to setFromCache().
+  std::optional<bool> fromCache_;
+  std::string cacheKey_;
 };
 
 // Builds a hash table for use in HashProbe. This is the final
@@ -116,6 +137,9 @@ class HashBuild final : public Operator {
   // Set of active rows during addInput().
   SelectivityVector activeRows_;
 
+  // New rows of 'table_' for 'activeRows_', indexed by input row.
+  std::vector<char*> newRows_;
+
   // True if this is a build side of an anti join and has at least one entry
   // with null join keys.
   bool antiJoinHasNullKeys_{false};
@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/HashJoinTableCache.h"
+
+#include <gflags/gflags.h>
+
+DEFINE_int32(
+    hash_join_table_cache_mb,
+    facebook::velox::exec::HashJoinTableCache::kDefaultCapacity >> 20,
+    "Process-wide limit in mb on the memory of the hash join tables that are "
+    "shared across queries. This memory is not counted against any query.");
+
+namespace facebook::velox::exec {
+
+HashJoinTableCache::HashJoinTableCache(
+    int64_t capacity,
+    memory::MappedMemory* parent)
+    : tracker_(memory::MemoryUsageTracker::create()),
+      mappedMemory_(parent->addChild(tracker_)),
+      capacity_(capacity) {}
+
+// static
+HashJoinTableCache* HashJoinTableCache::instance() {
+  // Not destroyed at exit since the tables may still be in use.
+  static auto* cache = new HashJoinTableCache(
+      static_cast<int64_t>(FLAGS_hash_join_table_cache_mb) << 20);
+  return cache;
+}
+
+// static
+std::string HashJoinTableCache::makeKey(
+    const core::HashJoinNode& joinNode,
+    const std::string& dataKey) {
+  const auto& build = joinNode.sources()[1];
+  std::stringstream key;
+  key << static_cast<int>(joinNode.joinType()) << "[";
+  for (const auto& rightKey : joinNode.rightKeys()) {
+    key << rightKey->toString() << ",";
+  }
+  key << "]" << build->outputType()->toString() << "\n"
+      << build->toString(true, true) << dataKey;
+  return key.str();
+}
+
+// static
+bool HashJoinTableCache::isCacheable(const core::HashJoinNode& joinNode) {
+  return !joinNode.isRightJoin() && !joinNode.isFullJoin();
+}
+
+std::optional<HashJoinTableCache::Entry> HashJoinTableCache::find(
+    const std::string& key) {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    ++numMisses_;
+    return std::nullopt;
+  }
+  ++numHits_;
+  it->second.lastUse = ++useCounter_;
+  return it->second.entry;
+}
+
+bool HashJoinTableCache::insert(const std::string& key, Entry entry) {
+  const int64_t bytes = entry.table ? entry.table->allocatedBytes() : 0;
+  std::lock_guard<std::mutex> l(mutex_);
+  if (entries_.count(key)) {
+    return false;
+  }
+  if (!makeSpaceLocked(bytes)) {
+    ++numRejected_;
+    return false;
+  }
+  entries_[key] = CacheEntry{std::move(entry), bytes, ++useCounter_};
+  cachedBytes_ += bytes;
+  return true;
+}
+
+void HashJoinTableCache::setCapacity(int64_t capacity) {
+  std::lock_guard<std::mutex> l(mutex_);
+  capacity_ = capacity;
+  makeSpaceLocked(0);
+}
+
+bool HashJoinTableCache::hasRoom() {
+  std::lock_guard<std::mutex> l(mutex_);
+  const auto allocatedBytes = tracker_->getCurrentTotalBytes();
+  if (allocatedBytes < capacity_) {
+    return true;
+  }
+  // Evicting the unused tables frees their memory. The tables outside of
+  // the cache, e.g. being built or evicted while in use, take the rest.
+  makeSpaceLocked(allocatedBytes - cachedBytes_ + 1);
+  return tracker_->getCurrentTotalBytes() < capacity_;
+}
+
+void HashJoinTableCache::clear() {
+  std::lock_guard<std::mutex> l(mutex_);
+  entries_.clear();
+  cachedBytes_ = 0;
+}
+
+HashJoinTableCache::Stats HashJoinTableCache::stats() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  Stats stats;
+  stats.numEntries = entries_.size();
+  stats.cachedBytes = cachedBytes_;
+  stats.allocatedBytes = tracker_->getCurrentTotalBytes();
+  stats.numHits = numHits_;
+  stats.numMisses = numMisses_;
+  stats.numEvictions = numEvictions_;
+  stats.numRejected = numRejected_;
+  return stats;
+}
+
+bool HashJoinTableCache::makeSpaceLocked(int64_t bytes) {
+  while (cachedBytes_ + bytes > capacity_) {
+    // The entries are few and large, so a scan for the least recently used
+    // one is cheap compared to building any of them.
+    auto victim = entries_.end();
+    for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+      // The table is in use if a probe holds a reference besides the cache.
+      if (it->second.entry.table.use_count() > 1) {
+        continue;
+      }
+      if (victim == entries_.end() ||
+          it->second.lastUse < victim->second.lastUse) {
+        victim = it;
+      }
+    }
+    if (victim == entries_.end()) {
+      return false;
+    }
+    cachedBytes_ -= victim->second.bytes;
+    entries_.erase(victim);
+    ++numEvictions_;
+  }
+  return true;
+}
+
+} // namespace facebook::velox::exec
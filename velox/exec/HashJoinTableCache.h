@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <folly/container/F14Map.h>
+
+#include "velox/common/memory/MappedMemory.h"
+#include "velox/core/PlanNode.h"
+#include "velox/exec/HashTable.h"
+
+namespace facebook::velox::exec {
+
+// Process-wide cache of finished hash join build sides. Tasks that run the
+// same build side over the same data, e.g. many concurrent queries joining
+// one dimension table, probe one shared HashTable instead of each building
+// its own. A build side is cached only if its query sets
+// QueryCtx::kHashJoinTableCacheKey to a string that identifies the data it
+// reads. The tables are allocated from mappedMemory() so that they outlive
+// the Task that built them and are accounted to the cache, not to a query.
+//
+// This memory is outside of the MemoryPools of all queries and is not
+// counted against their limits. It is bounded by the capacity, which is set
+// by --hash_join_table_cache_mb for instance(): a build side is built in it
+// only if hasRoom(), so the allocation exceeds the capacity by at most the
+// tables being built at the same time.
+//
+// A table is referenced by shared_ptr from the cache and from the probes
+// using it. Eviction drops the reference of the cache, so a table is freed
+// when the last probe using it finishes. Only entries not in use by any
+// probe are evicted to make space, least recently used first.
+class HashJoinTableCache {
+ public:
+  // The result of a build side. See HashJoinBridge::HashBuildResult.
+  struct Entry {
+    std::shared_ptr<BaseHashTable> table;
+    bool antiJoinHasNullKeys{false};
+  };
+
+  struct Stats {
+    int32_t numEntries{0};
+    // Sum of the allocatedBytes() of the cached tables.
+    int64_t cachedBytes{0};
+    // Memory allocated from mappedMemory(), including tables being built,
+    // tables not admitted and evicted tables still in use.
+    int64_t allocatedBytes{0};
+    int64_t numHits{0};
+    int64_t numMisses{0};
+    int64_t numEvictions{0};
+    // Number of tables not cached because the entries in use left no room.
+    int64_t numRejected{0};
+  };
+
+  static constexpr int64_t kDefaultCapacity = 1L << 30;
+
+  explicit HashJoinTableCache(
+      int64_t capacity,
+      memory::MappedMemory* parent = memory::MappedMemory::getInstance());
+
+  // Returns the process-wide instance, of --hash_join_table_cache_mb
+  // capacity.
+  static HashJoinTableCache* instance();
+
+  // Returns the key for the build side of 'joinNode' reading the data
+  // identified by 'dataKey'. This covers the plan of the build side, its
+  // keys and the join type, which decides how duplicate keys are kept.
+  static std::string makeKey(
+      const core::HashJoinNode& joinNode,
+      const std::string& dataKey);
+
+  // Returns true if the build side of 'joinNode' may be shared. Right and
+  // full outer joins mark the build rows they hit, so their tables are not
+  // shared.
+  static bool isCacheable(const core::HashJoinNode& joinNode);
+
+  // Returns the entry for 'key' or std::nullopt if there is none.
+  std::optional<Entry> find(const std::string& key);
+
+  // Adds 'entry' under 'key', evicting unused entries to stay within the
+  // capacity. Returns false if 'entry' does not fit or if there already is
+  // an entry for 'key', which is then kept.
+  bool insert(const std::string& key, Entry entry);
+
+  // Sets the maximum total size of the cached tables, evicting unused
+  // entries if needed.
+  void setCapacity(int64_t capacity);
+
+  // Returns true if the memory allocated from mappedMemory() is under the
+  // capacity, so that another table may be built in it. Evicts unused
+  // entries if needed.
+  bool hasRoom();
+
+  // Drops all entries.
+  void clear();
+
+  Stats stats() const;
+
+  // Memory for the tables of cacheable build sides.
+  memory::MappedMemory* mappedMemory() const {
+    return mappedMemory_.get();
+  }
+
+ private:
+  struct CacheEntry {
+    Entry entry;
+    int64_t bytes;
+    uint64_t lastUse;
+  };
+
+  // Evicts unused entries in LRU order until 'bytes' more fit in the
+  // capacity. Returns false if they do not.
+  bool makeSpaceLocked(int64_t bytes);
+
+  const std::shared_ptr<memory::MemoryUsageTracker> tracker_;
+  const std::shared_ptr<memory::MappedMemory> mappedMemory_;
+
+  mutable std::mutex mutex_;
+  folly::F14FastMap<std::string, CacheEntry> entries_;
+  int64_t capacity_;
+  int64_t cachedBytes_{0};
+  uint64_t useCounter_{0};
+  int64_t numHits_{0};
+  int64_t numMisses_{0};
+  int64_t numEvictions_{0};
+  int64_t numRejected_{0};
+};
+
+} // namespace facebook::velox::exec
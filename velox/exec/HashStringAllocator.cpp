@@ -227,6 +227,33 @@ HashStringAllocator::allocate(int32_t size, bool exactSize) {
   return header;
 }
 
+void HashStringAllocator::allocateBatch(
+    folly::Range<const int32_t*> sizes,
+    Header** headers) {
+  VELOX_CHECK(
+      !currentHeader_,
+      "Do not call allocateBatch() when a write is in progress");
+  if (sizes.empty()) {
+    return;
+  }
+  // The blocks are adjacent, each after the Header of the next.
+  int64_t totalSize = -static_cast<int64_t>(sizeof(Header));
+  for (auto size : sizes) {
+    totalSize += std::max(size, kMinAlloc) + sizeof(Header);
+  }
+  VELOX_CHECK_LE(totalSize, Header::kSizeMask);
+  auto header = allocate(totalSize, true);
+  // The last block gets the possible excess of the allocation.
+  auto end = header->end();
+  for (auto i = 0; i < sizes.size() - 1; ++i) {
+    headers[i] = header;
+    header->setSize(std::max(sizes[i], kMinAlloc));
+    auto next = header->end();
+    header = new (next) Header(end - next - sizeof(Header));
+  }
+  headers[sizes.size() - 1] = header;
+}
+
 HashStringAllocator::Header* FOLLY_NULLABLE
 HashStringAllocator::allocateFromFreeList(
     int32_t preferredSize,
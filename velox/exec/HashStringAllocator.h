@@ -179,6 +179,14 @@ class HashStringAllocator : public StreamArena {
     return allocate(std::max(size, kMinAlloc), true);
   }
 
+  // Allocates a contiguous block of at least 'sizes[i]' bytes for each i
+  // and stores its Header in 'headers[i]'. The blocks are cut from a single
+  // allocation, so that storing a batch of strings looks up the free list
+  // once. Each block is an independent allocation and is freed with free().
+  void allocateBatch(
+      folly::Range<const int32_t*> sizes,
+      Header* FOLLY_NONNULL* FOLLY_NONNULL headers);
+
   // Returns the header immediately below 'data'.
   static Header* FOLLY_NONNULL headerOf(const void* FOLLY_NONNULL data) {
     return reinterpret_cast<Header*>(
@@ -131,6 +131,11 @@ class BaseHashTable {
   /// VectorHashers of 'this'.
   virtual HashMode hashMode() const = 0;
 
+  /// Returns the groups of a table in HashMode::kArray indexed by the group
+  /// number groupProbe() leaves in HashLookup::hashes. nullptr for a number
+  /// without a group.
+  virtual folly::Range<char**> arrayGroups() const = 0;
+
   /// Disables use of array or normalized key hash modes.
   void forceGenericHashMode() {
     setHashMode(HashMode::kHash, 0);
@@ -274,6 +279,11 @@ class HashTable : public BaseHashTable {
 
   void decideHashMode(int32_t numNew) override;
 
+  folly::Range<char**> arrayGroups() const override {
+    VELOX_CHECK(hashMode_ == HashMode::kArray);
+    return folly::Range<char**>(table_, size_);
+  }
+
   // Moves the contents of 'tables' into 'this' and prepares 'this'
   // for use in hash join probe. A hash join build side is prepared as
   // follows: 1. Each build side thread gets a random selection of the
@@ -49,9 +49,7 @@ class MergeSourceData {
     DecodedVector decoded;
     for (int col = 0; col < input->childrenSize(); ++col) {
       decoded.decode(*input->childAt(col), allRows);
-      for (int i = 0; i < input->size(); ++i) {
-        data_->store(decoded, i, rows_[i], col);
-      }
+      data_->storeColumn(decoded, allRows, rows_.data(), col);
     }
   }
 
@@ -224,6 +224,18 @@ std::vector<ChannelIndex> calculateOutputChannels(
   return outputChannels;
 }
 
+PerfCounterTimer::~PerfCounterTimer() {
+  process::PerfCounts end;
+  if (!stats_ || !process::readThreadPerfCounts(end)) {
+    return;
+  }
+  const auto counts = end - start_;
+  stats_->addRuntimeStat("perfCycles", counts.cycles);
+  stats_->addRuntimeStat("perfInstructions", counts.instructions);
+  stats_->addRuntimeStat("perfLlcMisses", counts.llcMisses);
+  stats_->addRuntimeStat("perfBranchMisses", counts.branchMisses);
+}
+
 void OperatorStats::add(const OperatorStats& other) {
   numSplits += other.numSplits;
   rawInputBytes += other.rawInputBytes;
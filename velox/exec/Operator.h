@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #pragma once
+#include "velox/common/process/PerfCounters.h"
 #include "velox/common/time/CpuWallTimer.h"
 #include "velox/core/PlanNode.h"
 #include "velox/exec/Driver.h"
@@ -151,6 +152,24 @@ struct OperatorStats {
   void clear();
 };
 
+// Adds the hardware events counted on the calling thread during the
+// lifetime of 'this' to the runtime stats of 'stats'. Does nothing if
+// 'stats' is nullptr or if the counters are not available.
+class PerfCounterTimer {
+ public:
+  explicit PerfCounterTimer(OperatorStats* stats) : stats_(stats) {
+    if (stats_ && !process::readThreadPerfCounts(start_)) {
+      stats_ = nullptr;
+    }
+  }
+
+  ~PerfCounterTimer();
+
+ private:
+  OperatorStats* stats_;
+  process::PerfCounts start_;
+};
+
 class OperatorCtx {
  public:
   explicit OperatorCtx(DriverCtx* driverCtx)
@@ -317,6 +336,17 @@ class Operator {
     return false;
   }
 
+  // Returns the input channels whose minimum and maximum, together with the
+  // number of input rows and the non-null count of each input column, fully
+  // determine the result of 'this'. The source operator may then replace
+  // its output with any rows that have the same such values, e.g. rows made
+  // from file statistics. Returns std::nullopt if the result depends on
+  // anything else.
+  virtual std::optional<std::vector<ChannelIndex>> statsAggregationChannels()
+      const {
+    return std::nullopt;
+  }
+
   OperatorStats& stats() {
     return stats_;
   }
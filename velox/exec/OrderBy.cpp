@@ -50,9 +50,7 @@ void OrderBy::addInput(RowVectorPtr input) {
   }
   for (size_t col = 0; col < input->childrenSize(); ++col) {
     DecodedVector decoded(*input->childAt(col), allRows);
-    for (int i = 0; i < input->size(); ++i) {
-      data_->store(decoded, i, rows[i], col);
-    }
+    data_->storeColumn(decoded, allRows, rows.data(), col);
   }
 
   numRows_ += allRows.size();
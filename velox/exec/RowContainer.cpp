@@ -282,6 +282,77 @@ void RowContainer::store(
   }
 }
 
+void RowContainer::storeColumn(
+    const DecodedVector& decoded,
+    const SelectivityVector& rows,
+    char* const* rowPointers,
+    int32_t columnIndex) {
+  bool nullable = columnIndex >= keyTypes_.size() || nullableKeys_;
+  VELOX_DCHECK(columnIndex < keyTypes_.size() || aggregates_.empty());
+  VELOX_DYNAMIC_TYPE_DISPATCH_ALL(
+      storeColumnTyped,
+      typeKinds_[columnIndex],
+      decoded,
+      rows,
+      rowPointers,
+      columnIndex,
+      nullable);
+}
+
+void RowContainer::copyStrings(
+    const SelectivityVector& rows,
+    char* const* rowPointers,
+    int32_t offset,
+    int32_t nullByte,
+    uint8_t nullMask) {
+  // Bytes of strings to allocate together. Small enough to usually fit in
+  // the free space of the current slab of 'stringAllocator_'.
+  constexpr int32_t kBatchBytes = 16 << 10;
+  int32_t pendingBytes = 0;
+  auto flush = [&]() {
+    if (pendingStrings_.empty()) {
+      return;
+    }
+    stringHeaders_.resize(pendingStrings_.size());
+    stringAllocator_.allocateBatch(
+        folly::Range<const int32_t*>(
+            pendingSizes_.data(), pendingSizes_.size()),
+        stringHeaders_.data());
+    for (auto i = 0; i < pendingStrings_.size(); ++i) {
+      auto string = pendingStrings_[i];
+      auto data = stringHeaders_[i]->begin();
+      memcpy(data, string->data(), string->size());
+      *string = StringView(data, string->size());
+    }
+    pendingStrings_.clear();
+    pendingSizes_.clear();
+    pendingBytes = 0;
+  };
+
+  rows.applyToSelected([&](auto row) {
+    char* rowPointer = rowPointers[row];
+    if (isNullAt(rowPointer, nullByte, nullMask)) {
+      return;
+    }
+    auto string = reinterpret_cast<StringView*>(rowPointer + offset);
+    if (string->isInline()) {
+      return;
+    }
+    if (string->size() > kBatchBytes) {
+      // Large strings may be split over several blocks.
+      stringAllocator_.copyMultipart(rowPointer, offset);
+      return;
+    }
+    pendingStrings_.push_back(string);
+    pendingSizes_.push_back(string->size());
+    pendingBytes += string->size();
+    if (pendingBytes >= kBatchBytes) {
+      flush();
+    }
+  });
+  flush();
+}
+
 void RowContainer::prepareRead(
     const char* row,
     int32_t offset,
@@ -346,19 +417,63 @@ void RowContainer::extractComplexType(
     const char* const* rows,
     int32_t numRows,
     RowColumn column,
-    VectorPtr result) {
+    int32_t resultOffset,
+    const VectorPtr& result) {
   ByteStream stream;
   auto nullByte = column.nullByte();
   auto nullMask = column.nullMask();
   auto offset = column.offset();
-  result->resize(numRows);
   for (int i = 0; i < numRows; ++i) {
     auto row = rows[i];
     if (!row || row[nullByte] & nullMask) {
-      result->setNull(i, true);
+      result->setNull(resultOffset + i, true);
     } else {
       prepareRead(row, offset, stream);
-      ContainerRowSerde::instance().deserialize(stream, i, result.get());
+      ContainerRowSerde::instance().deserialize(
+          stream, resultOffset + i, result.get());
+    }
+  }
+}
+
+// static
+void RowContainer::extractColumns(
+    const char* const* rows,
+    int32_t numRows,
+    folly::Range<const RowColumn*> columns,
+    folly::Range<const VectorPtr*> results) {
+  VELOX_CHECK_EQ(columns.size(), results.size());
+  if (columns.empty()) {
+    return;
+  }
+  // The span of the row that holds the values and null flags of 'columns'.
+  auto firstByte = std::numeric_limits<int32_t>::max();
+  auto lastByte = 0;
+  for (auto i = 0; i < columns.size(); ++i) {
+    results[i]->resize(numRows);
+    firstByte = std::min(firstByte, columns[i].offset());
+    lastByte = std::max(lastByte, columns[i].offset());
+    if (columns[i].nullMask()) {
+      firstByte = std::min(firstByte, columns[i].nullByte());
+      lastByte = std::max(lastByte, columns[i].nullByte());
+    }
+  }
+  auto rowRange = folly::Range<const char* const*>(rows, numRows);
+  prefetchRows(rowRange.subpiece(0, kExtractBatchSize), firstByte, lastByte);
+  for (auto start = 0; start < numRows; start += kExtractBatchSize) {
+    const auto batchSize = std::min(kExtractBatchSize, numRows - start);
+    prefetchRows(
+        rowRange.subpiece(start + batchSize, kExtractBatchSize),
+        firstByte,
+        lastByte);
+    for (auto i = 0; i < columns.size(); ++i) {
+      VELOX_DYNAMIC_TYPE_DISPATCH_ALL(
+          extractColumnTyped,
+          results[i]->typeKind(),
+          rows + start,
+          batchSize,
+          columns[i],
+          start,
+          results[i]);
     }
   }
 }
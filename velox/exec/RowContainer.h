@@ -140,6 +140,17 @@ class RowContainer {
       char* row,
       int32_t columnIndex);
 
+  // Stores the values of 'decoded' at 'rows' into 'columnIndex' of
+  // 'rowPointers[row]' for each selected row. Same as calling store() for
+  // each row but dispatches on the type once per batch, skips null checks
+  // for data without nulls and allocates the copies of the non-inline
+  // strings of the batch together.
+  void storeColumn(
+      const DecodedVector& decoded,
+      const SelectivityVector& rows,
+      char* const* rowPointers,
+      int32_t columnIndex);
+
   HashStringAllocator& stringAllocator() {
     return stringAllocator_;
   }
@@ -170,6 +181,18 @@ class RowContainer {
     extractColumn(rows, numRows, columnAt(columnIndex), result);
   }
 
+  // Copies the values at each of 'columns' into the corresponding vector
+  // in 'results' for the 'numRows' rows pointed to by 'rows'. Null
+  // entries in 'rows' give nulls as in extractColumn(). Works on groups
+  // of kExtractBatchSize rows: prefetches the rows of the next group, then
+  // copies all of 'columns' from the current group, so that each row is
+  // brought into cache once however many columns are extracted.
+  static void extractColumns(
+      const char* const* rows,
+      int32_t numRows,
+      folly::Range<const RowColumn*> columns,
+      folly::Range<const VectorPtr*> results);
+
   static inline int32_t nullByte(int32_t nullOffset) {
     return nullOffset / 8;
   }
@@ -280,13 +303,41 @@ class RowContainer {
   // Extract column values for 'rows' into 'result'.
   void extractRows(const std::vector<char*>& rows, const RowVectorPtr& result) {
     VELOX_CHECK_EQ(rows.size(), result->size());
+    std::vector<RowColumn> columns;
+    columns.reserve(result->childrenSize());
     for (int i = 0; i < result->childrenSize(); ++i) {
-      RowContainer::extractColumn(
-          rows.data(), rows.size(), columnAt(i), result->childAt(i));
+      columns.push_back(columnAt(i));
     }
+    RowContainer::extractColumns(
+        rows.data(),
+        rows.size(),
+        folly::range(columns),
+        folly::range(result->children()));
   }
 
  private:
+  // Number of rows whose values are copied between prefetches in
+  // extractColumns(). Enough to cover the latency of the misses on the
+  // next group without evicting the rows of the current one.
+  static constexpr int32_t kExtractBatchSize = 32;
+
+  // Issues prefetches for the bytes from 'firstByte' to 'lastByte' of the
+  // non-null rows in 'rows'.
+  static inline void prefetchRows(
+      folly::Range<const char* const*> rows,
+      int32_t firstByte,
+      int32_t lastByte) {
+    for (auto row : rows) {
+      if (!row) {
+        continue;
+      }
+      for (auto byte = firstByte; byte < lastByte; byte += 64) {
+        __builtin_prefetch(row + byte);
+      }
+      __builtin_prefetch(row + lastByte);
+    }
+  }
+
   static inline bool
   isNullAt(const char* row, int32_t nullByte, uint8_t nullMask) {
     return (row[nullByte] & nullMask) != 0;
@@ -302,15 +353,19 @@ class RowContainer {
     return *reinterpret_cast<T*>(group + offset);
   }
 
+  // Copies the values at 'column' of the 'numRows' rows pointed to by
+  // 'rows' into 'result' starting at 'resultOffset'. 'result' must be sized
+  // to at least 'resultOffset' + 'numRows'.
   template <TypeKind Kind>
   static void extractColumnTyped(
       const char* const* rows,
       int32_t numRows,
       RowColumn column,
-      VectorPtr result) {
+      int32_t resultOffset,
+      const VectorPtr& result) {
     if (Kind == TypeKind::ROW || Kind == TypeKind::ARRAY ||
         Kind == TypeKind::MAP) {
-      extractComplexType(rows, numRows, column, result);
+      extractComplexType(rows, numRows, column, resultOffset, result);
       return;
     }
     using T = typename KindToFlatVector<Kind>::HashRowType;
@@ -318,10 +373,16 @@ class RowContainer {
     auto nullMask = column.nullMask();
     auto offset = column.offset();
     if (!nullMask) {
-      extractValuesNoNulls<T>(rows, numRows, offset, flatResult);
+      extractValuesNoNulls<T>(rows, numRows, offset, resultOffset, flatResult);
     } else {
       extractValuesWithNulls<T>(
-          rows, numRows, offset, column.nullByte(), nullMask, flatResult);
+          rows,
+          numRows,
+          offset,
+          column.nullByte(),
+          nullMask,
+          resultOffset,
+          flatResult);
     }
   }
 
@@ -360,6 +421,26 @@ class RowContainer {
     }
   }
 
+  template <TypeKind Kind>
+  void storeColumnTyped(
+      const DecodedVector& decoded,
+      const SelectivityVector& rows,
+      char* const* rowPointers,
+      int32_t columnIndex,
+      bool nullable);
+
+  // Copies the non-inline strings at 'offset' of the 'rows' of
+  // 'rowPointers' to 'stringAllocator_' and points the StringViews to the
+  // copies. Rows that are null at 'nullByte' and 'nullMask' are skipped.
+  // The copies are read with HashStringAllocator::contiguousString() and
+  // freed one by one, like the ones made by copyMultipart().
+  void copyStrings(
+      const SelectivityVector& rows,
+      char* const* rowPointers,
+      int32_t offset,
+      int32_t nullByte,
+      uint8_t nullMask);
+
   template <typename T>
   static void extractValuesWithNulls(
       const char* const* rows,
@@ -367,18 +448,20 @@ class RowContainer {
       int32_t offset,
       int32_t nullByte,
       uint8_t nullMask,
+      int32_t resultOffset,
       FlatVector<T>* result) {
-    result->resize(numRows);
-    BufferPtr nullBuffer = result->mutableNulls(numRows);
+    const auto size = resultOffset + numRows;
+    BufferPtr nullBuffer = result->mutableNulls(size);
     auto nulls = nullBuffer->asMutable<uint64_t>();
-    BufferPtr valuesBuffer = result->mutableValues(numRows);
+    BufferPtr valuesBuffer = result->mutableValues(size);
     auto values = valuesBuffer->asMutableRange<T>();
     for (int32_t i = 0; i < numRows; ++i) {
+      const auto index = resultOffset + i;
       if (rows[i] == nullptr) {
-        bits::setNull(nulls, i, true);
+        bits::setNull(nulls, index, true);
       } else {
-        bits::setNull(nulls, i, isNullAt(rows[i], nullByte, nullMask));
-        values[i] = valueAt<T>(rows[i], offset);
+        bits::setNull(nulls, index, isNullAt(rows[i], nullByte, nullMask));
+        values[index] = valueAt<T>(rows[i], offset);
       }
     }
   }
@@ -388,17 +471,18 @@ class RowContainer {
       const char* const* rows,
       int32_t numRows,
       int32_t offset,
+      int32_t resultOffset,
       FlatVector<T>* result) {
-    result->resize(numRows);
-    BufferPtr valuesBuffer = result->mutableValues(numRows);
+    BufferPtr valuesBuffer = result->mutableValues(resultOffset + numRows);
     auto values = valuesBuffer->asMutableRange<T>();
     for (int32_t i = 0; i < numRows; ++i) {
+      const auto index = resultOffset + i;
       if (rows[i] == nullptr) {
-        result->setNull(i, true);
+        result->setNull(index, true);
       } else {
-        result->setNull(i, false);
+        result->setNull(index, false);
         // Here a StringView will reference the hash table, not copy.
-        values[i] = valueAt<T>(rows[i], offset);
+        values[index] = valueAt<T>(rows[i], offset);
       }
     }
   }
@@ -537,7 +621,8 @@ class RowContainer {
       const char* const* rows,
       int32_t numRows,
       RowColumn column,
-      VectorPtr result);
+      int32_t resultOffset,
+      const VectorPtr& result);
 
   static void extractString(
       StringView value,
@@ -611,6 +696,12 @@ class RowContainer {
   HashStringAllocator stringAllocator_;
   const RowSerde& serde_;
 
+  // Scratch for copyStrings(). The strings waiting for a block, their sizes
+  // and the Headers of the blocks.
+  std::vector<StringView*> pendingStrings_;
+  std::vector<int32_t> pendingSizes_;
+  std::vector<HashStringAllocator::Header*> stringHeaders_;
+
   // RowContainer requires a valid reference to a vector of aggregates. We use
   // a static constant to ensure the aggregates_ is valid throughout the
   // lifetime of the RowContainer.
@@ -685,14 +776,15 @@ inline void RowContainer::extractValuesNoNulls<StringView>(
     const char* const* rows,
     int32_t numRows,
     int32_t offset,
+    int32_t resultOffset,
     FlatVector<StringView>* result) {
-  result->resize(numRows);
   for (int32_t i = 0; i < numRows; ++i) {
+    const auto index = resultOffset + i;
     if (rows[i] == nullptr) {
-      result->setNull(i, true);
+      result->setNull(index, true);
     } else {
-      result->setNull(i, false);
-      extractString(valueAt<StringView>(rows[i], offset), result, i);
+      result->setNull(index, false);
+      extractString(valueAt<StringView>(rows[i], offset), result, index);
     }
   }
 }
@@ -704,13 +796,14 @@ inline void RowContainer::extractValuesWithNulls<StringView>(
     int32_t offset,
     int32_t nullByte,
     uint8_t nullMask,
+    int32_t resultOffset,
     FlatVector<StringView>* result) {
-  result->resize(numRows);
   for (int32_t i = 0; i < numRows; ++i) {
+    const auto index = resultOffset + i;
     if (!rows[i] || isNullAt(rows[i], nullByte, nullMask)) {
-      result->setNull(i, true);
+      result->setNull(index, true);
     } else {
-      extractString(valueAt<StringView>(rows[i], offset), result, i);
+      extractString(valueAt<StringView>(rows[i], offset), result, index);
     }
   }
 }
@@ -720,7 +813,8 @@ inline void RowContainer::extractColumnTyped<TypeKind::OPAQUE>(
     const char* const* /*rows*/,
     int32_t /*numRows*/,
     RowColumn /*column*/,
-    VectorPtr /*result*/) {
+    int32_t /*resultOffset*/,
+    const VectorPtr& /*result*/) {
   VELOX_UNSUPPORTED("RowContainer doesn't support values of type OPAQUE");
 }
 
@@ -729,8 +823,63 @@ inline void RowContainer::extractColumn(
     int32_t numRows,
     RowColumn column,
     VectorPtr result) {
-  VELOX_DYNAMIC_TYPE_DISPATCH_ALL(
-      extractColumnTyped, result->typeKind(), rows, numRows, column, result);
+  extractColumns(
+      rows,
+      numRows,
+      folly::Range<const RowColumn*>(&column, 1),
+      folly::Range<const VectorPtr*>(&result, 1));
+}
+
+template <TypeKind Kind>
+void RowContainer::storeColumnTyped(
+    const DecodedVector& decoded,
+    const SelectivityVector& rows,
+    char* const* rowPointers,
+    int32_t columnIndex,
+    bool nullable) {
+  using T = typename TypeTraits<Kind>::NativeType;
+  constexpr bool isString =
+      Kind == TypeKind::VARCHAR || Kind == TypeKind::VARBINARY;
+  if constexpr (
+      !(TypeTraits<Kind>::isPrimitiveType && TypeTraits<Kind>::isFixedWidth &&
+        Kind != TypeKind::UNKNOWN && Kind != TypeKind::OPAQUE) &&
+      !isString) {
+    // Complex types are serialized one value at a time.
+    rows.applyToSelected([&](auto row) {
+      store(decoded, row, rowPointers[row], columnIndex);
+    });
+  } else {
+    auto column = rowColumns_[columnIndex];
+    auto offset = column.offset();
+    if (!nullable || !decoded.mayHaveNulls()) {
+      if (Kind != TypeKind::BOOLEAN && decoded.isIdentityMapping()) {
+        auto values = decoded.data<T>();
+        rows.applyToSelected([&](auto row) {
+          valueAt<T>(rowPointers[row], offset) = values[row];
+        });
+      } else {
+        rows.applyToSelected([&](auto row) {
+          valueAt<T>(rowPointers[row], offset) = decoded.valueAt<T>(row);
+        });
+      }
+    } else {
+      auto nullByte = column.nullByte();
+      auto nullMask = column.nullMask();
+      rows.applyToSelected([&](auto row) {
+        char* rowPointer = rowPointers[row];
+        if (decoded.isNullAt(row)) {
+          rowPointer[nullByte] |= nullMask;
+          valueAt<T>(rowPointer, offset) = T();
+        } else {
+          valueAt<T>(rowPointer, offset) = decoded.valueAt<T>(row);
+        }
+      });
+    }
+    if constexpr (isString) {
+      copyStrings(
+          rows, rowPointers, offset, column.nullByte(), column.nullMask());
+    }
+  }
 }
 
 template <bool mayHaveNulls>
@@ -44,7 +44,7 @@ RowVectorPtr TableScan::getOutput() {
     if (needNewSplit_) {
       exec::Split split;
       auto reason = driverCtx_->task->getSplitOrFuture(
-          planNodeId_, split, blockingFuture_);
+          planNodeId_, split, blockingFuture_, /*mayDivide=*/true);
       if (reason != BlockingReason::kNotBlocked) {
         hasBlockingFuture_ = true;
         return nullptr;
@@ -79,6 +79,11 @@ RowVectorPtr TableScan::getOutput() {
           dataSource_->addDynamicFilter(entry.first, entry.second);
         }
         pendingDynamicFilters_.clear();
+        auto minMaxChannels =
+            driverCtx_->driver->sourceStatsAggregationChannels();
+        if (minMaxChannels) {
+          dataSource_->enableAggregationFromStats(*minMaxChannels);
+        }
       } else {
         VELOX_CHECK(
             connector_->connectorId() == connectorSplit->connectorId,
@@ -87,6 +92,8 @@ RowVectorPtr TableScan::getOutput() {
 
       dataSource_->addSplit(connectorSplit);
       ++stats_.numSplits;
+      divideSplit();
+      preloadSplits();
     }
 
     auto data = dataSource_->next(kDefaultBatchSize);
@@ -107,6 +114,38 @@ RowVectorPtr TableScan::getOutput() {
   }
 }
 
+void TableScan::divideSplit() {
+  auto& task = driverCtx_->task;
+  std::vector<exec::Split> parts;
+  auto numWaiting = task->numWaitingForSplits(planNodeId_);
+  if (numWaiting > 0) {
+    for (auto& part : dataSource_->divideSplit(numWaiting + 1)) {
+      parts.emplace_back(std::move(part), currentSplitGroupId_);
+    }
+  }
+  task->addSplitParts(planNodeId_, std::move(parts));
+}
+
+void TableScan::preloadSplits() {
+  const auto& queryCtx = driverCtx_->task->queryCtx();
+  auto executor = queryCtx->executor();
+  if (!executor || !dataSource_->canPreloadSplits()) {
+    return;
+  }
+  // The drivers of the plan node share the queue, so the preloaded splits
+  // are ahead of the ones any of them reads next.
+  const auto maxPreloaded =
+      queryCtx->maxSplitPreloadPerDriver() * driverCtx_->numDrivers;
+  driverCtx_->task->preloadSplits(
+      planNodeId_, maxPreloaded, [&](const exec::Split& split) {
+        // Splits of another connector fail when they get to be read.
+        if (split.hasConnectorSplit() &&
+            split.connectorSplit->connectorId == connector_->connectorId()) {
+          dataSource_->preloadSplit(split.connectorSplit, executor);
+        }
+      });
+}
+
 void TableScan::addDynamicFilter(
     ChannelIndex outputChannel,
     const std::shared_ptr<common::Filter>& filter) {
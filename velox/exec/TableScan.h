@@ -58,6 +58,15 @@ class TableScan : public SourceOperator {
  private:
   static constexpr int32_t kDefaultBatchSize = 1024;
 
+  // Has 'dataSource_' divide the split just added among this and the
+  // drivers waiting for splits and queues the parts for them.
+  void divideSplit();
+
+  // Has 'dataSource_' prepare the first maxSplitPreloadPerDriver queued
+  // splits per driver on the executor of the query while the current split
+  // is read. The splits stay in the Task queue.
+  void preloadSplits();
+
   const core::PlanNodeId planNodeId_;
   const std::shared_ptr<connector::ConnectorTableHandle> tableHandle_;
   const std::
@@ -42,7 +42,12 @@ Task::Task(
       onError_(onError),
       pool_(queryCtx_->pool()->addScopedChild("task_root")),
       bufferManager_(
-          PartitionedOutputBufferManager::getInstance(queryCtx_->host())) {}
+          PartitionedOutputBufferManager::getInstance(queryCtx_->host())) {
+  if (queryCtx_->traceEnabled()) {
+    traceRecorder_ =
+        std::make_shared<TraceRecorder>(queryCtx_->traceMaxEvents());
+  }
+}
 
 Task::~Task() {
   try {
@@ -239,11 +244,18 @@ void Task::addSplit(const core::PlanNodeId& planNodeId, exec::Split&& split) {
   addSplitLocked(splitsStates_[planNodeId], std::move(split));
 }
 
-void Task::addSplitLocked(SplitsState& splitsState, exec::Split&& split) {
+void Task::addSplitLocked(
+    SplitsState& splitsState,
+    exec::Split&& split,
+    bool isPart) {
   ++taskStats_.numTotalSplits;
   ++taskStats_.numQueuedSplits;
 
-  splitsState.splits.push_back(split);
+  if (isPart) {
+    splitsState.splitParts.push_back(split);
+  } else {
+    splitsState.splits.push_back(split);
+  }
 
   if (split.hasGroup()) {
     ++splitsState.groupSplits[split.groupId].numIncompleteSplits;
@@ -294,12 +306,13 @@ bool Task::isAllSplitsFinishedLocked() {
 BlockingReason Task::getSplitOrFuture(
     const core::PlanNodeId& planNodeId,
     exec::Split& split,
-    ContinueFuture& future) {
+    ContinueFuture& future,
+    bool mayDivide) {
   std::lock_guard<std::mutex> l(mutex_);
 
   auto& splitsState = splitsStates_[planNodeId];
-  if (splitsState.splits.empty()) {
-    if (splitsState.noMoreSplits) {
+  if (splitsState.splits.empty() && splitsState.splitParts.empty()) {
+    if (splitsState.noMoreSplits && splitsState.numDividing == 0) {
       return BlockingReason::kNotBlocked;
     }
     auto [splitPromise, splitFuture] = makeVeloxPromiseContract<bool>(
@@ -309,8 +322,68 @@ BlockingReason Task::getSplitOrFuture(
     return BlockingReason::kWaitForSplit;
   }
 
-  split = std::move(splitsState.splits.front());
-  splitsState.splits.pop_front();
+  if (splitsState.splitParts.empty()) {
+    takeSplitLocked(splitsState.splits, split);
+    if (splitsState.numPreloadedSplits > 0) {
+      --splitsState.numPreloadedSplits;
+    }
+  } else {
+    takeSplitLocked(splitsState.splitParts, split);
+  }
+  if (mayDivide && split.hasConnectorSplit()) {
+    ++splitsState.numDividing;
+  }
+  return BlockingReason::kNotBlocked;
+}
+
+int32_t Task::numWaitingForSplits(const core::PlanNodeId& planNodeId) {
+  std::lock_guard<std::mutex> l(mutex_);
+  return splitsStates_[planNodeId].splitPromises.size();
+}
+
+void Task::addSplitParts(
+    const core::PlanNodeId& planNodeId,
+    std::vector<exec::Split> parts) {
+  std::lock_guard<std::mutex> l(mutex_);
+
+  auto& splitsState = splitsStates_[planNodeId];
+  VELOX_CHECK_GT(splitsState.numDividing, 0);
+  --splitsState.numDividing;
+  if (state_ == kRunning) {
+    for (auto& part : parts) {
+      addSplitLocked(splitsState, std::move(part), true);
+    }
+  }
+  // The callers waiting for parts finish if no more can come.
+  if (splitsState.noMoreSplits && splitsState.numDividing == 0) {
+    for (auto& promise : splitsState.splitPromises) {
+      promise.setValue(false);
+    }
+    splitsState.splitPromises.clear();
+  }
+}
+
+void Task::preloadSplits(
+    const core::PlanNodeId& planNodeId,
+    int32_t maxPreloaded,
+    const std::function<void(const exec::Split&)>& preload) {
+  std::lock_guard<std::mutex> l(mutex_);
+
+  auto& splitsState = splitsStates_[planNodeId];
+  auto& splits = splitsState.splits;
+  auto& numPreloaded = splitsState.numPreloadedSplits;
+  while (numPreloaded < maxPreloaded &&
+         numPreloaded < static_cast<int32_t>(splits.size())) {
+    preload(splits[numPreloaded]);
+    ++numPreloaded;
+  }
+}
+
+void Task::takeSplitLocked(
+    std::deque<exec::Split>& queue,
+    exec::Split& split) {
+  split = std::move(queue.front());
+  queue.pop_front();
 
   --taskStats_.numQueuedSplits;
   ++taskStats_.numRunningSplits;
@@ -319,8 +392,6 @@ BlockingReason Task::getSplitOrFuture(
     taskStats_.firstSplitStartTimeMs = getCurrentTimeMs();
   }
   taskStats_.lastSplitStartTimeMs = getCurrentTimeMs();
-
-  return BlockingReason::kNotBlocked;
 }
 
 void Task::splitFinished(
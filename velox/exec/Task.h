@@ -20,6 +20,7 @@
 #include "velox/exec/LocalPartition.h"
 #include "velox/exec/MergeSource.h"
 #include "velox/exec/Split.h"
+#include "velox/exec/TraceRecorder.h"
 #include "velox/vector/ComplexVector.h"
 
 namespace facebook::velox::exec {
@@ -148,10 +149,37 @@ class Task {
   // received, sets split to null and returns kNotBlocked. Otherwise, returns
   // kWaitForSplit and sets a future that will complete when split becomes
   // available or no-more-splits signal is received.
+  //
+  // If 'mayDivide' is true, the caller may queue parts of the split it
+  // gets with addSplitParts() and must call addSplitParts() once for the
+  // split whether it divides it or not. Until then, callers that find no
+  // split wait for the parts instead of finishing.
   BlockingReason getSplitOrFuture(
       const core::PlanNodeId& planNodeId,
       exec::Split& split,
-      ContinueFuture& future);
+      ContinueFuture& future,
+      bool mayDivide = false);
+
+  // Returns the number of callers of getSplitOrFuture() for the plan node
+  // with specified ID that are waiting for a split.
+  int32_t numWaitingForSplits(const core::PlanNodeId& planNodeId);
+
+  // Queues 'parts' of a split that was taken by getSplitOrFuture() with
+  // 'mayDivide' set. 'parts' is empty if the split was not divided. The
+  // parts count as splits of their own in the task stats.
+  void addSplitParts(
+      const core::PlanNodeId& planNodeId,
+      std::vector<exec::Split> parts);
+
+  // Calls 'preload' on each of the first 'maxPreloaded' queued splits for
+  // the source operator corresponding to plan node with specified ID that
+  // it has not been called on before. The splits stay queued and go to
+  // whichever driver asks first. 'preload' is called under the Task lock,
+  // so it must not block or call into the Task.
+  void preloadSplits(
+      const core::PlanNodeId& planNodeId,
+      int32_t maxPreloaded,
+      const std::function<void(const exec::Split&)>& preload);
 
   void splitFinished(const core::PlanNodeId& planNodeId, int32_t splitGroupId);
 
@@ -334,6 +362,14 @@ class Task {
   // thread is not running a Driver of 'this'.
   Driver* FOLLY_NULLABLE thisDriver() const;
 
+  // Returns the timeline of the Drivers of 'this' or nullptr if
+  // QueryCtx::kTraceEnabled is not set. Shared with the Drivers, which may
+  // record after 'this' is freed, e.g. when a blocking future is realized
+  // after terminate().
+  const std::shared_ptr<TraceRecorder>& traceRecorder() const {
+    return traceRecorder_;
+  }
+
  private:
   struct BarrierState {
     int32_t numRequested;
@@ -352,12 +388,26 @@ class Task {
     // Arrived (added), but not distributed yet, splits.
     std::deque<exec::Split> splits;
 
+    // Parts of divided splits, not distributed yet. These are given out
+    // before 'splits' by getSplitOrFuture() and are not preloaded, since
+    // they are meant for the drivers that wait for splits.
+    std::deque<exec::Split> splitParts;
+
+    // Number of splits at the front of 'splits' that have been passed to
+    // preloadSplits() callbacks.
+    int32_t numPreloadedSplits{0};
+
     // Blocking promises given out when out of splits to distribute.
     std::vector<VeloxPromise<bool>> splitPromises;
 
     // Singnal, that no more splits will arrive.
     bool noMoreSplits{false};
 
+    // Number of splits given out with 'mayDivide' for which
+    // addSplitParts() has not been called. Parts of these may still arrive
+    // after 'noMoreSplits'.
+    int32_t numDividing{0};
+
     // For splits, coming with group ids, we keep track of them.
     std::unordered_map<int32_t, GroupSplitsInfo> groupSplits;
 
@@ -385,7 +435,15 @@ class Task {
       int32_t splitGroupId,
       std::unordered_map<int32_t, GroupSplitsInfo>::iterator it);
 
-  void addSplitLocked(SplitsState& splitsState, exec::Split&& split);
+  // Queues 'split' in 'splitsState', with the parts of divided splits if
+  // 'isPart' is true.
+  void addSplitLocked(
+      SplitsState& splitsState,
+      exec::Split&& split,
+      bool isPart = false);
+
+  // Moves the first split of 'queue' to 'split' and counts it as running.
+  void takeSplitLocked(std::deque<exec::Split>& queue, exec::Split& split);
 
   const std::string taskId_;
   std::shared_ptr<const core::PlanNode> planNode_;
@@ -430,6 +488,7 @@ class Task {
 
   TaskStats taskStats_;
   std::unique_ptr<velox::memory::MemoryPool> pool_;
+  std::shared_ptr<TraceRecorder> traceRecorder_;
   std::vector<std::shared_ptr<MergeSource>> localMergeSources_;
 
   struct LocalExchange {
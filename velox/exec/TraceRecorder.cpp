@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/TraceRecorder.h"
+
+#include <algorithm>
+#include <set>
+
+#include <fmt/format.h>
+#include <folly/Bits.h>
+#include <folly/json.h>
+
+#include "velox/common/base/Exceptions.h"
+#include "velox/exec/Driver.h"
+
+namespace facebook::velox::exec {
+
+TraceRecorder::TraceRecorder(int32_t capacity)
+    : slots_(folly::nextPowTwo<uint64_t>(std::max<int32_t>(capacity, 1))),
+      mask_(slots_.size() - 1) {
+  VELOX_CHECK_GT(capacity, 0);
+}
+
+void TraceRecorder::setOperatorName(
+    int32_t pipelineId,
+    int32_t operatorId,
+    const std::string& name) {
+  std::lock_guard<std::mutex> l(mutex_);
+  if (operatorNames_.size() <= static_cast<size_t>(pipelineId)) {
+    operatorNames_.resize(pipelineId + 1);
+  }
+  auto& names = operatorNames_[pipelineId];
+  if (names.size() <= static_cast<size_t>(operatorId)) {
+    names.resize(operatorId + 1);
+  }
+  names[operatorId] = name;
+}
+
+std::vector<TraceEvent> TraceRecorder::events() const {
+  const uint64_t end = nextIndex_.load(std::memory_order_acquire);
+  const uint64_t begin = end > slots_.size() ? end - slots_.size() : 0;
+  std::vector<TraceEvent> result;
+  result.reserve(end - begin);
+  for (auto index = begin; index < end; ++index) {
+    const auto& slot = slots_[index & mask_];
+    const auto sequence = slot.sequence.load(std::memory_order_acquire);
+    if (sequence != index + 1) {
+      // Being written or already overwritten by a later event.
+      continue;
+    }
+    uint64_t words[kEventWords];
+    for (auto i = 0; i < kEventWords; ++i) {
+      words[i] = slot.words[i].load(std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.sequence.load(std::memory_order_relaxed) != sequence) {
+      continue;
+    }
+    TraceEvent event;
+    memcpy(&event, words, sizeof(TraceEvent));
+    result.push_back(event);
+  }
+  std::sort(
+      result.begin(),
+      result.end(),
+      [](const TraceEvent& left, const TraceEvent& right) {
+        return left.startMicros < right.startMicros;
+      });
+  return result;
+}
+
+namespace {
+const char* methodName(TraceEvent::Type type) {
+  switch (type) {
+    case TraceEvent::Type::kGetOutput:
+      return "getOutput";
+    case TraceEvent::Type::kAddInput:
+      return "addInput";
+    case TraceEvent::Type::kFinish:
+      return "finish";
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+folly::dynamic metadataEvent(
+    const char* name,
+    int32_t pid,
+    int32_t tid,
+    const std::string& label) {
+  return folly::dynamic::object("name", name)("ph", "M")("pid", pid)(
+      "tid", tid)("args", folly::dynamic::object("name", label));
+}
+} // namespace
+
+std::string TraceRecorder::toChromeTrace() const {
+  const auto allEvents = events();
+  std::vector<std::vector<std::string>> operatorNames;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    operatorNames = operatorNames_;
+  }
+  auto operatorName = [&](const TraceEvent& event) {
+    const size_t pipelineId = event.pipelineId;
+    const size_t operatorId = event.operatorId;
+    if (event.operatorId >= 0 && pipelineId < operatorNames.size() &&
+        operatorId < operatorNames[pipelineId].size() &&
+        !operatorNames[pipelineId][operatorId].empty()) {
+      return operatorNames[pipelineId][operatorId];
+    }
+    return fmt::format("op{}", event.operatorId);
+  };
+
+  folly::dynamic traceEvents = folly::dynamic::array;
+  // Names the process of each pipeline and the thread of each Driver.
+  std::set<std::pair<int32_t, int32_t>> drivers;
+  for (const auto& event : allEvents) {
+    drivers.insert({event.pipelineId, event.driverId});
+  }
+  int32_t lastPipelineId = -1;
+  for (const auto& [pipelineId, driverId] : drivers) {
+    if (pipelineId != lastPipelineId) {
+      traceEvents.push_back(metadataEvent(
+          "process_name",
+          pipelineId,
+          0,
+          fmt::format("Pipeline {}", pipelineId)));
+      lastPipelineId = pipelineId;
+    }
+    traceEvents.push_back(metadataEvent(
+        "thread_name",
+        pipelineId,
+        driverId,
+        fmt::format("Driver {}", driverId)));
+  }
+
+  for (const auto& event : allEvents) {
+    folly::dynamic traceEvent = folly::dynamic::object("ph", "X")(
+        "ts", static_cast<int64_t>(event.startMicros))(
+        "dur", static_cast<int64_t>(event.durationMicros))(
+        "pid", event.pipelineId)("tid", event.driverId);
+    switch (event.type) {
+      case TraceEvent::Type::kOnThread:
+        traceEvent["name"] = "onThread";
+        traceEvent["cat"] = "driver";
+        traceEvent["args"] = folly::dynamic::object("thread", event.threadId);
+        break;
+      case TraceEvent::Type::kBlocked:
+        traceEvent["name"] = fmt::format(
+            "blocked: {}",
+            blockingReasonToString(
+                static_cast<BlockingReason>(event.blockingReason)));
+        traceEvent["cat"] = "blocked";
+        traceEvent["args"] =
+            folly::dynamic::object("operator", operatorName(event));
+        break;
+      default:
+        traceEvent["name"] = fmt::format(
+            "{}.{}", operatorName(event), methodName(event.type));
+        traceEvent["cat"] = "operator";
+        traceEvent["args"] = folly::dynamic::object("thread", event.threadId);
+        break;
+    }
+    traceEvents.push_back(std::move(traceEvent));
+  }
+  return folly::toJson(folly::dynamic::object("traceEvents", traceEvents)(
+      "displayTimeUnit", "ms"));
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace facebook::velox::exec {
+
+// An interval in the timeline of a Driver.
+struct TraceEvent {
+  enum class Type : uint8_t {
+    // The Driver is on a thread, from entering to leaving runInternal().
+    kOnThread,
+    // The Driver calls Operator::getOutput(), addInput() or finish().
+    kGetOutput,
+    kAddInput,
+    kFinish,
+    // The Driver is off thread waiting for a future of an operator.
+    // 'blockingReason' is the BlockingReason.
+    kBlocked,
+  };
+
+  Type type{Type::kOnThread};
+  uint8_t blockingReason{0};
+  int32_t pipelineId{0};
+  int32_t driverId{0};
+  // The operatorId of the operator or -1 for kOnThread.
+  int32_t operatorId{-1};
+  // The tid of the thread running the Driver. 0 for kBlocked.
+  int32_t threadId{0};
+  uint64_t startMicros{0};
+  uint64_t durationMicros{0};
+};
+
+// Records the timeline of the Drivers of a Task: when each is on thread,
+// its calls into operators and the time it is blocked. The events go to a
+// fixed size ring buffer that keeps the most recent ones. record() does not
+// lock or allocate, so that tracing can stay on in production with a cost
+// of two clock reads per operator call. toChromeTrace() exports the
+// events in the Chrome trace event format, which chrome://tracing and
+// Perfetto show as one row per Driver.
+//
+// Enabled by QueryCtx::kTraceEnabled. See Task::traceRecorder().
+class TraceRecorder {
+ public:
+  // Keeps the last 'capacity' events, rounded up to a power of 2.
+  explicit TraceRecorder(int32_t capacity);
+
+  // Returns the time in microseconds since epoch. Same clock as
+  // BlockingState.
+  static uint64_t nowMicros() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::high_resolution_clock::now().time_since_epoch())
+        .count();
+  }
+
+  // Adds 'event', overwriting the oldest event if the buffer is full. May
+  // be called from any number of threads.
+  void record(const TraceEvent& event) {
+    const auto index = nextIndex_.fetch_add(1, std::memory_order_relaxed);
+    auto& slot = slots_[index & mask_];
+    uint64_t words[kEventWords] = {};
+    memcpy(words, &event, sizeof(TraceEvent));
+    // 'sequence' is 0 while the slot is written, so that a concurrent
+    // events() skips it.
+    slot.sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (auto i = 0; i < kEventWords; ++i) {
+      slot.words[i].store(words[i], std::memory_order_relaxed);
+    }
+    slot.sequence.store(index + 1, std::memory_order_release);
+  }
+
+  // Sets the label of operator 'operatorId' of pipeline 'pipelineId'.
+  void setOperatorName(
+      int32_t pipelineId,
+      int32_t operatorId,
+      const std::string& name);
+
+  // Returns the events in the buffer ordered by start time. Events being
+  // written during the call are left out.
+  std::vector<TraceEvent> events() const;
+
+  // Returns the total number of events recorded, including overwritten
+  // ones.
+  uint64_t numRecorded() const {
+    return nextIndex_;
+  }
+
+  int32_t capacity() const {
+    return slots_.size();
+  }
+
+  // Returns the events as a JSON object in the Chrome trace event format.
+  // Each Driver is a thread in the process of its pipeline.
+  std::string toChromeTrace() const;
+
+ private:
+  static_assert(std::is_trivially_copyable_v<TraceEvent>);
+  static constexpr int32_t kEventWords =
+      (sizeof(TraceEvent) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+  struct Slot {
+    // 1 + the index of the event in the slot. 0 if the slot is empty or
+    // being written.
+    std::atomic<uint64_t> sequence{0};
+    // The bytes of the TraceEvent. Atomic so that events() may read them
+    // while record() overwrites them. events() then drops what it read,
+    // since 'sequence' has changed.
+    std::array<std::atomic<uint64_t>, kEventWords> words;
+  };
+
+  std::vector<Slot> slots_;
+  const uint64_t mask_;
+  std::atomic<uint64_t> nextIndex_{0};
+
+  mutable std::mutex mutex_;
+  // Labels of the operators by pipeline and operator id.
+  std::vector<std::vector<std::string>> operatorNames_;
+};
+
+// Records an event covering the lifetime of 'this' if 'recorder' is not
+// nullptr.
+class TraceScope {
+ public:
+  TraceScope(TraceRecorder* recorder, const TraceEvent& event)
+      : recorder_(recorder) {
+    if (recorder_) {
+      event_ = event;
+      event_.startMicros = TraceRecorder::nowMicros();
+    }
+  }
+
+  ~TraceScope() {
+    end();
+  }
+
+  // Records the event now instead of at destruction. Used before an action
+  // that may free the recorder, e.g. Driver::close().
+  void end() {
+    if (recorder_) {
+      event_.durationMicros = TraceRecorder::nowMicros() - event_.startMicros;
+      recorder_->record(event_);
+      recorder_ = nullptr;
+    }
+  }
+
+  TraceScope(const TraceScope&) = delete;
+  TraceScope& operator=(const TraceScope&) = delete;
+
+ private:
+  TraceRecorder* recorder_;
+  TraceEvent event_;
+};
+
+} // namespace facebook::velox::exec
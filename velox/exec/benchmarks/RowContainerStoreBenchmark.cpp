@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+#include "velox/exec/RowContainer.h"
+#include "velox/vector/tests/VectorMaker.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::test;
+
+// Compares filling a RowContainer with store() one value at a time to
+// storeColumn() a column at a time.
+
+namespace {
+
+constexpr vector_size_t kNumRows = 10'000;
+
+class RowContainerStoreBenchmark {
+ public:
+  RowContainerStoreBenchmark() {
+    // A third of the strings are inlined in the StringView.
+    for (auto i = 0; i < kNumRows; ++i) {
+      auto size = i % 3 == 0 ? 8 : 20 + i % 20;
+      strings_.push_back(std::string(size, 'a' + i % 26));
+    }
+    fixedWidth_ = vectorMaker_.rowVector({
+        vectorMaker_.flatVector<int64_t>(
+            kNumRows, [](auto row) { return row; }),
+        vectorMaker_.flatVector<double>(
+            kNumRows, [](auto row) { return row * 0.1; }),
+        vectorMaker_.flatVector<int32_t>(
+            kNumRows,
+            [](auto row) { return row; },
+            VectorMaker::nullEvery(7)),
+    });
+    withStrings_ = vectorMaker_.rowVector({
+        vectorMaker_.flatVector<int64_t>(
+            kNumRows, [](auto row) { return row; }),
+        vectorMaker_.flatVector<StringView>(
+            kNumRows, [&](auto row) { return StringView(strings_[row]); }),
+        vectorMaker_.flatVector<StringView>(
+            kNumRows,
+            [&](auto row) { return StringView(strings_[kNumRows - 1 - row]); },
+            VectorMaker::nullEvery(5)),
+    });
+  }
+
+  // Stores all rows of 'data' in a new RowContainer with the first column
+  // as key. Returns the number of values stored.
+  size_t run(const RowVectorPtr& data, bool byColumn) {
+    folly::BenchmarkSuspender suspender;
+    const auto& types = data->type()->as<TypeKind::ROW>().children();
+    RowContainer container(
+        {types[0]},
+        false, // nullableKeys
+        kEmptyAggregates,
+        std::vector<TypePtr>(types.begin() + 1, types.end()),
+        false, // hasNext
+        true, // isJoinBuild
+        false, // hasProbedFlag
+        false, // hasNormalizedKey
+        memory::MappedMemory::getInstance(),
+        ContainerRowSerde::instance());
+    SelectivityVector allRows(data->size());
+    std::vector<DecodedVector> decoded(data->childrenSize());
+    for (auto column = 0; column < data->childrenSize(); ++column) {
+      decoded[column].decode(*data->childAt(column), allRows);
+    }
+    std::vector<char*> rows(data->size());
+    for (auto row = 0; row < data->size(); ++row) {
+      rows[row] = container.newRow();
+    }
+    suspender.dismiss();
+
+    if (byColumn) {
+      for (auto column = 0; column < data->childrenSize(); ++column) {
+        container.storeColumn(decoded[column], allRows, rows.data(), column);
+      }
+    } else {
+      for (auto row = 0; row < data->size(); ++row) {
+        for (auto column = 0; column < data->childrenSize(); ++column) {
+          container.store(decoded[column], row, rows[row], column);
+        }
+      }
+    }
+    return data->size() * data->childrenSize();
+  }
+
+  const RowVectorPtr& fixedWidth() const {
+    return fixedWidth_;
+  }
+
+  const RowVectorPtr& withStrings() const {
+    return withStrings_;
+  }
+
+ private:
+  static inline const std::vector<std::unique_ptr<Aggregate>>
+      kEmptyAggregates;
+
+  std::unique_ptr<memory::MemoryPool> pool_{
+      memory::getDefaultScopedMemoryPool()};
+  VectorMaker vectorMaker_{pool_.get()};
+  std::vector<std::string> strings_;
+  RowVectorPtr fixedWidth_;
+  RowVectorPtr withStrings_;
+};
+
+std::unique_ptr<RowContainerStoreBenchmark> benchmark;
+
+BENCHMARK_MULTI(fixedWidthByRow) {
+  return benchmark->run(benchmark->fixedWidth(), false);
+}
+
+BENCHMARK_RELATIVE_MULTI(fixedWidthByColumn) {
+  return benchmark->run(benchmark->fixedWidth(), true);
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_MULTI(stringsByRow) {
+  return benchmark->run(benchmark->withStrings(), false);
+}
+
+BENCHMARK_RELATIVE_MULTI(stringsByColumn) {
+  return benchmark->run(benchmark->withStrings(), true);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  benchmark = std::make_unique<RowContainerStoreBenchmark>();
+  folly::runBenchmarks();
+  benchmark.reset();
+  return 0;
+}
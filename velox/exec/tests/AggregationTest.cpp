@@ -344,6 +344,58 @@ TEST_F(AggregationTest, hashmodes) {
       " GROUP BY c0, C1, C2, c3, C4, C5");
 }
 
+TEST_F(AggregationTest, denseAccumulators) {
+  // The first batches have keys of low cardinality. The table is in kArray
+  // mode and sum, count, min, max and avg keep their accumulators in dense
+  // arrays. The next batches need a larger array and the last ones a hash
+  // table, so that the table changes mode while accumulators are not yet in
+  // the rows.
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 15; ++i) {
+    auto vector = makeVectors(rowType_, 100, 1)[0];
+    if (i < 10) {
+      auto keys = vector->childAt(0)->asFlatVector<int64_t>();
+      for (auto row = 0; row < vector->size(); ++row) {
+        if (!keys->isNullAt(row)) {
+          keys->set(row, keys->valueAt(row) % (i < 5 ? 10 : 1'000));
+        }
+      }
+    }
+    vectors.push_back(vector);
+  }
+  createDuckDbTable(vectors);
+
+  auto op = PlanBuilder()
+                .values(vectors)
+                .singleAggregation(
+                    {0},
+                    {"sum(c1)",
+                     "sum(c5)",
+                     "count(c2)",
+                     "min(c3)",
+                     "max(c4)",
+                     "avg(c2)"})
+                .planNode();
+  assertQuery(
+      op,
+      "SELECT c0, sum(c1), sum(c5), count(c2), min(c3), max(c4), avg(c2) "
+      "FROM tmp GROUP BY c0");
+
+  // Only the low cardinality batches. The accumulators are added to the
+  // rows when producing the output.
+  vectors.resize(5);
+  createDuckDbTable(vectors);
+  op = PlanBuilder()
+           .values(vectors)
+           .singleAggregation(
+               {0}, {"sum(c3)", "count(1)", "min(c5)", "max(c1)", "avg(c5)"})
+           .planNode();
+  assertQuery(
+      op,
+      "SELECT c0, sum(c3), count(1), min(c5), max(c1), avg(c5) "
+      "FROM tmp GROUP BY c0");
+}
+
 TEST_F(AggregationTest, rangeToDistinct) {
   rng_.seed(1);
   std::vector<std::string> keyNames = {"C0", "C1", "C2", "C3", "C4", "C5"};
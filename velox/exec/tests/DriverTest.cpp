@@ -411,6 +411,123 @@ TEST_F(DriverTest, pause) {
   EXPECT_EQ(operators[1].outputPositions, 10 * hits);
 }
 
+TEST_F(DriverTest, perfCounters) {
+  CursorParameters params;
+  params.queryCtx = core::QueryCtx::create();
+  params.queryCtx->setConfigOverridesUnsafe(
+      {{core::QueryCtx::kPerfCountersEnabled, "true"}});
+  params.planNode =
+      makeValuesFilterProject(rowType_, "m1 % 10 > 0", "m1 % 3", 10, 1'000);
+  int32_t numRead = 0;
+  readResults(params, ResultOperation::kRead, 1'000'000, &numRead);
+  auto& executor = folly::QueuedImmediateExecutor::instance();
+  tasks_[0]->cancelPool()->finishFuture().via(&executor).wait();
+
+  // The counters are there if the machine and the kernel settings allow
+  // counting.
+  process::PerfCounts counts;
+  const bool hasCounters = process::readThreadPerfCounts(counts);
+  const auto stats = tasks_[0]->taskStats().pipelineStats;
+  ASSERT_EQ(stats.size(), 1);
+  for (const auto& op : stats[0].operatorStats) {
+    auto it = op.runtimeStats.find("perfInstructions");
+    if (!hasCounters) {
+      EXPECT_EQ(it, op.runtimeStats.end()) << op.operatorType;
+      continue;
+    }
+    ASSERT_NE(it, op.runtimeStats.end()) << op.operatorType;
+    EXPECT_GT(it->second.sum, 0) << op.operatorType;
+    EXPECT_EQ(1, op.runtimeStats.count("perfCycles"));
+    EXPECT_EQ(1, op.runtimeStats.count("perfLlcMisses"));
+    EXPECT_EQ(1, op.runtimeStats.count("perfBranchMisses"));
+  }
+}
+
+TEST_F(DriverTest, trace) {
+  CursorParameters params;
+  params.queryCtx = core::QueryCtx::create();
+  params.queryCtx->setConfigOverridesUnsafe(
+      {{core::QueryCtx::kTraceEnabled, "true"}});
+  params.planNode =
+      makeValuesFilterProject(rowType_, "m1 % 10 > 0", "m1 % 3", 10, 1'000);
+  params.maxDrivers = 2;
+  int32_t numRead = 0;
+  readResults(params, ResultOperation::kRead, 1'000'000, &numRead);
+  auto& executor = folly::QueuedImmediateExecutor::instance();
+  tasks_[0]->cancelPool()->finishFuture().via(&executor).wait();
+
+  auto recorder = tasks_[0]->traceRecorder();
+  ASSERT_NE(recorder, nullptr);
+  const auto events = recorder->events();
+  ASSERT_EQ(events.size(), recorder->numRecorded());
+  std::unordered_set<int32_t> onThreadDrivers;
+  int32_t numGetOutput = 0;
+  for (auto i = 0; i < events.size(); ++i) {
+    const auto& event = events[i];
+    if (i > 0) {
+      EXPECT_LE(events[i - 1].startMicros, event.startMicros);
+    }
+    EXPECT_EQ(0, event.pipelineId);
+    switch (event.type) {
+      case TraceEvent::Type::kOnThread:
+        EXPECT_EQ(-1, event.operatorId);
+        onThreadDrivers.insert(event.driverId);
+        break;
+      case TraceEvent::Type::kGetOutput:
+        ++numGetOutput;
+        break;
+      default:
+        break;
+    }
+  }
+  EXPECT_EQ(2, onThreadDrivers.size());
+  EXPECT_GT(numGetOutput, 0);
+
+  const auto json = recorder->toChromeTrace();
+  EXPECT_NE(json.find("\"traceEvents\""), std::string::npos);
+  EXPECT_NE(json.find("Values.getOutput"), std::string::npos);
+  EXPECT_NE(json.find("FilterProject.addInput"), std::string::npos);
+  EXPECT_NE(json.find("\"onThread\""), std::string::npos);
+
+  // A trace is kept only if enabled.
+  params.queryCtx = core::QueryCtx::create();
+  readResults(params, ResultOperation::kRead, 1'000'000, &numRead);
+  EXPECT_EQ(tasks_.back()->traceRecorder(), nullptr);
+}
+
+TEST_F(DriverTest, traceRecorderWrapAround) {
+  TraceRecorder recorder(10);
+  EXPECT_EQ(16, recorder.capacity());
+  for (auto i = 0; i < 100; ++i) {
+    TraceEvent event;
+    event.type = TraceEvent::Type::kGetOutput;
+    event.operatorId = i;
+    event.startMicros = i;
+    recorder.record(event);
+  }
+  EXPECT_EQ(100, recorder.numRecorded());
+  const auto events = recorder.events();
+  // The most recent events are kept.
+  ASSERT_EQ(16, events.size());
+  for (auto i = 0; i < events.size(); ++i) {
+    EXPECT_EQ(84 + i, events[i].operatorId);
+  }
+}
+
+TEST_F(DriverTest, traceScopeEnd) {
+  TraceRecorder recorder(10);
+  {
+    TraceEvent event;
+    event.type = TraceEvent::Type::kOnThread;
+    TraceScope scope(&recorder, event);
+    scope.end();
+    EXPECT_EQ(1, recorder.numRecorded());
+  }
+  // The destructor does not record an ended scope again.
+  EXPECT_EQ(1, recorder.numRecorded());
+  EXPECT_EQ(TraceEvent::Type::kOnThread, recorder.events()[0].type);
+}
+
 TEST_F(DriverTest, yield) {
   constexpr int32_t kNumTasks = 20;
   constexpr int32_t kThreadsPerTask = 5;
@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/HashJoinTableCache.h"
+
+#include <gtest/gtest.h>
+
+#include "velox/exec/tests/PlanBuilder.h"
+#include "velox/vector/tests/VectorMaker.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::exec::test;
+
+class HashJoinTableCacheTest : public testing::Test {
+ protected:
+  // Returns a join table with 'numRows' rows allocated from the memory of
+  // 'cache_'.
+  std::shared_ptr<BaseHashTable> makeTable(int32_t numRows) {
+    std::vector<std::unique_ptr<VectorHasher>> hashers;
+    hashers.push_back(std::make_unique<VectorHasher>(BIGINT(), 0));
+    auto table = HashTable<true>::createForJoin(
+        std::move(hashers), {BIGINT()}, true, cache_->mappedMemory());
+    for (auto i = 0; i < numRows; ++i) {
+      table->rows()->newRow();
+    }
+    return table;
+  }
+
+  std::shared_ptr<const core::HashJoinNode> makeJoin(core::JoinType joinType) {
+    auto data = vectorMaker_.rowVector(
+        {vectorMaker_.flatVector<int64_t>({1, 2, 3}),
+         vectorMaker_.flatVector<int64_t>({4, 5, 6})});
+    return std::dynamic_pointer_cast<const core::HashJoinNode>(
+        PlanBuilder()
+            .values({data})
+            .hashJoin(
+                {0},
+                {0},
+                PlanBuilder().values({data}).planNode(),
+                "",
+                {0, 1},
+                joinType)
+            .planNode());
+  }
+
+  std::unique_ptr<memory::MemoryPool> pool_{
+      memory::getDefaultScopedMemoryPool()};
+  facebook::velox::test::VectorMaker vectorMaker_{pool_.get()};
+  std::unique_ptr<HashJoinTableCache> cache_{
+      std::make_unique<HashJoinTableCache>(
+          HashJoinTableCache::kDefaultCapacity)};
+};
+
+TEST_F(HashJoinTableCacheTest, findAndInsert) {
+  EXPECT_FALSE(cache_->find("a").has_value());
+  auto table = makeTable(100);
+  EXPECT_TRUE(cache_->insert("a", {table, false}));
+  EXPECT_TRUE(cache_->insert("b", {nullptr, true}));
+  // An existing entry is kept.
+  EXPECT_FALSE(cache_->insert("a", {makeTable(10), false}));
+
+  auto entry = cache_->find("a");
+  ASSERT_TRUE(entry.has_value());
+  EXPECT_EQ(table, entry->table);
+  EXPECT_FALSE(entry->antiJoinHasNullKeys);
+  entry = cache_->find("b");
+  ASSERT_TRUE(entry.has_value());
+  EXPECT_EQ(nullptr, entry->table);
+  EXPECT_TRUE(entry->antiJoinHasNullKeys);
+
+  auto stats = cache_->stats();
+  EXPECT_EQ(2, stats.numEntries);
+  EXPECT_EQ(table->allocatedBytes(), stats.cachedBytes);
+  EXPECT_GE(stats.allocatedBytes, table->allocatedBytes());
+  EXPECT_EQ(2, stats.numHits);
+  EXPECT_EQ(1, stats.numMisses);
+
+  // The memory of the tables is released when the last reference is gone.
+  table = nullptr;
+  entry.reset();
+  cache_->clear();
+  EXPECT_EQ(0, cache_->stats().numEntries);
+  EXPECT_EQ(0, cache_->stats().allocatedBytes);
+}
+
+TEST_F(HashJoinTableCacheTest, eviction) {
+  auto a = makeTable(100);
+  auto b = makeTable(100);
+  auto c = makeTable(100);
+  const auto tableBytes = a->allocatedBytes();
+  ASSERT_GT(tableBytes, 0);
+  ASSERT_EQ(tableBytes, b->allocatedBytes());
+  cache_->setCapacity(2 * tableBytes);
+  EXPECT_TRUE(cache_->insert("a", {a, false}));
+  EXPECT_TRUE(cache_->insert("b", {b, false}));
+  // 'a' is used more recently than 'b'.
+  EXPECT_TRUE(cache_->find("a").has_value());
+
+  // Only the cache references 'b', which is evicted to make room for 'c'.
+  b = nullptr;
+  a = nullptr;
+  EXPECT_TRUE(cache_->insert("c", {c, false}));
+  EXPECT_FALSE(cache_->find("b").has_value());
+  EXPECT_TRUE(cache_->find("a").has_value());
+  EXPECT_EQ(1, cache_->stats().numEvictions);
+
+  // 'c' is in use and 'a' is not, so 'a' is evicted even though it is used
+  // more recently.
+  EXPECT_TRUE(cache_->find("a").has_value());
+  EXPECT_TRUE(cache_->insert("d", {makeTable(100), false}));
+  EXPECT_FALSE(cache_->find("a").has_value());
+
+  // Both entries are in use. There is no room for another table.
+  auto d = cache_->find("d")->table;
+  EXPECT_FALSE(cache_->insert("e", {makeTable(100), false}));
+  EXPECT_EQ(1, cache_->stats().numRejected);
+  EXPECT_EQ(2, cache_->stats().numEntries);
+
+  // Shrinking the capacity evicts the unused entries.
+  d = nullptr;
+  cache_->setCapacity(tableBytes);
+  EXPECT_FALSE(cache_->find("d").has_value());
+  EXPECT_TRUE(cache_->find("c").has_value());
+}
+
+TEST_F(HashJoinTableCacheTest, hasRoom) {
+  auto a = makeTable(100);
+  const auto tableBytes = a->allocatedBytes();
+  cache_->setCapacity(2 * tableBytes);
+  EXPECT_TRUE(cache_->hasRoom());
+
+  // A table being built counts against the capacity although it is not
+  // cached.
+  auto b = makeTable(100);
+  EXPECT_TRUE(cache_->insert("a", {a, false}));
+  EXPECT_FALSE(cache_->hasRoom());
+
+  // 'a' is evicted when it is no longer in use.
+  a = nullptr;
+  EXPECT_TRUE(cache_->hasRoom());
+  EXPECT_FALSE(cache_->find("a").has_value());
+  EXPECT_EQ(1, cache_->stats().numEvictions);
+  EXPECT_LT(cache_->stats().allocatedBytes, 2 * tableBytes);
+}
+
+TEST_F(HashJoinTableCacheTest, makeKey) {
+  auto inner = makeJoin(core::JoinType::kInner);
+  auto semi = makeJoin(core::JoinType::kSemi);
+  EXPECT_EQ(
+      HashJoinTableCache::makeKey(*inner, "v1"),
+      HashJoinTableCache::makeKey(*makeJoin(core::JoinType::kInner), "v1"));
+  EXPECT_NE(
+      HashJoinTableCache::makeKey(*inner, "v1"),
+      HashJoinTableCache::makeKey(*inner, "v2"));
+  EXPECT_NE(
+      HashJoinTableCache::makeKey(*inner, "v1"),
+      HashJoinTableCache::makeKey(*semi, "v1"));
+
+  EXPECT_TRUE(HashJoinTableCache::isCacheable(*inner));
+  EXPECT_TRUE(HashJoinTableCache::isCacheable(*semi));
+  EXPECT_FALSE(
+      HashJoinTableCache::isCacheable(*makeJoin(core::JoinType::kRight)));
+  EXPECT_FALSE(
+      HashJoinTableCache::isCacheable(*makeJoin(core::JoinType::kFull)));
+}
@@ -15,6 +15,7 @@
  */
 
 #include "velox/dwio/dwrf/test/utils/BatchMaker.h"
+#include "velox/exec/HashJoinTableCache.h"
 #include "velox/exec/tests/Cursor.h"
 #include "velox/exec/tests/HiveConnectorTestBase.h"
 #include "velox/exec/tests/PlanBuilder.h"
@@ -802,3 +803,66 @@ TEST_F(HashJoinTest, leftJoin) {
       op,
       "SELECT t.c0, t.c1, u.c1 FROM t LEFT JOIN u ON t.c0 = u.c0 AND (t.c1 + u.c1) % 2 = 3");
 }
+
+TEST_F(HashJoinTest, tableCache) {
+  auto leftVectors = makeRowVector({
+      makeFlatVector<int32_t>(1'000, [](auto row) { return row % 23; }),
+      makeFlatVector<int64_t>(1'000, [](auto row) { return row; }),
+  });
+  auto rightVectors = makeRowVector({
+      makeFlatVector<int32_t>(1'000, [](auto row) { return row % 31; }),
+      makeFlatVector<int64_t>(1'000, [](auto row) { return -row; }),
+  });
+  createDuckDbTable("t", {leftVectors});
+  createDuckDbTable("u", {rightVectors});
+
+  CursorParameters params;
+  params.planNode =
+      PlanBuilder(10)
+          .values({leftVectors}, true)
+          .hashJoin(
+              {0},
+              {0},
+              PlanBuilder(0).values({rightVectors}, true).planNode(),
+              "",
+              {1, 3})
+          .planNode();
+  params.maxDrivers = 4;
+
+  auto buildFromCache = [](const std::shared_ptr<Task>& task) {
+    for (const auto& pipeline : task->taskStats().pipelineStats) {
+      for (const auto& op : pipeline.operatorStats) {
+        if (op.operatorType == "HashBuild") {
+          return op.runtimeStats.count("hashTableFromCache") > 0;
+        }
+      }
+    }
+    VELOX_FAIL("No HashBuild in the task");
+  };
+
+  // The first query builds the table and the second one probes it.
+  auto* cache = HashJoinTableCache::instance();
+  const auto numEntries = cache->stats().numEntries;
+  for (auto i = 0; i < 2; ++i) {
+    params.queryCtx = core::QueryCtx::create();
+    params.queryCtx->setConfigOverridesUnsafe(
+        {{core::QueryCtx::kHashJoinTableCacheKey, "HashJoinTest.tableCache"}});
+    auto task = ::assertQuery(
+        params,
+        [](auto*) {},
+        "SELECT t.c1, u.c1 FROM t, u WHERE t.c0 = u.c0",
+        duckDbQueryRunner_);
+    EXPECT_EQ(i == 1, buildFromCache(task));
+  }
+  EXPECT_EQ(numEntries + 1, cache->stats().numEntries);
+
+  // Without the key, the table is built again.
+  params.queryCtx = core::QueryCtx::create();
+  auto task = ::assertQuery(
+      params,
+      [](auto*) {},
+      "SELECT t.c1, u.c1 FROM t, u WHERE t.c0 = u.c0",
+      duckDbQueryRunner_);
+  EXPECT_FALSE(buildFromCache(task));
+  cache->clear();
+}
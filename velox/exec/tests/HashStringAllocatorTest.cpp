@@ -108,6 +108,40 @@ TEST_F(HashStringAllocatorTest, allocate) {
   EXPECT_LE(instance_->retainedSize() - instance_->freeSpace(), 200);
 }
 
+TEST_F(HashStringAllocatorTest, allocateBatch) {
+  for (auto count = 0; count < 3; ++count) {
+    std::vector<HashStringAllocator::Header*> headers;
+    for (auto batch = 0; batch < 1'000; ++batch) {
+      std::vector<int32_t> sizes;
+      for (auto i = 0; i < 1 + batch % 20; ++i) {
+        sizes.push_back((i * 17 + batch) % 200);
+      }
+      std::vector<HashStringAllocator::Header*> batchHeaders(sizes.size());
+      instance_->allocateBatch(
+          folly::Range<const int32_t*>(sizes.data(), sizes.size()),
+          batchHeaders.data());
+      for (auto i = 0; i < sizes.size(); ++i) {
+        EXPECT_GE(batchHeaders[i]->size(), sizes[i]);
+        EXPECT_FALSE(batchHeaders[i]->isFree());
+        initializeContents(batchHeaders[i]);
+        headers.push_back(batchHeaders[i]);
+      }
+    }
+    instance_->checkConsistency();
+    // Free the blocks of each batch in a different order.
+    for (int32_t step = 5; step >= 1; --step) {
+      for (auto i = 0; i < headers.size(); i += step) {
+        if (headers[i]) {
+          instance_->free(headers[i]);
+          headers[i] = nullptr;
+        }
+      }
+      instance_->checkConsistency();
+    }
+  }
+  EXPECT_LE(instance_->retainedSize() - instance_->freeSpace(), 200);
+}
+
 TEST_F(HashStringAllocatorTest, multipart) {
   constexpr int32_t kNumSamples = 10'000;
   std::vector<Multipart> data(kNumSamples);
@@ -16,6 +16,7 @@
 #include "velox/exec/RowContainer.h"
 #include <gtest/gtest.h>
 #include <array>
+#include <numeric>
 #include <random>
 #include "velox/dwio/dwrf/test/utils/BatchMaker.h"
 #include "velox/dwio/type/fbhive/HiveTypeParser.h"
@@ -315,3 +316,161 @@ TEST_F(RowContainerTest, types) {
     }
   }
 }
+
+TEST_F(RowContainerTest, storeColumn) {
+  constexpr int32_t kNumRows = 1'000;
+  auto batch = makeDataset(
+      "long_val:bigint,"
+      "string_val:string,"
+      "bool_val:boolean,"
+      "string_val2:string,"
+      "double_val:double,"
+      "array_val:array<string>,"
+      "int_val:int",
+      kNumRows,
+      [](RowVectorPtr rows) {
+        auto strings = rows->childAt(1)->as<FlatVector<StringView>>();
+        for (auto i = 0; i < strings->size(); i += 97) {
+          std::string chars;
+          makeLargeString(i * 100, chars);
+          strings->set(i, StringView(chars));
+        }
+      });
+  const auto& types = batch->type()->as<TypeKind::ROW>().children();
+  // Two non-null keys and nullable dependents.
+  std::vector<TypePtr> keys(types.begin(), types.begin() + 2);
+  std::vector<TypePtr> dependents(types.begin() + 2, types.end());
+  makeNonNull(batch, 0);
+  makeNonNull(batch, 1);
+  // Dictionary encode one dependent.
+  auto indices = AlignedBuffer::allocate<vector_size_t>(kNumRows, pool_.get());
+  for (auto i = 0; i < kNumRows; ++i) {
+    indices->asMutable<vector_size_t>()[i] = kNumRows - 1 - i;
+  }
+  batch->childAt(3) = BaseVector::wrapInDictionary(
+      BufferPtr(nullptr), indices, kNumRows, batch->childAt(3));
+
+  auto expected = makeRowContainer(keys, dependents);
+  auto data = makeRowContainer(keys, dependents);
+  std::vector<char*> expectedRows(kNumRows);
+  std::vector<char*> rows(kNumRows);
+  for (auto i = 0; i < kNumRows; ++i) {
+    expectedRows[i] = expected->newRow();
+    rows[i] = data->newRow();
+  }
+
+  // Every third row is left out.
+  SelectivityVector selectedRows(kNumRows);
+  for (auto i = 0; i < kNumRows; i += 3) {
+    selectedRows.setValid(i, false);
+  }
+  selectedRows.updateBounds();
+  std::vector<char*> selectedExpectedRows;
+  std::vector<char*> selected;
+  selectedRows.applyToSelected([&](auto row) {
+    selectedExpectedRows.push_back(expectedRows[row]);
+    selected.push_back(rows[row]);
+  });
+
+  for (auto column = 0; column < batch->childrenSize(); ++column) {
+    DecodedVector decoded(*batch->childAt(column), selectedRows);
+    selectedRows.applyToSelected([&](auto row) {
+      expected->store(decoded, row, expectedRows[row], column);
+    });
+    data->storeColumn(decoded, selectedRows, rows.data(), column);
+  }
+  data->stringAllocator().checkConsistency();
+
+  for (auto column = 0; column < batch->childrenSize(); ++column) {
+    auto expectedColumn =
+        BaseVector::create(types[column], selected.size(), pool_.get());
+    expected->extractColumn(
+        selectedExpectedRows.data(),
+        selectedExpectedRows.size(),
+        column,
+        expectedColumn);
+    testExtractColumnForAllRows(*data, selected, column, expectedColumn);
+  }
+
+  // The strings are freed one by one when the rows are reused.
+  for (auto row : selected) {
+    data->initializeRow(row, true);
+  }
+  data->stringAllocator().checkConsistency();
+}
+
+TEST_F(RowContainerTest, extractColumns) {
+  // Not a multiple of the batch size of extractColumns.
+  constexpr int32_t kNumRows = 1'001;
+  auto batch = makeDataset(
+      "long_val:bigint,"
+      "string_val:string,"
+      "bool_val:boolean,"
+      "int_val:int,"
+      "string_val2:string,"
+      "array_val:array<string>,"
+      "double_val:double",
+      kNumRows,
+      [](RowVectorPtr rows) {
+        auto strings = rows->childAt(4)->as<FlatVector<StringView>>();
+        for (auto i = 0; i < strings->size(); i += 97) {
+          std::string chars;
+          makeLargeString(i * 100, chars);
+          strings->set(i, StringView(chars));
+        }
+      });
+  const auto& types = batch->type()->as<TypeKind::ROW>().children();
+  std::vector<TypePtr> keys(types.begin(), types.begin() + 2);
+  std::vector<TypePtr> dependents(types.begin() + 2, types.end());
+  makeNonNull(batch, 0);
+  makeNonNull(batch, 1);
+  auto data = makeRowContainer(keys, dependents);
+  std::vector<char*> rows(kNumRows);
+  for (auto i = 0; i < kNumRows; ++i) {
+    rows[i] = data->newRow();
+  }
+  SelectivityVector allRows(kNumRows);
+  for (auto column = 0; column < batch->childrenSize(); ++column) {
+    DecodedVector decoded(*batch->childAt(column), allRows);
+    data->storeColumn(decoded, allRows, rows.data(), column);
+  }
+
+  // Gathers the rows in a random order, as a hash join does, with every
+  // tenth row pointer null.
+  std::vector<vector_size_t> order(kNumRows);
+  std::iota(order.begin(), order.end(), 0);
+  std::shuffle(order.begin(), order.end(), std::mt19937(1));
+  std::vector<char*> gathered(kNumRows);
+  for (auto i = 0; i < kNumRows; ++i) {
+    gathered[i] = i % 10 == 0 ? nullptr : rows[order[i]];
+  }
+
+  // Extracts a subset of the columns in a different order.
+  std::vector<int32_t> projected = {5, 0, 4, 2, 6, 1};
+  std::vector<RowColumn> columns;
+  std::vector<VectorPtr> results;
+  for (auto column : projected) {
+    columns.push_back(data->columnAt(column));
+    results.push_back(BaseVector::create(types[column], 1, pool_.get()));
+  }
+  RowContainer::extractColumns(
+      gathered.data(),
+      gathered.size(),
+      folly::range(columns),
+      folly::range(results));
+  for (auto i = 0; i < projected.size(); ++i) {
+    const auto& expected = batch->childAt(projected[i]);
+    const auto& result = results[i];
+    ASSERT_EQ(kNumRows, result->size());
+    for (auto row = 0; row < kNumRows; ++row) {
+      if (!gathered[row]) {
+        EXPECT_TRUE(result->isNullAt(row)) << "at " << row;
+      } else {
+        EXPECT_TRUE(expected->equalValueAt(result.get(), order[row], row))
+            << "at " << row << ": expected "
+            << expected->toString(order[row]) << ", got "
+            << result->toString(row);
+      }
+    }
+  }
+}
@@ -13,6 +13,8 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <folly/executors/CPUThreadPoolExecutor.h>
+
 #include "velox/connectors/hive/HiveConnector.h"
 #include "velox/connectors/hive/HiveConnectorSplit.h"
 #include "velox/dwio/dwrf/test/utils/DataFiles.h"
@@ -36,6 +38,7 @@ using namespace facebook::velox::exec;
 using namespace facebook::velox::common::test;
 using namespace facebook::velox::exec::test;
 
+
 static const std::string kNodeSelectionStrategy = "node_selection_strategy";
 static const std::string kSoftAffinity = "SOFT_AFFINITY";
 static const std::string kTableScanTest = "TableScanTest.Writer";
@@ -151,6 +154,59 @@ class TableScanTest : public HiveConnectorTestBase {
     assertQuery(op, split, "SELECT '2020-11-01' FROM tmp");
   }
 
+  // Reads a file with one stripe per vector of 'vectors' as one split,
+  // which is divided among 4 drivers, one stripe each.
+  void testDivideSplit(const std::vector<RowVectorPtr>& vectors) {
+    auto filePath = TempFilePath::create();
+    {
+      dwrf::WriterOptions options;
+      options.config = std::make_shared<dwrf::Config>();
+      options.schema = rowType_;
+      dwrf::Writer writer{
+          options,
+          std::make_unique<facebook::dwio::common::FileSink>(filePath->path),
+          pool_->addChild(
+              kTableScanTest, std::numeric_limits<int64_t>::max())};
+      for (const auto& vector : vectors) {
+        writer.write(vector);
+        writer.flush();
+      }
+      writer.close();
+    }
+    createDuckDbTable(vectors);
+
+    CursorParameters params;
+    params.planNode = tableScanNode();
+    params.maxDrivers = 4;
+    auto cursor = std::make_unique<TaskCursor>(params);
+    auto task = cursor->task();
+
+    // The split is added when all 4 drivers wait for splits, so that the
+    // driver that gets it divides it with the other 3, one stripe each.
+    std::thread splitAdder([&]() {
+      while (task->numWaitingForSplits("0") < 4) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+      addSplit(task.get(), "0", makeHiveSplit(filePath->path));
+    });
+
+    std::vector<RowVectorPtr> results;
+    while (cursor->moveNext()) {
+      results.push_back(cursor->current());
+      if (results.size() == 1) {
+        // The split is divided before the first batch is produced.
+        task->noMoreSplits("0");
+      }
+    }
+    splitAdder.join();
+    assertResults(results, rowType_, "SELECT * FROM tmp", duckDbQueryRunner_);
+
+    auto stats = getTableScanStats(task);
+    EXPECT_EQ(4, stats.numSplits);
+    EXPECT_EQ(1, stats.runtimeStats["dividedSplits"].sum);
+    EXPECT_EQ(4, task->taskStats().numFinishedSplits);
+  }
+
   std::shared_ptr<const RowType> rowType_{
       ROW({"c0", "c1", "c2", "c3", "c4", "c5"},
           {BIGINT(), INTEGER(), SMALLINT(), REAL(), DOUBLE(), VARCHAR()})};
@@ -475,6 +531,65 @@ TEST_F(TableScanTest, waitForSplit) {
       duckDbQueryRunner_);
 }
 
+TEST_F(TableScanTest, preloadSplits) {
+  auto filePaths = makeFilePaths(10);
+  auto vectors = makeVectors(10, 1'000);
+  for (int32_t i = 0; i < vectors.size(); i++) {
+    writeToFile(filePaths[i]->path, kTableScanTest, vectors[i]);
+  }
+
+  auto executor = std::make_shared<folly::CPUThreadPoolExecutor>(4);
+  for (auto maxPreload : {0, 1, 3}) {
+    CursorParameters params;
+    params.planNode = tableScanNode(ROW({"c0"}, {BIGINT()}));
+    params.queryCtx = core::QueryCtx::create(
+        std::make_shared<core::MemConfig>(
+            std::unordered_map<std::string, std::string>{
+                {core::QueryCtx::kMaxSplitPreloadPerDriver,
+                 std::to_string(maxPreload)}}),
+        {},
+        memory::MappedMemory::getInstance(),
+        memory::getProcessDefaultMemoryManager().getRoot().addScopedChild(
+            "preloadSplits"),
+        executor);
+
+    auto cursor = std::make_unique<TaskCursor>(params);
+    for (const auto& filePath : filePaths) {
+      addSplit(cursor->task().get(), "0", makeHiveSplit(filePath->path));
+    }
+    cursor->task()->noMoreSplits("0");
+
+    int32_t numRead = 0;
+    while (cursor->moveNext()) {
+      numRead += cursor->current()->size();
+    }
+    EXPECT_EQ(10'000, numRead);
+
+    auto stats = getTableScanStats(cursor->task());
+    EXPECT_EQ(10, stats.numSplits);
+    // The first split is not preloaded, the others are if preloading is on.
+    EXPECT_EQ(
+        maxPreload == 0 ? 0 : 9, stats.runtimeStats["preloadedSplits"].sum);
+  }
+
+  // An error opening a preloaded file is raised when its split is read.
+  CursorParameters params;
+  params.planNode = tableScanNode();
+  params.queryCtx = core::QueryCtx::create(
+      std::make_shared<core::MemConfig>(),
+      {},
+      memory::MappedMemory::getInstance(),
+      memory::getProcessDefaultMemoryManager().getRoot().addScopedChild(
+          "preloadSplits"),
+      executor);
+  auto cursor = std::make_unique<TaskCursor>(params);
+  addSplit(cursor->task().get(), "0", makeHiveSplit(filePaths[0]->path));
+  addSplit(
+      cursor->task().get(), "0", makeHiveSplit("file:/path/to/nowhere.orc"));
+  cursor->task()->noMoreSplits("0");
+  EXPECT_THROW(while (cursor->moveNext()) {}, std::runtime_error);
+}
+
 TEST_F(TableScanTest, splitOffsetAndLength) {
   auto vectors = makeVectors(10, 1'000);
   auto filePath = TempFilePath::create();
@@ -1659,3 +1774,248 @@ TEST_F(TableScanTest, bitwiseAggregationPushdown) {
       {filePath},
       "SELECT c5, bit_or(c0), bit_or(c1), bit_or(c2), bit_or(c6) FROM tmp group by c5");
 }
+
+TEST_F(TableScanTest, aggregationFromStats) {
+  auto rowType = ROW(
+      {"c0", "c1", "c2", "c3"}, {BIGINT(), INTEGER(), SMALLINT(), DOUBLE()});
+  auto filePaths = makeFilePaths(3);
+  auto vectors = makeVectors(3, 1'000, rowType);
+  for (int32_t i = 0; i < vectors.size(); i++) {
+    writeToFile(filePaths[i]->path, kTableScanTest, vectors[i]);
+  }
+  createDuckDbTable(vectors);
+
+  auto tableHandle = makeTableHandle(SubfieldFilters());
+  auto assignments = allRegularColumns(rowType);
+
+  auto task = assertQuery(
+      PlanBuilder()
+          .tableScan(rowType, tableHandle, assignments)
+          .singleAggregation(
+              {},
+              {"count(1)",
+               "count(c0)",
+               "min(c0)",
+               "max(c0)",
+               "max(c1)",
+               "min(c2)",
+               "count(c3)"})
+          .planNode(),
+      filePaths,
+      "SELECT count(*), count(c0), min(c0), max(c0), max(c1), min(c2), "
+      "count(c3) FROM tmp");
+  auto tableScanStats = getTableScanStats(task);
+  EXPECT_EQ(3, tableScanStats.runtimeStats["statsAnsweredSplits"].sum);
+  EXPECT_EQ(3'000, tableScanStats.rawInputPositions);
+
+  // Partial aggregation is answered from stats too.
+  task = assertQuery(
+      PlanBuilder()
+          .tableScan(rowType, tableHandle, assignments)
+          .partialAggregation({}, {"count(1)", "min(c1)", "max(c2)"})
+          .finalAggregation({}, {"sum(a0)", "min(a1)", "max(a2)"})
+          .planNode(),
+      filePaths,
+      "SELECT count(*), min(c1), max(c2) FROM tmp");
+  EXPECT_EQ(
+      3, getTableScanStats(task).runtimeStats["statsAnsweredSplits"].sum);
+
+  // min of a double needs the values.
+  task = assertQuery(
+      PlanBuilder()
+          .tableScan(rowType, tableHandle, assignments)
+          .singleAggregation({}, {"count(1)", "min(c3)"})
+          .planNode(),
+      filePaths,
+      "SELECT count(*), min(c3) FROM tmp");
+  EXPECT_EQ(
+      0, getTableScanStats(task).runtimeStats["statsAnsweredSplits"].sum);
+
+  // Filters and aggregates other than count, min and max need the values.
+  tableHandle = makeTableHandle(
+      SubfieldFiltersBuilder().add("c0", greaterThanOrEqual(0)).build());
+  task = assertQuery(
+      PlanBuilder()
+          .tableScan(rowType, tableHandle, assignments)
+          .singleAggregation({}, {"count(1)", "max(c1)"})
+          .planNode(),
+      filePaths,
+      "SELECT count(*), max(c1) FROM tmp WHERE c0 >= 0");
+  EXPECT_EQ(
+      0, getTableScanStats(task).runtimeStats["statsAnsweredSplits"].sum);
+
+  tableHandle = makeTableHandle(SubfieldFilters());
+  task = assertQuery(
+      PlanBuilder()
+          .tableScan(rowType, tableHandle, assignments)
+          .singleAggregation({}, {"count(1)", "sum(c1)"})
+          .planNode(),
+      filePaths,
+      "SELECT count(*), sum(c1) FROM tmp");
+  EXPECT_EQ(
+      0, getTableScanStats(task).runtimeStats["statsAnsweredSplits"].sum);
+}
+
+TEST_F(TableScanTest, aggregationFromStatsWithPartitionKeyFilter) {
+  auto rowType = ROW({"c0", "c1"}, {BIGINT(), INTEGER()});
+  auto filePaths = makeFilePaths(3);
+  auto vectors = makeVectors(3, 1'000, rowType);
+  for (int32_t i = 0; i < vectors.size(); i++) {
+    writeToFile(filePaths[i]->path, kTableScanTest, vectors[i]);
+  }
+  createDuckDbTable(vectors);
+
+  std::vector<std::shared_ptr<connector::ConnectorSplit>> splits;
+  for (const auto& filePath : filePaths) {
+    splits.push_back(std::make_shared<HiveConnectorSplit>(
+        kHiveConnectorId,
+        filePath->path,
+        facebook::dwio::common::FileFormat::ORC,
+        0,
+        fs::file_size(filePath->path),
+        std::unordered_map<std::string, std::string>{{"ds", "2021-01-01"}}));
+  }
+  auto outputType = ROW({"ds", "c0", "c1"}, {VARCHAR(), BIGINT(), INTEGER()});
+  ColumnHandleMap assignments = {
+      {"ds", partitionKey("ds")},
+      {"c0", regularColumn("c0")},
+      {"c1", regularColumn("c1")}};
+  auto makePlan = [&](const std::string& ds) {
+    return PlanBuilder()
+        .tableScan(
+            outputType,
+            makeTableHandle(
+                SubfieldFiltersBuilder().add("ds", equal(ds)).build()),
+            assignments)
+        .singleAggregation({}, {"count(1)", "min(c0)", "max(c1)"})
+        .planNode();
+  };
+
+  // The filter on the partition key holds for all rows of the splits, so
+  // these are answered from stats.
+  auto task = OperatorTestBase::assertQuery(
+      makePlan("2021-01-01"),
+      splits,
+      "SELECT count(*), min(c0), max(c1) FROM tmp");
+  EXPECT_EQ(
+      3, getTableScanStats(task).runtimeStats["statsAnsweredSplits"].sum);
+
+  // No split passes the filter.
+  task = OperatorTestBase::assertQuery(
+      makePlan("2020-01-01"),
+      splits,
+      "SELECT count(*), min(c0), max(c1) FROM tmp WHERE false");
+  EXPECT_EQ(3, getSkippedSplitsStat(task));
+  EXPECT_EQ(
+      0, getTableScanStats(task).runtimeStats["statsAnsweredSplits"].sum);
+}
+
+TEST_F(TableScanTest, decodedStripeCache) {
+  // Replace the connector with one that has a decoded stripe cache.
+  connector::unregisterConnector(kHiveConnectorId);
+  auto hiveConnector =
+      connector::getConnectorFactory(kHiveConnectorName)
+          ->newConnector(
+              kHiveConnectorId,
+              std::make_shared<core::MemConfig>(
+                  std::unordered_map<std::string, std::string>{
+                      {HiveConnector::kDecodedStripeCacheBytes,
+                       std::to_string(64 << 20)}}));
+  connector::registerConnector(hiveConnector);
+  auto cache = std::dynamic_pointer_cast<HiveConnector>(hiveConnector)
+                   ->decodedStripeCache();
+  ASSERT_TRUE(cache != nullptr);
+
+  auto vectors = makeVectors(10, 1'000);
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->path, kTableScanTest, vectors);
+  createDuckDbTable(vectors);
+
+  // The first scan decodes the stripes and adds their columns to the cache.
+  assertQuery(tableScanNode(), {filePath}, "SELECT * FROM tmp");
+  EXPECT_EQ(0, cache->numHits());
+  EXPECT_LT(0, cache->currentBytes());
+
+  // The second scan gets all columns from the cache.
+  auto numMisses = cache->numMisses();
+  assertQuery(tableScanNode(), {filePath}, "SELECT * FROM tmp");
+  EXPECT_EQ(numMisses, cache->numMisses());
+  EXPECT_LT(0, cache->numHits());
+
+  // Filters are applied to the cached values.
+  auto numHits = cache->numHits();
+  auto tableHandle = makeTableHandle(
+      SubfieldFiltersBuilder()
+          .add("c0", greaterThanOrEqual(0))
+          .add("c5", isNotNull())
+          .build());
+  assertQuery(
+      PlanBuilder()
+          .tableScan(rowType_, tableHandle, allRegularColumns(rowType_))
+          .planNode(),
+      {filePath},
+      "SELECT * FROM tmp WHERE c0 >= 0 AND c5 IS NOT NULL");
+  EXPECT_EQ(numMisses, cache->numMisses());
+  EXPECT_LT(numHits, cache->numHits());
+}
+
+TEST_F(TableScanTest, decodedStripeCacheSkipsLargeColumns) {
+  connector::unregisterConnector(kHiveConnectorId);
+  auto hiveConnector =
+      connector::getConnectorFactory(kHiveConnectorName)
+          ->newConnector(
+              kHiveConnectorId,
+              std::make_shared<core::MemConfig>(
+                  std::unordered_map<std::string, std::string>{
+                      {HiveConnector::kDecodedStripeCacheBytes,
+                       std::to_string(1 << 20)}}));
+  connector::registerConnector(hiveConnector);
+  auto cache = std::dynamic_pointer_cast<HiveConnector>(hiveConnector)
+                   ->decodedStripeCache();
+  ASSERT_TRUE(cache != nullptr);
+
+  auto rowType = ROW({"c0"}, {BIGINT()});
+  auto scan = [&](int32_t numRows) {
+    auto vectors = makeVectors(1, numRows, rowType);
+    auto filePath = TempFilePath::create();
+    writeToFile(filePath->path, kTableScanTest, vectors);
+    createDuckDbTable(vectors);
+    assertQuery(
+        PlanBuilder()
+            .tableScan(
+                rowType,
+                makeTableHandle(SubfieldFilters{}),
+                allRegularColumns(rowType))
+            .planNode(),
+        {filePath},
+        "SELECT * FROM tmp");
+  };
+
+  // 100'000 bigints take 800KB, over an eighth of the capacity, so the
+  // stripe is not collected.
+  scan(100'000);
+  EXPECT_EQ(0, cache->currentBytes());
+
+  // 10'000 take 80KB.
+  scan(10'000);
+  EXPECT_LT(0, cache->currentBytes());
+
+  // The cached vectors are allocated within the capacity.
+  EXPECT_EQ(1 << 20, cache->pool()->getCap());
+  EXPECT_LE(cache->pool()->getCurrentBytes(), 1 << 20);
+}
+
+TEST_F(TableScanTest, divideSplit) {
+  testDivideSplit(makeVectors(4, 1'000));
+}
+
+// The driver that divides the split reads a stripe of 10 rows and finishes
+// while the others read theirs. The readers of the other parts must not
+// depend on it.
+TEST_F(TableScanTest, divideSplitShortFirstPart) {
+  auto vectors = makeVectors(1, 10);
+  for (auto& vector : makeVectors(3, 20'000)) {
+    vectors.push_back(std::move(vector));
+  }
+  testDivideSplit(vectors);
+}
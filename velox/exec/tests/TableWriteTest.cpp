@@ -211,6 +211,92 @@ TEST_F(TableWriteTest, constantVectors) {
       "SELECT * FROM tmp");
 }
 
+TEST_F(TableWriteTest, sortedWrite) {
+  auto vectors = makeVectors(rowType_, 5, 1'000);
+  createDuckDbTable(vectors);
+
+  auto outputFile = TempFilePath::create();
+  auto plan = PlanBuilder()
+                  .values(vectors)
+                  .tableWrite(
+                      rowType_->names(),
+                      std::make_shared<core::InsertTableHandle>(
+                          kHiveConnectorId,
+                          std::make_shared<HiveInsertTableHandle>(
+                              outputFile->path,
+                              std::vector<std::string>{"c1", "c0"})),
+                      "rows")
+                  .project({"rows"})
+                  .planNode();
+  assertQuery(plan, "SELECT 5000");
+
+  bool added = false;
+  ::assertQuery(
+      PlanBuilder().tableScan(rowType_).planNode(),
+      [&](Task* task) {
+        if (!added) {
+          addSplit(task, "0", makeHiveSplit(outputFile->path));
+          task->noMoreSplits("0");
+          added = true;
+        }
+      },
+      "SELECT * FROM tmp ORDER BY c1 NULLS FIRST, c0 NULLS FIRST",
+      duckDbQueryRunner_,
+      std::vector<uint32_t>{1, 0});
+}
+
+TEST_F(TableWriteTest, zOrderWrite) {
+  // The points of an 8 x 8 grid in reverse order, with the position of each
+  // on the Z curve in which 'x' has the more significant bits.
+  auto mortonCode = [](int32_t x, int32_t y) {
+    int32_t code = 0;
+    for (auto bit = 0; bit < 3; ++bit) {
+      code |= ((x >> bit) & 1) << (2 * bit + 1);
+      code |= ((y >> bit) & 1) << (2 * bit);
+    }
+    return code;
+  };
+  auto vector = makeRowVector({
+      makeFlatVector<int32_t>(64, [](auto row) { return (63 - row) % 8; }),
+      makeFlatVector<int64_t>(64, [](auto row) { return (63 - row) / 8; }),
+      makeFlatVector<int32_t>(
+          64,
+          [&](auto row) { return mortonCode((63 - row) % 8, (63 - row) / 8); }),
+  });
+  auto rowType = ROW({"x", "y", "code"}, {INTEGER(), BIGINT(), INTEGER()});
+  createDuckDbTable({vector});
+
+  auto outputFile = TempFilePath::create();
+  auto plan = PlanBuilder()
+                  .values({vector})
+                  .tableWrite(
+                      rowType->names(),
+                      std::make_shared<core::InsertTableHandle>(
+                          kHiveConnectorId,
+                          std::make_shared<HiveInsertTableHandle>(
+                              outputFile->path,
+                              std::vector<std::string>{"x", "y"},
+                              HiveInsertTableHandle::SortOrder::kZOrder)),
+                      "rows")
+                  .project({"rows"})
+                  .planNode();
+  assertQuery(plan, "SELECT 64");
+
+  bool added = false;
+  ::assertQuery(
+      PlanBuilder().tableScan(rowType).planNode(),
+      [&](Task* task) {
+        if (!added) {
+          addSplit(task, "0", makeHiveSplit(outputFile->path));
+          task->noMoreSplits("0");
+          added = true;
+        }
+      },
+      "SELECT * FROM tmp ORDER BY c2",
+      duckDbQueryRunner_,
+      std::vector<uint32_t>{2});
+}
+
 // Generate input data and execute a query to generate an output file. It adds a
 // "WHERE false" filter to ensure no data is output'ed to the file, and checks
 // that no leftover empty files were created.
@@ -39,6 +39,7 @@ bool Codegen::initialize(
         proto::CodegenOptionsProto>::loadProtoFromJson(codegenOptionsJson);
 
     useSymbolsForArithmetic_ = codegenOptionsProto.usesymbolsforarithmetic();
+    backgroundCompilation_ = codegenOptionsProto.backgroundcompilation();
     initializeCodeManager(codegenOptionsProto.compileroptions());
     initializeUDFManager();
     initializeTransform();
@@ -100,6 +101,11 @@ bool Codegen::initializeTransform() {
           *udfManager_,
           useSymbolsForArithmetic_,
           *std::static_pointer_cast<DefaultEventSequence>(eventSequence_)));
+  if (backgroundCompilation_) {
+    auto flags = CodegenCompiledExpressionTransform::defaultFlags;
+    flags.backgroundCompilation = true;
+    transform_->setTransformFlags(flags);
+  }
   return true;
 }
 
@@ -62,6 +62,9 @@ class Codegen {
   // Follows Velox, defaults to false
   bool useSymbolsForArithmetic_ = false;
 
+  // Compile in the background and interpret until the code is ready.
+  bool backgroundCompilation_ = false;
+
   bool initializeCodeManager(
       const proto::CompilerOptionsProto& compilerOptionsProto);
 
@@ -23,6 +23,7 @@
 #include "velox/core/PlanNode.h"
 #include "velox/experimental/codegen/CompiledExpressionAnalysis.h"
 #include "velox/experimental/codegen/code_generator/ExprCodeGenerator.h"
+#include "velox/experimental/codegen/compiler_utils/BackgroundCompiledCall.h"
 #include "velox/experimental/codegen/compiler_utils/CodeManager.h"
 #include "velox/experimental/codegen/compiler_utils/ICompiledCall.h"
 #include "velox/experimental/codegen/transform/PlanNodeTransform.h"
@@ -44,11 +45,15 @@ class CompiledExpressionTransformVisitor {
       const CompilerOptions& options,
       DefaultScopedTimer::EventSequence& eventSequence,
       bool compileFilter = true,
-      bool mergeFilter = true)
+      bool mergeFilter = true,
+      bool backgroundCompilation = false)
       : codeManager_(options, eventSequence),
         compiledExprAnalysisResult_(compiledExprAnalysisResult),
         compileFilter_(compileFilter),
-        mergeFilter_(mergeFilter) {}
+        // A merged filter drops rows, which the interpreted fallback of
+        // background compilation cannot reproduce.
+        mergeFilter_(mergeFilter && !backgroundCompilation),
+        backgroundCompilation_(backgroundCompilation) {}
 
   template <typename Children>
   std::shared_ptr<core::PlanNode> visit(
@@ -108,6 +113,7 @@ class CompiledExpressionTransformVisitor {
 
   bool compileFilter_;
   bool mergeFilter_;
+  bool backgroundCompilation_;
 
   std::optional<std::reference_wrapper<const GeneratedExpressionStruct>>
   getGeneratedCode(const std::shared_ptr<const ITypedExpr>& expression) {
@@ -400,12 +406,14 @@ class CompiledExpressionTransformVisitor {
   /// into                    {PlusExpr,MinusExpr}
   /// [   -> FieldsAccess(c) -> CompiledEpr{c,d}  -> FieldsAccess(b) ->
   /// InputExpr({a,b},{DOUBLE,DOUBLE}) [   -> FieldsAccess(d) / \
-  /// FieldsAccess(a) / \param dynamicObjectPath  compiled code path \param
+  /// FieldsAccess(a) / \param fileString generated code \param
+  /// interpretedExprs original expressions, one per output column \param
   /// callOutputType compiled expression output row type \param callInputType
   /// compiled expression input  row type \param projectionInputType input type
   /// of the original projection \return
   std::vector<std::shared_ptr<const ITypedExpr>> buildCompiledCallExpr(
-      const std::filesystem::path& dynamicObjectPath,
+      const std::string& fileString,
+      const std::vector<std::shared_ptr<const ITypedExpr>>& interpretedExprs,
       const std::shared_ptr<const RowType>& callOutputType,
       const std::shared_ptr<const RowType>& callInputType,
       const std::shared_ptr<const RowType>& projectionInputType) {
@@ -418,9 +426,21 @@ class CompiledExpressionTransformVisitor {
     auto inputFieldAccessVector =
         buildFieldAccessor(*callInputType, projectionInputExpr);
 
-    // Create ICompiledExpression
-    auto compiledExpression = std::make_shared<codegen::ICompiledCall>(
-        dynamicObjectPath, inputFieldAccessVector, callOutputType);
+    // Create ICompiledExpression. In background mode the library is built
+    // while the query runs the interpreted expressions.
+    std::shared_ptr<const ITypedExpr> compiledExpression;
+    if (backgroundCompilation_) {
+      compiledExpression = std::make_shared<codegen::BackgroundCompiledCall>(
+          codeManager_.compileAndLinkAsync(fileString),
+          interpretedExprs,
+          inputFieldAccessVector,
+          callOutputType);
+    } else {
+      compiledExpression = std::make_shared<codegen::ICompiledCall>(
+          codeManager_.compileAndLink(fileString),
+          inputFieldAccessVector,
+          callOutputType);
+    }
 
     // Create the field accessor to read the output of the compiled call
     auto outputFieldAccessVector =
@@ -486,14 +506,15 @@ class CompiledExpressionTransformVisitor {
             "isDefaultNullStrict",
             isDefaultNullStrict(filter.id()) ? "true" : "false"));
 
-    auto compiledObject = codeManager_.compiler().compileString({}, fileString);
-    auto dynamicObject = codeManager_.compiler().link({}, {compiledObject});
-
     // Extract the row input expression from the current filter
     const auto inputType = filter.sources()[0]->outputType();
 
     std::shared_ptr<const ITypedExpr> newFilter = buildCompiledCallExpr(
-        dynamicObject, concatOutputType, concatInputType, inputType)[0];
+        fileString,
+        {filter.filter()},
+        concatOutputType,
+        concatInputType,
+        inputType)[0];
 
     // Build new filter node with newly generated expressions
     return utils::adapter::FilterCopy::copyWith(
@@ -583,16 +604,23 @@ class CompiledExpressionTransformVisitor {
         fmt::arg(
             "isDefaultNullStrict", isDefaultNullStrict ? "true" : "false"));
 
-    auto compiledObject = codeManager_.compiler().compileString({}, fileString);
-    auto dynamicObject = codeManager_.compiler().link({}, {compiledObject});
     std::vector<std::shared_ptr<const ITypedExpr>> newProjections;
 
     // Extract the row input expression from the current projection
     const auto inputType = projection.sources()[0]->outputType();
 
+    std::vector<std::shared_ptr<const ITypedExpr>> interpretedExprs;
+    for (const auto& [columnIndex, expressionStruct] : generatedColumns) {
+      interpretedExprs.push_back(projection.projections()[columnIndex]);
+    }
+
     std::vector<std::shared_ptr<const ITypedExpr>> newExpressions =
         buildCompiledCallExpr(
-            dynamicObject, concatOutputType, concatInputType, inputType);
+            fileString,
+            interpretedExprs,
+            concatOutputType,
+            concatInputType,
+            inputType);
 
     // oldToNewExpressionColumnMap[Index] in the new projection list maps to
     // projection.projections()[Index] in the old;
@@ -642,6 +670,10 @@ union TransformFlags {
     // invalid if enableDefaultNullOpt not set
     bool enableFilterDefaultNull : 1;
 
+    // compile in the background and interpret until the code is ready
+    // disables mergeFilter
+    bool backgroundCompilation : 1;
+
     // up for more flags in the future
   };
 
@@ -651,7 +683,7 @@ union TransformFlags {
 
 class CodegenCompiledExpressionTransform final : PlanNodeTransform {
  public:
-  constexpr static TransformFlags defaultFlags = {{1, 1, 1, 1}};
+  constexpr static TransformFlags defaultFlags = {{1, 1, 1, 1, 0}};
   CodegenCompiledExpressionTransform(
       const CompilerOptions& options,
       const UDFManager& udfManager,
@@ -683,7 +715,8 @@ class CodegenCompiledExpressionTransform final : PlanNodeTransform {
         compilerOptions_,
         eventSequence_,
         flags_.compileFilter,
-        flags_.mergeFilter);
+        flags_.mergeFilter,
+        flags_.backgroundCompilation);
 
     auto nodeTransformer = [&visitor](
                                auto& node, const auto& transformedChildren) {
@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <chrono>
+#include <future>
+#include <mutex>
+#include "velox/experimental/codegen/compiler_utils/ICompiledCall.h"
+#include "velox/expression/Expr.h"
+
+namespace facebook {
+namespace velox {
+namespace codegen {
+
+/// Library of a BackgroundCompiledCall. Loads the library once it is built
+/// and makes the generated function. Shared by the
+/// BackgroundCompiledFunctions of all the expressions made from the call.
+class BackgroundCompiledLibrary {
+ public:
+  BackgroundCompiledLibrary(
+      std::shared_future<std::filesystem::path> library,
+      std::shared_ptr<const RowType> outputType)
+      : library_(std::move(library)), outputType_(std::move(outputType)) {}
+
+  /// Returns the generated function once the library is ready, nullptr
+  /// before that or if the compilation failed.
+  const GeneratedVectorFunctionBase* compiledFunction() {
+    std::lock_guard<std::mutex> l(mutex_);
+    if (compiled_ || failed_) {
+      return compiled_.get();
+    }
+    if (library_.wait_for(std::chrono::seconds(0)) !=
+        std::future_status::ready) {
+      return nullptr;
+    }
+    try {
+      auto& loader = native_loader::NativeLibraryLoader::getDefaultLoader();
+      // The loader is shared with all compiled expressions.
+      static std::mutex loaderMutex;
+      std::lock_guard<std::mutex> loaderLock(loaderMutex);
+      const auto& path = library_.get();
+      auto loadedLibrary = loader.findLoadedLibrary(path);
+      if (loadedLibrary == nullptr) {
+        loadedLibrary = loader.loadLibrary(path, nullptr);
+      }
+      auto newInstance = loader.getFunction<NewInstanceSignature>(
+          "newInstance", loadedLibrary);
+      compiled_ = newInstance();
+      compiled_->setRowType(outputType_);
+    } catch (const std::exception& e) {
+      LOG(WARNING) << "Background compilation failed, keep interpreting: "
+                   << e.what();
+      failed_ = true;
+      compiled_.reset();
+    }
+    return compiled_.get();
+  }
+
+  /// Blocks until the library is built or its build failed.
+  void wait() const {
+    library_.wait();
+  }
+
+ private:
+  using NewInstanceSignature =
+      std::unique_ptr<GeneratedVectorFunctionBase> (*)();
+
+  const std::shared_future<std::filesystem::path> library_;
+  const std::shared_ptr<const RowType> outputType_;
+
+  std::mutex mutex_;
+  std::unique_ptr<GeneratedVectorFunctionBase> compiled_;
+  bool failed_{false};
+};
+
+/// Vector function behind a BackgroundCompiledCall. Evaluates the original
+/// expressions with the interpreter until the library is ready, then
+/// delegates every following batch to the generated function. If the
+/// compilation fails, the interpreter keeps being used. A new instance is
+/// made for each expression, so an instance is used by one thread at a
+/// time.
+class BackgroundCompiledFunction : public exec::VectorFunction {
+ public:
+  BackgroundCompiledFunction(
+      std::shared_ptr<BackgroundCompiledLibrary> library,
+      std::vector<std::shared_ptr<const core::ITypedExpr>> interpretedExprs,
+      std::shared_ptr<const RowType> inputType,
+      std::shared_ptr<const RowType> outputType)
+      : library_(std::move(library)),
+        interpretedExprs_(std::move(interpretedExprs)),
+        inputType_(std::move(inputType)),
+        outputType_(std::move(outputType)) {}
+
+  void apply(
+      const SelectivityVector& rows,
+      std::vector<VectorPtr>& args,
+      exec::Expr* caller,
+      exec::EvalCtx* context,
+      VectorPtr* result) const override {
+    if (auto compiled = library_->compiledFunction()) {
+      compiled->apply(rows, args, caller, context, result);
+      return;
+    }
+
+    // The interpreted expressions reference the input columns by name, so
+    // evaluate them over a row made of the arguments of the compiled call.
+    auto input = std::make_shared<RowVector>(
+        context->pool(), inputType_, BufferPtr(nullptr), rows.end(), args);
+    if (!exprSet_) {
+      auto exprs = interpretedExprs_;
+      exprSet_ =
+          std::make_unique<exec::ExprSet>(std::move(exprs), context->execCtx());
+    }
+    exec::EvalCtx evalCtx(context->execCtx(), exprSet_.get(), input.get());
+    std::vector<VectorPtr> columns;
+    exprSet_->eval(rows, &evalCtx, &columns);
+    *result = std::make_shared<RowVector>(
+        context->pool(),
+        outputType_,
+        BufferPtr(nullptr),
+        rows.end(),
+        std::move(columns));
+  }
+
+  // Both the interpreted expressions and the generated function handle
+  // null inputs themselves.
+  bool isDefaultNullBehavior() const override {
+    return false;
+  }
+
+ private:
+  const std::shared_ptr<BackgroundCompiledLibrary> library_;
+  const std::vector<std::shared_ptr<const core::ITypedExpr>> interpretedExprs_;
+  const std::shared_ptr<const RowType> inputType_;
+  const std::shared_ptr<const RowType> outputType_;
+
+  // The interpreted expressions, compiled on first use with the ExecCtx of
+  // the expression 'this' is made for.
+  mutable std::unique_ptr<exec::ExprSet> exprSet_;
+};
+
+/// Compiled expression whose library is still being built. Produces the
+/// same row as the ICompiledCall it stands for, from the same inputs.
+/// Queries start right away on the interpreter and switch to the compiled
+/// code between batches once the library is available.
+class BackgroundCompiledCall : public core::CallTypedExpr {
+ public:
+  /// 'interpretedExprs' are the original expressions, one per column of
+  /// 'rowType'. 'inputs' are the field accesses of the compiled call.
+  BackgroundCompiledCall(
+      std::shared_future<std::filesystem::path> library,
+      const std::vector<std::shared_ptr<const ITypedExpr>>& interpretedExprs,
+      const std::vector<std::shared_ptr<const ITypedExpr>>& inputs,
+      const std::shared_ptr<const RowType>& rowType)
+      : core::CallTypedExpr(rowType, inputs, ""),
+        library_(std::make_shared<BackgroundCompiledLibrary>(
+            std::move(library), rowType)),
+        interpretedExprs_(interpretedExprs) {
+    VELOX_CHECK_EQ(interpretedExprs_.size(), rowType->size());
+  }
+  BackgroundCompiledCall(const BackgroundCompiledCall&) = delete;
+  BackgroundCompiledCall(BackgroundCompiledCall&&) = delete;
+
+  std::string toString() const override {
+    return "[BackgroundCompiled] : " + core::CallTypedExpr::toString();
+  }
+
+  bool operator==(const ITypedExpr& other) const override {
+    return dynamic_cast<const BackgroundCompiledCall*>(&other) == this;
+  }
+
+  /// Blocks until the library is built or its build failed.
+  void waitForLibrary() const {
+    library_->wait();
+  }
+
+  // Registers the switching function on first use, as ICompiledCall does.
+  // Each expression made from 'this' gets its own instance of it.
+  const std::string& name() const override {
+    if (!name_.has_value()) {
+      std::vector<std::string> inputNames;
+      std::vector<TypePtr> inputTypes;
+      for (const auto& input : inputs()) {
+        auto field =
+            std::dynamic_pointer_cast<const core::FieldAccessTypedExpr>(input);
+        VELOX_CHECK_NOT_NULL(field);
+        inputNames.push_back(field->name());
+        inputTypes.push_back(field->type());
+      }
+      name_ = registerCompiledFunction(
+          [library = library_,
+           interpretedExprs = interpretedExprs_,
+           inputType = ROW(std::move(inputNames), std::move(inputTypes)),
+           outputType = std::dynamic_pointer_cast<const RowType>(type())](
+              const std::string& /*name*/,
+              const std::vector<exec::VectorFunctionArg>& /*inputArgs*/) {
+            return std::make_shared<BackgroundCompiledFunction>(
+                library, interpretedExprs, inputType, outputType);
+          });
+    }
+    return name_.value();
+  }
+
+ private:
+  const std::shared_ptr<BackgroundCompiledLibrary> library_;
+  const std::vector<std::shared_ptr<const ITypedExpr>> interpretedExprs_;
+  mutable std::optional<std::string> name_;
+};
+
+} // namespace codegen
+} // namespace velox
+} // namespace facebook
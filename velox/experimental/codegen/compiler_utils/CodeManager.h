@@ -15,6 +15,8 @@
  */
 #pragma once
 
+#include <future>
+#include "velox/experimental/codegen/compiler_utils/CompiledLibraryCache.h"
 #include "velox/experimental/codegen/compiler_utils/Compiler.h"
 #include "velox/experimental/codegen/compiler_utils/CompilerOptions.h"
 #include "velox/experimental/codegen/library_loader/NativeLibraryLoader.h"
@@ -22,6 +24,7 @@
 
 namespace facebook::velox::codegen {
 
+using compiler_utils::CompiledLibraryCache;
 using compiler_utils::Compiler;
 using compiler_utils::CompilerOptions;
 using native_loader::NativeLibraryLoader;
@@ -45,7 +48,51 @@ class CodeManager {
     return loader_;
   }
 
+  /// Compiles and links 'cppContent' into a dynamic library and returns its
+  /// path. When CompilerOptions::libraryCacheDirectory is set, a library
+  /// previously built from the same source and options is reused, including
+  /// one built by another query or process.
+  std::filesystem::path compileAndLink(const std::string& cppContent) {
+    return compileAndLink(compiler_, cppContent);
+  }
+
+  /// Same as compileAndLink() but runs on a separate thread. The compilation
+  /// uses its own Compiler and event sequence, so it may outlive this object.
+  /// Releasing the last reference to the future waits for the compilation.
+  std::shared_future<std::filesystem::path> compileAndLinkAsync(
+      const std::string& cppContent) {
+    return std::async(
+               std::launch::async,
+               [options = compiler_.compilerOptions(), cppContent]() {
+                 DefaultScopedTimer::EventSequence eventSequence;
+                 Compiler compiler(options, eventSequence);
+                 return compileAndLink(compiler, cppContent);
+               })
+        .share();
+  }
+
  private:
+  static std::filesystem::path compileAndLink(
+      Compiler& compiler,
+      const std::string& cppContent) {
+    const auto& cacheDirectory =
+        compiler.compilerOptions().libraryCacheDirectory;
+    if (!cacheDirectory.has_value()) {
+      auto object = compiler.compileString({}, cppContent);
+      return compiler.link({}, {object});
+    }
+
+    CompiledLibraryCache cache(cacheDirectory.value());
+    const auto key =
+        CompiledLibraryCache::key(compiler.compilerOptions(), cppContent);
+    if (auto cached = cache.find(key)) {
+      return cached.value();
+    }
+    auto object = compiler.compileString({}, cppContent);
+    auto library = compiler.link({}, {object});
+    return cache.insert(key, library);
+  }
+
   Compiler compiler_;
   NativeLibraryLoader loader_;
   DefaultScopedTimer::EventSequence eventSequence_;
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <filesystem>
+#include <optional>
+#include <string>
+#include "fmt/format.h"
+#include "folly/hash/SpookyHashV2.h"
+#include "velox/experimental/codegen/compiler_utils/CompilerOptions.h"
+#include "velox/experimental/codegen/external_process/Filesystem.h"
+
+namespace facebook::velox::codegen::compiler_utils {
+
+/// Content-addressed on-disk cache of compiled expression libraries.
+/// A library is stored under a key derived from the generated source and
+/// from the compiler options that affect the generated binary. Entries are
+/// published with an atomic rename, so the cache directory can be shared by
+/// concurrent queries and processes and survives restarts.
+class CompiledLibraryCache {
+ public:
+  /// Bump when the layout of cached libraries or the key changes.
+  static constexpr int32_t kFormatVersion = 1;
+
+  explicit CompiledLibraryCache(const std::filesystem::path& directory)
+      : directory_(directory) {
+    std::filesystem::create_directories(directory_);
+  }
+
+  const std::filesystem::path& directory() const {
+    return directory_;
+  }
+
+  /// Returns the cache key of the library built from 'cppContent' with
+  /// 'options'. Options that do not change the binary (temp, formatter and
+  /// cache directories) are not part of the key. The modification time of
+  /// the compiler is, so that upgrading the toolchain invalidates the cache.
+  static std::string key(
+      const CompilerOptions& options,
+      const std::string& cppContent) {
+    auto canonicalOptions = options;
+    canonicalOptions.tempDirectory.clear();
+    canonicalOptions.formatterPath.reset();
+    canonicalOptions.libraryCacheDirectory.reset();
+
+    std::error_code errorCode;
+    auto compilerTime =
+        std::filesystem::last_write_time(options.compilerPath, errorCode);
+    const std::string header = fmt::format(
+        "{}\n{}\n{}\n",
+        kFormatVersion,
+        errorCode ? 0 : compilerTime.time_since_epoch().count(),
+        CompilerOptions::formatAsJson(canonicalOptions));
+
+    uint64_t hash1 = 0;
+    uint64_t hash2 = 0;
+    folly::hash::SpookyHashV2 hasher;
+    hasher.Init(hash1, hash2);
+    hasher.Update(header.data(), header.size());
+    hasher.Update(cppContent.data(), cppContent.size());
+    hasher.Final(&hash1, &hash2);
+    return fmt::format("{:016x}{:016x}", hash1, hash2);
+  }
+
+  /// Returns the path of the cached library for 'key' if there is one.
+  std::optional<std::filesystem::path> find(const std::string& key) const {
+    auto path = libraryPath(key);
+    if (std::filesystem::exists(path)) {
+      return path;
+    }
+    return std::nullopt;
+  }
+
+  /// Copies 'library' into the cache under 'key' and returns the path of
+  /// the cached copy. If another writer publishes the same key concurrently,
+  /// one of the identical copies wins.
+  std::filesystem::path insert(
+      const std::string& key,
+      const std::filesystem::path& library) {
+    auto path = libraryPath(key);
+    // Write to a unique file in the cache directory first so that readers
+    // never observe a partially written library.
+    auto tempPath = pathGenerator_.tempPath(directory_, key, ".tmp");
+    try {
+      std::filesystem::copy_file(
+          library, tempPath, std::filesystem::copy_options::overwrite_existing);
+      std::filesystem::rename(tempPath, path);
+    } catch (const std::filesystem::filesystem_error&) {
+      std::error_code ignored;
+      std::filesystem::remove(tempPath, ignored);
+      throw;
+    }
+    return path;
+  }
+
+ private:
+  std::filesystem::path libraryPath(const std::string& key) const {
+    return directory_ / fmt::format("{}.so", key);
+  }
+
+  const std::filesystem::path directory_;
+  filesystem::PathGenerator pathGenerator_;
+};
+
+} // namespace facebook::velox::codegen::compiler_utils
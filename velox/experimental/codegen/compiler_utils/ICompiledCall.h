@@ -23,6 +23,45 @@ namespace facebook {
 namespace velox {
 namespace codegen {
 
+// Idealy we should push this code closer to vectorFunction.cpp
+// In particular, we should had an "annonymous" registration where the map
+// it self chose a random name, instead of us guessing.
+inline std::string registerCompiledFunction(
+    exec::VectorFunctionFactory factory) {
+  const char* compiledFunctionNameFormat = "compiledFunction_{}";
+  static const size_t kMaxRegistrationTry = 100;
+  static const size_t kMaxRegisteredFunction = 10000;
+  // Seed with a real random value, if available
+  std::random_device r;
+  std::uniform_int_distribution<int> uniform_dist(1, kMaxRegisteredFunction);
+  int functionID = uniform_dist(r);
+  std::string functionName =
+      fmt::format(compiledFunctionNameFormat, functionID);
+  size_t tryCounter = 0;
+  while (!exec::registerStatefulVectorFunction(functionName, {}, factory)) {
+    if (tryCounter > kMaxRegistrationTry) {
+      throw std::runtime_error(fmt::format(
+          "Can't register new function after {} attempts", tryCounter));
+    }
+    functionID = uniform_dist(r);
+    functionName = fmt::format(compiledFunctionNameFormat, functionID);
+    tryCounter++;
+  };
+  return functionName;
+}
+
+// Registers one instance of 'vectorFunction' for all the expressions that
+// call it.
+inline std::string registerCompiledFunction(
+    std::unique_ptr<exec::VectorFunction> vectorFunction) {
+  std::shared_ptr<exec::VectorFunction> sharedFunction =
+      std::move(vectorFunction);
+  return registerCompiledFunction(
+      [sharedFunction](const auto& /*name*/, const auto& /*inputArgs*/) {
+        return sharedFunction;
+      });
+}
+
 /// Models compiled expressions.
 /// In general, generation function from a dynamicLib produce multiple output.
 /// A compiled expression is represented by an dynamicLib
@@ -69,7 +108,10 @@ class ICompiledCall : public core::CallTypedExpr {
   std::unique_ptr<GeneratedVectorFunctionBase> newInstance() const {
     if (!newInstanceFunction_.has_value()) {
       auto& loader = native_loader::NativeLibraryLoader::getDefaultLoader();
-      auto loadedLibrary = loader.loadLibrary(dynamicLibPath_, nullptr);
+      auto loadedLibrary = loader.findLoadedLibrary(dynamicLibPath_);
+      if (loadedLibrary == nullptr) {
+        loadedLibrary = loader.loadLibrary(dynamicLibPath_, nullptr);
+      }
       auto newInstance = loader.getFunction<NewInstanceSignature>(
           "newInstance", loadedLibrary);
       newInstanceFunction_ = newInstance;
@@ -86,37 +128,9 @@ class ICompiledCall : public core::CallTypedExpr {
     generatedVectorFunction->setRowType(
         std::dynamic_pointer_cast<const RowType>(this->type()));
 
-    return insertFunction(std::move(generatedVectorFunction));
+    return registerCompiledFunction(std::move(generatedVectorFunction));
   }
 
-  // Idealy we should push this code closer to vectorFunction.cpp
-  // In particular, we should had an "annonymous" registration where the map
-  // it self chose a random name, instead of us guessing.
-  std::string insertFunction(std::unique_ptr<GeneratedVectorFunctionBase>
-                                 generatedVectorFunction) const {
-    const char* compiledFunctionNameFormat = "compiledFunction_{}";
-    static const size_t kMaxRegistrationTry = 100;
-    static const size_t kMaxRegisteredFunction = 10000;
-    // Seed with a real random value, if available
-    std::random_device r;
-    std::uniform_int_distribution<int> uniform_dist(1, kMaxRegisteredFunction);
-    int functionID = uniform_dist(r);
-    std::string functionName =
-        fmt::format(compiledFunctionNameFormat, functionID);
-    size_t tryCounter = 0;
-    while (!exec::registerVectorFunction(
-        functionName, {}, std::move(generatedVectorFunction))) {
-      if (tryCounter > kMaxRegistrationTry) {
-        throw std::runtime_error(fmt::format(
-            "Can't register new function after {} attempts", tryCounter));
-      }
-      functionID = uniform_dist(r);
-      functionName = fmt::format(compiledFunctionNameFormat, functionID);
-      tryCounter++;
-    };
-    return functionName;
-  };
-
   std::filesystem::path dynamicLibPath_;
   mutable std::optional<std::string> name_;
   mutable std::optional<NewInstanceSignature> newInstanceFunction_;
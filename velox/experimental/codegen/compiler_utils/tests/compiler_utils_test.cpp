@@ -20,6 +20,8 @@
 #include <iostream>
 #include <regex>
 #include "boost/filesystem.hpp"
+#include "velox/experimental/codegen/compiler_utils/CodeManager.h"
+#include "velox/experimental/codegen/compiler_utils/CompiledLibraryCache.h"
 #include "velox/experimental/codegen/compiler_utils/Compiler.h"
 #include "velox/experimental/codegen/compiler_utils/tests/definitions.h"
 #include "velox/experimental/codegen/external_process/Filesystem.h"
@@ -290,4 +292,87 @@ TEST(Compiler, CompileAndLink) {
   ASSERT_EQ(dlerror(), nullptr);
   ASSERT_EQ(f(), 24);
 };
+
+TEST(CompiledLibraryCache, key) {
+  auto options = CompilerOptions()
+                     .withCompilerPath("/usr/bin/clang")
+                     .withOptimizationLevel("-O3")
+                     .withTempDirectory("/tmp/a");
+  auto key = CompiledLibraryCache::key(options, "int f();");
+  ASSERT_EQ(key.size(), 32);
+  ASSERT_EQ(key, CompiledLibraryCache::key(options, "int f();"));
+
+  // Directories do not change the binary and are not part of the key.
+  auto otherDirectories = options;
+  otherDirectories.withTempDirectory("/tmp/b").withLibraryCacheDirectory(
+      "/tmp/cache");
+  ASSERT_EQ(key, CompiledLibraryCache::key(otherDirectories, "int f();"));
+
+  ASSERT_NE(key, CompiledLibraryCache::key(options, "int g();"));
+  auto otherLevel = options;
+  otherLevel.withOptimizationLevel("-O0");
+  ASSERT_NE(key, CompiledLibraryCache::key(otherLevel, "int f();"));
+}
+
+TEST(CompiledLibraryCache, insertAndFind) {
+  filesystem::PathGenerator pathGenerator;
+  // Reuse the name of a fresh temp file for the cache directory.
+  auto directory = pathGenerator.tempPath("cache", "");
+  std::filesystem::remove(directory);
+
+  auto library = pathGenerator.tempPath("library", ".so");
+  std::ofstream(library) << "not really a library";
+
+  {
+    CompiledLibraryCache cache(directory);
+    ASSERT_FALSE(cache.find("abc").has_value());
+    auto cached = cache.insert("abc", library);
+    ASSERT_EQ(cached.parent_path(), directory);
+    ASSERT_EQ(
+        std::filesystem::file_size(cached),
+        std::filesystem::file_size(library));
+    // Inserting the same key again replaces the entry.
+    ASSERT_EQ(cache.insert("abc", library), cached);
+  }
+
+  // A new cache over the same directory sees the entry.
+  CompiledLibraryCache cache(directory);
+  ASSERT_TRUE(cache.find("abc").has_value());
+  ASSERT_FALSE(cache.find("abd").has_value());
+  std::filesystem::remove_all(directory);
+}
+
+TEST(CodeManager, compileAndLinkCached) {
+  auto sourceCode = R"a(
+  extern "C" {
+  int f() {
+    return 24;
+  };
+  }
+  )a";
+
+  filesystem::PathGenerator pathGenerator;
+  // Reuse the name of a fresh temp file for the cache directory.
+  auto directory = pathGenerator.tempPath("cache", "");
+  std::filesystem::remove(directory);
+  auto options = testCompilerOptions().withLibraryCacheDirectory(directory);
+
+  DefaultScopedTimer::EventSequence eventSequence;
+  CodeManager codeManager(options, eventSequence);
+  auto library = codeManager.compileAndLink(sourceCode);
+  ASSERT_EQ(library.parent_path(), directory);
+  auto modified = std::filesystem::last_write_time(library);
+
+  // A second manager, as in another query, reuses the cached library.
+  CodeManager otherCodeManager(options, eventSequence);
+  ASSERT_EQ(otherCodeManager.compileAndLink(sourceCode), library);
+  ASSERT_EQ(otherCodeManager.compileAndLinkAsync(sourceCode).get(), library);
+  ASSERT_EQ(std::filesystem::last_write_time(library), modified);
+
+  auto libraryPtr =
+      native_loader::NativeLibraryLoader::loadLibraryInternal(library);
+  auto f = (int (*)())dlsym(libraryPtr, "f");
+  ASSERT_EQ(f(), 24);
+  std::filesystem::remove_all(directory);
+}
 } // namespace facebook::velox::codegen::compiler_utils::test
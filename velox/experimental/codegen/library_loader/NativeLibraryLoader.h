@@ -99,6 +99,20 @@ class NativeLibraryLoader {
     return uncheckedGetSymbolPtr<Func>(libraryPtr, functionName);
   }
 
+  /// Returns the pointer of the library loaded from 'path' or nullptr if no
+  /// such library is loaded. Cached libraries are shared by all expressions
+  /// compiled from the same source, so they may already be loaded.
+  void* findLoadedLibrary(const std::filesystem::path& path) const {
+    auto it = std::find_if(
+        loadedLibraries.begin(),
+        loadedLibraries.end(),
+        [&path](const auto& loadedLibraryEntry) {
+          const auto& libraryInfo = loadedLibraryEntry.second;
+          return libraryInfo.path == path;
+        });
+    return it == loadedLibraries.end() ? nullptr : it->first;
+  }
+
   /// Loads and verifies a given dynamic libraries
   /// \param path
   /// \return pointer to the loader libraries
@@ -105,4 +105,45 @@ TEST_F(CodegenTest, stringCompound) {
   testExpressions<VarcharType>({"lower(upper(a))"}, inputRowType, 10, 100);
 };
 
+// With default null behavior, a null in one input would make all outputs
+// of the compiled call null. The columns have nulls in different rows.
+TEST_F(CodegenTest, backgroundCompilationWithNulls) {
+  auto inputRowType = ROW({"a", "b"}, std::vector<TypePtr>{DOUBLE(), DOUBLE()});
+  testBackgroundCompilation<DoubleType, DoubleType>(
+      {"a", "b"}, inputRowType, 10, 100);
+  testBackgroundCompilation<DoubleType, DoubleType>(
+      {"if(a > b , a + b, a - b)", "a + b"}, inputRowType, 10, 100);
+};
+
+// Evaluates a BackgroundCompiledCall whose library is never ready, so that
+// every batch is interpreted.
+TEST_F(CodegenTest, backgroundCompiledCallInterpreted) {
+  auto inputRowType = ROW({"a", "b"}, std::vector<TypePtr>{DOUBLE(), DOUBLE()});
+  auto input = createRowVector(1, 100, inputRowType)[0];
+
+  std::promise<std::filesystem::path> library;
+  auto call = std::make_shared<BackgroundCompiledCall>(
+      library.get_future().share(),
+      std::vector<std::shared_ptr<const core::ITypedExpr>>{
+          makeTypedExpr("a", inputRowType), makeTypedExpr("b", inputRowType)},
+      std::vector<std::shared_ptr<const core::ITypedExpr>>{
+          makeTypedExpr("a", inputRowType), makeTypedExpr("b", inputRowType)},
+      ROW({"x", "y"}, std::vector<TypePtr>{DOUBLE(), DOUBLE()}));
+
+  exec::ExprSet exprSet({call}, execCtx_.get());
+  SelectivityVector rows(input->size());
+  // The second batch reuses the interpreted expressions of the first.
+  for (auto i = 0; i < 2; ++i) {
+    EvalCtx context(execCtx_.get(), &exprSet, input.get());
+    std::vector<VectorPtr> results(1);
+    exprSet.eval(rows, &context, &results);
+    auto result = results[0]->as<RowVector>();
+    for (auto column = 0; column < 2; ++column) {
+      ASSERT_FALSE(compareSimpleVector<double>(
+                       input->childAt(column), result->childAt(column))
+                       .has_value());
+    }
+  }
+};
+
 } // namespace facebook::velox::codegen
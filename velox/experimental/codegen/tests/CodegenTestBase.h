@@ -416,6 +416,76 @@ class CodegenTestBase : public CodegenTestCore, public testing::Test {
     }
   }
 
+  /// Runs the projections with background compilation, first while the
+  /// library is being built and then once it is ready, and compares the
+  /// results with the interpreter. Nulls are placed independently in each
+  /// input column.
+  /// \tparam SQLType
+  /// \param projection
+  /// \param inputRowType
+  /// \param testBatches
+  /// \param rowPerBatch
+  /// \return void
+  template <typename... SQLType>
+  auto testBackgroundCompilation(
+      const std::vector<std::string>& projectionExprs,
+      const std::shared_ptr<const RowType>& inputRowType,
+      size_t testBatches,
+      size_t rowPerBatch) {
+    auto inputVectors =
+        createRowVector(testBatches, rowPerBatch, inputRowType);
+    auto plan =
+        createPlanNodeFromExpr<SQLType...>("", projectionExprs, inputVectors);
+
+    std::unique_ptr<TaskCursor> referenceTaskCursor;
+    auto references = runQuery(plan, referenceTaskCursor);
+
+    auto flags = defaultFlags;
+    flags.backgroundCompilation = 1;
+    codegenTransformation_->setTransformFlags(flags);
+    auto compiledPlan = codegenTransformation_->transform(*plan);
+    eventSequence_.clear();
+
+    for (auto libraryReady : {false, true}) {
+      if (libraryReady) {
+        waitForLibraries(*compiledPlan);
+      }
+      std::unique_ptr<TaskCursor> compiledTaskCursor;
+      auto results = runQuery(compiledPlan, compiledTaskCursor);
+      ASSERT_EQ(results.size(), testBatches);
+      for (size_t batchIdx = 0; batchIdx < testBatches; ++batchIdx) {
+        ASSERT_FALSE(
+            compareRowVector<typename SQLType::NativeType::NativeType...>(
+                references[batchIdx],
+                results[batchIdx],
+                std::index_sequence_for<SQLType...>()))
+            << "libraryReady: " << libraryReady;
+      }
+    }
+  }
+
+  /// Waits for the libraries of the background compiled calls in the
+  /// projections of 'plan' and its sources.
+  static void waitForLibraries(const core::PlanNode& plan) {
+    std::function<void(const core::ITypedExpr&)> waitForExpr =
+        [&](const core::ITypedExpr& expr) {
+          if (auto call = dynamic_cast<const BackgroundCompiledCall*>(&expr)) {
+            call->waitForLibrary();
+          }
+          for (const auto& input : expr.inputs()) {
+            waitForExpr(*input);
+          }
+        };
+    if (auto project = dynamic_cast<const core::ProjectNode*>(&plan)) {
+      for (const auto& projection : project->projections()) {
+        waitForExpr(*projection);
+      }
+    }
+    for (const auto& source : plan.sources()) {
+      waitForLibraries(*source);
+    }
+  }
+
   virtual void SetUp() override {
     init();
   }
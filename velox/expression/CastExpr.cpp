@@ -19,6 +19,7 @@
 #include "velox/core/CoreTypeSystem.h"
 #include "velox/expression/VectorUdfTypeSystem.h"
 #include "velox/external/date/tz.h"
+#include "velox/type/FastConversions.h"
 #include "velox/vector/FunctionVector.h"
 
 namespace facebook::velox::exec {
@@ -58,6 +59,62 @@ void applyCastKernel(
   }
 }
 
+/// True if applyFastCastKernel handles the cast from From to To.
+template <typename To, typename From>
+constexpr bool hasFastCastKernel() {
+  if constexpr (std::is_same_v<From, StringView>) {
+    return std::is_same_v<To, double> ||
+        (std::is_integral_v<To> && !std::is_same_v<To, bool>);
+  } else if constexpr (std::is_same_v<To, StringView>) {
+    return std::is_floating_point_v<From> ||
+        (std::is_integral_v<From> && !std::is_same_v<From, bool>);
+  } else {
+    return false;
+  }
+}
+
+/// Batch kernel for the casts between strings and numbers. Converts all
+/// 'rows' with the fast conversions of FastConversions.h. Parsing rejects
+/// the rare inputs that need the full grammar or fail, those rows are left
+/// selected in 'remainingRows' for applyCastKernel.
+template <typename To, typename From>
+void applyFastCastKernel(
+    const SelectivityVector& rows,
+    const DecodedVector& input,
+    FlatVector<To>* resultFlatVector,
+    SelectivityVector& remainingRows) {
+  if constexpr (std::is_same_v<From, StringView>) {
+    remainingRows.clearAll();
+    rows.applyToSelected([&](vector_size_t row) {
+      const auto value = input.valueAt<StringView>(row);
+      std::optional<To> result;
+      if constexpr (std::is_same_v<To, double>) {
+        result = util::fast::tryParseDouble(value.data(), value.size());
+      } else {
+        result = util::fast::tryParseInteger<To>(value.data(), value.size());
+      }
+      if (result.has_value()) {
+        resultFlatVector->set(row, result.value());
+      } else {
+        remainingRows.setValid(row, true);
+      }
+    });
+    remainingRows.updateBounds();
+  } else {
+    char buffer[util::fast::kMaxDoubleLength];
+    rows.applyToSelected([&](vector_size_t row) {
+      size_t length;
+      if constexpr (std::is_floating_point_v<From>) {
+        length = util::fast::formatDouble(input.valueAt<From>(row), buffer);
+      } else {
+        length = util::fast::formatInteger(input.valueAt<From>(row), buffer);
+      }
+      resultFlatVector->set(row, StringView(buffer, length));
+    });
+    remainingRows.clearAll();
+  }
+}
+
 void populateNestedRows(
     const SelectivityVector& rows,
     const vector_size_t* rawSizes,
@@ -82,9 +139,22 @@ void CastExpr::applyCastWithTry(
   const auto& queryCtx = context->execCtx()->queryCtx();
   auto isCastIntByTruncate = queryCtx->isCastIntByTruncate();
 
+  // Rows left for the per-row kernels below.
+  const SelectivityVector* slowRows = &rows;
+  LocalSelectivityVector remainingRows(context);
+  if constexpr (hasFastCastKernel<To, From>()) {
+    remainingRows.allocate(rows.end());
+    applyFastCastKernel<To, From>(
+        rows, input, resultFlatVector, *remainingRows.get());
+    if (!remainingRows.get()->hasSelections()) {
+      return;
+    }
+    slowRows = remainingRows.get();
+  }
+
   if (!nullOnFailure_) {
     if (!isCastIntByTruncate) {
-      rows.applyToSelected([&](int row) {
+      slowRows->applyToSelected([&](int row) {
         // Passing a false truncate flag
         try {
           applyCastKernel<To, From, false>(row, input, resultFlatVector);
@@ -93,7 +163,7 @@ void CastExpr::applyCastWithTry(
         }
       });
     } else {
-      rows.applyToSelected([&](int row) {
+      slowRows->applyToSelected([&](int row) {
         // Passing a true truncate flag
         try {
           applyCastKernel<To, From, true>(row, input, resultFlatVector);
@@ -104,7 +174,7 @@ void CastExpr::applyCastWithTry(
     }
   } else {
     if (!isCastIntByTruncate) {
-      rows.applyToSelected([&](int row) {
+      slowRows->applyToSelected([&](int row) {
         // TRY_CAST implementation
         try {
           applyCastKernel<To, From, false>(row, input, resultFlatVector);
@@ -113,7 +183,7 @@ void CastExpr::applyCastWithTry(
         }
       });
     } else {
-      rows.applyToSelected([&](int row) {
+      slowRows->applyToSelected([&](int row) {
         // TRY_CAST implementation
         try {
           applyCastKernel<To, From, true>(row, input, resultFlatVector);
@@ -85,6 +85,12 @@ class ConstantExpr : public SpecialForm {
     return sharedSubexprValues_;
   }
 
+  // Returns the value as text, also before the first evaluation.
+  std::string valueToString() const {
+    return sharedSubexprValues_ ? sharedSubexprValues_->toString(0)
+                                : value_.toJson();
+  }
+
  private:
   const variant value_;
 };
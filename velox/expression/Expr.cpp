@@ -18,6 +18,7 @@
 #include "velox/core/Expressions.h"
 #include "velox/expression/ControlExpr.h"
 #include "velox/expression/ExprCompiler.h"
+#include "velox/expression/ExprResultCache.h"
 #include "velox/expression/VarSetter.h"
 #include "velox/expression/VectorFunction.h"
 
@@ -691,6 +692,10 @@ void Expr::evalWithMemo(
   VectorPtr base;
   distinctFields_[0]->evalSpecialForm(rows, context, &base);
   ++numCachableInput_;
+  auto* sharedCache = resultCache(context);
+  if (baseDictionary_ != base && sharedCache) {
+    loadMemo(sharedCache, base, context);
+  }
   if (baseDictionary_ == base) {
     ++numCacheableRepeats_;
     if (cachedDictionaryIndices_) {
@@ -740,6 +745,14 @@ void Expr::evalWithMemo(
 
       cachedDictionaryIndices_->select(*uncached);
       dictionaryCache_->copy(result->get(), *uncached, nullptr);
+      if (sharedCache) {
+        sharedCache->insert(
+            resultCacheKey_,
+            base,
+            *dictionaryCache_,
+            *cachedDictionaryIndices_,
+            *uncached);
+      }
     }
     return;
   }
@@ -752,6 +765,73 @@ void Expr::evalWithMemo(
   }
   *cachedDictionaryIndices_ = rows;
   deselectErrors(context, *cachedDictionaryIndices_);
+  if (sharedCache && dictionaryCache_ &&
+      cachedDictionaryIndices_->hasSelections()) {
+    sharedCache->insert(
+        resultCacheKey_,
+        base,
+        *dictionaryCache_,
+        *cachedDictionaryIndices_,
+        *cachedDictionaryIndices_);
+  }
+}
+
+void Expr::appendResultCacheKey(std::ostream& out) const {
+  if (auto constant = dynamic_cast<const ConstantExpr*>(this)) {
+    out << constant->valueToString();
+  } else {
+    out << name_;
+  }
+  out << ":" << type_->toString();
+  if (!inputs_.empty()) {
+    out << "(";
+    for (const auto& input : inputs_) {
+      input->appendResultCacheKey(out);
+      out << ",";
+    }
+    out << ")";
+  }
+}
+
+ExprResultCache* Expr::resultCache(EvalCtx* context) {
+  auto queryCtx = context->execCtx()->queryCtx();
+  if (!queryCtx || !queryCtx->exprResultCacheEnabled() ||
+      !ExprResultCache::isCacheable(*type())) {
+    return nullptr;
+  }
+  if (resultCacheKey_.empty()) {
+    std::stringstream key;
+    appendResultCacheKey(key);
+    // The settings of the query that change the results of functions, e.g.
+    // of casts to timestamp. The entries are shared across queries.
+    key << ";" << queryCtx->sessionTimezone() << ","
+        << queryCtx->adjustTimestampToTimezone() << ","
+        << queryCtx->isCastIntByTruncate() << ","
+        << queryCtx->isMatchStructByName();
+    resultCacheKey_ = key.str();
+  }
+  return ExprResultCache::instance();
+}
+
+bool Expr::loadMemo(
+    ExprResultCache* cache,
+    const VectorPtr& base,
+    EvalCtx* context) {
+  auto entry = cache->find(resultCacheKey_, base);
+  if (!entry.has_value()) {
+    return false;
+  }
+  baseDictionary_ = base;
+  // Shared with the cache. The memo is extended into a copy, see
+  // evalWithMemo().
+  dictionaryCache_ = entry->values;
+  if (!cachedDictionaryIndices_) {
+    cachedDictionaryIndices_ =
+        context->execCtx()->getSelectivityVector(entry->rows->size());
+  }
+  *cachedDictionaryIndices_ = *entry->rows;
+  context->exprSet()->addToMemo(this);
+  return true;
 }
 
 void Expr::setAllNulls(
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <ostream>
 #include <vector>
 
 #include <folly/container/F14Map.h>
@@ -57,6 +58,7 @@ class DecodedArgs {
 };
 
 class ExprSet;
+class ExprResultCache;
 class FieldReference;
 class VectorFunction;
 
@@ -217,6 +219,22 @@ class Expr {
       EvalCtx* context,
       VectorPtr* result);
 
+  // Returns the ExprResultCache if enabled for the query of 'context' and
+  // applicable to 'this', else nullptr.
+  ExprResultCache* resultCache(EvalCtx* context);
+
+  // Appends to 'out' the names and types of 'this' and its inputs and the
+  // values of literals. Unlike toString(), this tells apart Exprs that
+  // differ only in literals or types.
+  void appendResultCacheKey(std::ostream& out) const;
+
+  // Sets the memo of 'this' from the entry of 'cache' for 'base'. Returns
+  // false if there is none.
+  bool loadMemo(
+      ExprResultCache* cache,
+      const VectorPtr& base,
+      EvalCtx* context);
+
   void evalWithNulls(
       const SelectivityVector& rows,
       EvalCtx* context,
@@ -340,6 +358,9 @@ class Expr {
   // The indices that are valid in 'dictionaryCache_'.
   std::unique_ptr<SelectivityVector> cachedDictionaryIndices_;
 
+  // The key of 'this' in ExprResultCache. Set on first use.
+  std::string resultCacheKey_;
+
   // Count of executions where this is wrapped in a dictionary so that
   // results could be cached.
   int32_t numCachableInput_{0};
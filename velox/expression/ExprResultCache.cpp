@@ -0,0 +1,226 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/expression/ExprResultCache.h"
+
+#include "velox/vector/DecodedVector.h"
+#include "velox/vector/FlatVector.h"
+
+namespace facebook::velox::exec {
+
+namespace {
+// Copies the positions 'rows' of 'values' into 'target'. Strings are copied
+// too, since copy() would share the string buffers of 'values'.
+void copyRows(
+    const BaseVector& values,
+    const SelectivityVector& rows,
+    BaseVector& target) {
+  if (values.typeKind() == TypeKind::VARCHAR ||
+      values.typeKind() == TypeKind::VARBINARY) {
+    auto flatTarget = target.asFlatVector<StringView>();
+    DecodedVector decoded(values, rows);
+    rows.applyToSelected([&](auto row) {
+      if (decoded.isNullAt(row)) {
+        flatTarget->setNull(row, true);
+      } else {
+        flatTarget->set(row, decoded.valueAt<StringView>(row));
+      }
+    });
+  } else {
+    target.copy(&values, rows, nullptr);
+  }
+}
+} // namespace
+
+ExprResultCache::ExprResultCache(int64_t capacity)
+    : pool_(memory::getProcessDefaultMemoryManager().getRoot().addScopedChild(
+          "expr_result_cache")),
+      capacity_(capacity) {}
+
+// static
+ExprResultCache* ExprResultCache::instance() {
+  // Not destroyed at exit since operators may still reference the string
+  // buffers of cached values.
+  static auto* cache = new ExprResultCache(kDefaultCapacity);
+  return cache;
+}
+
+std::optional<ExprResultCache::Entry> ExprResultCache::find(
+    const std::string& expr,
+    const VectorPtr& base) {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = entries_.find(Key{expr, base.get()});
+  if (it == entries_.end()) {
+    ++numMisses_;
+    return std::nullopt;
+  }
+  if (it->second.base.lock() != base) {
+    // The base of the entry was freed and 'base' reuses its address.
+    eraseLocked(it);
+    ++numMisses_;
+    return std::nullopt;
+  }
+  ++numHits_;
+  it->second.lastUse = ++useCounter_;
+  return it->second.entry;
+}
+
+void ExprResultCache::insert(
+    const std::string& expr,
+    const VectorPtr& base,
+    const BaseVector& values,
+    const SelectivityVector& rows,
+    const SelectivityVector& newRows) {
+  Key key{expr, base.get()};
+  std::optional<Entry> previous;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    auto it = entries_.find(key);
+    if (it != entries_.end() && it->second.base.lock() == base) {
+      if (extendLocked(it, values, newRows)) {
+        return;
+      }
+      previous = it->second.entry;
+    }
+  }
+
+  // A reader holds the values of the entry. Copies outside of the mutex.
+  // A concurrent insert for the same key may be replaced, which loses at
+  // most the rows only it had.
+  auto allRows = std::make_shared<SelectivityVector>(rows);
+  SelectivityVector previousRows;
+  if (previous.has_value()) {
+    previousRows = *previous->rows;
+    previousRows.deselect(rows);
+    if (allRows->size() < previousRows.size()) {
+      allRows->resize(previousRows.size(), false);
+    }
+    allRows->select(previousRows);
+  }
+  auto copy = BaseVector::create(values.type(), allRows->size(), pool_.get());
+  copyRows(values, rows, *copy);
+  if (previousRows.hasSelections()) {
+    copyRows(*previous->values, previousRows, *copy);
+  }
+  Entry entry{std::move(copy), std::move(allRows)};
+  const int64_t bytes = entry.values->retainedSize();
+
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = entries_.find(key);
+  if (it != entries_.end()) {
+    eraseLocked(it);
+  }
+  if (!makeSpaceLocked(bytes)) {
+    return;
+  }
+  entries_[key] = CacheEntry{base, std::move(entry), bytes, ++useCounter_};
+  cachedBytes_ += bytes;
+}
+
+bool ExprResultCache::extendLocked(
+    folly::F14FastMap<Key, CacheEntry>::iterator it,
+    const BaseVector& values,
+    const SelectivityVector& newRows) {
+  auto& cacheEntry = it->second;
+  if (cacheEntry.entry.values.use_count() > 1) {
+    return false;
+  }
+  cacheEntry.lastUse = ++useCounter_;
+  SelectivityVector added(newRows);
+  added.deselect(*cacheEntry.entry.rows);
+  if (!added.hasSelections()) {
+    return true;
+  }
+
+  // Copies under the mutex, but only the rows that are new to the entry.
+  auto& cached = cacheEntry.entry.values;
+  if (cached->size() < added.size()) {
+    cached->resize(added.size());
+  }
+  copyRows(values, added, *cached);
+  // Readers may hold the previous rows.
+  auto rows = std::make_shared<SelectivityVector>(*cacheEntry.entry.rows);
+  if (rows->size() < added.size()) {
+    rows->resize(added.size(), false);
+  }
+  rows->select(added);
+  cacheEntry.entry.rows = std::move(rows);
+
+  const int64_t bytes = cached->retainedSize();
+  auto key = it->first;
+  auto extended = std::move(cacheEntry);
+  eraseLocked(it);
+  if (makeSpaceLocked(bytes)) {
+    extended.bytes = bytes;
+    entries_[key] = std::move(extended);
+    cachedBytes_ += bytes;
+  }
+  return true;
+}
+
+void ExprResultCache::setCapacity(int64_t capacity) {
+  std::lock_guard<std::mutex> l(mutex_);
+  capacity_ = capacity;
+  makeSpaceLocked(0);
+}
+
+void ExprResultCache::clear() {
+  std::lock_guard<std::mutex> l(mutex_);
+  entries_.clear();
+  cachedBytes_ = 0;
+}
+
+ExprResultCache::Stats ExprResultCache::stats() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  Stats stats;
+  stats.numEntries = entries_.size();
+  stats.cachedBytes = cachedBytes_;
+  stats.numHits = numHits_;
+  stats.numMisses = numMisses_;
+  stats.numEvictions = numEvictions_;
+  return stats;
+}
+
+bool ExprResultCache::makeSpaceLocked(int64_t bytes) {
+  if (bytes > capacity_) {
+    return false;
+  }
+  while (cachedBytes_ + bytes > capacity_) {
+    // Entries of freed base vectors go first.
+    auto victim = entries_.end();
+    for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+      if (it->second.base.expired()) {
+        victim = it;
+        break;
+      }
+      if (victim == entries_.end() ||
+          it->second.lastUse < victim->second.lastUse) {
+        victim = it;
+      }
+    }
+    eraseLocked(victim);
+    ++numEvictions_;
+  }
+  return true;
+}
+
+void ExprResultCache::eraseLocked(
+    folly::F14FastMap<Key, CacheEntry>::iterator it) {
+  cachedBytes_ -= it->second.bytes;
+  entries_.erase(it);
+}
+
+} // namespace facebook::velox::exec
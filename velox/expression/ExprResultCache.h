@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <mutex>
+#include <optional>
+
+#include <folly/container/F14Map.h>
+#include <folly/hash/Hash.h>
+
+#include "velox/common/memory/Memory.h"
+#include "velox/vector/BaseVector.h"
+#include "velox/vector/SelectivityVector.h"
+
+namespace facebook::velox::exec {
+
+// Process-wide cache of the results of deterministic expressions over the
+// base vectors of dictionaries. An Expr remembers its result for the last
+// base dictionary it saw, see Expr::evalWithMemo(). This cache shares these
+// results between Exprs of different ExprSets, operators and queries, so
+// that an expensive function over a dictionary shared by many scans, e.g.
+// the dictionary of a stripe, is evaluated once per dictionary value.
+//
+// An entry is keyed on the text of the Expr, the settings of the query that
+// affect function results and the identity of the base vector. The entry
+// holds a weak reference to the base, so it is not used for another vector
+// allocated at the same address after the base is freed. The values are
+// copied into memory of the cache, so that they outlive the operators that
+// computed them. Only results of primitive types are cached. Enabled by
+// QueryCtx::kExprResultCacheEnabled.
+class ExprResultCache {
+ public:
+  struct Entry {
+    // Values for the positions of the base vector that are set in 'rows'.
+    VectorPtr values;
+    std::shared_ptr<const SelectivityVector> rows;
+  };
+
+  struct Stats {
+    int32_t numEntries{0};
+    // Sum of the retainedSize() of the cached values.
+    int64_t cachedBytes{0};
+    int64_t numHits{0};
+    int64_t numMisses{0};
+    int64_t numEvictions{0};
+  };
+
+  static constexpr int64_t kDefaultCapacity = 256L << 20;
+
+  explicit ExprResultCache(int64_t capacity);
+
+  // Returns the process-wide instance.
+  static ExprResultCache* instance();
+
+  // Returns true if results of 'type' can be cached.
+  static bool isCacheable(const Type& type) {
+    return type.isPrimitiveType();
+  }
+
+  // Returns the values of 'expr' over 'base' or std::nullopt if there are
+  // none.
+  std::optional<Entry> find(const std::string& expr, const VectorPtr& base);
+
+  // Adds the positions 'newRows' of 'values' to the result of 'expr' over
+  // 'base'. 'rows' are all the set positions of 'values' and include
+  // 'newRows'. Only 'newRows' are copied into an entry that no reader
+  // holds. Otherwise the entry is replaced by a copy of 'rows' and of the
+  // rows of the previous entry. Evicts the least recently used entries to
+  // stay within the capacity.
+  void insert(
+      const std::string& expr,
+      const VectorPtr& base,
+      const BaseVector& values,
+      const SelectivityVector& rows,
+      const SelectivityVector& newRows);
+
+  // Sets the maximum total size of the cached values, evicting entries if
+  // needed.
+  void setCapacity(int64_t capacity);
+
+  // Drops all entries.
+  void clear();
+
+  Stats stats() const;
+
+ private:
+  using Key = std::pair<std::string, const BaseVector*>;
+
+  struct CacheEntry {
+    std::weak_ptr<BaseVector> base;
+    Entry entry;
+    int64_t bytes;
+    uint64_t lastUse;
+  };
+
+  // Copies the positions 'newRows' of 'values' that are not yet in the
+  // entry at 'it' into its values. Returns false if a reader holds the
+  // values, which are then not changed.
+  bool extendLocked(
+      folly::F14FastMap<Key, CacheEntry>::iterator it,
+      const BaseVector& values,
+      const SelectivityVector& newRows);
+
+  // Evicts entries in LRU order until 'bytes' more fit in the capacity.
+  // Returns false if they do not.
+  bool makeSpaceLocked(int64_t bytes);
+
+  // Removes the entry at 'it' and updates 'cachedBytes_'.
+  void eraseLocked(folly::F14FastMap<Key, CacheEntry>::iterator it);
+
+  // Memory for the cached values.
+  const std::unique_ptr<memory::MemoryPool> pool_;
+
+  mutable std::mutex mutex_;
+  folly::F14FastMap<Key, CacheEntry> entries_;
+  int64_t capacity_;
+  int64_t cachedBytes_{0};
+  uint64_t useCounter_{0};
+  int64_t numHits_{0};
+  int64_t numMisses_{0};
+  int64_t numEvictions_{0};
+};
+
+} // namespace facebook::velox::exec
@@ -303,6 +303,109 @@ TEST_F(CastExprTest, errorHandling) {
       "tinyint", {"1", "2", "3", "100", "-100.5"}, {1, 2, 3, 100, -100}, true);
 }
 
+TEST_F(CastExprTest, stringToNumber) {
+  // Plain decimal strings are parsed in batch, the others by folly.
+  testCast<std::string, int64_t>(
+      "bigint",
+      {"0",
+       "-0",
+       "+12",
+       "007",
+       "12345678",
+       "-123456789012345678",
+       "1234567890123456789",
+       "-9223372036854775808",
+       "9223372036854775808",
+       "12a",
+       "",
+       "-",
+       std::nullopt},
+      {0,
+       0,
+       12,
+       7,
+       12345678,
+       -123456789012345678,
+       1234567890123456789,
+       std::numeric_limits<int64_t>::min(),
+       std::nullopt,
+       std::nullopt,
+       std::nullopt,
+       std::nullopt,
+       std::nullopt},
+      false,
+      true);
+  testCast<std::string, int32_t>(
+      "int",
+      {"2147483647", "-2147483648", "2147483648", "-99999999999"},
+      {std::numeric_limits<int32_t>::max(),
+       std::numeric_limits<int32_t>::min(),
+       std::nullopt,
+       std::nullopt},
+      false,
+      true);
+  testCast<std::string, int8_t>(
+      "tinyint",
+      {"127", "-128", "128"},
+      {127, -128, std::nullopt},
+      false,
+      true);
+  testCast<std::string, int64_t>(
+      "bigint", {"1", "99999999999999999999"}, {}, true);
+
+  testCast<std::string, double>(
+      "double",
+      {"1.5",
+       "-0.25",
+       "123",
+       "0.1",
+       "123456789012345",
+       "1234567890.123456",
+       "1e3",
+       "abc",
+       std::nullopt},
+      {1.5,
+       -0.25,
+       123,
+       0.1,
+       123456789012345,
+       1234567890.123456,
+       1000,
+       std::nullopt,
+       std::nullopt},
+      false,
+      true);
+}
+
+TEST_F(CastExprTest, numberToString) {
+  testCast<int64_t, std::string>(
+      "string",
+      {0,
+       -1,
+       99,
+       100,
+       std::numeric_limits<int64_t>::min(),
+       std::numeric_limits<int64_t>::max(),
+       std::nullopt},
+      {"0",
+       "-1",
+       "99",
+       "100",
+       "-9223372036854775808",
+       "9223372036854775807",
+       std::nullopt});
+  testCast<int8_t, std::string>("string", {-128, 127, 5}, {"-128", "127", "5"});
+  testCast<double, std::string>(
+      "string",
+      {0.1,
+       100.0,
+       123456789.25,
+       std::numeric_limits<double>::quiet_NaN(),
+       -std::numeric_limits<double>::infinity()},
+      {"0.1", "100", "123456789.25", "NaN", "-Infinity"});
+  testCast<float, std::string>("string", {0.5, -3}, {"0.5", "-3"});
+}
+
 constexpr vector_size_t kVectorSize = 1'000;
 
 TEST_F(CastExprTest, mapCast) {
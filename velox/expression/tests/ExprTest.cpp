@@ -19,6 +19,7 @@
 #include "velox/dwio/common/DataSink.h"
 #include "velox/exec/tests/utils/FunctionUtils.h"
 #include "velox/expression/ControlExpr.h"
+#include "velox/expression/ExprResultCache.h"
 #include "velox/functions/Udf.h"
 #include "velox/functions/prestosql/CoreFunctions.h"
 #include "velox/functions/prestosql/VectorFunctions.h"
@@ -2217,3 +2218,68 @@ TEST_F(ExprTest, memoNulls) {
   expectedResult = BaseVector::createConstant(true, 5, execCtx_->pool());
   assertEqualVectors(expectedResult, result);
 }
+
+TEST_F(ExprTest, sharedMemo) {
+  queryCtx_->setConfigOverridesUnsafe(
+      {{core::QueryCtx::kExprResultCacheEnabled, "true"}});
+  auto cache = exec::ExprResultCache::instance();
+  cache->clear();
+  auto numHits = cache->stats().numHits;
+
+  auto base = makeFlatVector<int64_t>(1'000, [](auto row) { return row; });
+  auto evenIndices = makeIndices(100, [](auto row) { return 8 + row * 2; });
+  auto oddIndices = makeIndices(100, [](auto row) { return 9 + row * 2; });
+  auto rowType = ROW({"c0"}, {base->type()});
+
+  auto exprSet = compileExpression("c0 + 1", rowType);
+  auto result = evaluate(
+      exprSet.get(), makeRowVector({wrapInDictionary(evenIndices, 100, base)}));
+  auto expectedResult =
+      makeFlatVector<int64_t>(100, [](auto row) { return 9 + row * 2; });
+  assertEqualVectors(expectedResult, result);
+  EXPECT_EQ(1, cache->stats().numEntries);
+
+  // Another ExprSet with the same expression finds the values of the first.
+  auto otherExprSet = compileExpression("c0 + 1", rowType);
+  result = evaluate(
+      otherExprSet.get(),
+      makeRowVector({wrapInDictionary(evenIndices, 100, base)}));
+  assertEqualVectors(expectedResult, result);
+  EXPECT_EQ(numHits + 1, cache->stats().numHits);
+
+  // Rows not in the cache are evaluated and added.
+  result = evaluate(
+      otherExprSet.get(),
+      makeRowVector({wrapInDictionary(oddIndices, 100, base)}));
+  expectedResult =
+      makeFlatVector<int64_t>(100, [](auto row) { return 10 + row * 2; });
+  assertEqualVectors(expectedResult, result);
+  EXPECT_EQ(1, cache->stats().numEntries);
+
+  // A different literal is a different expression.
+  auto plusTwo = compileExpression("c0 + 2", rowType);
+  result = evaluate(
+      plusTwo.get(), makeRowVector({wrapInDictionary(evenIndices, 100, base)}));
+  expectedResult =
+      makeFlatVector<int64_t>(100, [](auto row) { return 10 + row * 2; });
+  assertEqualVectors(expectedResult, result);
+  EXPECT_EQ(numHits + 1, cache->stats().numHits);
+  EXPECT_EQ(2, cache->stats().numEntries);
+
+  // A query with another session timezone does not share the entries.
+  queryCtx_->setConfigOverridesUnsafe(
+      {{core::QueryCtx::kExprResultCacheEnabled, "true"},
+       {core::QueryCtx::kSessionTimezone, "America/Los_Angeles"}});
+  auto otherSession = compileExpression("c0 + 1", rowType);
+  result = evaluate(
+      otherSession.get(),
+      makeRowVector({wrapInDictionary(evenIndices, 100, base)}));
+  expectedResult =
+      makeFlatVector<int64_t>(100, [](auto row) { return 9 + row * 2; });
+  assertEqualVectors(expectedResult, result);
+  EXPECT_EQ(numHits + 1, cache->stats().numHits);
+  EXPECT_EQ(3, cache->stats().numEntries);
+
+  cache->clear();
+  queryCtx_->setConfigOverridesUnsafe({});
+}
@@ -18,6 +18,7 @@
 #include <re2/re2.h>
 #include <optional>
 
+#include "velox/common/base/SimdUtil.h"
 #include "velox/expression/EvalCtx.h"
 #include "velox/expression/Expr.h"
 #include "velox/expression/VectorUdfTypeSystem.h"
@@ -323,6 +324,408 @@ std::shared_ptr<VectorFunction> makeRe2MatchImpl(
   return kMatchExpr;
 }
 
+// Classification of a LIKE pattern. Each kind other than kGeneric is
+// evaluated by a specialized kernel that does not need RE2.
+enum class PatternKind {
+  // Only '_' wildcards, e.g. '___'. Matches strings of exactly 'length'
+  // characters.
+  kExactlyN,
+  // Only '_' and '%' wildcards with at least one '%', e.g. '_%_'. Matches
+  // strings of at least 'length' characters.
+  kAtLeastN,
+  // No wildcards, e.g. 'abc'.
+  kFixed,
+  // Literal followed by one or more '%', e.g. 'abc%'.
+  kPrefix,
+  // One or more '%' followed by a literal, e.g. '%abc'.
+  kSuffix,
+  // Literal surrounded by '%', e.g. '%abc%'.
+  kSubstring,
+  // ASCII literal characters and '_' only, e.g. 'a_c'. Evaluated byte-wise
+  // for ASCII inputs and with RE2 otherwise.
+  kRelaxedFixed,
+  // Anything else. Evaluated with RE2.
+  kGeneric,
+};
+
+// Number of UTF-8 characters in 's'. Counts the bytes that do not continue a
+// multi-byte sequence.
+size_t utf8Length(StringView s) {
+  size_t length = 0;
+  for (auto i = 0; i < s.size(); ++i) {
+    length += (s.data()[i] & 0xC0) != 0x80;
+  }
+  return length;
+}
+
+bool isAsciiString(StringView s) {
+  for (auto i = 0; i < s.size(); ++i) {
+    if (s.data()[i] & 0x80) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Returns true if 'needle' occurs in 'haystack'. Compares the first and last
+// byte of 'needle' against 32 consecutive positions of 'haystack' at a time
+// and checks the full needle only at positions where both match.
+bool simdContains(std::string_view haystack, std::string_view needle) {
+  using V = simd::Vectors<int8_t>;
+  const auto haystackSize = haystack.size();
+  const auto needleSize = needle.size();
+  if (needleSize == 0) {
+    return true;
+  }
+  if (needleSize > haystackSize) {
+    return false;
+  }
+  if (needleSize == 1) {
+    return memchr(haystack.data(), needle[0], haystackSize) != nullptr;
+  }
+  const auto first = V::setAll(needle[0]);
+  const auto last = V::setAll(needle[needleSize - 1]);
+  size_t offset = 0;
+  for (; offset + needleSize - 1 + V::VSize <= haystackSize;
+       offset += V::VSize) {
+    const auto blockFirst = V::load(haystack.data() + offset);
+    const auto blockLast = V::load(haystack.data() + offset + needleSize - 1);
+    uint32_t candidates = V::compareResult(
+        V::compareEq(blockFirst, first) & V::compareEq(blockLast, last));
+    while (candidates) {
+      const auto position = offset + __builtin_ctz(candidates);
+      if (memcmp(
+              haystack.data() + position + 1,
+              needle.data() + 1,
+              needleSize - 2) == 0) {
+        return true;
+      }
+      candidates &= candidates - 1;
+    }
+  }
+  return haystack.substr(offset).find(needle) != std::string_view::npos;
+}
+
+// Analyzes a LIKE pattern once and matches inputs against it using the
+// cheapest kernel for the pattern's shape.
+class LikeMatcher {
+ public:
+  LikeMatcher(StringView pattern, std::optional<char> escapeChar) {
+    parse(pattern, escapeChar);
+  }
+
+  PatternKind kind() const {
+    return kind_;
+  }
+
+  template <PatternKind kind>
+  bool match(StringView input) const {
+    if constexpr (kind == PatternKind::kExactlyN) {
+      return input.size() >= length_ && utf8Length(input) == length_;
+    } else if constexpr (kind == PatternKind::kAtLeastN) {
+      return input.size() >= length_ && utf8Length(input) >= length_;
+    } else if constexpr (kind == PatternKind::kFixed) {
+      return input.size() == fixedPattern_.size() &&
+          memcmp(input.data(), fixedPattern_.data(), fixedPattern_.size()) ==
+          0;
+    } else if constexpr (kind == PatternKind::kPrefix) {
+      return input.size() >= fixedPattern_.size() &&
+          memcmp(input.data(), fixedPattern_.data(), fixedPattern_.size()) ==
+          0;
+    } else if constexpr (kind == PatternKind::kSuffix) {
+      return input.size() >= fixedPattern_.size() &&
+          memcmp(input.data() + input.size() - fixedPattern_.size(),
+                 fixedPattern_.data(),
+                 fixedPattern_.size()) == 0;
+    } else if constexpr (kind == PatternKind::kSubstring) {
+      return simdContains(
+          std::string_view(input.data(), input.size()), fixedPattern_);
+    } else if constexpr (kind == PatternKind::kRelaxedFixed) {
+      if (isAsciiString(input)) {
+        if (input.size() != fixedPattern_.size()) {
+          return false;
+        }
+        for (auto i = 0; i < fixedPattern_.size(); ++i) {
+          if (!wildcards_[i] && input.data()[i] != fixedPattern_[i]) {
+            return false;
+          }
+        }
+        return true;
+      }
+      // A '_' may match a multi-byte character.
+      return re2FullMatch(input, *re_);
+    } else {
+      return re2FullMatch(input, *re_);
+    }
+  }
+
+  bool match(StringView input) const {
+    switch (kind_) {
+      case PatternKind::kExactlyN:
+        return match<PatternKind::kExactlyN>(input);
+      case PatternKind::kAtLeastN:
+        return match<PatternKind::kAtLeastN>(input);
+      case PatternKind::kFixed:
+        return match<PatternKind::kFixed>(input);
+      case PatternKind::kPrefix:
+        return match<PatternKind::kPrefix>(input);
+      case PatternKind::kSuffix:
+        return match<PatternKind::kSuffix>(input);
+      case PatternKind::kSubstring:
+        return match<PatternKind::kSubstring>(input);
+      case PatternKind::kRelaxedFixed:
+        return match<PatternKind::kRelaxedFixed>(input);
+      case PatternKind::kGeneric:
+        return match<PatternKind::kGeneric>(input);
+    }
+    VELOX_UNREACHABLE();
+  }
+
+ private:
+  // One element of a parsed pattern: a literal byte, '%' or '_'.
+  struct Token {
+    enum Type { kLiteral, kAnyString, kAnyChar } type;
+    char value;
+  };
+
+  void parse(StringView pattern, std::optional<char> escapeChar) {
+    static constexpr const char* kBadEscape =
+        "Escape character must be followed by '%', '_' or the escape character itself";
+    std::vector<Token> tokens;
+    tokens.reserve(pattern.size());
+    for (auto i = 0; i < pattern.size(); ++i) {
+      const char c = pattern.data()[i];
+      if (escapeChar.has_value() && c == escapeChar.value()) {
+        VELOX_USER_CHECK_LT(i + 1, pattern.size(), kBadEscape);
+        const char next = pattern.data()[++i];
+        VELOX_USER_CHECK(
+            next == '%' || next == '_' || next == escapeChar.value(),
+            kBadEscape);
+        tokens.push_back({Token::kLiteral, next});
+      } else if (c == '%') {
+        tokens.push_back({Token::kAnyString, c});
+      } else if (c == '_') {
+        tokens.push_back({Token::kAnyChar, c});
+      } else {
+        tokens.push_back({Token::kLiteral, c});
+      }
+    }
+
+    int32_t numAnyString = 0;
+    int32_t numAnyChar = 0;
+    int32_t firstLiteral = -1;
+    int32_t lastLiteral = -1;
+    bool asciiLiterals = true;
+    for (auto i = 0; i < tokens.size(); ++i) {
+      switch (tokens[i].type) {
+        case Token::kAnyString:
+          ++numAnyString;
+          break;
+        case Token::kAnyChar:
+          ++numAnyChar;
+          break;
+        case Token::kLiteral:
+          if (firstLiteral < 0) {
+            firstLiteral = i;
+          }
+          lastLiteral = i;
+          asciiLiterals &= (tokens[i].value & 0x80) == 0;
+          break;
+      }
+    }
+
+    if (firstLiteral < 0) {
+      length_ = numAnyChar;
+      kind_ = numAnyString == 0 ? PatternKind::kExactlyN
+                                : PatternKind::kAtLeastN;
+      return;
+    }
+
+    if (numAnyChar == 0) {
+      // Literals must be contiguous for the prefix, suffix and substring
+      // kernels.
+      bool contiguous = true;
+      for (auto i = firstLiteral; i <= lastLiteral; ++i) {
+        if (tokens[i].type != Token::kLiteral) {
+          contiguous = false;
+          break;
+        }
+        fixedPattern_.push_back(tokens[i].value);
+      }
+      if (contiguous) {
+        const bool leading = firstLiteral > 0;
+        const bool trailing = lastLiteral < tokens.size() - 1;
+        if (leading && trailing) {
+          kind_ = PatternKind::kSubstring;
+        } else if (leading) {
+          kind_ = PatternKind::kSuffix;
+        } else if (trailing) {
+          kind_ = PatternKind::kPrefix;
+        } else {
+          kind_ = PatternKind::kFixed;
+        }
+        return;
+      }
+      fixedPattern_.clear();
+    } else if (numAnyString == 0 && asciiLiterals) {
+      kind_ = PatternKind::kRelaxedFixed;
+      for (const auto& token : tokens) {
+        fixedPattern_.push_back(token.value);
+        wildcards_.push_back(token.type == Token::kAnyChar);
+      }
+      makeRegex(tokens);
+      return;
+    }
+
+    kind_ = PatternKind::kGeneric;
+    makeRegex(tokens);
+  }
+
+  // Translates 'tokens' into an equivalent RE2 regex for full matching.
+  void makeRegex(const std::vector<Token>& tokens) {
+    // Let '.' match new lines.
+    std::string regex = "(?s)";
+    std::string literal;
+    for (const auto& token : tokens) {
+      if (token.type == Token::kLiteral) {
+        literal.push_back(token.value);
+        continue;
+      }
+      regex += RE2::QuoteMeta(literal);
+      literal.clear();
+      regex += token.type == Token::kAnyString ? ".*" : ".";
+    }
+    regex += RE2::QuoteMeta(literal);
+    re_ = std::make_unique<RE2>(regex, RE2::Quiet);
+    checkForBadPattern(*re_);
+  }
+
+  PatternKind kind_;
+
+  // Number of characters matched by '_' for kExactlyN and kAtLeastN.
+  size_t length_{0};
+
+  // Unescaped literal for kFixed, kPrefix, kSuffix and kSubstring. For
+  // kRelaxedFixed, the pattern with wildcard positions flagged in
+  // 'wildcards_'.
+  std::string fixedPattern_;
+  std::vector<bool> wildcards_;
+
+  // Translated regex for kRelaxedFixed and kGeneric.
+  std::unique_ptr<RE2> re_;
+};
+
+std::optional<char> getEscapeChar(StringView escape) {
+  VELOX_USER_CHECK_EQ(
+      escape.size(), 1, "Escape string must be a single character");
+  return escape.data()[0];
+}
+
+class LikeWithConstantPattern final : public VectorFunction {
+ public:
+  LikeWithConstantPattern(StringView pattern, std::optional<char> escapeChar)
+      : matcher_(pattern, escapeChar) {}
+
+  void apply(
+      const SelectivityVector& rows,
+      std::vector<VectorPtr>& args,
+      Expr* /* caller */,
+      EvalCtx* context,
+      VectorPtr* resultRef) const final {
+    VELOX_CHECK(args.size() == 2 || args.size() == 3);
+    FlatVector<bool>& result =
+        ensureWritableBool(rows, context->pool(), resultRef);
+    exec::LocalDecodedVector toSearch(context, *args[0], rows);
+    switch (matcher_.kind()) {
+      case PatternKind::kExactlyN:
+        applyKernel<PatternKind::kExactlyN>(rows, toSearch.get(), result);
+        break;
+      case PatternKind::kAtLeastN:
+        applyKernel<PatternKind::kAtLeastN>(rows, toSearch.get(), result);
+        break;
+      case PatternKind::kFixed:
+        applyKernel<PatternKind::kFixed>(rows, toSearch.get(), result);
+        break;
+      case PatternKind::kPrefix:
+        applyKernel<PatternKind::kPrefix>(rows, toSearch.get(), result);
+        break;
+      case PatternKind::kSuffix:
+        applyKernel<PatternKind::kSuffix>(rows, toSearch.get(), result);
+        break;
+      case PatternKind::kSubstring:
+        applyKernel<PatternKind::kSubstring>(rows, toSearch.get(), result);
+        break;
+      case PatternKind::kRelaxedFixed:
+        applyKernel<PatternKind::kRelaxedFixed>(rows, toSearch.get(), result);
+        break;
+      case PatternKind::kGeneric:
+        applyKernel<PatternKind::kGeneric>(rows, toSearch.get(), result);
+        break;
+    }
+  }
+
+ private:
+  template <PatternKind kind>
+  void applyKernel(
+      const SelectivityVector& rows,
+      DecodedVector* toSearch,
+      FlatVector<bool>& result) const {
+    if (toSearch->isIdentityMapping()) {
+      auto rawStrings = toSearch->data<StringView>();
+      rows.applyToSelected([&](int i) {
+        result.set(i, matcher_.match<kind>(rawStrings[i]));
+      });
+      return;
+    }
+    rows.applyToSelected([&](int i) {
+      result.set(i, matcher_.match<kind>(toSearch->valueAt<StringView>(i)));
+    });
+  }
+
+  const LikeMatcher matcher_;
+};
+
+class Like final : public VectorFunction {
+ public:
+  void apply(
+      const SelectivityVector& rows,
+      std::vector<VectorPtr>& args,
+      Expr* caller,
+      EvalCtx* context,
+      VectorPtr* resultRef) const final {
+    VELOX_CHECK(args.size() == 2 || args.size() == 3);
+    auto pattern = getIfConstant<StringView>(*args[1]);
+    std::optional<StringView> escape;
+    if (args.size() == 3) {
+      escape = getIfConstant<StringView>(*args[2]);
+    }
+    if (pattern.has_value() && (args.size() == 2 || escape.has_value())) {
+      LikeWithConstantPattern(
+          *pattern,
+          escape.has_value() ? getEscapeChar(*escape) : std::nullopt)
+          .apply(rows, args, caller, context, resultRef);
+      return;
+    }
+    // General case. The pattern is analyzed for every row.
+    FlatVector<bool>& result =
+        ensureWritableBool(rows, context->pool(), resultRef);
+    exec::LocalDecodedVector toSearch(context, *args[0], rows);
+    exec::LocalDecodedVector patterns(context, *args[1], rows);
+    std::optional<exec::LocalDecodedVector> escapes;
+    if (args.size() == 3) {
+      escapes.emplace(context, *args[2], rows);
+    }
+    rows.applyToSelected([&](int row) {
+      std::optional<char> escapeChar;
+      if (escapes.has_value()) {
+        escapeChar = getEscapeChar((*escapes)->valueAt<StringView>(row));
+      }
+      LikeMatcher matcher(patterns->valueAt<StringView>(row), escapeChar);
+      result.set(row, matcher.match(toSearch->valueAt<StringView>(row)));
+    });
+  }
+};
+
 } // namespace
 
 std::shared_ptr<VectorFunction> makeRe2Match(
@@ -439,4 +842,58 @@ std::vector<std::shared_ptr<exec::FunctionSignature>> re2ExtractSignatures() {
   };
 }
 
+std::shared_ptr<VectorFunction> makeLike(
+    const std::string& name,
+    const std::vector<VectorFunctionArg>& inputArgs) {
+  auto numArgs = inputArgs.size();
+  VELOX_USER_CHECK(
+      numArgs == 2 || numArgs == 3,
+      "{} requires 2 or 3 arguments, but got {}",
+      name,
+      numArgs);
+  for (const auto& arg : inputArgs) {
+    VELOX_USER_CHECK(
+        arg.type->isVarchar(),
+        "{} expected VARCHAR arguments but got ({})",
+        name,
+        printTypesCsv(inputArgs));
+  }
+
+  BaseVector* constantPattern = inputArgs[1].constantValue.get();
+  if (constantPattern == nullptr || constantPattern->isNullAt(0)) {
+    return std::make_shared<Like>();
+  }
+
+  std::optional<char> escapeChar;
+  if (numArgs == 3) {
+    BaseVector* constantEscape = inputArgs[2].constantValue.get();
+    if (constantEscape == nullptr || constantEscape->isNullAt(0)) {
+      return std::make_shared<Like>();
+    }
+    escapeChar = getEscapeChar(
+        constantEscape->as<ConstantVector<StringView>>()->valueAt(0));
+  }
+  return std::make_shared<LikeWithConstantPattern>(
+      constantPattern->as<ConstantVector<StringView>>()->valueAt(0),
+      escapeChar);
+}
+
+std::vector<std::shared_ptr<exec::FunctionSignature>> likeSignatures() {
+  // varchar, varchar -> boolean
+  // varchar, varchar, varchar -> boolean
+  return {
+      exec::FunctionSignatureBuilder()
+          .returnType("boolean")
+          .argumentType("varchar")
+          .argumentType("varchar")
+          .build(),
+      exec::FunctionSignatureBuilder()
+          .returnType("boolean")
+          .argumentType("varchar")
+          .argumentType("varchar")
+          .argumentType("varchar")
+          .build(),
+  };
+}
+
 } // namespace facebook::velox::functions
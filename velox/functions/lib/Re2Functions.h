@@ -73,4 +73,20 @@ std::shared_ptr<exec::VectorFunction> makeRe2Extract(
 
 std::vector<std::shared_ptr<exec::FunctionSignature>> re2ExtractSignatures();
 
+/// like(string, pattern) → bool
+/// like(string, pattern, escape) → bool
+///
+/// Returns whether string matches the SQL LIKE pattern. '%' matches zero or
+/// more characters and '_' matches exactly one character. If escape is
+/// specified, it must be a single character and escapes '%', '_' and itself.
+///
+/// A constant pattern is analyzed once. Exact, prefix, suffix and substring
+/// patterns, as well as patterns consisting of literals and '_' only, are
+/// evaluated without RE2. All other patterns are translated to an RE2 regex.
+std::shared_ptr<exec::VectorFunction> makeLike(
+    const std::string& name,
+    const std::vector<exec::VectorFunctionArg>& inputArgs);
+
+std::vector<std::shared_ptr<exec::FunctionSignature>> likeSignatures();
+
 } // namespace facebook::velox::functions
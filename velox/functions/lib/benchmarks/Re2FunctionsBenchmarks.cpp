@@ -82,6 +82,31 @@ BENCHMARK_NAMED_PARAM_MULTI(regexExtract, bs1k, 1 << 10);
 BENCHMARK_NAMED_PARAM_MULTI(regexExtract, bs10k, 10 << 10);
 BENCHMARK_NAMED_PARAM_MULTI(regexExtract, bs100k, 100 << 10);
 
+int like(int n, int blockSize, const char* pattern) {
+  folly::BenchmarkSuspender kSuspender;
+  FunctionBenchmarkBase benchmarkBase;
+
+  VectorFuzzer::Options opts;
+  opts.vectorSize = blockSize;
+  opts.stringLength = 100;
+  auto vector = VectorFuzzer(opts, benchmarkBase.pool()).fuzzFlat(VARCHAR());
+  const auto data = benchmarkBase.maker().rowVector({vector});
+
+  exec::ExprSet expr = benchmarkBase.compileExpression(
+      folly::to<std::string>("like(c0, '", pattern, "')"), data->type());
+  kSuspender.dismiss();
+  for (int i = 0; i != n; ++i) {
+    benchmarkBase.evaluate(expr, data);
+  }
+  return n * blockSize;
+}
+
+BENCHMARK_NAMED_PARAM_MULTI(like, prefix, 10 << 10, "abc%");
+BENCHMARK_NAMED_PARAM_MULTI(like, suffix, 10 << 10, "%abc");
+BENCHMARK_NAMED_PARAM_MULTI(like, substring, 10 << 10, "%abc%");
+BENCHMARK_NAMED_PARAM_MULTI(like, relaxedFixed, 10 << 10, "a_c");
+BENCHMARK_NAMED_PARAM_MULTI(like, generic, 10 << 10, "%a%b_c%");
+
 } // namespace
 
 void registerRe2Functions() {
@@ -91,6 +116,7 @@ void registerRe2Functions() {
       "re2_search", re2SearchSignatures(), makeRe2Search);
   exec::registerStatefulVectorFunction(
       "re2_extract", re2ExtractSignatures(), makeRe2Extract);
+  exec::registerStatefulVectorFunction("like", likeSignatures(), makeLike);
 }
 
 } // namespace facebook::velox::functions::test
@@ -36,6 +36,7 @@ class Re2FunctionsTest : public test::FunctionBaseTest {
         "re2_search", re2SearchSignatures(), makeRe2Search);
     exec::registerStatefulVectorFunction(
         "re2_extract", re2ExtractSignatures(), makeRe2Extract);
+    exec::registerStatefulVectorFunction("like", likeSignatures(), makeLike);
   }
 };
 
@@ -324,5 +325,90 @@ TEST_F(Re2FunctionsTest, regexExtractConstantPatternNoGroupId) {
   EXPECT_EQ(extract("a b245 c3", "\\d+"), "245");
 }
 
+template <typename F>
+void testLike(F&& like) {
+  // Exact match.
+  EXPECT_EQ(true, like("abc", "abc"));
+  EXPECT_EQ(false, like("abcd", "abc"));
+  EXPECT_EQ(true, like("", ""));
+  EXPECT_EQ(false, like("a", ""));
+  // Prefix.
+  EXPECT_EQ(true, like("abcdef", "abc%"));
+  EXPECT_EQ(true, like("abc", "abc%%"));
+  EXPECT_EQ(false, like("xabc", "abc%"));
+  // Suffix.
+  EXPECT_EQ(true, like("xyzabc", "%abc"));
+  EXPECT_EQ(false, like("abcx", "%abc"));
+  // Substring, including strings longer than one SIMD block.
+  EXPECT_EQ(true, like("xxabcxx", "%abc%"));
+  EXPECT_EQ(true, like("abc", "%abc%"));
+  EXPECT_EQ(false, like("ab", "%abc%"));
+  EXPECT_EQ(true, like(std::string(100, 'a') + "needle", "%needle%"));
+  EXPECT_EQ(
+      true, like(std::string(40, 'a') + "x" + std::string(40, 'a'), "%x%"));
+  EXPECT_EQ(
+      false,
+      like(std::string(100, 'n') + "eedl" + std::string(7, 'e'), "%needle%"));
+  // Only wildcards.
+  EXPECT_EQ(true, like("abc", "___"));
+  EXPECT_EQ(false, like("abcd", "___"));
+  EXPECT_EQ(true, like("信念", "__"));
+  EXPECT_EQ(true, like("abcd", "_%_"));
+  EXPECT_EQ(false, like("a", "_%_"));
+  EXPECT_EQ(true, like("", "%"));
+  // Literals and '_'.
+  EXPECT_EQ(true, like("abc", "a_c"));
+  EXPECT_EQ(false, like("abd", "a_c"));
+  EXPECT_EQ(false, like("abbc", "a_c"));
+  EXPECT_EQ(true, like("a信c", "a_c"));
+  // Generic patterns.
+  EXPECT_EQ(true, like("abcdef", "a%c_e%"));
+  EXPECT_EQ(false, like("abcdef", "a%c_f%"));
+  EXPECT_EQ(true, like("a\nb", "a%b"));
+  EXPECT_EQ(true, like("a.*b", "a.*_"));
+  EXPECT_EQ(false, like("axxb", "a.*_"));
+  // Null cases.
+  EXPECT_EQ(std::nullopt, like(std::nullopt, "%"));
+}
+
+TEST_F(Re2FunctionsTest, likeConstantPattern) {
+  testLike([&](std::optional<std::string> str, std::string pattern) {
+    return evaluateOnce<bool>("like(c0, '" + pattern + "')", str);
+  });
+}
+
+TEST_F(Re2FunctionsTest, like) {
+  testLike([&](std::optional<std::string> str,
+               std::optional<std::string> pattern) {
+    return evaluateOnce<bool>("like(c0, c1)", str, pattern);
+  });
+}
+
+TEST_F(Re2FunctionsTest, likeWithEscape) {
+  auto like = [&](std::optional<std::string> str, const std::string& pattern) {
+    return evaluateOnce<bool>("like(c0, '" + pattern + "', '#')", str);
+  };
+  EXPECT_EQ(true, like("50%", "50#%"));
+  EXPECT_EQ(false, like("500", "50#%"));
+  EXPECT_EQ(true, like("a_b", "%#_%"));
+  EXPECT_EQ(false, like("ab", "%#_%"));
+  EXPECT_EQ(true, like("a#", "a##"));
+  EXPECT_THROW(like("a", "a#"), VeloxUserError);
+  EXPECT_THROW(like("a", "#a"), VeloxUserError);
+  EXPECT_THROW(
+      evaluateOnce<bool>(
+          "like(c0, 'a', '##')", std::optional<std::string>("a")),
+      VeloxUserError);
+
+  auto likeVariableEscape = [&](std::optional<std::string> str,
+                                std::optional<std::string> pattern,
+                                std::optional<std::string> escape) {
+    return evaluateOnce<bool>("like(c0, c1, c2)", str, pattern, escape);
+  };
+  EXPECT_EQ(true, likeVariableEscape("50%", "50#%", "#"));
+  EXPECT_EQ(false, likeVariableEscape("500", "50#%", "#"));
+  EXPECT_EQ(std::nullopt, likeVariableEscape("500", "50#%", std::nullopt));
+}
+
 } // namespace
 } // namespace facebook::velox::functions
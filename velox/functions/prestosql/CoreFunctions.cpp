@@ -18,7 +18,6 @@
 #include "velox/functions/lib/RegistrationHelpers.h"
 #include "velox/functions/prestosql/DateTimeFunctions.h"
 #include "velox/functions/prestosql/Hash.h"
-#include "velox/functions/prestosql/JsonExtractScalar.h"
 #include "velox/functions/prestosql/Rand.h"
 #include "velox/functions/prestosql/RegisterArithmetic.h"
 #include "velox/functions/prestosql/RegisterCheckedArithmetic.h"
@@ -33,8 +32,6 @@ void registerFunctions() {
 
   registerFunction<udf_rand, double>(EMPTY);
 
-  registerFunction<udf_json_extract_scalar, Varchar, Varchar, Varchar>();
-
   // Register string functions.
   registerFunction<udf_chr, Varchar, int64_t>();
   registerFunction<udf_codepoint, int32_t, Varchar>();
@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/functions/prestosql/JsonFunctions.h"
+#include <folly/String.h>
+#include "velox/expression/EvalCtx.h"
+#include "velox/expression/Expr.h"
+#include "velox/functions/prestosql/json/JsonExtractor.h"
+#include "velox/functions/prestosql/json/JsonScalarExtractor.h"
+#include "velox/vector/FlatVector.h"
+
+namespace facebook::velox::functions {
+namespace {
+
+// Extracts the scalar at the path of 'extractor' from 'json' into row 'row' of
+// 'result'. Returns true if the result references the string buffers of the
+// input.
+bool extractScalar(
+    const JsonScalarExtractor& extractor,
+    StringView json,
+    vector_size_t row,
+    FlatVector<StringView>& result,
+    std::string& scratch) {
+  VELOX_USER_CHECK(
+      extractor.isValid(), "Invalid JSON path: {}", extractor.path());
+  folly::StringPiece input(json.data(), json.size());
+  if (!extractor.isSupported()) {
+    auto value = jsonExtractScalar(input, extractor.path());
+    if (value.hasValue()) {
+      result.set(row, StringView(value.value()));
+    } else {
+      result.setNull(row, true);
+    }
+    return false;
+  }
+
+  auto value = extractor.extract(input, scratch);
+  if (!value.has_value()) {
+    result.setNull(row, true);
+    return false;
+  }
+  StringView valueView(value->data(), value->size());
+  if (value->begin() >= input.begin() && value->end() <= input.end()) {
+    result.setNoCopy(row, valueView);
+    return !valueView.isInline();
+  }
+  result.set(row, valueView);
+  return false;
+}
+
+class JsonExtractScalarFunction : public exec::VectorFunction {
+ public:
+  // 'extractor' is set if the path is constant.
+  explicit JsonExtractScalarFunction(
+      std::unique_ptr<JsonScalarExtractor> extractor = nullptr)
+      : extractor_(std::move(extractor)) {}
+
+  void apply(
+      const SelectivityVector& rows,
+      std::vector<VectorPtr>& args,
+      exec::Expr* /*caller*/,
+      exec::EvalCtx* context,
+      VectorPtr* resultRef) const override {
+    BaseVector::ensureWritable(rows, VARCHAR(), context->pool(), resultRef);
+    auto* result = (*resultRef)->as<FlatVector<StringView>>();
+
+    exec::LocalDecodedVector jsons(context, *args[0], rows);
+    std::string scratch;
+    bool mustRefSourceStrings = false;
+
+    if (extractor_) {
+      rows.applyToSelected([&](auto row) {
+        try {
+          mustRefSourceStrings |= extractScalar(
+              *extractor_,
+              jsons->valueAt<StringView>(row),
+              row,
+              *result,
+              scratch);
+        } catch (const std::exception& e) {
+          context->setError(row, std::current_exception());
+        }
+      });
+    } else {
+      // The path is compiled again only when it differs from the previous
+      // row's.
+      exec::LocalDecodedVector paths(context, *args[1], rows);
+      std::unique_ptr<JsonScalarExtractor> extractor;
+      rows.applyToSelected([&](auto row) {
+        try {
+          auto path = paths->valueAt<StringView>(row);
+          if (!extractor ||
+              extractor->path() !=
+                  folly::trimWhitespace(
+                      folly::StringPiece(path.data(), path.size()))) {
+            extractor = std::make_unique<JsonScalarExtractor>(
+                folly::StringPiece(path.data(), path.size()));
+          }
+          mustRefSourceStrings |= extractScalar(
+              *extractor,
+              jsons->valueAt<StringView>(row),
+              row,
+              *result,
+              scratch);
+        } catch (const std::exception& e) {
+          context->setError(row, std::current_exception());
+        }
+      });
+    }
+
+    if (mustRefSourceStrings) {
+      result->acquireSharedStringBuffers(jsons->base());
+    }
+  }
+
+ private:
+  const std::unique_ptr<JsonScalarExtractor> extractor_;
+};
+
+} // namespace
+
+std::vector<std::shared_ptr<exec::FunctionSignature>>
+jsonExtractScalarSignatures() {
+  // varchar, varchar -> varchar
+  return {exec::FunctionSignatureBuilder()
+              .returnType("varchar")
+              .argumentType("varchar")
+              .argumentType("varchar")
+              .build()};
+}
+
+std::shared_ptr<exec::VectorFunction> makeJsonExtractScalar(
+    const std::string& name,
+    const std::vector<exec::VectorFunctionArg>& inputArgs) {
+  VELOX_CHECK_EQ(inputArgs.size(), 2, "{} requires 2 arguments", name);
+  BaseVector* constantPath = inputArgs[1].constantValue.get();
+  if (constantPath != nullptr && !constantPath->isNullAt(0)) {
+    auto path = constantPath->as<ConstantVector<StringView>>()->valueAt(0);
+    return std::make_shared<JsonExtractScalarFunction>(
+        std::make_unique<JsonScalarExtractor>(
+            folly::StringPiece(path.data(), path.size())));
+  }
+  return std::make_shared<JsonExtractScalarFunction>();
+}
+
+} // namespace facebook::velox::functions
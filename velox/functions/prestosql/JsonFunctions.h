@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <vector>
+
+#include "velox/expression/VectorFunction.h"
+
+namespace facebook::velox::functions {
+
+/// json_extract_scalar(json, json_path) -> varchar
+///
+/// Vectorized version of udf_json_extract_scalar. A constant path is compiled
+/// once per expression and documents are scanned with JsonScalarExtractor
+/// instead of being parsed into folly::dynamic. Results that appear verbatim
+/// in the input reference the input string buffers.
+std::vector<std::shared_ptr<exec::FunctionSignature>>
+jsonExtractScalarSignatures();
+
+std::shared_ptr<exec::VectorFunction> makeJsonExtractScalar(
+    const std::string& name,
+    const std::vector<exec::VectorFunctionArg>& inputArgs);
+
+} // namespace facebook::velox::functions
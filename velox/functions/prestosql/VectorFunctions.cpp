@@ -15,6 +15,7 @@
  */
 #include "velox/functions/prestosql/VectorFunctions.h"
 #include "velox/functions/lib/Re2Functions.h"
+#include "velox/functions/prestosql/JsonFunctions.h"
 #include "velox/functions/prestosql/TimestampWithTimeZoneType.h"
 #include "velox/functions/prestosql/WidthBucketArray.h"
 
@@ -69,6 +70,12 @@ void registerVectorFunctions() {
       "regexp_extract", re2ExtractSignatures(), makeRe2Extract);
   exec::registerStatefulVectorFunction(
       "regexp_like", re2SearchSignatures(), makeRe2Search);
+  exec::registerStatefulVectorFunction("like", likeSignatures(), makeLike);
+
+  exec::registerStatefulVectorFunction(
+      "json_extract_scalar",
+      jsonExtractScalarSignatures(),
+      makeJsonExtractScalar);
 
   VELOX_REGISTER_VECTOR_FUNCTION(udf_to_utf8, "to_utf8");
 
@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+#include "velox/functions/lib/benchmarks/FunctionBenchmarkBase.h"
+#include "velox/type/FastConversions.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+
+namespace {
+
+constexpr vector_size_t kSize = 10'000;
+
+// Casts between VARCHAR and numbers. The first group compares the batch
+// kernels of CastExpr on plain decimal strings to the same casts on strings
+// padded with a space, which go through folly row by row. The second group
+// compares the conversions of FastConversions.h to the folly calls they
+// replace.
+class CastBenchmark : public functions::test::FunctionBenchmarkBase {
+ public:
+  CastBenchmark() : FunctionBenchmarkBase() {
+    for (auto row = 0; row < kSize; ++row) {
+      const int64_t integer = (row * 2654435761LL) % 10'000'000'000LL - row;
+      const double real = integer / 1000.0;
+      integers_.push_back(integer);
+      doubles_.push_back(real);
+      integerStrings_.push_back(folly::to<std::string>(integer));
+      paddedIntegerStrings_.push_back(" " + integerStrings_.back());
+      doubleStrings_.push_back(folly::to<std::string>(real));
+      paddedDoubleStrings_.push_back(" " + doubleStrings_.back());
+    }
+    // The StringViews in 'data_' reference the strings above.
+    data_ = vectorMaker_.rowVector({
+        vectorMaker_.flatVector(integerStrings_),
+        vectorMaker_.flatVector(paddedIntegerStrings_),
+        vectorMaker_.flatVector(doubleStrings_),
+        vectorMaker_.flatVector(paddedDoubleStrings_),
+        vectorMaker_.flatVector(integers_),
+        vectorMaker_.flatVector(doubles_),
+    });
+  }
+
+  size_t run(const std::string& expression) {
+    folly::BenchmarkSuspender suspender;
+    auto exprSet = compileExpression(expression, data_->type());
+    suspender.dismiss();
+
+    size_t cnt = 0;
+    for (auto i = 0; i < 10; i++) {
+      cnt += evaluate(exprSet, data_)->size();
+    }
+    return cnt;
+  }
+
+  const std::vector<int64_t>& integers() const {
+    return integers_;
+  }
+
+  const std::vector<double>& doubles() const {
+    return doubles_;
+  }
+
+  const std::vector<std::string>& integerStrings() const {
+    return integerStrings_;
+  }
+
+  const std::vector<std::string>& doubleStrings() const {
+    return doubleStrings_;
+  }
+
+ private:
+  std::vector<int64_t> integers_;
+  std::vector<double> doubles_;
+  std::vector<std::string> integerStrings_;
+  std::vector<std::string> paddedIntegerStrings_;
+  std::vector<std::string> doubleStrings_;
+  std::vector<std::string> paddedDoubleStrings_;
+  RowVectorPtr data_;
+};
+
+std::unique_ptr<CastBenchmark> benchmark;
+
+BENCHMARK_MULTI(castVarcharToBigintFolly) {
+  return benchmark->run("cast(c1 as bigint)");
+}
+
+BENCHMARK_RELATIVE_MULTI(castVarcharToBigint) {
+  return benchmark->run("cast(c0 as bigint)");
+}
+
+BENCHMARK_MULTI(castVarcharToDoubleFolly) {
+  return benchmark->run("cast(c3 as double)");
+}
+
+BENCHMARK_RELATIVE_MULTI(castVarcharToDouble) {
+  return benchmark->run("cast(c2 as double)");
+}
+
+BENCHMARK_MULTI(castBigintToVarchar) {
+  return benchmark->run("cast(c4 as varchar)");
+}
+
+BENCHMARK_MULTI(castDoubleToVarchar) {
+  return benchmark->run("cast(c5 as varchar)");
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_MULTI(parseIntegerFolly) {
+  int64_t sum = 0;
+  for (const auto& input : benchmark->integerStrings()) {
+    sum += folly::to<int64_t>(folly::StringPiece(input));
+  }
+  folly::doNotOptimizeAway(sum);
+  return kSize;
+}
+
+BENCHMARK_RELATIVE_MULTI(parseInteger) {
+  int64_t sum = 0;
+  for (const auto& input : benchmark->integerStrings()) {
+    sum +=
+        util::fast::tryParseInteger<int64_t>(input.data(), input.size())
+            .value();
+  }
+  folly::doNotOptimizeAway(sum);
+  return kSize;
+}
+
+BENCHMARK_MULTI(parseDoubleFolly) {
+  double sum = 0;
+  for (const auto& input : benchmark->doubleStrings()) {
+    sum += folly::to<double>(folly::StringPiece(input));
+  }
+  folly::doNotOptimizeAway(sum);
+  return kSize;
+}
+
+BENCHMARK_RELATIVE_MULTI(parseDouble) {
+  double sum = 0;
+  for (const auto& input : benchmark->doubleStrings()) {
+    sum += util::fast::tryParseDouble(input.data(), input.size()).value();
+  }
+  folly::doNotOptimizeAway(sum);
+  return kSize;
+}
+
+BENCHMARK_MULTI(formatIntegerFolly) {
+  size_t length = 0;
+  for (auto value : benchmark->integers()) {
+    length += folly::to<std::string>(value).size();
+  }
+  folly::doNotOptimizeAway(length);
+  return kSize;
+}
+
+BENCHMARK_RELATIVE_MULTI(formatInteger) {
+  size_t length = 0;
+  char buffer[util::fast::kMaxIntegerLength];
+  for (auto value : benchmark->integers()) {
+    length += util::fast::formatInteger(value, buffer);
+  }
+  folly::doNotOptimizeAway(length);
+  return kSize;
+}
+
+BENCHMARK_MULTI(formatDoubleFolly) {
+  size_t length = 0;
+  for (auto value : benchmark->doubles()) {
+    length += folly::to<std::string>(value).size();
+  }
+  folly::doNotOptimizeAway(length);
+  return kSize;
+}
+
+BENCHMARK_RELATIVE_MULTI(formatDouble) {
+  size_t length = 0;
+  char buffer[util::fast::kMaxDoubleLength];
+  for (auto value : benchmark->doubles()) {
+    length += util::fast::formatDouble(value, buffer);
+  }
+  folly::doNotOptimizeAway(length);
+  return kSize;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  benchmark = std::make_unique<CastBenchmark>();
+  folly::runBenchmarks();
+  benchmark.reset();
+  return 0;
+}
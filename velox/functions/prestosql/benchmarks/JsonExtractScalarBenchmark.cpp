@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+#include "velox/functions/lib/benchmarks/FunctionBenchmarkBase.h"
+#include "velox/functions/prestosql/JsonExtractScalar.h"
+#include "velox/functions/prestosql/VectorFunctions.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+
+namespace {
+
+// Compares the vectorized json_extract_scalar, which scans the documents with
+// JsonScalarExtractor, to the simple function that parses each document into
+// folly::dynamic.
+class JsonExtractScalarBenchmark
+    : public functions::test::FunctionBenchmarkBase {
+ public:
+  JsonExtractScalarBenchmark() : FunctionBenchmarkBase() {
+    functions::registerVectorFunctions();
+    registerFunction<udf_json_extract_scalar, Varchar, Varchar, Varchar>(
+        {"json_extract_scalar_folly"});
+
+    constexpr vector_size_t size = 1000;
+    for (auto row = 0; row < size; ++row) {
+      logLines_.push_back(makeLogLine(row));
+    }
+    // The StringViews in 'data_' reference 'logLines_'.
+    data_ = vectorMaker_.rowVector({vectorMaker_.flatVector(logLines_)});
+  }
+
+  void run(const std::string& functionName, const std::string& path) {
+    folly::BenchmarkSuspender suspender;
+    auto exprSet = compileExpression(
+        fmt::format("{}(c0, '{}')", functionName, path), data_->type());
+    suspender.dismiss();
+
+    int cnt = 0;
+    for (auto i = 0; i < 100; i++) {
+      cnt += evaluate(exprSet, data_)->size();
+    }
+    folly::doNotOptimizeAway(cnt);
+  }
+
+ private:
+  // A service log record with nested request metadata, similar to what log
+  // analytics queries extract fields from.
+  static std::string makeLogLine(int32_t row) {
+    return fmt::format(
+        R"({{"timestamp":"2021-06-01T12:{:02}:{:02}.{:03}Z","level":"{}",)"
+        R"("service":"api-gateway","host":"host-{}.example.com",)"
+        R"("request":{{"method":"GET","path":"/v1/users/{}/orders?limit=50",)"
+        R"("status":{},"latency_ms":{}.{},"headers":{{"user-agent":)"
+        R"("Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36",)"
+        R"("x-request-id":"req-{:08x}"}}}},)"
+        R"("user":{{"id":{},"roles":["viewer","editor"],"tags":[{{"k":"a"}},)"
+        R"({{"k":"b"}}]}},"message":"request completed in \"{}\" ms"}})",
+        row % 60,
+        row % 60,
+        row % 1000,
+        row % 10 == 0 ? "ERROR" : "INFO",
+        row % 97,
+        row * 7,
+        row % 10 == 0 ? 500 : 200,
+        row % 300,
+        row % 10,
+        row * 2654435761u,
+        row * 13,
+        row % 300);
+  }
+
+  std::vector<std::string> logLines_;
+  RowVectorPtr data_;
+};
+
+std::unique_ptr<JsonExtractScalarBenchmark> benchmark;
+
+BENCHMARK(follyLevel) {
+  benchmark->run("json_extract_scalar_folly", "$.level");
+}
+
+BENCHMARK_RELATIVE(vectorizedLevel) {
+  benchmark->run("json_extract_scalar", "$.level");
+}
+
+BENCHMARK(follyRequestId) {
+  benchmark->run(
+      "json_extract_scalar_folly", "$.request.headers.x-request-id");
+}
+
+BENCHMARK_RELATIVE(vectorizedRequestId) {
+  benchmark->run("json_extract_scalar", "$.request.headers.x-request-id");
+}
+
+BENCHMARK(follyUserId) {
+  benchmark->run("json_extract_scalar_folly", "$.user.id");
+}
+
+BENCHMARK_RELATIVE(vectorizedUserId) {
+  benchmark->run("json_extract_scalar", "$.user.id");
+}
+
+BENCHMARK(follyMessage) {
+  benchmark->run("json_extract_scalar_folly", "$.message");
+}
+
+BENCHMARK_RELATIVE(vectorizedMessage) {
+  benchmark->run("json_extract_scalar", "$.message");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  benchmark = std::make_unique<JsonExtractScalarBenchmark>();
+  folly::runBenchmarks();
+  benchmark.reset();
+  return 0;
+}
@@ -0,0 +1,427 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/functions/prestosql/json/JsonScalarExtractor.h"
+
+#include <algorithm>
+#include <cctype>
+
+#include "folly/Conv.h"
+#include "folly/String.h"
+#include "folly/Unicode.h"
+#include "velox/common/base/SimdUtil.h"
+#include "velox/functions/prestosql/json/JsonPathTokenizer.h"
+
+namespace facebook::velox::functions {
+
+namespace {
+
+using V = simd::Vectors<int8_t>;
+
+bool isWhitespace(char c) {
+  return c == ' ' || c == '\n' || c == '\t' || c == '\r';
+}
+
+const char* skipWhitespace(const char* pos, const char* end) {
+  while (pos < end && isWhitespace(*pos)) {
+    ++pos;
+  }
+  return pos;
+}
+
+// Returns the first position in [pos, end) that holds one of 'chars', or
+// 'end' if there is none. Compares 32 bytes at a time while a full vector
+// fits before 'end'.
+template <char... chars>
+const char* findFirstOf(const char* pos, const char* end) {
+  for (; pos + V::VSize <= end; pos += V::VSize) {
+    const auto block = V::load(pos);
+    const uint32_t matches =
+        V::compareResult((V::compareEq(block, V::setAll(chars)) | ...));
+    if (matches) {
+      return pos + __builtin_ctz(matches);
+    }
+  }
+  for (; pos < end; ++pos) {
+    if (((*pos == chars) || ...)) {
+      return pos;
+    }
+  }
+  return end;
+}
+
+// 'pos' is the first character after the opening quote of a string. Returns
+// the position of the closing quote or nullptr if the string is not
+// terminated. Sets 'hasEscapes' if the string contains backslashes.
+const char* findStringEnd(const char* pos, const char* end, bool& hasEscapes) {
+  hasEscapes = false;
+  for (;;) {
+    pos = findFirstOf<'"', '\\'>(pos, end);
+    if (pos == end) {
+      return nullptr;
+    }
+    if (*pos == '"') {
+      return pos;
+    }
+    hasEscapes = true;
+    pos += 2;
+    if (pos > end) {
+      return nullptr;
+    }
+  }
+}
+
+// 'pos' is at the opening bracket or brace of an object or array. Returns the
+// position after the matching closing bracket or brace, or nullptr if the
+// container is not terminated. Does not check that brackets and braces are
+// paired correctly.
+const char* skipContainer(const char* pos, const char* end) {
+  int32_t depth = 0;
+  for (;;) {
+    pos = findFirstOf<'"', '{', '}', '[', ']'>(pos, end);
+    if (pos == end) {
+      return nullptr;
+    }
+    switch (*pos) {
+      case '"': {
+        bool hasEscapes;
+        pos = findStringEnd(pos + 1, end, hasEscapes);
+        if (!pos) {
+          return nullptr;
+        }
+        break;
+      }
+      case '{':
+      case '[':
+        ++depth;
+        break;
+      default:
+        if (--depth == 0) {
+          return pos + 1;
+        }
+    }
+    ++pos;
+  }
+}
+
+// Returns the position after the value starting at 'pos' or nullptr if the
+// value is malformed.
+const char* skipValue(const char* pos, const char* end) {
+  if (pos == end) {
+    return nullptr;
+  }
+  switch (*pos) {
+    case '"': {
+      bool hasEscapes;
+      auto stringEnd = findStringEnd(pos + 1, end, hasEscapes);
+      return stringEnd ? stringEnd + 1 : nullptr;
+    }
+    case '{':
+    case '[':
+      return skipContainer(pos, end);
+    default:
+      // Number or literal.
+      while (pos < end && *pos != ',' && *pos != '}' && *pos != ']' &&
+             !isWhitespace(*pos)) {
+        ++pos;
+      }
+      return pos;
+  }
+}
+
+int32_t hexValue(char c) {
+  if (c >= '0' && c <= '9') {
+    return c - '0';
+  }
+  if (c >= 'a' && c <= 'f') {
+    return c - 'a' + 10;
+  }
+  if (c >= 'A' && c <= 'F') {
+    return c - 'A' + 10;
+  }
+  return -1;
+}
+
+// Reads 4 hex digits at 'pos'. Returns -1 if they are not valid.
+int32_t readCodeUnit(const char* pos, const char* end) {
+  if (end - pos < 4) {
+    return -1;
+  }
+  int32_t value = 0;
+  for (auto i = 0; i < 4; ++i) {
+    auto digit = hexValue(pos[i]);
+    if (digit < 0) {
+      return -1;
+    }
+    value = (value << 4) | digit;
+  }
+  return value;
+}
+
+// Appends the unescaped contents of the JSON string [begin, end) to 'out'.
+// Returns false if an escape sequence is invalid.
+bool unescape(const char* begin, const char* end, std::string& out) {
+  out.clear();
+  const char* pos = begin;
+  while (pos < end) {
+    auto backslash = static_cast<const char*>(memchr(pos, '\\', end - pos));
+    if (!backslash) {
+      out.append(pos, end - pos);
+      return true;
+    }
+    out.append(pos, backslash - pos);
+    pos = backslash + 1;
+    if (pos == end) {
+      return false;
+    }
+    switch (*pos++) {
+      case '"':
+        out.push_back('"');
+        break;
+      case '\\':
+        out.push_back('\\');
+        break;
+      case '/':
+        out.push_back('/');
+        break;
+      case 'b':
+        out.push_back('\b');
+        break;
+      case 'f':
+        out.push_back('\f');
+        break;
+      case 'n':
+        out.push_back('\n');
+        break;
+      case 'r':
+        out.push_back('\r');
+        break;
+      case 't':
+        out.push_back('\t');
+        break;
+      case 'u': {
+        int32_t codePoint = readCodeUnit(pos, end);
+        if (codePoint < 0) {
+          return false;
+        }
+        pos += 4;
+        if (codePoint >= 0xD800 && codePoint <= 0xDBFF) {
+          // High surrogate. Must be followed by an escaped low surrogate.
+          if (end - pos < 6 || pos[0] != '\\' || pos[1] != 'u') {
+            return false;
+          }
+          int32_t low = readCodeUnit(pos + 2, end);
+          if (low < 0xDC00 || low > 0xDFFF) {
+            return false;
+          }
+          pos += 6;
+          codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+        }
+        folly::appendCodePointToUtf8(codePoint, out);
+        break;
+      }
+      default:
+        return false;
+    }
+  }
+  return true;
+}
+
+// Returns the text of the number [begin, end) as folly::dynamic::asString()
+// would produce after folly::parseJson(). Integers that print the same are
+// returned verbatim.
+std::optional<folly::StringPiece>
+numberAsString(const char* begin, const char* end, std::string& scratch) {
+  folly::StringPiece text(begin, end);
+  const char* digits = begin + (*begin == '-');
+  if (digits == end || !std::isdigit(*digits) ||
+      (*digits == '0' && digits + 1 < end && std::isdigit(digits[1]))) {
+    return std::nullopt;
+  }
+  if (std::find_if(begin, end, [](char c) {
+        return c == '.' || c == 'e' || c == 'E';
+      }) == end) {
+    auto value = folly::tryTo<int64_t>(text);
+    if (value.hasError()) {
+      return std::nullopt;
+    }
+    if (text != "-0") {
+      return text;
+    }
+    scratch = "0";
+    return folly::StringPiece(scratch);
+  }
+  auto value = folly::tryTo<double>(text);
+  if (value.hasError()) {
+    return std::nullopt;
+  }
+  scratch = folly::to<std::string>(value.value());
+  return folly::StringPiece(scratch);
+}
+
+} // namespace
+
+JsonScalarExtractor::JsonScalarExtractor(folly::StringPiece path)
+    : path_(folly::trimWhitespace(path).str()) {
+  JsonPathTokenizer tokenizer;
+  if (path_.empty() || !tokenizer.reset(path_)) {
+    return;
+  }
+  while (tokenizer.hasNext()) {
+    auto token = tokenizer.getNext();
+    if (!token) {
+      tokens_.clear();
+      return;
+    }
+    if (token.value() == "*") {
+      isSupported_ = false;
+    }
+    auto index = folly::tryTo<int32_t>(token.value());
+    tokens_.push_back(
+        {token.value(),
+         index.hasValue() && index.value() >= 0 ? index.value() : -1});
+  }
+  isValid_ = true;
+}
+
+std::optional<folly::StringPiece> JsonScalarExtractor::extract(
+    folly::StringPiece json,
+    std::string& scratch) const {
+  const char* pos = json.begin();
+  const char* end = json.end();
+
+  for (const auto& token : tokens_) {
+    pos = skipWhitespace(pos, end);
+    if (pos == end) {
+      return std::nullopt;
+    }
+    if (*pos == '{') {
+      // Find the member named 'token.key' and position 'pos' at its value.
+      pos = skipWhitespace(pos + 1, end);
+      for (;;) {
+        if (pos == end || *pos != '"') {
+          return std::nullopt;
+        }
+        bool hasEscapes;
+        const char* keyEnd = findStringEnd(pos + 1, end, hasEscapes);
+        if (!keyEnd) {
+          return std::nullopt;
+        }
+        bool found;
+        if (hasEscapes) {
+          if (!unescape(pos + 1, keyEnd, scratch)) {
+            return std::nullopt;
+          }
+          found = scratch == token.key;
+        } else {
+          found = folly::StringPiece(pos + 1, keyEnd) == token.key;
+        }
+        pos = skipWhitespace(keyEnd + 1, end);
+        if (pos == end || *pos != ':') {
+          return std::nullopt;
+        }
+        pos = skipWhitespace(pos + 1, end);
+        if (found) {
+          break;
+        }
+        pos = skipValue(pos, end);
+        if (!pos) {
+          return std::nullopt;
+        }
+        pos = skipWhitespace(pos, end);
+        if (pos == end || *pos != ',') {
+          // End of object or malformed.
+          return std::nullopt;
+        }
+        pos = skipWhitespace(pos + 1, end);
+      }
+    } else if (*pos == '[') {
+      if (token.index < 0) {
+        return std::nullopt;
+      }
+      pos = skipWhitespace(pos + 1, end);
+      if (pos < end && *pos == ']') {
+        return std::nullopt;
+      }
+      for (auto i = 0; i < token.index; ++i) {
+        pos = skipValue(pos, end);
+        if (!pos) {
+          return std::nullopt;
+        }
+        pos = skipWhitespace(pos, end);
+        if (pos == end || *pos != ',') {
+          return std::nullopt;
+        }
+        pos = skipWhitespace(pos + 1, end);
+      }
+    } else {
+      // Subscript into a scalar.
+      return std::nullopt;
+    }
+  }
+
+  pos = skipWhitespace(pos, end);
+  if (pos == end) {
+    return std::nullopt;
+  }
+  const char* valueEnd = skipValue(pos, end);
+  if (!valueEnd) {
+    return std::nullopt;
+  }
+  if (tokens_.empty() && skipWhitespace(valueEnd, end) != end) {
+    // The whole document is the value and has trailing characters.
+    return std::nullopt;
+  }
+
+  switch (*pos) {
+    case '"': {
+      bool hasEscapes;
+      const char* stringEnd = findStringEnd(pos + 1, end, hasEscapes);
+      if (!hasEscapes) {
+        return folly::StringPiece(pos + 1, stringEnd);
+      }
+      if (!unescape(pos + 1, stringEnd, scratch)) {
+        return std::nullopt;
+      }
+      return folly::StringPiece(scratch);
+    }
+    case 't':
+    case 'f': {
+      folly::StringPiece literal(pos, valueEnd);
+      if (literal == "true" || literal == "false") {
+        return literal;
+      }
+      return std::nullopt;
+    }
+    case '-':
+    case '0':
+    case '1':
+    case '2':
+    case '3':
+    case '4':
+    case '5':
+    case '6':
+    case '7':
+    case '8':
+    case '9':
+      return numberAsString(pos, valueEnd, scratch);
+    default:
+      // Null, object, array or malformed.
+      return std::nullopt;
+  }
+}
+
+} // namespace facebook::velox::functions
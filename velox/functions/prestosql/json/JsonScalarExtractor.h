@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "folly/Range.h"
+
+namespace facebook::velox::functions {
+
+/// Streaming extractor for jsonExtractScalar. The path is tokenized once at
+/// construction. extract() then walks the JSON text directly, skipping
+/// objects, arrays and strings that are not on the path with SIMD scans for
+/// structural characters, without building a folly::dynamic or allocating.
+///
+/// Results match jsonExtractScalar() for well-formed documents. The document
+/// is only validated along the path, so malformed text outside of the path
+/// may produce a value where jsonExtractScalar() returns none. For duplicate
+/// keys, the first occurrence is used.
+class JsonScalarExtractor {
+ public:
+  explicit JsonScalarExtractor(folly::StringPiece path);
+
+  /// False if the path could not be tokenized. extract() must not be called
+  /// on an invalid extractor.
+  bool isValid() const {
+    return isValid_;
+  }
+
+  /// False if the path uses features the streaming extractor does not
+  /// implement (wildcards). Such paths must be evaluated with
+  /// jsonExtractScalar().
+  bool isSupported() const {
+    return isSupported_;
+  }
+
+  const std::string& path() const {
+    return path_;
+  }
+
+  /// Returns the scalar at the path in 'json' as text, or std::nullopt if
+  /// there is no such value, the value is null, an object or an array, or the
+  /// document is malformed. The result points into 'json' when the value can
+  /// be returned verbatim (unescaped strings, booleans, integers) and into
+  /// 'scratch' otherwise.
+  std::optional<folly::StringPiece> extract(
+      folly::StringPiece json,
+      std::string& scratch) const;
+
+ private:
+  struct Token {
+    std::string key;
+    // Array subscript if 'key' is a valid index, -1 otherwise.
+    int32_t index;
+  };
+
+  const std::string path_;
+  std::vector<Token> tokens_;
+  bool isValid_{false};
+  bool isSupported_{true};
+};
+
+} // namespace facebook::velox::functions
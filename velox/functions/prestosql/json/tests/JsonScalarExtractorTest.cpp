@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/functions/prestosql/json/JsonScalarExtractor.h"
+
+#include "gtest/gtest.h"
+#include "velox/functions/prestosql/json/JsonExtractor.h"
+
+using facebook::velox::functions::jsonExtractScalar;
+using facebook::velox::functions::JsonScalarExtractor;
+
+namespace {
+
+std::optional<std::string> extract(
+    const std::string& json,
+    const std::string& path) {
+  JsonScalarExtractor extractor(path);
+  EXPECT_TRUE(extractor.isValid());
+  EXPECT_TRUE(extractor.isSupported());
+  std::string scratch;
+  auto result = extractor.extract(json, scratch);
+  if (!result.has_value()) {
+    return std::nullopt;
+  }
+  return result->str();
+}
+
+// Checks that the streaming extractor agrees with jsonExtractScalar.
+void expectSameAsFolly(const std::string& json, const std::string& path) {
+  auto expected = jsonExtractScalar(json, path);
+  auto actual = extract(json, path);
+  EXPECT_EQ(expected.hasValue(), actual.has_value()) << json << " " << path;
+  if (expected.hasValue() && actual.has_value()) {
+    EXPECT_EQ(expected.value(), actual.value()) << json << " " << path;
+  }
+}
+
+TEST(JsonScalarExtractorTest, scalars) {
+  EXPECT_EQ(extract("1", "$"), "1");
+  EXPECT_EQ(extract(" -12 ", "$"), "-12");
+  EXPECT_EQ(extract("-0", "$"), "0");
+  EXPECT_EQ(extract("true", "$"), "true");
+  EXPECT_EQ(extract("false", "$"), "false");
+  EXPECT_EQ(extract("null", "$"), std::nullopt);
+  EXPECT_EQ(extract(R"("abc")", "$"), "abc");
+  EXPECT_EQ(extract(R"("")", "$"), "");
+  EXPECT_EQ(extract("1 2", "$"), std::nullopt);
+  EXPECT_EQ(extract("01", "$"), std::nullopt);
+  EXPECT_EQ(extract("tru", "$"), std::nullopt);
+  EXPECT_EQ(extract("", "$"), std::nullopt);
+  EXPECT_EQ(
+      extract(
+          "184467440737095516151844674407370955161518446744073709551615", "$"),
+      std::nullopt);
+
+  for (auto json : {"1.1", "1.0", "1e3", "-2.5E-3", "123456789.123"}) {
+    expectSameAsFolly(json, "$");
+  }
+}
+
+TEST(JsonScalarExtractorTest, strings) {
+  EXPECT_EQ(extract(R"({"k":"a\"b"})", "$.k"), "a\"b");
+  EXPECT_EQ(extract(R"({"k":"a\\b\/c\n"})", "$.k"), "a\\b/c\n");
+  EXPECT_EQ(extract(R"({"k":"I ♥ UTF-8"})", "$.k"), u8"I ♥ UTF-8");
+  EXPECT_EQ(extract(R"({"k":"𝄞"})", "$.k"), u8"\U0001D11E");
+  EXPECT_EQ(extract(R"({"k":"\ud834"})", "$.k"), std::nullopt);
+  EXPECT_EQ(extract(R"({"k":"\x"})", "$.k"), std::nullopt);
+  EXPECT_EQ(extract(R"({"k":"abc)", "$.k"), std::nullopt);
+
+  // Escaped keys.
+  EXPECT_EQ(extract(R"({"a\"b":1})", R"($["a\"b"])"), "1");
+  EXPECT_EQ(extract(R"({"ab":1})", "$.ab"), "1");
+}
+
+TEST(JsonScalarExtractorTest, paths) {
+  const std::string json = R"(
+    {"store": {
+       "fruit": [{"weight": 8, "type": "apple"},
+                 {"weight": 9, "type": "pear", "tags": ["a]", "{b"]}],
+       "bicycle": {"price": 19.95, "color": "red"}},
+     "email": "amy@only_for_json_udf_test.net",
+     "owner": "amy",
+     "0": "zero"})";
+  EXPECT_EQ(extract(json, "$.owner"), "amy");
+  EXPECT_EQ(extract(json, " $.owner "), "amy");
+  EXPECT_EQ(extract(json, "$.store.fruit[0].weight"), "8");
+  EXPECT_EQ(extract(json, "$.store.fruit[1].type"), "pear");
+  EXPECT_EQ(extract(json, "$.store.fruit[1].tags[1]"), "{b");
+  EXPECT_EQ(extract(json, "$.store.fruit[2].type"), std::nullopt);
+  EXPECT_EQ(extract(json, "$.store.bicycle.color"), "red");
+  EXPECT_EQ(extract(json, "$[\"store\"][\"bicycle\"][\"color\"]"), "red");
+  EXPECT_EQ(extract(json, "$[0]"), "zero");
+  EXPECT_EQ(extract(json, "$.store"), std::nullopt);
+  EXPECT_EQ(extract(json, "$.store.fruit"), std::nullopt);
+  EXPECT_EQ(extract(json, "$.store.fruit.type"), std::nullopt);
+  EXPECT_EQ(extract(json, "$.owner.name"), std::nullopt);
+  EXPECT_EQ(extract(json, "$.nonexistent"), std::nullopt);
+  expectSameAsFolly(json, "$.store.bicycle.price");
+
+  EXPECT_EQ(extract("[]", "$[0]"), std::nullopt);
+  EXPECT_EQ(extract("{}", "$.a"), std::nullopt);
+  EXPECT_EQ(extract("[1, [2, 3], {\"a\": [4]}, 5]", "$[3]"), "5");
+  EXPECT_EQ(extract("[1, [2, 3], {\"a\": [4]}, 5]", "$[2].a[0]"), "4");
+
+  // Long documents exercise the vectorized scans.
+  std::string longJson = "{\"skip\": [";
+  for (auto i = 0; i < 100; ++i) {
+    longJson += "{\"key\": \"value with \\\"quotes\\\" and ]} " +
+        std::to_string(i) + "\"},";
+  }
+  longJson += "0], \"target\": \"found\"}";
+  EXPECT_EQ(extract(longJson, "$.target"), "found");
+  EXPECT_EQ(extract(longJson, "$.skip[100]"), "0");
+  expectSameAsFolly(longJson, "$.skip[57].key");
+}
+
+TEST(JsonScalarExtractorTest, invalidAndUnsupportedPaths) {
+  for (auto path : {"", "$[]", "$[-1]", "$k1", "$.k1.", "$.k1]"}) {
+    EXPECT_FALSE(JsonScalarExtractor(path).isValid()) << path;
+  }
+  JsonScalarExtractor wildcard("$.store[*].type");
+  EXPECT_TRUE(wildcard.isValid());
+  EXPECT_FALSE(wildcard.isSupported());
+}
+
+} // namespace
@@ -62,6 +62,35 @@ TEST_F(JsonExtractScalarTest, simple) {
       "v2");
 }
 
+TEST_F(JsonExtractScalarTest, constantPath) {
+  using S = StringView;
+  auto data = makeRowVector({makeNullableFlatVector<StringView>(
+      {S(R"({"k1":{"k2":"a string that is not inlined"}})"),
+       S(R"({"k1":{"k2":123}})"),
+       S(R"({"k1":{"k2":[1]}})"),
+       S(R"({"k1":{"k2":"esc\"aped"}})"),
+       std::nullopt,
+       S(R"({"k1":{"k2":1.50}})")})});
+  auto result = evaluate<SimpleVector<StringView>>(
+      "json_extract_scalar(c0, '$.k1.k2')", data);
+  auto expected = makeNullableFlatVector<StringView>(
+      {S("a string that is not inlined"),
+       S("123"),
+       std::nullopt,
+       S("esc\"aped"),
+       std::nullopt,
+       S("1.5")});
+  assertEqualVectors(expected, result);
+
+  // Wildcards are evaluated by the folly based extractor.
+  data = makeRowVector({makeFlatVector<StringView>(
+      {S(R"([{"k1":"v1"}])"), S(R"([{"k1":"v1"}, {"k1":"v2"}])")})});
+  result = evaluate<SimpleVector<StringView>>(
+      "json_extract_scalar(c0, '$[*].k1')", data);
+  expected = makeNullableFlatVector<StringView>({S("v1"), std::nullopt});
+  assertEqualVectors(expected, result);
+}
+
 TEST_F(JsonExtractScalarTest, utf8) {
   EXPECT_EQ(
       json_extract_scalar(R"({"k1":"I \u2665 UTF-8"})", "$.k1"),
@@ -0,0 +1,248 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/row/UnsafeRow.h"
+#include "velox/vector/ComplexVector.h"
+#include "velox/vector/DecodedVector.h"
+
+namespace facebook::velox::row {
+
+/// Converts a RowVector to UnsafeRows a column at a time. The layout of the
+/// fixed length region is computed once per RowType. Each batch is then
+/// written in three passes over the columns: the row sizes, the null bits
+/// and fixed width values, and finally the variable length data.
+///
+/// Row i is byte for byte what UnsafeRowDynamicSerializer::serialize() writes
+/// for row i of the same vector into a zeroed buffer. Rows are laid out back
+/// to back in one buffer, each starting at a field width aligned offset.
+///
+/// Supports fixed width types, TIMESTAMP (written as seconds), VARCHAR and
+/// VARBINARY. Use UnsafeRowDynamicSerializer for rows with complex types.
+class UnsafeRowBatchSerializer {
+ public:
+  explicit UnsafeRowBatchSerializer(RowTypePtr rowType)
+      : rowType_(std::move(rowType)),
+        nullLength_(UnsafeRow::getNullLength(rowType_->size())),
+        fixedLength_(
+            nullLength_ + rowType_->size() * UnsafeRow::kFieldWidthBytes),
+        decoded_(rowType_->size()) {
+    VELOX_CHECK(
+        isSupported(*rowType_),
+        "Unsupported type for UnsafeRowBatchSerializer: {}",
+        rowType_->toString());
+    for (auto i = 0; i < rowType_->size(); ++i) {
+      const auto& type = rowType_->childAt(i);
+      if (type->isFixedWidth()) {
+        fixedWidthColumns_.push_back(i);
+      } else {
+        hasVariableWidth_ = true;
+      }
+    }
+  }
+
+  /// Returns true if all fields of 'rowType' can be converted in batch.
+  static bool isSupported(const RowType& rowType) {
+    for (const auto& type : rowType.children()) {
+      switch (type->kind()) {
+        case TypeKind::BOOLEAN:
+        case TypeKind::TINYINT:
+        case TypeKind::SMALLINT:
+        case TypeKind::INTEGER:
+        case TypeKind::BIGINT:
+        case TypeKind::REAL:
+        case TypeKind::DOUBLE:
+        case TypeKind::TIMESTAMP:
+        case TypeKind::VARCHAR:
+        case TypeKind::VARBINARY:
+          break;
+        default:
+          return false;
+      }
+    }
+    return true;
+  }
+
+  /// Serializes all rows of 'data' into a new buffer. Row i starts at
+  /// 'offsets[i]' and is 'sizes[i]' bytes long.
+  BufferPtr serialize(
+      const RowVector& data,
+      memory::MemoryPool* pool,
+      std::vector<size_t>& offsets,
+      std::vector<size_t>& sizes) {
+    VELOX_CHECK_EQ(data.childrenSize(), rowType_->size());
+    const auto numRows = data.size();
+    SelectivityVector rows(numRows);
+    for (auto i = 0; i < rowType_->size(); ++i) {
+      decoded_[i].decode(*data.childAt(i), rows);
+    }
+
+    computeSizes(numRows, sizes);
+    offsets.resize(numRows);
+    size_t totalSize = 0;
+    for (auto row = 0; row < numRows; ++row) {
+      offsets[row] = totalSize;
+      totalSize += UnsafeRow::alignToFieldWidth(sizes[row]);
+    }
+
+    auto buffer = AlignedBuffer::allocate<char>(totalSize, pool);
+    char* rawBuffer = buffer->asMutable<char>();
+    // Padding and the slots of null fields are zero.
+    std::memset(rawBuffer, 0, totalSize);
+
+    writeNulls(numRows, offsets, rawBuffer);
+    for (auto column : fixedWidthColumns_) {
+      VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+          writeFixedWidth,
+          rowType_->childAt(column)->kind(),
+          column,
+          numRows,
+          offsets,
+          rawBuffer);
+    }
+    if (hasVariableWidth_) {
+      writeVariableWidth(numRows, offsets, rawBuffer);
+    }
+    return buffer;
+  }
+
+ private:
+  // Number of bytes written for each variable width field, 0 for fixed width
+  // fields.
+  size_t variableSize(int32_t column, vector_size_t row) const {
+    const auto& decoded = decoded_[column];
+    if (rowType_->childAt(column)->isFixedWidth() || decoded.isNullAt(row)) {
+      return 0;
+    }
+    return decoded.valueAt<StringView>(row).size();
+  }
+
+  // Each field aligns the end of the variable length region before it is
+  // written, as UnsafeRow::getSerializationLocation() does, so only a non-null
+  // variable width field in last position leaves a row unaligned.
+  void computeSizes(vector_size_t numRows, std::vector<size_t>& sizes) const {
+    sizes.assign(numRows, fixedLength_);
+    if (!hasVariableWidth_) {
+      return;
+    }
+    for (auto column = 0; column < rowType_->size(); ++column) {
+      for (auto row = 0; row < numRows; ++row) {
+        sizes[row] = UnsafeRow::alignToFieldWidth(sizes[row]) +
+            variableSize(column, row);
+      }
+    }
+  }
+
+  void writeNulls(
+      vector_size_t numRows,
+      const std::vector<size_t>& offsets,
+      char* buffer) const {
+    for (auto column = 0; column < rowType_->size(); ++column) {
+      const auto& decoded = decoded_[column];
+      if (!decoded.mayHaveNulls()) {
+        continue;
+      }
+      for (auto row = 0; row < numRows; ++row) {
+        if (decoded.isNullAt(row)) {
+          bits::setBit(buffer + offsets[row], column);
+        }
+      }
+    }
+  }
+
+  template <TypeKind Kind>
+  void writeFixedWidth(
+      int32_t column,
+      vector_size_t numRows,
+      const std::vector<size_t>& offsets,
+      char* buffer) const {
+    using T = typename TypeTraits<Kind>::NativeType;
+    // Follow Spark, write timestamps as seconds.
+    using Stored = std::conditional_t<Kind == TypeKind::TIMESTAMP, int64_t, T>;
+    const auto& decoded = decoded_[column];
+    const size_t slot = nullLength_ + column * UnsafeRow::kFieldWidthBytes;
+
+    auto store = [&](vector_size_t row) {
+      Stored value;
+      if constexpr (Kind == TypeKind::TIMESTAMP) {
+        value = decoded.valueAt<Timestamp>(row).getSeconds();
+      } else {
+        value = decoded.valueAt<T>(row);
+      }
+      *reinterpret_cast<Stored*>(buffer + offsets[row] + slot) = value;
+    };
+
+    if constexpr (Kind != TypeKind::BOOLEAN && Kind != TypeKind::TIMESTAMP) {
+      if (decoded.isIdentityMapping() && !decoded.mayHaveNulls()) {
+        const T* values = decoded.data<T>();
+        for (auto row = 0; row < numRows; ++row) {
+          *reinterpret_cast<T*>(buffer + offsets[row] + slot) = values[row];
+        }
+        return;
+      }
+    }
+    for (auto row = 0; row < numRows; ++row) {
+      if (!decoded.isNullAt(row)) {
+        store(row);
+      }
+    }
+  }
+
+  // Appends the variable width fields after the fixed length region of each
+  // row, column by column, keeping the end of each row in 'ends_'.
+  void writeVariableWidth(
+      vector_size_t numRows,
+      const std::vector<size_t>& offsets,
+      char* buffer) {
+    ends_.assign(numRows, fixedLength_);
+    for (auto column = 0; column < rowType_->size(); ++column) {
+      if (rowType_->childAt(column)->isFixedWidth()) {
+        for (auto row = 0; row < numRows; ++row) {
+          ends_[row] = UnsafeRow::alignToFieldWidth(ends_[row]);
+        }
+        continue;
+      }
+      const auto& decoded = decoded_[column];
+      const size_t slot = nullLength_ + column * UnsafeRow::kFieldWidthBytes;
+      for (auto row = 0; row < numRows; ++row) {
+        const size_t end = UnsafeRow::alignToFieldWidth(ends_[row]);
+        ends_[row] = end;
+        if (decoded.isNullAt(row)) {
+          continue;
+        }
+        const auto value = decoded.valueAt<StringView>(row);
+        char* rowStart = buffer + offsets[row];
+        *reinterpret_cast<uint64_t*>(rowStart + slot) =
+            static_cast<uint64_t>(end) << 32 | value.size();
+        std::memcpy(rowStart + end, value.data(), value.size());
+        ends_[row] = end + value.size();
+      }
+    }
+  }
+
+  const RowTypePtr rowType_;
+  const size_t nullLength_;
+  // Size of the null bits and the fixed width slots of each row.
+  const size_t fixedLength_;
+  std::vector<int32_t> fixedWidthColumns_;
+  bool hasVariableWidth_{false};
+
+  // Reused across batches.
+  std::vector<DecodedVector> decoded_;
+  std::vector<size_t> ends_;
+};
+
+} // namespace facebook::velox::row
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include "velox/row/UnsafeRowBatchSerializer.h"
+#include "velox/row/UnsafeRowDynamicSerializer.h"
+#include "velox/vector/tests/VectorMaker.h"
+
+// Compares converting a RowVector to UnsafeRows one row at a time with
+// UnsafeRowDynamicSerializer against UnsafeRowBatchSerializer.
+
+namespace facebook::velox::row {
+namespace {
+
+constexpr vector_size_t kNumRows = 10'000;
+
+class UnsafeRowSerializeBenchmark {
+ public:
+  UnsafeRowSerializeBenchmark() {
+    for (auto i = 0; i < kNumRows; ++i) {
+      strings_.push_back(std::string(5 + i % 40, 'a' + i % 26));
+    }
+
+    fixedWidth_ = vectorMaker_.rowVector({
+        vectorMaker_.flatVector<int64_t>(
+            kNumRows, [](auto row) { return row; }),
+        vectorMaker_.flatVector<int32_t>(
+            kNumRows,
+            [](auto row) { return row; },
+            test::VectorMaker::nullEvery(5)),
+        vectorMaker_.flatVector<double>(
+            kNumRows, [](auto row) { return row * 0.1; }),
+        vectorMaker_.flatVector<int16_t>(
+            kNumRows, [](auto row) { return row; }),
+        vectorMaker_.flatVector<bool>(
+            kNumRows, [](auto row) { return row % 3 == 0; }),
+    });
+
+    mixed_ = vectorMaker_.rowVector({
+        vectorMaker_.flatVector<int64_t>(
+            kNumRows, [](auto row) { return row; }),
+        vectorMaker_.flatVector<StringView>(
+            kNumRows,
+            [&](auto row) { return StringView(strings_[row]); },
+            test::VectorMaker::nullEvery(7)),
+        vectorMaker_.flatVector<double>(
+            kNumRows, [](auto row) { return row * 0.1; }),
+        vectorMaker_.flatVector<StringView>(
+            kNumRows,
+            [&](auto row) { return StringView(strings_[kNumRows - 1 - row]); }),
+    });
+
+    // Large enough for any row of the vectors above.
+    rowBuffer_.resize(1024);
+  }
+
+  size_t rowByRow(const RowVectorPtr& data) {
+    size_t totalSize = 0;
+    for (auto row = 0; row < data->size(); ++row) {
+      std::fill(rowBuffer_.begin(), rowBuffer_.end(), 0);
+      totalSize += UnsafeRowDynamicSerializer::serialize(
+                       data->type(), data, rowBuffer_.data(), row)
+                       .value();
+    }
+    return totalSize;
+  }
+
+  size_t batch(const RowVectorPtr& data) {
+    UnsafeRowBatchSerializer serializer(
+        std::dynamic_pointer_cast<const RowType>(data->type()));
+    auto buffer = serializer.serialize(*data, pool_.get(), offsets_, sizes_);
+    return buffer->size();
+  }
+
+  const RowVectorPtr& fixedWidth() const {
+    return fixedWidth_;
+  }
+
+  const RowVectorPtr& mixed() const {
+    return mixed_;
+  }
+
+ private:
+  std::unique_ptr<memory::ScopedMemoryPool> pool_ =
+      memory::getDefaultScopedMemoryPool();
+  test::VectorMaker vectorMaker_{pool_.get()};
+  std::vector<std::string> strings_;
+  RowVectorPtr fixedWidth_;
+  RowVectorPtr mixed_;
+  std::vector<char> rowBuffer_;
+  std::vector<size_t> offsets_;
+  std::vector<size_t> sizes_;
+};
+
+std::unique_ptr<UnsafeRowSerializeBenchmark> benchmark;
+
+BENCHMARK_MULTI(fixedWidthRowByRow) {
+  folly::doNotOptimizeAway(benchmark->rowByRow(benchmark->fixedWidth()));
+  return kNumRows;
+}
+
+BENCHMARK_RELATIVE_MULTI(fixedWidthBatch) {
+  folly::doNotOptimizeAway(benchmark->batch(benchmark->fixedWidth()));
+  return kNumRows;
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_MULTI(mixedRowByRow) {
+  folly::doNotOptimizeAway(benchmark->rowByRow(benchmark->mixed()));
+  return kNumRows;
+}
+
+BENCHMARK_RELATIVE_MULTI(mixedBatch) {
+  folly::doNotOptimizeAway(benchmark->batch(benchmark->mixed()));
+  return kNumRows;
+}
+
+} // namespace
+} // namespace facebook::velox::row
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  facebook::velox::row::benchmark =
+      std::make_unique<facebook::velox::row::UnsafeRowSerializeBenchmark>();
+  folly::runBenchmarks();
+  facebook::velox::row::benchmark.reset();
+  return 0;
+}
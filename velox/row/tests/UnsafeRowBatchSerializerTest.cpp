@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/row/UnsafeRowBatchSerializer.h"
+#include <gtest/gtest.h>
+#include "velox/row/UnsafeRowDynamicSerializer.h"
+#include "velox/vector/tests/VectorMaker.h"
+
+namespace facebook::velox::row {
+namespace {
+
+class UnsafeRowBatchSerializerTest : public ::testing::Test {
+ protected:
+  // Serializes 'data' in batch and checks each row against
+  // UnsafeRowDynamicSerializer.
+  void testRoundTrip(const RowVectorPtr& data) {
+    auto rowType = std::dynamic_pointer_cast<const RowType>(data->type());
+    UnsafeRowBatchSerializer serializer(rowType);
+    std::vector<size_t> offsets;
+    std::vector<size_t> sizes;
+    // Serialize twice to check that the serializer can be reused.
+    for (auto i = 0; i < 2; ++i) {
+      auto buffer = serializer.serialize(*data, pool_.get(), offsets, sizes);
+      ASSERT_EQ(offsets.size(), data->size());
+      ASSERT_EQ(sizes.size(), data->size());
+
+      for (auto row = 0; row < data->size(); ++row) {
+        ASSERT_EQ(offsets[row] % UnsafeRow::kFieldWidthBytes, 0);
+        std::vector<char> expected(1024, 0);
+        auto expectedSize = UnsafeRowDynamicSerializer::serialize(
+            rowType, data, expected.data(), row);
+        ASSERT_EQ(sizes[row], expectedSize.value()) << "at row " << row;
+        ASSERT_EQ(
+            0,
+            std::memcmp(
+                buffer->as<char>() + offsets[row],
+                expected.data(),
+                sizes[row]))
+            << "at row " << row;
+      }
+    }
+  }
+
+  std::unique_ptr<memory::ScopedMemoryPool> pool_ =
+      memory::getDefaultScopedMemoryPool();
+  velox::test::VectorMaker vectorMaker_{pool_.get()};
+};
+
+TEST_F(UnsafeRowBatchSerializerTest, fixedWidth) {
+  const vector_size_t size = 100;
+  auto data = vectorMaker_.rowVector({
+      vectorMaker_.flatVector<int64_t>(
+          size, [](auto row) { return row * 0x0101010101; }),
+      vectorMaker_.flatVector<int32_t>(
+          size,
+          [](auto row) { return -row; },
+          velox::test::VectorMaker::nullEvery(3)),
+      vectorMaker_.flatVector<bool>(
+          size,
+          [](auto row) { return row % 2 == 0; },
+          velox::test::VectorMaker::nullEvery(5)),
+      vectorMaker_.flatVector<int16_t>(size, [](auto row) { return row; }),
+      vectorMaker_.flatVector<int8_t>(
+          size,
+          [](auto row) { return row; },
+          velox::test::VectorMaker::nullEvery(7)),
+      vectorMaker_.flatVector<double>(
+          size, [](auto row) { return row * 1.5; }),
+      vectorMaker_.flatVector<float>(
+          size,
+          [](auto row) { return row * 0.5; },
+          velox::test::VectorMaker::nullEvery(4)),
+      vectorMaker_.flatVector<Timestamp>(
+          size,
+          [](auto row) { return Timestamp(row * 1000, row); },
+          velox::test::VectorMaker::nullEvery(6)),
+  });
+  testRoundTrip(data);
+}
+
+TEST_F(UnsafeRowBatchSerializerTest, variableWidth) {
+  const vector_size_t size = 100;
+  std::vector<std::string> strings;
+  for (auto i = 0; i < size; ++i) {
+    strings.push_back(std::string(i % 23, 'a' + i % 26));
+  }
+  auto stringAt = [&](auto row) { return StringView(strings[row]); };
+
+  auto data = vectorMaker_.rowVector({
+      vectorMaker_.flatVector<StringView>(
+          size, stringAt, velox::test::VectorMaker::nullEvery(3)),
+      vectorMaker_.flatVector<int64_t>(size, [](auto row) { return row; }),
+      vectorMaker_.flatVector<StringView>(size, stringAt),
+      vectorMaker_.flatVector<int32_t>(
+          size,
+          [](auto row) { return row; },
+          velox::test::VectorMaker::nullEvery(2)),
+      // Variable width field in last position, sometimes null.
+      vectorMaker_.flatVector<StringView>(
+          size,
+          [&](auto row) { return StringView(strings[size - 1 - row]); },
+          velox::test::VectorMaker::nullEvery(4)),
+  });
+  testRoundTrip(data);
+}
+
+TEST_F(UnsafeRowBatchSerializerTest, encodings) {
+  auto data = vectorMaker_.rowVector({
+      vectorMaker_.constantVector<int32_t>(
+          std::vector<std::optional<int32_t>>(6, 0x22222222)),
+      vectorMaker_.constantVector<int64_t>(
+          std::vector<std::optional<int64_t>>(6, std::nullopt)),
+      vectorMaker_.dictionaryVector<int64_t>(
+          {10, std::nullopt, 15, 15, std::nullopt, 10}),
+      vectorMaker_.constantVector<StringView>(
+          std::vector<std::optional<StringView>>(6, StringView("1234"))),
+      vectorMaker_.dictionaryVector<StringView>(
+          {StringView("a string longer than inline"),
+           std::nullopt,
+           StringView("short"),
+           StringView("a string longer than inline"),
+           StringView(""),
+           std::nullopt}),
+  });
+  testRoundTrip(data);
+}
+
+TEST_F(UnsafeRowBatchSerializerTest, unsupported) {
+  ASSERT_TRUE(UnsafeRowBatchSerializer::isSupported(
+      *ROW({"a", "b"}, {BIGINT(), VARCHAR()})));
+  ASSERT_FALSE(UnsafeRowBatchSerializer::isSupported(
+      *ROW({"a", "b"}, {BIGINT(), ARRAY(BIGINT())})));
+  EXPECT_THROW(
+      UnsafeRowBatchSerializer(ROW({"a"}, {MAP(BIGINT(), BIGINT())})),
+      VeloxRuntimeError);
+}
+
+} // namespace
+} // namespace facebook::velox::row
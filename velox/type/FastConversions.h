@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <double-conversion/double-conversion.h>
+#include <folly/Conv.h>
+#include <folly/Portability.h>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <type_traits>
+
+/// Fast paths for the string <-> number conversions of util::Converter.
+/// The parsers only accept the plain decimal forms that make up almost all
+/// data and return std::nullopt for everything else (whitespace, exponents,
+/// overflow, ...), in which case the caller falls back to util::Converter.
+/// When a fast path returns a value, it is the value util::Converter
+/// returns for the same input.
+namespace facebook::velox::util::fast {
+
+namespace detail {
+
+// Inputs with at most this many digits cannot overflow an uint64_t.
+constexpr size_t kMaxIntegerDigits = 18;
+
+// Up to 15 significant digits fit exactly in the mantissa of a double.
+constexpr size_t kMaxDoubleDigits = 15;
+
+constexpr double kPowersOfTen[] = {1e0,
+                                   1e1,
+                                   1e2,
+                                   1e3,
+                                   1e4,
+                                   1e5,
+                                   1e6,
+                                   1e7,
+                                   1e8,
+                                   1e9,
+                                   1e10,
+                                   1e11,
+                                   1e12,
+                                   1e13,
+                                   1e14,
+                                   1e15};
+
+constexpr char kDigitPairs[] =
+    "0001020304050607080910111213141516171819"
+    "2021222324252627282930313233343536373839"
+    "4041424344454647484950515253545556575859"
+    "6061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+// True if all 8 bytes of 'chunk' are ASCII digits. A byte above '9' carries
+// into the high nibble when 6 is added to it, a byte below '0' has a high
+// nibble other than 3 already.
+inline bool isEightDigits(uint64_t chunk) {
+  return ((chunk & 0xF0F0F0F0F0F0F0F0) |
+          (((chunk + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4)) ==
+      0x3333333333333333;
+}
+
+// Returns the value of 8 ASCII digits loaded little endian, i.e. with the
+// most significant digit in the lowest byte. Combines adjacent digits, then
+// pairs of 2 and pairs of 4 digits with 3 multiplications.
+inline uint32_t parseEightDigits(uint64_t chunk) {
+  constexpr uint64_t kMask = 0x000000FF000000FF;
+  constexpr uint64_t kMul1 = 100 + (1000000ULL << 32);
+  constexpr uint64_t kMul2 = 1 + (10000ULL << 32);
+  chunk -= 0x3030303030303030;
+  chunk = (chunk * 10) + (chunk >> 8);
+  chunk = (((chunk & kMask) * kMul1) + (((chunk >> 16) & kMask) * kMul2)) >> 32;
+  return static_cast<uint32_t>(chunk);
+}
+
+// Parses 'size' ASCII digits into 'value'. Returns false if there is a non
+// digit.
+inline bool parseDigits(const char* data, size_t size, uint64_t& value) {
+  size_t i = 0;
+  if constexpr (folly::kIsLittleEndian) {
+    for (; i + 8 <= size; i += 8) {
+      uint64_t chunk;
+      std::memcpy(&chunk, data + i, sizeof(chunk));
+      if (!isEightDigits(chunk)) {
+        return false;
+      }
+      value = value * 100'000'000 + parseEightDigits(chunk);
+    }
+  }
+  for (; i < size; ++i) {
+    const uint8_t digit = data[i] - '0';
+    if (digit > 9) {
+      return false;
+    }
+    value = value * 10 + digit;
+  }
+  return true;
+}
+
+} // namespace detail
+
+/// Parses [+-]?[0-9]+ with at most 18 digits. Matches folly::to<T>, which
+/// also accepts a leading '+' and leading zeros.
+template <typename T>
+std::optional<T> tryParseInteger(const char* data, size_t size) {
+  static_assert(std::is_integral_v<T> && std::is_signed_v<T>);
+  bool negative = false;
+  size_t start = 0;
+  if (size > 0 && (data[0] == '-' || data[0] == '+')) {
+    negative = data[0] == '-';
+    start = 1;
+  }
+  const size_t numDigits = size - start;
+  if (numDigits == 0 || numDigits > detail::kMaxIntegerDigits) {
+    return std::nullopt;
+  }
+  uint64_t magnitude = 0;
+  if (!detail::parseDigits(data + start, numDigits, magnitude)) {
+    return std::nullopt;
+  }
+  const int64_t value = negative ? -static_cast<int64_t>(magnitude)
+                                 : static_cast<int64_t>(magnitude);
+  if constexpr (sizeof(T) < sizeof(int64_t)) {
+    if (value < std::numeric_limits<T>::min() ||
+        value > std::numeric_limits<T>::max()) {
+      return std::nullopt;
+    }
+  }
+  return static_cast<T>(value);
+}
+
+/// Parses -?[0-9]+(\.[0-9]+)? with at most 15 digits in total. The digits
+/// and the power of ten they are divided by are exact doubles, so the
+/// division is correctly rounded and matches folly::to<double>.
+inline std::optional<double> tryParseDouble(const char* data, size_t size) {
+  const bool negative = size > 0 && data[0] == '-';
+  const size_t start = negative ? 1 : 0;
+  const char* dot =
+      static_cast<const char*>(std::memchr(data + start, '.', size - start));
+  const size_t integerDigits = dot ? dot - (data + start) : size - start;
+  const size_t fractionDigits = dot ? size - start - integerDigits - 1 : 0;
+  if (integerDigits == 0 || (dot && fractionDigits == 0) ||
+      integerDigits + fractionDigits > detail::kMaxDoubleDigits) {
+    return std::nullopt;
+  }
+  uint64_t mantissa = 0;
+  if (!detail::parseDigits(data + start, integerDigits, mantissa) ||
+      (dot && !detail::parseDigits(dot + 1, fractionDigits, mantissa))) {
+    return std::nullopt;
+  }
+  const double value =
+      static_cast<double>(mantissa) / detail::kPowersOfTen[fractionDigits];
+  return negative ? -value : value;
+}
+
+/// Enough for any integer written by formatInteger.
+constexpr size_t kMaxIntegerLength = 20;
+
+/// Enough for any double written by formatDouble.
+constexpr size_t kMaxDoubleLength = 64;
+
+/// Writes 'value' in decimal to 'out', which must have room for
+/// kMaxIntegerLength characters, and returns the number of characters.
+/// Same as folly::to<std::string>.
+inline size_t formatInteger(int64_t value, char* out) {
+  char buffer[kMaxIntegerLength];
+  char* const end = buffer + kMaxIntegerLength;
+  char* position = end;
+  uint64_t magnitude = value < 0 ? 0 - static_cast<uint64_t>(value) : value;
+  while (magnitude >= 100) {
+    position -= 2;
+    std::memcpy(position, detail::kDigitPairs + (magnitude % 100) * 2, 2);
+    magnitude /= 100;
+  }
+  if (magnitude >= 10) {
+    position -= 2;
+    std::memcpy(position, detail::kDigitPairs + magnitude * 2, 2);
+  } else {
+    *--position = '0' + magnitude;
+  }
+  if (value < 0) {
+    *--position = '-';
+  }
+  const size_t length = end - position;
+  std::memcpy(out, position, length);
+  return length;
+}
+
+/// Writes the shortest representation of 'value' that round trips to
+/// 'out', which must have room for kMaxDoubleLength characters, and returns
+/// the number of characters. Uses the settings of folly::to<std::string>,
+/// but with one converter for all calls and no std::string. Floats are
+/// written as the double they convert to, as folly does.
+inline size_t formatDouble(double value, char* out) {
+  static const double_conversion::DoubleToStringConverter kConverter(
+      double_conversion::DoubleToStringConverter::NO_FLAGS,
+      "Infinity",
+      "NaN",
+      'E',
+      folly::detail::kConvMaxDecimalInShortestLow,
+      folly::detail::kConvMaxDecimalInShortestHigh,
+      6, // max leading padding zeros
+      1); // max trailing padding zeros
+  double_conversion::StringBuilder builder(out, kMaxDoubleLength);
+  kConverter.ToShortest(value, &builder);
+  const size_t length = builder.position();
+  builder.Finalize();
+  return length;
+}
+
+} // namespace facebook::velox::util::fast
@@ -27,6 +27,7 @@
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/SimdUtil.h"
 #include "velox/type/StringView.h"
+#include "velox/type/Timestamp.h"
 
 namespace facebook ::velox::common {
 
@@ -45,6 +46,7 @@ enum class FilterKind {
   kBytesValues,
   kBigintMultiRange,
   kMultiRange,
+  kTimestampRange,
 };
 
 /**
@@ -165,6 +167,10 @@ class Filter {
     VELOX_UNSUPPORTED("{}: testBytes() is not supported.", toString());
   }
 
+  virtual bool testTimestamp(const Timestamp& /* unused */) const {
+    VELOX_UNSUPPORTED("{}: testTimestamp() is not supported.", toString());
+  }
+
   // Returns true if it is useful to call testLength before other
   // tests. This should be true for string IN and equals because it is
   // possible to fail these based on the length alone. This would
@@ -273,6 +279,10 @@ class AlwaysFalse final : public Filter {
     return false;
   }
 
+  bool testTimestamp(const Timestamp& /* unused */) const final {
+    return false;
+  }
+
   bool testBytesRange(
       std::optional<std::string_view> /*min*/,
       std::optional<std::string_view> /*max*/,
@@ -337,6 +347,10 @@ class AlwaysTrue final : public Filter {
     return true;
   }
 
+  bool testTimestamp(const Timestamp& /* unused */) const final {
+    return true;
+  }
+
   bool testBytesRange(
       std::optional<std::string_view> /*min*/,
       std::optional<std::string_view> /*max*/,
@@ -397,6 +411,10 @@ class IsNull final : public Filter {
     return false;
   }
 
+  bool testTimestamp(const Timestamp& /* unused */) const final {
+    return false;
+  }
+
   bool testBytesRange(
       std::optional<std::string_view> /*min*/,
       std::optional<std::string_view> /*max*/,
@@ -454,6 +472,10 @@ class IsNotNull final : public Filter {
     return true;
   }
 
+  bool testTimestamp(const Timestamp& /* unused */) const final {
+    return true;
+  }
+
   bool testBytesRange(
       std::optional<std::string_view> /*min*/,
       std::optional<std::string_view> /*max*/,
@@ -655,6 +677,9 @@ class BigintValuesUsingHashTable final : public Filter {
     return max_;
   }
 
+  /// Returns the values that pass the filter in no particular order.
+  std::vector<int64_t> values() const;
+
   std::string toString() const final {
     return fmt::format(
         "BigintValuesUsingHashTable: [{}, {}] {}",
@@ -710,6 +735,9 @@ class BigintValuesUsingBitmask final : public Filter {
 
   std::unique_ptr<Filter> mergeWith(const Filter* other) const final;
 
+  /// Returns the values that pass the filter in ascending order.
+  std::vector<int64_t> values() const;
+
  private:
   std::unique_ptr<Filter>
   mergeWith(int64_t min, int64_t max, const Filter* other) const;
@@ -1101,6 +1129,10 @@ class BytesValues final : public Filter {
       std::optional<std::string_view> max,
       bool hasNull) const final;
 
+  const folly::F14FastSet<std::string>& values() const {
+    return values_;
+  }
+
  private:
   std::string lower_;
   std::string upper_;
@@ -1187,6 +1219,54 @@ class MultiRange final : public Filter {
   const bool nanAllowed_;
 };
 
+/// Range filter for timestamps. Supports open, closed and unbounded ranges,
+/// e.g. c >= '2021-01-01', c BETWEEN '2021-01-01' and '2021-01-31'. Open ranges
+/// can be implemented by using the timestamp one nanosecond to the left or
+/// right of the end of the range.
+class TimestampRange final : public Filter {
+ public:
+  /// @param lower Lower end of the range, inclusive.
+  /// @param upper Upper end of the range, inclusive.
+  /// @param nullAllowed Null values are passing the filter if true.
+  TimestampRange(
+      const Timestamp& lower,
+      const Timestamp& upper,
+      bool nullAllowed)
+      : Filter(true, nullAllowed, FilterKind::kTimestampRange),
+        lower_(lower),
+        upper_(upper) {}
+
+  std::unique_ptr<Filter> clone() const final {
+    return std::make_unique<TimestampRange>(*this);
+  }
+
+  bool testTimestamp(const Timestamp& value) const final {
+    return value >= lower_ && value <= upper_;
+  }
+
+  const Timestamp& lower() const {
+    return lower_;
+  }
+
+  const Timestamp& upper() const {
+    return upper_;
+  }
+
+  std::unique_ptr<Filter> mergeWith(const Filter* other) const final;
+
+  std::string toString() const final {
+    return fmt::format(
+        "TimestampRange: [{}, {}] {}",
+        lower_.toString(),
+        upper_.toString(),
+        nullAllowed_ ? "with nulls" : "no nulls");
+  }
+
+ private:
+  const Timestamp lower_;
+  const Timestamp upper_;
+};
+
 // Helper for applying filters to different types
 template <typename TFilter, typename T>
 static inline bool applyFilter(TFilter& filter, T value) {
@@ -1214,6 +1294,11 @@ static inline bool applyFilter(TFilter& filter, StringView value) {
   return filter.testBytes(value.data(), value.size());
 }
 
+template <typename TFilter>
+static inline bool applyFilter(TFilter& filter, const Timestamp& value) {
+  return filter.testTimestamp(value);
+}
+
 // Creates a hash or bitmap based IN filter depending on value distribution.
 std::unique_ptr<Filter> createBigintValues(
     const std::vector<int64_t>& values,
@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+
+#include "velox/type/FastConversions.h"
+
+namespace facebook::velox::util::fast {
+namespace {
+
+template <typename T>
+std::optional<T> parseInteger(const std::string& input) {
+  return tryParseInteger<T>(input.data(), input.size());
+}
+
+std::optional<double> parseDouble(const std::string& input) {
+  return tryParseDouble(input.data(), input.size());
+}
+
+std::string integerToString(int64_t value) {
+  char buffer[kMaxIntegerLength];
+  return std::string(buffer, formatInteger(value, buffer));
+}
+
+std::string doubleToString(double value) {
+  char buffer[kMaxDoubleLength];
+  return std::string(buffer, formatDouble(value, buffer));
+}
+
+TEST(FastConversionsTest, parseInteger) {
+  EXPECT_EQ(0, parseInteger<int64_t>("0"));
+  EXPECT_EQ(0, parseInteger<int64_t>("-0"));
+  EXPECT_EQ(12, parseInteger<int64_t>("+12"));
+  EXPECT_EQ(7, parseInteger<int64_t>("0000000000000007"));
+  EXPECT_EQ(12345678, parseInteger<int64_t>("12345678"));
+  EXPECT_EQ(-123456789, parseInteger<int64_t>("-123456789"));
+  EXPECT_EQ(999999999999999999, parseInteger<int64_t>("999999999999999999"));
+  EXPECT_EQ(127, parseInteger<int8_t>("127"));
+  EXPECT_EQ(-32768, parseInteger<int16_t>("-32768"));
+
+  // Left to folly.
+  for (auto input :
+       {"",
+        "-",
+        "+",
+        " 1",
+        "1 ",
+        "1a",
+        "1234567a",
+        "12345678a",
+        "a2345678",
+        "1234567890123456789",
+        "1.0",
+        "1e3",
+        "--1"}) {
+    EXPECT_FALSE(parseInteger<int64_t>(input).has_value()) << input;
+  }
+  EXPECT_FALSE(parseInteger<int8_t>("128").has_value());
+  EXPECT_FALSE(parseInteger<int32_t>("-2147483649").has_value());
+}
+
+TEST(FastConversionsTest, parseIntegerMatchesFolly) {
+  std::mt19937 rng(1);
+  for (auto i = 0; i < 10'000; ++i) {
+    // Values with 1 to 18 digits.
+    int64_t value = rng() % 1'000'000'000;
+    value = value * 1'000'000'000 + rng() % 1'000'000'000;
+    value /= static_cast<int64_t>(std::pow(10, rng() % 18));
+    if (rng() % 2) {
+      value = -value;
+    }
+    auto input = folly::to<std::string>(value);
+    EXPECT_EQ(folly::to<int64_t>(input), parseInteger<int64_t>(input));
+    if (value == static_cast<int32_t>(value)) {
+      EXPECT_EQ(folly::to<int32_t>(input), parseInteger<int32_t>(input));
+    }
+  }
+}
+
+TEST(FastConversionsTest, parseDouble) {
+  EXPECT_EQ(1.5, parseDouble("1.5"));
+  EXPECT_EQ(-0.25, parseDouble("-0.25"));
+  EXPECT_EQ(123, parseDouble("123"));
+  EXPECT_EQ(0.1, parseDouble("0.1"));
+  EXPECT_EQ(123456789012345, parseDouble("123456789012345"));
+  EXPECT_EQ(0.123456789012345, parseDouble("0.123456789012345"));
+  EXPECT_TRUE(std::signbit(parseDouble("-0.0").value()));
+
+  // Left to folly.
+  for (auto input :
+       {"",
+        "-",
+        "+1",
+        ".5",
+        "1.",
+        "1..2",
+        "1.2.3",
+        "1e3",
+        " 1",
+        "NaN",
+        "1234567890123456",
+        "0.1234567890123456"}) {
+    EXPECT_FALSE(parseDouble(input).has_value()) << input;
+  }
+}
+
+TEST(FastConversionsTest, parseDoubleMatchesFolly) {
+  std::mt19937 rng(1);
+  for (auto i = 0; i < 10'000; ++i) {
+    auto integer = folly::to<std::string>(rng() % 10'000'000);
+    auto fraction = folly::to<std::string>(rng() % 100'000'000);
+    auto input = (rng() % 2 ? "-" : "") + integer + "." + fraction;
+    EXPECT_EQ(folly::to<double>(input), parseDouble(input)) << input;
+  }
+}
+
+TEST(FastConversionsTest, formatInteger) {
+  for (int64_t value :
+       {int64_t(0),
+        int64_t(-1),
+        int64_t(9),
+        int64_t(10),
+        int64_t(99),
+        int64_t(100),
+        int64_t(-12345),
+        std::numeric_limits<int64_t>::min(),
+        std::numeric_limits<int64_t>::max()}) {
+    EXPECT_EQ(folly::to<std::string>(value), integerToString(value));
+  }
+  std::mt19937_64 rng(1);
+  for (auto i = 0; i < 10'000; ++i) {
+    int64_t value = rng() >> (rng() % 64);
+    EXPECT_EQ(folly::to<std::string>(value), integerToString(value));
+  }
+}
+
+TEST(FastConversionsTest, formatDouble) {
+  for (double value :
+       {0.0,
+        -0.0,
+        0.1,
+        1.888,
+        -100.101,
+        1e20,
+        1e21,
+        1e-6,
+        1e-7,
+        123456789.25,
+        std::numeric_limits<double>::max(),
+        std::numeric_limits<double>::denorm_min(),
+        std::numeric_limits<double>::quiet_NaN(),
+        std::numeric_limits<double>::infinity(),
+        -std::numeric_limits<double>::infinity()}) {
+    EXPECT_EQ(folly::to<std::string>(value), doubleToString(value));
+  }
+  EXPECT_EQ(folly::to<std::string>(0.1f), doubleToString(0.1f));
+  std::mt19937_64 rng(1);
+  std::uniform_real_distribution<double> distribution(-1e10, 1e10);
+  for (auto i = 0; i < 10'000; ++i) {
+    double value = distribution(rng);
+    EXPECT_EQ(folly::to<std::string>(value), doubleToString(value));
+  }
+}
+
+} // namespace
+} // namespace facebook::velox::util::fast
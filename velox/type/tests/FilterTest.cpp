@@ -627,6 +627,43 @@ TEST(FilterTest, multiRangeWithNaNs) {
   EXPECT_TRUE(filter->testDouble(1.3));
 }
 
+TEST(FilterTest, timestampRange) {
+  auto filter = std::make_unique<TimestampRange>(
+      Timestamp(100, 500), Timestamp(200, 0), false);
+  EXPECT_TRUE(filter->testTimestamp(Timestamp(100, 500)));
+  EXPECT_TRUE(filter->testTimestamp(Timestamp(150, 0)));
+  EXPECT_TRUE(filter->testTimestamp(Timestamp(200, 0)));
+
+  EXPECT_FALSE(filter->testNull());
+  EXPECT_FALSE(filter->testTimestamp(Timestamp(100, 499)));
+  EXPECT_FALSE(filter->testTimestamp(Timestamp(200, 1)));
+
+  EXPECT_EQ(
+      "TimestampRange: [1970-01-01T00:01:40.000000500, "
+      "1970-01-01T00:03:20.000000000] no nulls",
+      filter->toString());
+
+  // Overlapping ranges.
+  TimestampRange other(Timestamp(150, 0), Timestamp(300, 0), true);
+  auto merged = filter->mergeWith(&other);
+  ASSERT_EQ(FilterKind::kTimestampRange, merged->kind());
+  EXPECT_TRUE(merged->testTimestamp(Timestamp(150, 0)));
+  EXPECT_TRUE(merged->testTimestamp(Timestamp(200, 0)));
+
+  EXPECT_FALSE(merged->testNull());
+  EXPECT_FALSE(merged->testTimestamp(Timestamp(149, 999)));
+  EXPECT_FALSE(merged->testTimestamp(Timestamp(200, 1)));
+
+  merged = other.mergeWith(isNotNull().get());
+  EXPECT_FALSE(merged->testNull());
+  EXPECT_TRUE(merged->testTimestamp(Timestamp(300, 0)));
+
+  // Disjoint ranges.
+  TimestampRange disjoint(Timestamp(300, 1), Timestamp(400, 0), true);
+  EXPECT_EQ(FilterKind::kAlwaysFalse, filter->mergeWith(&disjoint)->kind());
+  EXPECT_EQ(FilterKind::kIsNull, other.mergeWith(&disjoint)->kind());
+}
+
 TEST(FilterTest, createBigintValues) {
   // Small number of values from a very large range.
   {